@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/api_trace_decoder.h"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace OCLRT;
+
+int main(int numArgs, const char *argv[]) {
+    if (numArgs != 3) {
+        printf("Usage: %s <api trace file> <chrome trace json file>\n", argv[0]);
+        return 1;
+    }
+
+    std::ifstream input(argv[1], std::ios::binary);
+    if (!input.is_open()) {
+        printf("Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    ApiTraceDecoder decoder;
+    if (!decoder.load(input)) {
+        printf("%s is not a valid api trace, decoding stopped at record %zu\n", argv[1], decoder.getRecords().size());
+        return 1;
+    }
+
+    std::ofstream output(argv[2]);
+    if (!output.is_open()) {
+        printf("Cannot open %s\n", argv[2]);
+        return 1;
+    }
+    decoder.writeChromeTrace(output);
+
+    printf("Decoded %zu api calls.\n", decoder.getRecords().size());
+    return 0;
+}
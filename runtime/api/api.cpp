@@ -1340,6 +1340,12 @@ cl_int CL_API_CALL clCreateKernelsInProgram(cl_program clProgram,
     auto program = castToObject<Program>(clProgram);
     if (program) {
         auto numKernels = program->getNumKernels();
+        for (unsigned int ordinal = 0; ordinal < numKernels; ++ordinal) {
+            // patch lists decoded on first lookup may turn out to be invalid
+            if (program->getKernelInfo(ordinal) == nullptr) {
+                return CL_INVALID_PROGRAM_EXECUTABLE;
+            }
+        }
         for (unsigned int ordinal = 0; ordinal < numKernels; ++ordinal) {
             const auto kernelInfo = program->getKernelInfo(ordinal);
             DEBUG_BREAK_IF(kernelInfo == nullptr);
@@ -1657,6 +1663,7 @@ cl_int CL_API_CALL clGetEventProfilingInfo(cl_event event,
 cl_int CL_API_CALL clFlush(cl_command_queue commandQueue) {
     cl_int retVal = CL_SUCCESS;
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, nullptr);
     DBG_LOG_INPUTS("commandQueue", commandQueue);
     auto pCommandQueue = castToObject<CommandQueue>(commandQueue);
 
@@ -1669,6 +1676,7 @@ cl_int CL_API_CALL clFlush(cl_command_queue commandQueue) {
 cl_int CL_API_CALL clFinish(cl_command_queue commandQueue) {
     cl_int retVal = CL_SUCCESS;
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, nullptr);
     DBG_LOG_INPUTS("commandQueue", commandQueue);
     auto pCommandQueue = castToObject<CommandQueue>(commandQueue);
 
@@ -1696,6 +1704,7 @@ cl_int CL_API_CALL clEnqueueReadBuffer(cl_command_queue commandQueue,
         ptr);
 
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, buffer);
 
     DBG_LOG_INPUTS("commandQueue", commandQueue, "buffer", buffer, "blockingRead", blockingRead,
                    "offset", offset, "cb", cb, "ptr", ptr,
@@ -1741,6 +1750,7 @@ cl_int CL_API_CALL clEnqueueReadBufferRect(cl_command_queue commandQueue,
                                            cl_event *event) {
     cl_int retVal = CL_SUCCESS;
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, buffer);
 
     CommandQueue *pCommandQueue = nullptr;
     Buffer *pBuffer = nullptr;
@@ -1797,6 +1807,7 @@ cl_int CL_API_CALL clEnqueueWriteBuffer(cl_command_queue commandQueue,
                                         cl_event *event) {
     cl_int retVal = CL_SUCCESS;
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, buffer);
 
     DBG_LOG_INPUTS("commandQueue", commandQueue, "buffer", buffer, "blockingWrite", blockingWrite,
                    "offset", offset, "cb", cb, "ptr", ptr,
@@ -1849,6 +1860,7 @@ cl_int CL_API_CALL clEnqueueWriteBufferRect(cl_command_queue commandQueue,
                                             cl_event *event) {
     cl_int retVal = CL_SUCCESS;
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, buffer);
 
     CommandQueue *pCommandQueue = nullptr;
     Buffer *pBuffer = nullptr;
@@ -1906,6 +1918,7 @@ cl_int CL_API_CALL clEnqueueFillBuffer(cl_command_queue commandQueue,
                                        cl_event *event) {
     cl_int retVal = CL_SUCCESS;
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, buffer);
 
     CommandQueue *pCommandQueue = nullptr;
     Buffer *pBuffer = nullptr;
@@ -1942,6 +1955,7 @@ cl_int CL_API_CALL clEnqueueCopyBuffer(cl_command_queue commandQueue,
                                        cl_event *event) {
     cl_int retVal = CL_SUCCESS;
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, dstBuffer);
 
     CommandQueue *pCommandQueue = nullptr;
     Buffer *pSrcBuffer = nullptr;
@@ -1988,6 +2002,7 @@ cl_int CL_API_CALL clEnqueueCopyBufferRect(cl_command_queue commandQueue,
                                            cl_event *event) {
     cl_int retVal = CL_SUCCESS;
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, dstBuffer);
 
     CommandQueue *pCommandQueue = nullptr;
     Buffer *pSrcBuffer = nullptr;
@@ -2036,6 +2051,7 @@ cl_int CL_API_CALL clEnqueueReadImage(cl_command_queue commandQueue,
         WithCastToInternal(image, &pImage));
 
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, image);
 
     DBG_LOG_INPUTS("commandQueue", commandQueue, "image", image, "blockingRead", blockingRead,
                    "origin[0]", DebugManager.getInput(origin, 0), "origin[1]", DebugManager.getInput(origin, 1), "origin[2]", DebugManager.getInput(origin, 2),
@@ -2090,6 +2106,7 @@ cl_int CL_API_CALL clEnqueueWriteImage(cl_command_queue commandQueue,
         WithCastToInternal(image, &pImage));
 
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, image);
 
     DBG_LOG_INPUTS("commandQueue", commandQueue, "image", image, "blockingWrite", blockingWrite,
                    "origin[0]", DebugManager.getInput(origin, 0), "origin[1]", DebugManager.getInput(origin, 1), "origin[2]", DebugManager.getInput(origin, 2),
@@ -2143,6 +2160,7 @@ cl_int CL_API_CALL clEnqueueFillImage(cl_command_queue commandQueue,
         EventWaitList(numEventsInWaitList, eventWaitList));
 
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, image);
 
     DBG_LOG_INPUTS("commandQueue", commandQueue, "image", image, "fillColor", fillColor,
                    "origin[0]", origin[0], "origin[1]", origin[1], "origin[2]", origin[2],
@@ -2182,6 +2200,7 @@ cl_int CL_API_CALL clEnqueueCopyImage(cl_command_queue commandQueue,
                                   WithCastToInternal(dstImage, &pDstImage));
 
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, dstImage);
 
     DBG_LOG_INPUTS("commandQueue", commandQueue, "srcImage", srcImage, "dstImage", dstImage,
                    "origin[0]", DebugManager.getInput(srcOrigin, 0), "origin[1]", DebugManager.getInput(srcOrigin, 1), "origin[2]", DebugManager.getInput(srcOrigin, 2),
@@ -2230,6 +2249,7 @@ cl_int CL_API_CALL clEnqueueCopyImageToBuffer(cl_command_queue commandQueue,
                                               cl_event *event) {
     cl_int retVal = CL_SUCCESS;
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, dstBuffer);
 
     DBG_LOG_INPUTS("commandQueue", commandQueue, "srcImage", srcImage, "dstBuffer", dstBuffer,
                    "srcOrigin[0]", srcOrigin[0], "srcOrigin[1]", srcOrigin[1], "srcOrigin[2]", srcOrigin[2],
@@ -2279,6 +2299,7 @@ cl_int CL_API_CALL clEnqueueCopyBufferToImage(cl_command_queue commandQueue,
                                               cl_event *event) {
     cl_int retVal = CL_SUCCESS;
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, dstImage);
 
     DBG_LOG_INPUTS("commandQueue", commandQueue, "srcBuffer", srcBuffer, "dstImage", dstImage, "srcOffset", srcOffset,
                    "dstOrigin[0]", dstOrigin[0], "dstOrigin[1]", dstOrigin[1], "dstOrigin[2]", dstOrigin[2],
@@ -2331,6 +2352,7 @@ void *CL_API_CALL clEnqueueMapBuffer(cl_command_queue commandQueue,
     ErrorCodeHelper err(errcodeRet, CL_SUCCESS);
     cl_int retVal;
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, buffer);
     DBG_LOG_INPUTS("commandQueue", commandQueue, "buffer", buffer, "blockingMap", blockingMap,
                    "mapFlags", mapFlags, "offset", offset, "cb", cb,
                    "numEventsInWaitList", numEventsInWaitList,
@@ -2391,6 +2413,7 @@ void *CL_API_CALL clEnqueueMapImage(cl_command_queue commandQueue,
     cl_int retVal;
 
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, image);
 
     DBG_LOG_INPUTS("commandQueue", commandQueue,
                    "image", image,
@@ -2463,6 +2486,7 @@ cl_int CL_API_CALL clEnqueueUnmapMemObject(cl_command_queue commandQueue,
         WithCastToInternal(memObj, &pMemObj));
 
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, memObj);
 
     DBG_LOG_INPUTS("commandQueue", commandQueue,
                    "memObj", memObj,
@@ -2537,6 +2561,7 @@ cl_int CL_API_CALL clEnqueueNDRangeKernel(cl_command_queue commandQueue,
                                           cl_event *event) {
     cl_int retVal = CL_SUCCESS;
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, kernel);
     DBG_LOG_INPUTS("commandQueue", commandQueue, "cl_kernel", kernel, "globalWorkOffset", globalWorkOffset,
                    DebugManager.getSizes(globalWorkSize, workDim, false), DebugManager.getSizes(localWorkSize, workDim, true),
                    "numEventsInWaitList", numEventsInWaitList,
@@ -2575,6 +2600,7 @@ cl_int CL_API_CALL clEnqueueTask(cl_command_queue commandQueue,
                                  cl_event *event) {
     cl_int retVal = CL_SUCCESS;
     API_ENTER(&retVal);
+    API_TRACE_HANDLES(commandQueue, kernel);
     cl_uint workDim = 3;
     size_t *globalWorkOffset = nullptr;
     size_t globalWorkSize[3] = {1, 1, 1};
@@ -24,7 +24,11 @@
 #include "runtime/built_ins/built_ins.h"
 #include "runtime/built_ins/vme_dispatch_builder.h"
 #include "runtime/built_ins/sip.h"
+#include "runtime/compiler_interface/binary_cache.h"
 #include "runtime/compiler_interface/compiler_interface.h"
+#include "runtime/device/device.h"
+#include "runtime/os_interface/os_inc_base.h"
+#include "runtime/os_interface/os_library.h"
 #include "runtime/program/program.h"
 #include "runtime/mem_obj/image.h"
 #include "runtime/kernel/kernel.h"
@@ -32,6 +36,7 @@
 #include "runtime/helpers/convert_color.h"
 #include "runtime/helpers/dispatch_info_builder.h"
 #include "runtime/helpers/debug_helpers.h"
+#include <atomic>
 #include <sstream>
 
 namespace OCLRT {
@@ -44,8 +49,11 @@ const char *mediaKernelsBuildOptions = {
     "-D cl_intel_media_block_io "
     "-cl-fast-relaxed-math "};
 
-BuiltIns::BuiltIns() {
+static std::atomic<uint32_t> builtInsInstanceCounter(0);
+
+BuiltIns::BuiltIns() : instanceId(++builtInsInstanceCounter) {
     builtinsLib.reset(new BuiltinsLib());
+    sipBinaryCache.reset(new BinaryCache());
 }
 
 BuiltIns::~BuiltIns() {
@@ -111,47 +119,101 @@ SchedulerKernel &BuiltIns::getSchedulerKernel(Context &context) {
     return *static_cast<SchedulerKernel *>(schedulerBuiltIn.pKernel);
 }
 
+static std::unique_ptr<SipKernel> createSipKernel(SipKernelType type, const std::vector<char> &sipBinary) {
+    cl_int retVal = CL_SUCCESS;
+    auto program = Program::createFromGenBinary(nullptr,
+                                                sipBinary.data(),
+                                                sipBinary.size(),
+                                                true,
+                                                &retVal);
+    if (program == nullptr) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SipKernel> sipKernel;
+    retVal = program->processGenBinary();
+    auto kernelInfo = (retVal == CL_SUCCESS) ? program->getKernelInfo(size_t{0}) : nullptr;
+    if (kernelInfo != nullptr) {
+        uint32_t sipOffset = kernelInfo->systemKernelOffset;
+        if (sipOffset < kernelInfo->heapInfo.pKernelHeader->KernelHeapSize) {
+            sipKernel.reset(new SipKernel(type, ptrOffset(kernelInfo->heapInfo.pKernelHeap, sipOffset),
+                                          kernelInfo->heapInfo.pKernelHeader->KernelHeapSize - sipOffset));
+        }
+    }
+    program->release();
+    return sipKernel;
+}
+
+std::string BuiltIns::getCompilerFileStamp() const {
+    return OsLibrary::getFileStamp(Os::igcDllName);
+}
+
+std::string BuiltIns::getSipKernelCacheName(SipKernelType type, const Device &device) const {
+    const char *sipSrc = getSipLlSrc(device);
+    std::string compilerVersion = Os::igcDllName;
+    compilerVersion.append(" ");
+    compilerVersion.append(device.getDeviceInfo().driverVersion);
+    compilerVersion.append(" ");
+    compilerVersion.append(getCompilerFileStamp());
+    std::string sipInternalOptions = getSipKernelCompilerInternalOptions(type);
+
+    return sipBinaryCache->getCachedFileName(device.getHardwareInfo(),
+                                             ArrayRef<const char>(sipSrc, strlen(sipSrc)),
+                                             ArrayRef<const char>(compilerVersion.c_str(), compilerVersion.size()),
+                                             ArrayRef<const char>(sipInternalOptions.c_str(), sipInternalOptions.size()));
+}
+
 const SipKernel &BuiltIns::getSipKernel(SipKernelType type, const Device &device) {
     uint32_t kernelId = static_cast<uint32_t>(type);
     UNRECOVERABLE_IF(kernelId >= static_cast<uint32_t>(SipKernelType::COUNT));
-    auto &sipBuiltIn = this->sipKernels[kernelId];
 
-    auto initializer = [&] {
-        cl_int retVal = CL_SUCCESS;
+    // queried on every enqueue with mid-thread preemption, resolve the cache name only once per device
+    auto &resolvedSipKernel = device.getResolvedSipKernel(type);
+    auto resolvedKernel = resolvedSipKernel.find(instanceId);
+    if (resolvedKernel != nullptr) {
+        return *resolvedKernel;
+    }
+
+    auto sipCacheName = getSipKernelCacheName(type, device);
+
+    std::lock_guard<std::mutex> lock(sipKernelsMtx);
+    auto &sipKernel = this->sipKernels[sipCacheName];
+    if (sipKernel != nullptr) {
+        resolvedSipKernel.publish(sipKernel.get(), instanceId);
+        return *sipKernel;
+    }
+
+    // a valid cached binary spares loading the compiler
+    std::vector<char> sipBinary;
+    if (enableCacheing && sipBinaryCache->loadCheckedBinary(sipCacheName, sipBinary)) {
+        sipKernel = createSipKernel(type, sipBinary);
+    }
 
-        std::vector<char> sipBinary;
+    if (sipKernel == nullptr) {
         auto compilerInteface = CompilerInterface::getInstance();
         UNRECOVERABLE_IF(compilerInteface == nullptr);
 
+        sipBinary.clear();
         auto ret = compilerInteface->getSipKernelBinary(type, device, sipBinary);
 
         UNRECOVERABLE_IF(ret != CL_SUCCESS);
         UNRECOVERABLE_IF(sipBinary.size() == 0);
-        auto program = Program::createFromGenBinary(nullptr,
-                                                    sipBinary.data(),
-                                                    sipBinary.size(),
-                                                    true,
-                                                    &retVal);
-        DEBUG_BREAK_IF(retVal != CL_SUCCESS);
-        UNRECOVERABLE_IF(program == nullptr);
+        sipKernel = createSipKernel(type, sipBinary);
+        UNRECOVERABLE_IF(sipKernel == nullptr);
 
-        retVal = program->processGenBinary();
-        DEBUG_BREAK_IF(retVal != CL_SUCCESS);
-
-        auto kernelInfo = program->getKernelInfo(size_t{0});
-        UNRECOVERABLE_IF(kernelInfo == nullptr);
+        if (enableCacheing) {
+            sipBinaryCache->cacheCheckedBinary(sipCacheName, sipBinary.data(), static_cast<uint32_t>(sipBinary.size()));
+        }
+    }
+    resolvedSipKernel.publish(sipKernel.get(), instanceId);
+    return *sipKernel;
+}
 
-        uint32_t sipOffset = kernelInfo->systemKernelOffset;
-        UNRECOVERABLE_IF(sipOffset >= kernelInfo->heapInfo.pKernelHeader->KernelHeapSize)
-        sipBuiltIn.first.reset(new SipKernel(type, ptrOffset(kernelInfo->heapInfo.pKernelHeap, sipOffset),
-                                             kernelInfo->heapInfo.pKernelHeader->KernelHeapSize - sipOffset));
+BinaryCache *BuiltIns::replaceSipBinaryCache(BinaryCache *newCache) {
+    auto res = sipBinaryCache.release();
+    sipBinaryCache.reset(newCache);
 
-        DEBUG_BREAK_IF(retVal != CL_SUCCESS);
-        program->release();
-    };
-    std::call_once(sipBuiltIn.second, initializer);
-    UNRECOVERABLE_IF(sipBuiltIn.first == nullptr);
-    return *sipBuiltIn.first;
+    return res;
 }
 
 // VME:
@@ -270,12 +332,13 @@ template <typename HWFamily>
 class BuiltInOp<HWFamily, EBuiltInOps::CopyBufferToBuffer> : public BuiltinDispatchInfoBuilder {
   public:
     BuiltInOp(BuiltIns &kernelsLib, Context &context, Device &device)
-        : BuiltinDispatchInfoBuilder(kernelsLib), kernLeftLeftover(nullptr), kernMiddle(nullptr), kernRightLeftover(nullptr) {
+        : BuiltinDispatchInfoBuilder(kernelsLib), kernLeftLeftover(nullptr), kernMiddle(nullptr), kernMiddleMisaligned(nullptr), kernRightLeftover(nullptr) {
         populate(context, device,
                  EBuiltInOps::CopyBufferToBuffer,
                  "",
                  "CopyBufferToBufferLeftLeftover", kernLeftLeftover,
                  "CopyBufferToBufferMiddle", kernMiddle,
+                 "CopyBufferToBufferMiddleMisaligned", kernMiddleMisaligned,
                  "CopyBufferToBufferRightLeftover", kernRightLeftover);
     }
 
@@ -296,17 +359,14 @@ class BuiltInOp<HWFamily, EBuiltInOps::CopyBufferToBuffer> : public BuiltinDispa
 
         uintptr_t middleSizeBytes = operationParams.size.x - leftSize - rightSize; // calc middle size
 
-        if (!isAligned<4>(reinterpret_cast<uintptr_t>(operationParams.srcPtr) + operationParams.srcOffset.x + leftSize)) {
-            //corner case - src relative to dst does not have DWORD alignment
-            leftSize += middleSizeBytes;
-            middleSizeBytes = 0;
-        }
+        // src relative to dst does not have DWORD alignment - middle recombines aligned src DWORDs with funnel shifts
+        uint32_t srcMisalignment = static_cast<uint32_t>((reinterpret_cast<uintptr_t>(operationParams.srcPtr) + operationParams.srcOffset.x + leftSize) % sizeof(uint32_t));
 
         auto middleSizeEls = middleSizeBytes / middleElSize; // num work items in middle walker
 
         // Set-up ISA
         kernelSplit1DBuilder.setKernel(SplitDispatch::RegionCoordX::Left, kernLeftLeftover);
-        kernelSplit1DBuilder.setKernel(SplitDispatch::RegionCoordX::Middle, kernMiddle);
+        kernelSplit1DBuilder.setKernel(SplitDispatch::RegionCoordX::Middle, (srcMisalignment != 0) ? kernMiddleMisaligned : kernMiddle);
         kernelSplit1DBuilder.setKernel(SplitDispatch::RegionCoordX::Right, kernRightLeftover);
 
         // Set-up common kernel args
@@ -335,6 +395,11 @@ class BuiltInOp<HWFamily, EBuiltInOps::CopyBufferToBuffer> : public BuiltinDispa
         kernelSplit1DBuilder.setArg(SplitDispatch::RegionCoordX::Middle, 3, static_cast<uint32_t>(operationParams.dstOffset.x + leftSize));
         kernelSplit1DBuilder.setArg(SplitDispatch::RegionCoordX::Right, 3, static_cast<uint32_t>(operationParams.dstOffset.x + leftSize + middleSizeBytes));
 
+        // Set-up funnel shift
+        if (srcMisalignment != 0) {
+            kernelSplit1DBuilder.setArg(SplitDispatch::RegionCoordX::Middle, 4, srcMisalignment * 8);
+        }
+
         // Set-up work sizes
         // Note for split walker, it would be just builder.SetDipatchGeometry(GWS, ELWS, OFFSET)
         kernelSplit1DBuilder.setDispatchGeometry(SplitDispatch::RegionCoordX::Left, Vec3<size_t>{leftSize, 0, 0}, Vec3<size_t>{0, 0, 0}, Vec3<size_t>{0, 0, 0});
@@ -348,20 +413,47 @@ class BuiltInOp<HWFamily, EBuiltInOps::CopyBufferToBuffer> : public BuiltinDispa
   protected:
     Kernel *kernLeftLeftover;
     Kernel *kernMiddle;
+    Kernel *kernMiddleMisaligned;
     Kernel *kernRightLeftover;
 };
 
+size_t getCopyBufferRectElementSize(const BuiltinDispatchInfoBuilder::BuiltinOpParams &operationParams) {
+    auto srcBase = operationParams.srcMemObj ? reinterpret_cast<uintptr_t>(operationParams.srcMemObj->getCpuAddress()) : reinterpret_cast<uintptr_t>(operationParams.srcPtr);
+    auto dstBase = operationParams.dstMemObj ? reinterpret_cast<uintptr_t>(operationParams.dstMemObj->getCpuAddress()) : reinterpret_cast<uintptr_t>(operationParams.dstPtr);
+
+    size_t granularity = srcBase | dstBase |
+                         operationParams.srcOffset.x | operationParams.dstOffset.x | operationParams.size.x |
+                         operationParams.srcRowPitch | operationParams.srcSlicePitch |
+                         operationParams.dstRowPitch | operationParams.dstSlicePitch;
+
+    for (size_t elementSize : {16u, 8u, 4u}) {
+        if (granularity % elementSize == 0) {
+            return elementSize;
+        }
+    }
+    return 1;
+}
+
 template <typename HWFamily>
 class BuiltInOp<HWFamily, EBuiltInOps::CopyBufferRect> : public BuiltinDispatchInfoBuilder {
   public:
     BuiltInOp(BuiltIns &kernelsLib, Context &context, Device &device)
-        : BuiltinDispatchInfoBuilder(kernelsLib), kernelBytes{nullptr} {
+        : BuiltinDispatchInfoBuilder(kernelsLib), kernelBytes{nullptr}, kernel4Bytes{nullptr}, kernel8Bytes{nullptr}, kernel16Bytes{nullptr} {
         populate(context, device,
                  EBuiltInOps::CopyBufferRect,
                  "",
                  "CopyBufferRectBytes2d", kernelBytes[0],
                  "CopyBufferRectBytes2d", kernelBytes[1],
-                 "CopyBufferRectBytes3d", kernelBytes[2]);
+                 "CopyBufferRectBytes3d", kernelBytes[2],
+                 "CopyBufferRect4Bytes2d", kernel4Bytes[0],
+                 "CopyBufferRect4Bytes2d", kernel4Bytes[1],
+                 "CopyBufferRect4Bytes3d", kernel4Bytes[2],
+                 "CopyBufferRect8Bytes2d", kernel8Bytes[0],
+                 "CopyBufferRect8Bytes2d", kernel8Bytes[1],
+                 "CopyBufferRect8Bytes3d", kernel8Bytes[2],
+                 "CopyBufferRect16Bytes2d", kernel16Bytes[0],
+                 "CopyBufferRect16Bytes2d", kernel16Bytes[1],
+                 "CopyBufferRect16Bytes3d", kernel16Bytes[2]);
     }
 
     bool buildDispatchInfos(MultiDispatchInfo &multiDispatchInfo, const BuiltinOpParams &operationParams) const override {
@@ -391,7 +483,22 @@ class BuiltInOp<HWFamily, EBuiltInOps::CopyBufferRect> : public BuiltinDispatchI
 
         // Set-up ISA
         int dimensions = is3D ? 3 : 2;
-        kernelNoSplit3DBuilder.setKernel(kernelBytes[dimensions - 1]);
+        size_t elementSize = getCopyBufferRectElementSize(operationParams);
+        Kernel *const *kernels = kernelBytes;
+        switch (elementSize) {
+        case 16:
+            kernels = kernel16Bytes;
+            break;
+        case 8:
+            kernels = kernel8Bytes;
+            break;
+        case 4:
+            kernels = kernel4Bytes;
+            break;
+        default:
+            break;
+        }
+        kernelNoSplit3DBuilder.setKernel(kernels[dimensions - 1]);
 
         // arg0 = src
         if (operationParams.srcMemObj) {
@@ -407,24 +514,26 @@ class BuiltInOp<HWFamily, EBuiltInOps::CopyBufferRect> : public BuiltinDispatchI
             kernelNoSplit3DBuilder.setArgSvm(1, hostPtrSize, is3D ? operationParams.dstPtr : ptrOffset(operationParams.dstPtr, operationParams.dstOffset.z * operationParams.dstSlicePitch));
         }
 
+        // x origins and pitches are expressed in elements
         // arg2 = srcOrigin
-        uint32_t kSrcOrigin[4] = {(uint32_t)operationParams.srcOffset.x, (uint32_t)operationParams.srcOffset.y, (uint32_t)operationParams.srcOffset.z, 0};
+        uint32_t kSrcOrigin[4] = {(uint32_t)(operationParams.srcOffset.x / elementSize), (uint32_t)operationParams.srcOffset.y, (uint32_t)operationParams.srcOffset.z, 0};
         kernelNoSplit3DBuilder.setArg(2, sizeof(uint32_t) * 4, kSrcOrigin);
 
         // arg3 = dstOrigin
-        uint32_t kDstOrigin[4] = {(uint32_t)operationParams.dstOffset.x, (uint32_t)operationParams.dstOffset.y, (uint32_t)operationParams.dstOffset.z, 0};
+        uint32_t kDstOrigin[4] = {(uint32_t)(operationParams.dstOffset.x / elementSize), (uint32_t)operationParams.dstOffset.y, (uint32_t)operationParams.dstOffset.z, 0};
         kernelNoSplit3DBuilder.setArg(3, sizeof(uint32_t) * 4, kDstOrigin);
 
         // arg4 = srcPitch
-        uint32_t kSrcPitch[2] = {(uint32_t)operationParams.srcRowPitch, (uint32_t)operationParams.srcSlicePitch};
+        uint32_t kSrcPitch[2] = {(uint32_t)(operationParams.srcRowPitch / elementSize), (uint32_t)(operationParams.srcSlicePitch / elementSize)};
         kernelNoSplit3DBuilder.setArg(4, sizeof(uint32_t) * 2, kSrcPitch);
 
         // arg5 = dstPitch
-        uint32_t kDstPitch[2] = {(uint32_t)operationParams.dstRowPitch, (uint32_t)operationParams.dstSlicePitch};
+        uint32_t kDstPitch[2] = {(uint32_t)(operationParams.dstRowPitch / elementSize), (uint32_t)(operationParams.dstSlicePitch / elementSize)};
         kernelNoSplit3DBuilder.setArg(5, sizeof(uint32_t) * 2, kDstPitch);
 
         // Set-up work sizes
-        kernelNoSplit3DBuilder.setDispatchGeometry(operationParams.size, Vec3<size_t>{0, 0, 0}, Vec3<size_t>{0, 0, 0});
+        Vec3<size_t> region = {operationParams.size.x / elementSize, operationParams.size.y, operationParams.size.z};
+        kernelNoSplit3DBuilder.setDispatchGeometry(region, Vec3<size_t>{0, 0, 0}, Vec3<size_t>{0, 0, 0});
         kernelNoSplit3DBuilder.bake(multiDispatchInfo);
 
         return true;
@@ -432,6 +541,9 @@ class BuiltInOp<HWFamily, EBuiltInOps::CopyBufferRect> : public BuiltinDispatchI
 
   protected:
     Kernel *kernelBytes[3];
+    Kernel *kernel4Bytes[3];
+    Kernel *kernel8Bytes[3];
+    Kernel *kernel16Bytes[3];
 };
 
 template <typename HWFamily>
@@ -845,6 +957,23 @@ BuiltinDispatchInfoBuilder &BuiltIns::getBuiltinDispatchInfoBuilder(EBuiltInOps
     return *operationBuilder.first;
 }
 
+void BuiltIns::warmUpBuiltinDispatchInfoBuilders(Context &context, Device &device) {
+    // builders are created under call_once, so an enqueue racing with warm-up
+    // waits only for the builder it needs and never builds it twice
+    static const EBuiltInOps commonOperations[] = {
+        EBuiltInOps::CopyBufferToBuffer,
+        EBuiltInOps::CopyBufferRect,
+        EBuiltInOps::FillBuffer,
+        EBuiltInOps::CopyBufferToImage3d,
+        EBuiltInOps::CopyImage3dToBuffer,
+        EBuiltInOps::CopyImageToImage3d,
+        EBuiltInOps::FillImage3d};
+
+    for (auto operation : commonOperations) {
+        getBuiltinDispatchInfoBuilder(operation, context, device);
+    }
+}
+
 std::unique_ptr<BuiltinDispatchInfoBuilder> BuiltIns::setBuiltinDispatchInfoBuilder(EBuiltInOps operation, Context &context, Device &device, std::unique_ptr<BuiltinDispatchInfoBuilder> builder) {
     uint32_t operationId = static_cast<uint32_t>(operation);
     auto &operationBuilder = BuiltinOpsBuilders[operationId];
@@ -29,12 +29,14 @@
 #include <array>
 #include <cstdint>
 #include <fstream>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <tuple>
 
 namespace OCLRT {
+class BinaryCache;
 typedef std::vector<char> BuiltinResourceT;
 
 extern const char *mediaKernelsBuildOptions;
@@ -185,6 +187,7 @@ class BuiltIns {
     BuiltinDispatchInfoBuilder &getBuiltinDispatchInfoBuilder(EBuiltInOps op, Context &context, Device &device);
     std::unique_ptr<BuiltinDispatchInfoBuilder> setBuiltinDispatchInfoBuilder(EBuiltInOps op, Context &context, Device &device,
                                                                               std::unique_ptr<BuiltinDispatchInfoBuilder> newBuilder);
+    void warmUpBuiltinDispatchInfoBuilders(Context &context, Device &device);
 
     static BuiltIns &getInstance();
     static void shutDown();
@@ -211,6 +214,8 @@ class BuiltIns {
         return this->enableCacheing;
     }
 
+    BinaryCache *replaceSipBinaryCache(BinaryCache *newCache);
+
   protected:
     BuiltIns();
     virtual ~BuiltIns();
@@ -221,8 +226,15 @@ class BuiltIns {
     // scheduler kernel
     BuiltInKernel schedulerBuiltIn;
 
-    // sip builtins
-    std::pair<std::unique_ptr<SipKernel>, std::once_flag> sipKernels[static_cast<uint32_t>(SipKernelType::COUNT)];
+    // sip builtins, keyed by their binary cache name
+    std::string getSipKernelCacheName(SipKernelType type, const Device &device) const;
+    // changes whenever the compiler library is replaced, without loading it
+    MOCKABLE_VIRTUAL std::string getCompilerFileStamp() const;
+    std::map<std::string, std::unique_ptr<SipKernel>> sipKernels;
+    std::mutex sipKernelsMtx;
+    std::unique_ptr<BinaryCache> sipBinaryCache;
+    // tags sip kernels resolved into devices, never reused by a later instance
+    const uint32_t instanceId;
 
     std::unique_ptr<BuiltinsLib> builtinsLib;
 
@@ -294,6 +306,9 @@ class BuiltinDispatchInfoBuilder {
     BuiltIns &kernelsLib;
 };
 
+// widest element (16, 8, 4 or 1 bytes) dividing base addresses, x origins, pitches and region width of a rect copy
+size_t getCopyBufferRectElementSize(const BuiltinDispatchInfoBuilder::BuiltinOpParams &operationParams);
+
 template <typename HWFamily, EBuiltInOps OpCode>
 class BuiltInOp;
 
@@ -61,8 +61,6 @@ void SchedulerSimulation<BDWFamily>::startScheduler(uint32_t index,
                                                     GraphicsAllocation *ssh,
                                                     GraphicsAllocation *debugQueue) {
 
-    threadIDToLocalIDmap.insert(std::make_pair(std::this_thread::get_id(), index));
-
     while (!conditionReady) {
     }
 
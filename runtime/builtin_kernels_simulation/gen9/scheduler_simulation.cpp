@@ -63,8 +63,6 @@ void SchedulerSimulation<SKLFamily>::startScheduler(uint32_t index,
                                                     GraphicsAllocation *ssh,
                                                     GraphicsAllocation *debugQueue) {
 
-    threadIDToLocalIDmap.insert(std::make_pair(std::this_thread::get_id(), index));
-
     while (!conditionReady) {
     }
 
@@ -57,13 +57,18 @@ int4 operator+(int4 const &a, int4 const &b) {
     return c;
 }
 
+// the map is filled before the workers are dispatched and only read while they run
+static uint32_t getThreadLocalId() {
+    auto it = threadIDToLocalIDmap.find(std::this_thread::get_id());
+    return it != threadIDToLocalIDmap.end() ? it->second : 0;
+}
+
 uint get_local_id(int dim) {
     uint LID = 0;
 
     // use thread id
     if (threadIDToLocalIDmap.size() > 0) {
-        std::thread::id id = std::this_thread::get_id();
-        LID = threadIDToLocalIDmap[id] % 24;
+        LID = getThreadLocalId() % 24;
     }
     // use id from loop iteration
     else {
@@ -77,8 +82,7 @@ uint get_global_id(int dim) {
 
     // use thread id
     if (threadIDToLocalIDmap.size() > 0) {
-        std::thread::id id = std::this_thread::get_id();
-        GID = threadIDToLocalIDmap[id];
+        GID = getThreadLocalId();
     }
     // use id from loop iteration
     else {
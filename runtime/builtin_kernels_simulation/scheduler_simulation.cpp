@@ -31,6 +31,82 @@ using namespace OCLRT;
 namespace BuiltinKernelsSimulation {
 
 bool conditionReady = false;
-std::thread threads[NUM_OF_THREADS];
+
+SchedulerSimulationThreadPool::~SchedulerSimulationThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        terminate = true;
+    }
+    taskReady.notify_all();
+
+    for (uint32_t i = 1; i < NUM_OF_THREADS; i++) {
+        if (workers[i].joinable()) {
+            workers[i].join();
+        }
+    }
+}
+
+SchedulerSimulationThreadPool &SchedulerSimulationThreadPool::getInstance() {
+    static SchedulerSimulationThreadPool threadPool;
+    return threadPool;
+}
+
+void SchedulerSimulationThreadPool::start() {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (started) {
+        return;
+    }
+    for (uint32_t i = 1; i < NUM_OF_THREADS; i++) {
+        workers[i] = std::thread(&SchedulerSimulationThreadPool::workerLoop, this, i);
+    }
+    started = true;
+}
+
+void SchedulerSimulationThreadPool::run(const std::function<void(uint32_t)> &task) {
+    std::lock_guard<std::mutex> runLock(runMutex);
+    start();
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        this->task = &task;
+        workersRunning = NUM_OF_THREADS - 1;
+        generation++;
+    }
+    taskReady.notify_all();
+
+    task(0);
+
+    std::unique_lock<std::mutex> lock(mtx);
+    taskDone.wait(lock, [this] { return workersRunning == 0; });
+    this->task = nullptr;
+}
+
+std::thread::id SchedulerSimulationThreadPool::getThreadId(uint32_t index) const {
+    if (index == 0 || index >= NUM_OF_THREADS) {
+        return std::thread::id();
+    }
+    return workers[index].get_id();
+}
+
+void SchedulerSimulationThreadPool::workerLoop(uint32_t index) {
+    uint64_t lastGeneration = 0;
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+        taskReady.wait(lock, [&] { return terminate || generation != lastGeneration; });
+        if (terminate) {
+            return;
+        }
+        lastGeneration = generation;
+        auto currentTask = task;
+
+        lock.unlock();
+        (*currentTask)(index);
+        lock.lock();
+
+        if (--workersRunning == 0) {
+            taskDone.notify_one();
+        }
+    }
+}
 
 } // namespace BuiltinKernelsSimulation
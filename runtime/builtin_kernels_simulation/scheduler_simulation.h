@@ -20,7 +20,10 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 #pragma once
+#include <condition_variable>
 #include <cstdint>
+#include <functional>
+#include <mutex>
 #include <thread>
 
 #include "runtime/builtin_kernels_simulation/opencl_c.h"
@@ -31,7 +34,38 @@ class GraphicsAllocation;
 namespace BuiltinKernelsSimulation {
 
 extern bool conditionReady;
-extern std::thread threads[];
+
+// Threads for local IDs 1..NUM_OF_THREADS-1 of the simulated scheduler work group.
+// They are created on first use and reused by every run, local ID 0 runs on the caller.
+class SchedulerSimulationThreadPool {
+  public:
+    SchedulerSimulationThreadPool() = default;
+    ~SchedulerSimulationThreadPool();
+
+    static SchedulerSimulationThreadPool &getInstance();
+
+    void start();
+    void run(const std::function<void(uint32_t)> &task);
+
+    std::thread::id getThreadId(uint32_t index) const;
+    SynchronizationBarrier *getGlobalBarrier() { return &globalBarrier; }
+    bool isStarted() const { return started; }
+
+  protected:
+    void workerLoop(uint32_t index);
+
+    std::mutex runMutex;
+    std::mutex mtx;
+    std::condition_variable taskReady;
+    std::condition_variable taskDone;
+    const std::function<void(uint32_t)> *task = nullptr;
+    uint64_t generation = 0;
+    uint32_t workersRunning = 0;
+    bool terminate = false;
+    bool started = false;
+    std::thread workers[NUM_OF_THREADS];
+    SynchronizationBarrier globalBarrier{NUM_OF_THREADS};
+};
 
 template <typename GfxFamily>
 class SchedulerSimulation {
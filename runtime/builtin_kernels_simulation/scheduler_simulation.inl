@@ -35,7 +35,7 @@ namespace BuiltinKernelsSimulation {
 template <typename GfxFamily>
 void SchedulerSimulation<GfxFamily>::cleanSchedulerSimulation() {
     threadIDToLocalIDmap.clear();
-    delete pGlobalBarrier;
+    pGlobalBarrier = nullptr;
 }
 
 template <typename GfxFamily>
@@ -53,13 +53,16 @@ void SchedulerSimulation<GfxFamily>::initializeSchedulerSimulation(GraphicsAlloc
     localSize[1] = 1;
     localSize[2] = 1;
 
-    threadIDToLocalIDmap.clear();
-    pGlobalBarrier = new SynchronizationBarrier(NUM_OF_THREADS);
+    auto &threadPool = SchedulerSimulationThreadPool::getInstance();
+    threadPool.start();
 
-    // Spawn Thread ID == 0 on main thread
+    // Local IDs are known up front, workers only look them up
+    threadIDToLocalIDmap.clear();
+    threadIDToLocalIDmap[std::this_thread::get_id()] = 0;
     for (uint32_t i = 1; i < NUM_OF_THREADS; i++) {
-        threads[i] = std::thread(startScheduler, i, queue, commandsStack, eventsPool, secondaryBatchBuffer, dsh, reflectionSurface, queueStorageBuffer, ssh, debugQueue);
+        threadIDToLocalIDmap[threadPool.getThreadId(i)] = i;
     }
+    pGlobalBarrier = threadPool.getGlobalBarrier();
 
     conditionReady = true;
 }
@@ -86,26 +89,21 @@ void SchedulerSimulation<GfxFamily>::runSchedulerSimulation(GraphicsAllocation *
                                       ssh,
                                       debugQueue);
 
-        // start main thread with LID == 0
-        startScheduler(0,
-                       queue,
-                       commandsStack,
-                       eventsPool,
-                       secondaryBatchBuffer,
-                       dsh,
-                       reflectionSurface,
-                       queueStorageBuffer,
-                       ssh,
-                       debugQueue);
-
-        // Wait for all threads on main thread
-        if (threadIDToLocalIDmap[std::this_thread::get_id()] == 0) {
-
-            for (uint32_t i = 1; i < NUM_OF_THREADS; i++)
-                threads[i].join();
-
-            cleanSchedulerSimulation();
-        }
+        // main thread runs LID == 0 and returns when all threads are done
+        SchedulerSimulationThreadPool::getInstance().run([&](uint32_t index) {
+            startScheduler(index,
+                           queue,
+                           commandsStack,
+                           eventsPool,
+                           secondaryBatchBuffer,
+                           dsh,
+                           reflectionSurface,
+                           queueStorageBuffer,
+                           ssh,
+                           debugQueue);
+        });
+
+        cleanSchedulerSimulation();
     }
 };
 
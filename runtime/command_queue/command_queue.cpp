@@ -22,6 +22,7 @@
 
 #include "runtime/command_queue/command_queue.h"
 #include "runtime/command_queue/command_queue_hw.h"
+#include "runtime/command_queue/cpu_transfer_worker.h"
 #include "runtime/command_stream/command_stream_receiver.h"
 #include "runtime/context/context.h"
 #include "runtime/device/device.h"
@@ -30,6 +31,7 @@
 #include "runtime/event/event_builder.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/array_count.h"
+#include "runtime/helpers/blocked_commands_pool.h"
 #include "runtime/helpers/get_info.h"
 #include "runtime/helpers/options.h"
 #include "runtime/helpers/ptr_math.h"
@@ -88,9 +90,14 @@ CommandQueue::CommandQueue(Context *context,
     }
     commandQueueProperties = getCmdQueueProperties<cl_command_queue_properties>(properties);
     flushStamp.reset(new FlushStampTracker(true));
+    blockedCommandsPool.reset(new BlockedCommandsPool());
 }
 
 CommandQueue::~CommandQueue() {
+    if (cpuTransferWorker) {
+        cpuTransferWorker->stop();
+    }
+
     if (virtualEvent) {
         UNRECOVERABLE_IF(this->virtualEvent->getCommandQueue() != this && this->virtualEvent->getCommandQueue() != nullptr);
         virtualEvent->setCurrentCmdQVirtualEvent(false);
@@ -233,7 +240,14 @@ IndirectHeap &CommandQueue::getIndirectHeap(IndirectHeap::Type heapType,
     if (heap)
         heapMemory = heap->getGraphicsAllocation();
 
-    if (heap && heap->getAvailableSpace() < minRequiredSize && heapMemory) {
+    if (heap && heapMemory && heap->isUsageTracked()) {
+        auto reservedSize = heapType == IndirectHeap::INSTRUCTION ? getInstructionHeapReservedBlockSize() : 0;
+        if (reuseIndirectHeapSpace(*heap, minRequiredSize, reservedSize)) {
+            return *heap;
+        }
+        memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(heapMemory), REUSABLE_ALLOCATION);
+        heapMemory = nullptr;
+    } else if (heap && heap->getAvailableSpace() < minRequiredSize && heapMemory) {
         memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(heapMemory), REUSABLE_ALLOCATION);
         heapMemory = nullptr;
     }
@@ -266,9 +280,11 @@ IndirectHeap &CommandQueue::getIndirectHeap(IndirectHeap::Type heapType,
         if (heap) {
             heap->replaceBuffer(heapMemory->getUnderlyingBuffer(), finalHeapSize);
             heap->replaceGraphicsAllocation(heapMemory);
+            heap->resetUsageTracking();
         } else {
             heap = new IndirectHeap(heapMemory);
             heap->overrideMaxSize(finalHeapSize);
+            heap->enableUsageTracking();
         }
 
         if (heapType == IndirectHeap::INSTRUCTION) {
@@ -280,6 +296,40 @@ IndirectHeap &CommandQueue::getIndirectHeap(IndirectHeap::Type heapType,
     return *heap;
 }
 
+bool CommandQueue::reuseIndirectHeapSpace(IndirectHeap &heap, size_t minRequiredSize, size_t reservedSize) {
+    if (minRequiredSize + reservedSize > heap.getMaxAvailableSpace()) {
+        return false;
+    }
+
+    auto &commandStreamReceiver = device->getCommandStreamReceiver();
+    heap.reclaimCompletedUsage(*commandStreamReceiver.getTagAddress());
+
+    if (heap.getAvailableSpace() < minRequiredSize) {
+        // wrap around behind the reserved block, heap base and size stay unchanged
+        heap.rewind(commandStreamReceiver.peekTaskCount() + 1, reservedSize);
+    }
+
+    auto taskCountToReuse = heap.getTaskCountToReuse(minRequiredSize);
+    if (taskCountToReuse > commandStreamReceiver.peekTaskCount()) {
+        // space is held by the task currently being built, it cannot be waited on
+        return false;
+    }
+
+    if (taskCountToReuse > *commandStreamReceiver.getTagAddress()) {
+        commandStreamReceiver.waitForTaskCountWithKmdNotifyFallback(taskCountToReuse, flushStamp->peekStamp());
+        heap.reclaimCompletedUsage(*commandStreamReceiver.getTagAddress());
+    }
+    return true;
+}
+
+void CommandQueue::markIndirectHeapsUsedByTask(uint32_t taskCount) {
+    for (auto heap : indirectHeap) {
+        if (heap && heap->isUsageTracked()) {
+            heap->markUsedByTask(taskCount);
+        }
+    }
+}
+
 void CommandQueue::releaseIndirectHeap(IndirectHeap::Type heapType) {
     DEBUG_BREAK_IF(static_cast<uint32_t>(heapType) >= ARRAY_COUNT(indirectHeap));
     auto &heap = indirectHeap[heapType];
@@ -294,6 +344,7 @@ void CommandQueue::releaseIndirectHeap(IndirectHeap::Type heapType) {
             memoryManager->storeAllocation(std::unique_ptr<GraphicsAllocation>(heapMemory), REUSABLE_ALLOCATION);
         heap->replaceBuffer(nullptr, 0);
         heap->replaceGraphicsAllocation(nullptr);
+        heap->resetUsageTracking();
     }
 }
 
@@ -544,6 +595,69 @@ void *CommandQueue::enqueueReadMemObjForMap(TransferProperties &transferProperti
     return returnPtr;
 }
 
+bool CommandQueue::isCpuTransferSelected(bool cpuTransferPossible, bool cpuTransferPreferred, size_t transferSize) {
+    if (!cpuTransferPossible) {
+        return false;
+    }
+    auto defaultPath = cpuTransferPreferred ? TransferPath::CPU : TransferPath::GPU;
+    return device->getTransferPlanner().selectPath(transferSize, defaultPath) == TransferPath::CPU;
+}
+
+void CommandQueue::enqueueAsyncCpuTransfer(TransferProperties &transferProperties, EventsRequest &eventsRequest) {
+    TakeOwnershipWrapper<Device> deviceOwnership(*device);
+    TakeOwnershipWrapper<CommandQueue> queueOwnership(*this);
+
+    // the worker waits for the GPU work enqueued so far, batched submissions have to reach the hardware
+    device->getCommandStreamReceiver().flushBatchedSubmissions();
+    auto queueBlocked = isQueueBlocked();
+
+    EventBuilder eventBuilder;
+    if (eventsRequest.outEvent) {
+        eventBuilder.create<Event>(this, transferProperties.cmdType, Event::eventNotReady, Event::eventNotReady);
+        *eventsRequest.outEvent = eventBuilder.getEvent();
+        // second reference is held by the queue, the transfer event becomes its virtual event
+        eventBuilder.getEvent()->incRefInternal();
+    } else {
+        eventBuilder.create<VirtualEvent>(this, context);
+    }
+    auto transferEvent = eventBuilder.getEvent();
+    if (transferEvent->isProfilingEnabled()) {
+        transferEvent->setQueueTimeStamp();
+        transferEvent->setCPUProfilingPath(true);
+    }
+
+    // blocked commands are waited for through the virtual event dependency
+    auto taskCountToWait = queueBlocked ? 0u : taskCount;
+    auto flushStampToWait = queueBlocked ? 0u : flushStamp->peekStamp();
+    auto cmd = std::unique_ptr<Command>(new CommandCpuTransfer(*this, *transferEvent, *transferProperties.memObj,
+                                                               transferProperties.cmdType == CL_COMMAND_WRITE_BUFFER,
+                                                               *transferProperties.offset, *transferProperties.size, transferProperties.ptr,
+                                                               taskCountToWait, flushStampToWait));
+    transferEvent->setCommand(std::move(cmd));
+
+    std::unique_ptr<CpuTransferWorker::Job> job(new CpuTransferWorker::Job());
+    job->transferEvent = transferEvent;
+    for (cl_uint i = 0; i < eventsRequest.numEventsInWaitList; i++) {
+        job->dependencies.push_back(castToObjectOrAbort<Event>(eventsRequest.eventWaitList[i]));
+    }
+    if (queueBlocked) {
+        job->dependencies.push_back(virtualEvent);
+    }
+
+    transferEvent->setCurrentCmdQVirtualEvent(true);
+    if (!cpuTransferWorker) {
+        cpuTransferWorker = CpuTransferWorker::create();
+    }
+    cpuTransferWorker->enqueue(std::move(job));
+
+    if (virtualEvent) {
+        virtualEvent->setCurrentCmdQVirtualEvent(false);
+        virtualEvent->decRefInternal();
+    }
+    virtualEvent = transferEvent;
+    taskCount = transferEvent->getCompletionStamp();
+}
+
 void *CommandQueue::enqueueMapMemObject(TransferProperties &transferProperties, EventsRequest &eventsRequest, cl_int &errcodeRet) {
     if (transferProperties.memObj->mappingOnCpuAllowed()) {
         return cpuDataTransferHandler(transferProperties, eventsRequest, errcodeRet);
@@ -31,9 +31,11 @@
 #include <cstdint>
 
 namespace OCLRT {
+class BlockedCommandsPool;
 class Buffer;
 class LinearStream;
 class Context;
+class CpuTransferWorker;
 class Device;
 class EventBuilder;
 class Image;
@@ -300,6 +302,13 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
 
     void *cpuDataTransferHandler(TransferProperties &transferProperties, EventsRequest &eventsRequest, cl_int &retVal);
 
+    // cpuTransferPreferred carries the static heuristics used until the device transfer planner is calibrated
+    bool isCpuTransferSelected(bool cpuTransferPossible, bool cpuTransferPreferred, size_t transferSize);
+
+    // non-blocking read/write buffer copied on the queue's CPU transfer worker, later enqueues wait for it
+    void enqueueAsyncCpuTransfer(TransferProperties &transferProperties, EventsRequest &eventsRequest);
+    CpuTransferWorker *peekCpuTransferWorker() const { return cpuTransferWorker.get(); }
+
     virtual cl_int finish(bool dcFlush) { return CL_SUCCESS; }
 
     virtual cl_int flush() { return CL_SUCCESS; }
@@ -338,6 +347,9 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
                                   size_t minRequiredSize = 0u);
 
     MOCKABLE_VIRTUAL void releaseIndirectHeap(IndirectHeap::Type heapType);
+    void markIndirectHeapsUsedByTask(uint32_t taskCount);
+
+    BlockedCommandsPool &getBlockedCommandsPool() { return *blockedCommandsPool; }
 
     cl_command_queue_properties getCommandQueueProperties() const {
         return commandQueueProperties;
@@ -409,6 +421,8 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
 
     virtual void obtainTaskLevelAndBlockedStatus(unsigned int &taskLevel, cl_uint &numEventsInWaitList, const cl_event *&eventWaitList, bool &blockQueue, unsigned int commandType){};
 
+    bool reuseIndirectHeapSpace(IndirectHeap &heap, size_t minRequiredSize, size_t reservedSize);
+
     Context *context;
     Device *device;
 
@@ -427,6 +441,9 @@ class CommandQueue : public BaseObject<_cl_command_queue> {
     LinearStream *commandStream;
     IndirectHeap *indirectHeap[NUM_HEAPS];
 
+    std::unique_ptr<BlockedCommandsPool> blockedCommandsPool;
+    std::shared_ptr<CpuTransferWorker> cpuTransferWorker;
+
     bool mapDcFlushRequired = false;
     bool isSpecialCommandQueue = false;
 };
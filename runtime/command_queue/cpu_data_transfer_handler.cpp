@@ -27,6 +27,7 @@
 #include "runtime/helpers/get_info.h"
 #include "runtime/mem_obj/buffer.h"
 #include "runtime/mem_obj/image.h"
+#include <chrono>
 
 namespace OCLRT {
 void *CommandQueue::cpuDataTransferHandler(TransferProperties &transferProperties, EventsRequest &eventsRequest, cl_int &retVal) {
@@ -91,6 +92,9 @@ void *CommandQueue::cpuDataTransferHandler(TransferProperties &transferPropertie
             eventBuilder.getEvent()->setStartTimeStamp();
         }
 
+        size_t transferSize = 0;
+        auto transferStart = std::chrono::steady_clock::now();
+
         switch (transferProperties.cmdType) {
         case CL_COMMAND_MAP_BUFFER:
             if (!transferProperties.memObj->isMemObjZeroCopy()) {
@@ -154,6 +158,7 @@ void *CommandQueue::cpuDataTransferHandler(TransferProperties &transferPropertie
                 context->providePerformanceHint(CL_CONTEXT_DIAGNOSTICS_LEVEL_BAD_INTEL, CL_ENQUEUE_READ_BUFFER_REQUIRES_COPY_DATA, static_cast<cl_mem>(transferProperties.memObj), transferProperties.ptr);
             }
             memcpy_s(transferProperties.ptr, *transferProperties.size, ptrOffset(transferProperties.memObj->getCpuAddressForMemoryTransfer(), *transferProperties.offset), *transferProperties.size);
+            transferSize = *transferProperties.size;
             eventCompleted = true;
             break;
         case CL_COMMAND_WRITE_BUFFER:
@@ -161,6 +166,34 @@ void *CommandQueue::cpuDataTransferHandler(TransferProperties &transferPropertie
                 context->providePerformanceHint(CL_CONTEXT_DIAGNOSTICS_LEVEL_BAD_INTEL, CL_ENQUEUE_WRITE_BUFFER_REQUIRES_COPY_DATA, static_cast<cl_mem>(transferProperties.memObj), transferProperties.ptr);
             }
             memcpy_s(ptrOffset(transferProperties.memObj->getCpuAddressForMemoryTransfer(), *transferProperties.offset), *transferProperties.size, transferProperties.ptr, *transferProperties.size);
+            transferSize = *transferProperties.size;
+            eventCompleted = true;
+            break;
+        case CL_COMMAND_READ_BUFFER_RECT:
+        case CL_COMMAND_WRITE_BUFFER_RECT:
+            castToObjectOrAbort<Buffer>(transferProperties.memObj)->transferRectOnCpu(transferProperties.ptr, transferProperties.offset, transferProperties.hostOrigin, transferProperties.size,
+                                                                                      transferProperties.memObjRowPitch, transferProperties.memObjSlicePitch,
+                                                                                      transferProperties.hostRowPitch, transferProperties.hostSlicePitch,
+                                                                                      transferProperties.cmdType == CL_COMMAND_WRITE_BUFFER_RECT);
+            transferSize = transferProperties.size[0] * transferProperties.size[1] * transferProperties.size[2];
+            eventCompleted = true;
+            break;
+        case CL_COMMAND_READ_IMAGE:
+            if (!image->readTiledOnCpu(transferProperties.ptr, transferProperties.hostRowPitch, transferProperties.hostSlicePitch,
+                                       transferProperties.offset, transferProperties.size)) {
+                err.set(CL_OUT_OF_RESOURCES);
+            } else {
+                transferSize = image->calculateTransferSize(transferProperties.size);
+            }
+            eventCompleted = true;
+            break;
+        case CL_COMMAND_WRITE_IMAGE:
+            if (!image->writeTiledOnCpu(transferProperties.ptr, transferProperties.hostRowPitch, transferProperties.hostSlicePitch,
+                                        transferProperties.offset, transferProperties.size)) {
+                err.set(CL_OUT_OF_RESOURCES);
+            } else {
+                transferSize = image->calculateTransferSize(transferProperties.size);
+            }
             eventCompleted = true;
             break;
         case CL_COMMAND_MARKER:
@@ -169,6 +202,11 @@ void *CommandQueue::cpuDataTransferHandler(TransferProperties &transferPropertie
             err.set(CL_INVALID_OPERATION);
         }
 
+        if (transferSize != 0) {
+            auto transferTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - transferStart);
+            device->getTransferPlanner().recordCpuTransfer(transferSize, static_cast<uint64_t>(transferTime.count()));
+        }
+
         if (eventBuilder.getEvent()) {
             eventBuilder.getEvent()->setEndTimeStamp();
             eventBuilder.getEvent()->updateTaskCount(this->taskCount);
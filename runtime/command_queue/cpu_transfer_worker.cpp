@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/cpu_transfer_worker.h"
+#include "runtime/command_queue/command_queue.h"
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/device/device.h"
+#include "runtime/event/event.h"
+
+namespace OCLRT {
+
+std::shared_ptr<CpuTransferWorker> CpuTransferWorker::create() {
+    std::shared_ptr<CpuTransferWorker> transferWorker(new CpuTransferWorker());
+    // the thread holds its own reference, so the worker outlives an owner released by the last job
+    transferWorker->worker = std::thread([transferWorker]() { transferWorker->run(); });
+    return transferWorker;
+}
+
+void CpuTransferWorker::stop() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (stopped) {
+            return;
+        }
+        stopped = true;
+    }
+    jobSubmitted.notify_one();
+    if (worker.get_id() == std::this_thread::get_id()) {
+        worker.detach();
+    } else {
+        worker.join();
+    }
+}
+
+void CpuTransferWorker::enqueue(std::unique_ptr<Job> job) {
+    job->transferEvent->incRefInternal();
+    for (auto dependency : job->dependencies) {
+        dependency->incRefInternal();
+    }
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    queue.push_back(std::move(job));
+    jobSubmitted.notify_one();
+}
+
+void CpuTransferWorker::drain() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    jobCompleted.wait(lock, [&] { return queue.empty() && !busy; });
+}
+
+namespace {
+struct SubmissionSignal {
+    std::mutex mtx;
+    std::condition_variable submitted;
+    bool signalled = false;
+};
+
+void CL_CALLBACK signalSubmission(cl_event event, cl_int status, void *data) {
+    auto signal = static_cast<std::shared_ptr<SubmissionSignal> *>(data);
+    {
+        std::lock_guard<std::mutex> lock((*signal)->mtx);
+        (*signal)->signalled = true;
+    }
+    (*signal)->submitted.notify_one();
+    delete signal;
+}
+} // namespace
+
+void CpuTransferWorker::waitForSubmission(Event &dependency) {
+    // moves events that aren't blocked to CL_SUBMITTED, the rest is transitioned by whoever unblocks them
+    dependency.updateExecutionStatus();
+    if (dependency.peekExecutionStatus() <= CL_SUBMITTED) {
+        return;
+    }
+
+    // the callback may run after this wait returned, so it owns a reference of the signal
+    auto signal = std::make_shared<SubmissionSignal>();
+    dependency.addCallback(signalSubmission, CL_SUBMITTED, new std::shared_ptr<SubmissionSignal>(signal));
+
+    std::unique_lock<std::mutex> lock(signal->mtx);
+    signal->submitted.wait(lock, [&] { return signal->signalled || dependency.peekExecutionStatus() <= CL_SUBMITTED; });
+}
+
+int32_t CpuTransferWorker::waitForDependencies(Job &job) {
+    for (auto dependency : job.dependencies) {
+        waitForSubmission(*dependency);
+        if (dependency->isStatusCompletedByTermination()) {
+            return dependency->peekExecutionStatus();
+        }
+        // virtual events complete once their commands are submitted, the GPU work itself has to finish too
+        auto dependencyQueue = dependency->getCommandQueue();
+        if (dependencyQueue && dependency->peekTaskCount() != Event::eventNotReady) {
+            {
+                TakeOwnershipWrapper<Device> deviceOwnership(dependencyQueue->getDevice());
+                dependencyQueue->getDevice().getCommandStreamReceiver().flushBatchedSubmissions();
+            }
+            dependencyQueue->waitUntilComplete(dependency->peekTaskCount(), dependency->flushStamp->peekStamp());
+        }
+    }
+    return CL_COMPLETE;
+}
+
+void CpuTransferWorker::process(Job &job) {
+    auto transferEvent = job.transferEvent;
+
+    // completes the event, runs its transfer command and submits the commands blocked by it
+    transferEvent->setStatus(waitForDependencies(job));
+    if (transferEvent->isCurrentCmdQVirtualEvent()) {
+        transferEvent->getCommandQueue()->isQueueBlocked();
+    }
+
+    for (auto dependency : job.dependencies) {
+        dependency->decRefInternal();
+    }
+    transferEvent->decRefInternal();
+}
+
+void CpuTransferWorker::run() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true) {
+        jobSubmitted.wait(lock, [&] { return stopped || !queue.empty(); });
+        if (queue.empty()) {
+            return;
+        }
+        auto job = std::move(queue.front());
+        queue.pop_front();
+        busy = true;
+        lock.unlock();
+
+        process(*job);
+        job.reset();
+
+        lock.lock();
+        busy = false;
+        jobCompleted.notify_all();
+    }
+}
+} // namespace OCLRT
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OCLRT {
+class Event;
+
+// Submits CPU transfer commands of non-blocking reads and writes on a dedicated thread.
+// A job sleeps until its dependencies are submitted, waits for their GPU work, then completes
+// the transfer event, which runs its command and unblocks the commands waiting for it.
+class CpuTransferWorker {
+  public:
+    struct Job {
+        Event *transferEvent = nullptr;
+        std::vector<Event *> dependencies;
+    };
+
+    static std::shared_ptr<CpuTransferWorker> create();
+
+    CpuTransferWorker(const CpuTransferWorker &) = delete;
+    CpuTransferWorker &operator=(const CpuTransferWorker &) = delete;
+
+    // takes internal references of the transfer event and its dependencies
+    void enqueue(std::unique_ptr<Job> job);
+    void drain();
+
+    // Finishes the queued jobs and joins the thread. Releasing the last job may destroy the
+    // owner of this worker on the worker thread itself, the thread is detached in that case.
+    void stop();
+
+  protected:
+    CpuTransferWorker() = default;
+    // blocks until the event's commands are submitted (or it completes), without polling
+    static void waitForSubmission(Event &dependency);
+    static int32_t waitForDependencies(Job &job);
+    static void process(Job &job);
+    void run();
+
+    bool busy = false;
+    bool stopped = false;
+    std::deque<std::unique_ptr<Job>> queue;
+    std::mutex queueMutex;
+    std::condition_variable jobSubmitted;
+    std::condition_variable jobCompleted;
+    std::thread worker;
+};
+} // namespace OCLRT
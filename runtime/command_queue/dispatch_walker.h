@@ -34,6 +34,7 @@
 #include "runtime/event/user_event.h"
 #include "runtime/indirect_heap/indirect_heap.h"
 #include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/blocked_commands_pool.h"
 #include "runtime/helpers/debug_helpers.h"
 #include "runtime/helpers/kernel_commands.h"
 #include "runtime/helpers/task_information.h"
@@ -459,28 +460,35 @@ void dispatchWalker(
     size_t cmdQInstructionHeapReservedBlockSize = 0;
     if (blockQueue) {
         using KCH = KernelCommandsHelper<GfxFamily>;
-        commandStream = new LinearStream(alignedMalloc(MemoryConstants::pageSize, MemoryConstants::pageSize), MemoryConstants::pageSize);
         if (executionModelKernel) {
+            commandStream = new LinearStream(alignedMalloc(MemoryConstants::pageSize, MemoryConstants::pageSize), MemoryConstants::pageSize);
             uint32_t offsetDsh = commandQueue.getContext().getDefaultDeviceQueue()->getDshOffset();
             uint32_t colorCalcSize = commandQueue.getContext().getDefaultDeviceQueue()->colorCalcStateSize;
 
             dsh = allocateIndirectHeap([&multiDispatchInfo, offsetDsh] { return KCH::getTotalSizeRequiredDSH(multiDispatchInfo) + KCH::getTotalSizeRequiredIOH(multiDispatchInfo) + offsetDsh; });
             dsh->getSpace(colorCalcSize);
             ioh = dsh;
+            ish = allocateIndirectHeap([&multiDispatchInfo] { return KCH::getTotalSizeRequiredIH(multiDispatchInfo); });
+            ssh = allocateIndirectHeap([&multiDispatchInfo] { return KCH::getTotalSizeRequiredSSH(multiDispatchInfo); });
+            using UniqueIH = std::unique_ptr<IndirectHeap>;
+            *blockedCommandsData = new KernelOperation(std::unique_ptr<LinearStream>(commandStream), UniqueIH(dsh),
+                                                       UniqueIH(ish), UniqueIH(ioh), UniqueIH(ssh));
+            (*blockedCommandsData)->doNotFreeISH = true;
         } else {
-            dsh = allocateIndirectHeap([&multiDispatchInfo] { return KCH::getTotalSizeRequiredDSH(multiDispatchInfo); });
-            ioh = allocateIndirectHeap([&multiDispatchInfo] { return KCH::getTotalSizeRequiredIOH(multiDispatchInfo); });
+            // shared DSH/IOH of parent kernels is not recycled, all other blocked commands reuse queue's pooled storage
+            auto kernelOperation = commandQueue.getBlockedCommandsPool().obtainKernelOperation(MemoryConstants::pageSize,
+                                                                                               KCH::getTotalSizeRequiredDSH(multiDispatchInfo),
+                                                                                               KCH::getTotalSizeRequiredIH(multiDispatchInfo),
+                                                                                               KCH::getTotalSizeRequiredIOH(multiDispatchInfo),
+                                                                                               KCH::getTotalSizeRequiredSSH(multiDispatchInfo));
+            commandStream = kernelOperation->commandStream.get();
+            dsh = kernelOperation->dsh.get();
+            ish = kernelOperation->ish.get();
+            ioh = kernelOperation->ioh.get();
+            ssh = kernelOperation->ssh.get();
+            *blockedCommandsData = kernelOperation;
         }
-        ish = allocateIndirectHeap([&multiDispatchInfo] { return KCH::getTotalSizeRequiredIH(multiDispatchInfo); });
         cmdQInstructionHeapReservedBlockSize = commandQueue.getInstructionHeapReservedBlockSize();
-
-        ssh = allocateIndirectHeap([&multiDispatchInfo] { return KCH::getTotalSizeRequiredSSH(multiDispatchInfo); });
-        using UniqueIH = std::unique_ptr<IndirectHeap>;
-        *blockedCommandsData = new KernelOperation(std::unique_ptr<LinearStream>(commandStream), UniqueIH(dsh),
-                                                   UniqueIH(ish), UniqueIH(ioh), UniqueIH(ssh));
-        if (executionModelKernel) {
-            (*blockedCommandsData)->doNotFreeISH = true;
-        }
     } else {
         commandStream = &commandQueue.getCS(0);
         if (executionModelKernel && (commandQueue.getIndirectHeap(IndirectHeap::SURFACE_STATE, 0).getUsed() > 0)) {
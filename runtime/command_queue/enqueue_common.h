@@ -214,6 +214,22 @@ void CommandQueueHw<GfxFamily>::enqueueHandler(Surface **surfacesForResidency,
             printfHandler.get()->prepareDispatch(multiDispatchInfo);
         }
 
+        // grow the pooled private surface once for the whole dispatch before any kernel is patched with it
+        size_t privateSurfaceSize = 0;
+        for (auto &dispatchInfo : multiDispatchInfo) {
+            if (dispatchInfo.getKernel()->getKernelInfo().patchInfo.pAllocateStatelessPrivateSurface) {
+                privateSurfaceSize = std::max(privateSurfaceSize, static_cast<size_t>(dispatchInfo.getKernel()->getPrivateSurfaceSize()));
+            }
+        }
+        if (privateSurfaceSize > 0) {
+            auto pooledPrivateSurface = commandStreamReceiver.obtainPrivateSurface(privateSurfaceSize);
+            if (pooledPrivateSurface) {
+                for (auto &dispatchInfo : multiDispatchInfo) {
+                    dispatchInfo.getKernel()->patchPrivateSurface(*pooledPrivateSurface);
+                }
+            }
+        }
+
         if ((this->isProfilingEnabled() && (eventBuilder.getEvent() != nullptr))) {
             // Get allocation for timestamps
             hwTimeStamps = eventBuilder.getEvent()->getHwTimeStamp();
@@ -553,6 +569,8 @@ CompletionStamp CommandQueueHw<GfxFamily>::enqueueNonBlocked(
         taskLevel,
         dispatchFlags);
 
+    markIndirectHeapsUsedByTask(completionStamp.taskCount);
+
     for (auto surface : CreateRange(surfaces, surfaceCount)) {
         surface->setCompletionStamp(completionStamp, device, this);
     }
@@ -616,16 +634,23 @@ void CommandQueueHw<GfxFamily>::enqueueBlocked(
         eventBuilder->getEvent()->setCommand(std::move(cmd));
     } else {
         //store task data in event
+        auto kernelOperation = std::unique_ptr<KernelOperation>(blockedCommandsData); // marking ownership
+        auto pool = kernelOperation->pool;
         std::vector<Surface *> allSurfaces;
+        auto &kernelSurfaces = kernelOperation->pool ? kernelOperation->pooledSurfaces : allSurfaces;
         for (auto &dispatchInfo : multiDispatchInfo) {
-            dispatchInfo.getKernel()->getResidency(allSurfaces);
+            dispatchInfo.getKernel()->getResidency(kernelSurfaces, kernelOperation->pool);
             for (auto &surface : CreateRange(surfaces, surfaceCount)) {
-                allSurfaces.push_back(surface->duplicate());
+                auto surfaceCopy = kernelOperation->pool ? kernelOperation->pool->duplicateSurface(*surface) : nullptr;
+                if (surfaceCopy) {
+                    kernelOperation->pooledSurfaces.push_back(surfaceCopy);
+                } else {
+                    allSurfaces.push_back(surface->duplicate());
+                }
             }
         }
 
-        auto kernelOperation = std::unique_ptr<KernelOperation>(blockedCommandsData); // marking ownership
-        auto cmd = std::unique_ptr<Command>(new CommandComputeKernel(
+        auto cmd = std::unique_ptr<Command>(new (pool) CommandComputeKernel(
             *this,
             commandStreamReceiver,
             std::move(kernelOperation),
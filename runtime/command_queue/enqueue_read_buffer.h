@@ -47,8 +47,16 @@ cl_int CommandQueueHw<GfxFamily>::enqueueReadBuffer(
 
     cl_int retVal = CL_SUCCESS;
     bool isMemTransferNeeded = buffer->isMemObjZeroCopy() ? buffer->checkIfMemoryTransferIsRequired(offset, 0, ptr, CL_COMMAND_READ_BUFFER) : true;
+    if (isMemTransferNeeded && context->getDevice(0)->getDeviceInfo().cpuCopyAllowed &&
+        isCpuTransferSelected(buffer->isAsyncReadWriteOnCpuPossible(blockingRead), true, size)) {
+        TransferProperties transferProperties(buffer, CL_COMMAND_READ_BUFFER, false, &offset, &size, ptr, nullptr, nullptr);
+        EventsRequest eventsRequest(numEventsInWaitList, eventWaitList, event);
+        enqueueAsyncCpuTransfer(transferProperties, eventsRequest);
+        return retVal;
+    }
     if ((DebugManager.flags.DoCpuCopyOnReadBuffer.get() ||
-         buffer->isReadWriteOnCpuAllowed(blockingRead, numEventsInWaitList, ptr, size)) &&
+         isCpuTransferSelected(buffer->isReadWriteOnCpuPossible(blockingRead, numEventsInWaitList),
+                               buffer->isReadWriteOnCpuAllowed(blockingRead, numEventsInWaitList, ptr, size), size)) &&
         context->getDevice(0)->getDeviceInfo().cpuCopyAllowed) {
         if (!isMemTransferNeeded) {
             TransferProperties transferProperties(buffer, CL_COMMAND_MARKER, true, &offset, &size, ptr, nullptr, nullptr);
@@ -131,6 +139,9 @@ cl_int CommandQueueHw<GfxFamily>::enqueueReadBuffer(
         numEventsInWaitList,
         eventWaitList,
         event);
+    if (event) {
+        castToObjectOrAbort<Event>(*event)->setTransferSize(size);
+    }
     builder.releaseOwnership();
 
     return CL_SUCCESS;
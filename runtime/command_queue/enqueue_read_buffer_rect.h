@@ -77,6 +77,22 @@ cl_int CommandQueueHw<GfxFamily>::enqueueReadBufferRect(
 
         return CL_SUCCESS;
     }
+    auto transferSize = region[0] * region[1] * region[2];
+    if (isCpuTransferSelected(buffer->isReadWriteOnCpuPossible(blockingRead, numEventsInWaitList), false, transferSize) &&
+        context->getDevice(0)->getDeviceInfo().cpuCopyAllowed) {
+        cl_int retVal = CL_SUCCESS;
+        TransferProperties transferProperties(buffer, CL_COMMAND_READ_BUFFER_RECT, true, const_cast<size_t *>(bufferOrigin), const_cast<size_t *>(region),
+                                              ptr, nullptr, nullptr);
+        transferProperties.hostOrigin = hostOrigin;
+        transferProperties.hostRowPitch = hostRowPitch;
+        transferProperties.hostSlicePitch = hostSlicePitch;
+        transferProperties.memObjRowPitch = bufferRowPitch;
+        transferProperties.memObjSlicePitch = bufferSlicePitch;
+        EventsRequest eventsRequest(numEventsInWaitList, eventWaitList, event);
+        cpuDataTransferHandler(transferProperties, eventsRequest, retVal);
+        return retVal;
+    }
+
     auto &builder = BuiltIns::getInstance().getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferRect,
                                                                           this->getContext(), this->getDevice());
     builder.takeOwnership(this->context);
@@ -118,6 +134,9 @@ cl_int CommandQueueHw<GfxFamily>::enqueueReadBufferRect(
         numEventsInWaitList,
         eventWaitList,
         event);
+    if (event) {
+        castToObjectOrAbort<Event>(*event)->setTransferSize(transferSize);
+    }
 
     builder.releaseOwnership();
 
@@ -78,6 +78,19 @@ cl_int CommandQueueHw<GfxFamily>::enqueueReadImage(
         return CL_SUCCESS;
     }
 
+    if (isCpuTransferSelected(srcImage->isReadWriteOnCpuPossible(blockingRead, numEventsInWaitList),
+                              srcImage->isReadWriteOnCpuAllowed(blockingRead, numEventsInWaitList, region), srcImage->calculateTransferSize(region)) &&
+        context->getDevice(0)->getDeviceInfo().cpuCopyAllowed) {
+        cl_int retVal = CL_SUCCESS;
+        TransferProperties transferProperties(srcImage, CL_COMMAND_READ_IMAGE, true, const_cast<size_t *>(origin), const_cast<size_t *>(region),
+                                              ptr, nullptr, nullptr);
+        transferProperties.hostRowPitch = inputRowPitch;
+        transferProperties.hostSlicePitch = inputSlicePitch;
+        EventsRequest eventsRequest(numEventsInWaitList, eventWaitList, event);
+        cpuDataTransferHandler(transferProperties, eventsRequest, retVal);
+        return retVal;
+    }
+
     auto &builder = BuiltIns::getInstance().getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyImage3dToBuffer,
                                                                           this->getContext(), this->getDevice());
 
@@ -117,6 +130,9 @@ cl_int CommandQueueHw<GfxFamily>::enqueueReadImage(
         numEventsInWaitList,
         eventWaitList,
         event);
+    if (event) {
+        castToObjectOrAbort<Event>(*event)->setTransferSize(srcImage->calculateTransferSize(region));
+    }
 
     builder.releaseOwnership();
 
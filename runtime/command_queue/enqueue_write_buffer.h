@@ -46,8 +46,16 @@ cl_int CommandQueueHw<GfxFamily>::enqueueWriteBuffer(
 
     cl_int retVal = CL_SUCCESS;
     auto isMemTransferNeeded = buffer->isMemObjZeroCopy() ? buffer->checkIfMemoryTransferIsRequired(offset, 0, ptr, CL_COMMAND_READ_BUFFER) : true;
+    if (isMemTransferNeeded && context->getDevice(0)->getDeviceInfo().cpuCopyAllowed &&
+        isCpuTransferSelected(buffer->isAsyncReadWriteOnCpuPossible(blockingWrite), true, size)) {
+        TransferProperties transferProperties(buffer, CL_COMMAND_WRITE_BUFFER, false, &offset, &size, const_cast<void *>(ptr), nullptr, nullptr);
+        EventsRequest eventsRequest(numEventsInWaitList, eventWaitList, event);
+        enqueueAsyncCpuTransfer(transferProperties, eventsRequest);
+        return retVal;
+    }
     if ((DebugManager.flags.DoCpuCopyOnWriteBuffer.get() ||
-         buffer->isReadWriteOnCpuAllowed(blockingWrite, numEventsInWaitList, const_cast<void *>(ptr), size)) &&
+         isCpuTransferSelected(buffer->isReadWriteOnCpuPossible(blockingWrite, numEventsInWaitList),
+                               buffer->isReadWriteOnCpuAllowed(blockingWrite, numEventsInWaitList, const_cast<void *>(ptr), size), size)) &&
         context->getDevice(0)->getDeviceInfo().cpuCopyAllowed) {
         if (!isMemTransferNeeded) {
             TransferProperties transferProperties(buffer, CL_COMMAND_MARKER, true, &offset, &size, const_cast<void *>(ptr), nullptr, nullptr);
@@ -126,6 +134,9 @@ cl_int CommandQueueHw<GfxFamily>::enqueueWriteBuffer(
         numEventsInWaitList,
         eventWaitList,
         event);
+    if (event) {
+        castToObjectOrAbort<Event>(*event)->setTransferSize(size);
+    }
 
     if (context->isProvidingPerformanceHints()) {
         context->providePerformanceHint(CL_CONTEXT_DIAGNOSTICS_LEVEL_NEUTRAL_INTEL, CL_ENQUEUE_WRITE_BUFFER_REQUIRES_COPY_DATA, static_cast<cl_mem>(buffer));
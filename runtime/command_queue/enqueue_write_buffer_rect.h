@@ -76,6 +76,22 @@ cl_int CommandQueueHw<GfxFamily>::enqueueWriteBufferRect(
 
         return CL_SUCCESS;
     }
+    auto transferSize = region[0] * region[1] * region[2];
+    if (isCpuTransferSelected(buffer->isReadWriteOnCpuPossible(blockingWrite, numEventsInWaitList), false, transferSize) &&
+        context->getDevice(0)->getDeviceInfo().cpuCopyAllowed) {
+        cl_int retVal = CL_SUCCESS;
+        TransferProperties transferProperties(buffer, CL_COMMAND_WRITE_BUFFER_RECT, true, const_cast<size_t *>(bufferOrigin), const_cast<size_t *>(region),
+                                              const_cast<void *>(ptr), nullptr, nullptr);
+        transferProperties.hostOrigin = hostOrigin;
+        transferProperties.hostRowPitch = hostRowPitch;
+        transferProperties.hostSlicePitch = hostSlicePitch;
+        transferProperties.memObjRowPitch = bufferRowPitch;
+        transferProperties.memObjSlicePitch = bufferSlicePitch;
+        EventsRequest eventsRequest(numEventsInWaitList, eventWaitList, event);
+        cpuDataTransferHandler(transferProperties, eventsRequest, retVal);
+        return retVal;
+    }
+
     auto &builder = BuiltIns::getInstance().getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferRect,
                                                                           this->getContext(), this->getDevice());
     builder.takeOwnership(this->context);
@@ -117,6 +133,9 @@ cl_int CommandQueueHw<GfxFamily>::enqueueWriteBufferRect(
         numEventsInWaitList,
         eventWaitList,
         event);
+    if (event) {
+        castToObjectOrAbort<Event>(*event)->setTransferSize(transferSize);
+    }
 
     builder.releaseOwnership();
 
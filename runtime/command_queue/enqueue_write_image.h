@@ -75,6 +75,20 @@ cl_int CommandQueueHw<GfxFamily>::enqueueWriteImage(
 
         return CL_SUCCESS;
     }
+
+    if (isCpuTransferSelected(dstImage->isReadWriteOnCpuPossible(blockingWrite, numEventsInWaitList),
+                              dstImage->isReadWriteOnCpuAllowed(blockingWrite, numEventsInWaitList, region), dstImage->calculateTransferSize(region)) &&
+        context->getDevice(0)->getDeviceInfo().cpuCopyAllowed) {
+        cl_int retVal = CL_SUCCESS;
+        TransferProperties transferProperties(dstImage, CL_COMMAND_WRITE_IMAGE, true, const_cast<size_t *>(origin), const_cast<size_t *>(region),
+                                              const_cast<void *>(ptr), nullptr, nullptr);
+        transferProperties.hostRowPitch = inputRowPitch;
+        transferProperties.hostSlicePitch = inputSlicePitch;
+        EventsRequest eventsRequest(numEventsInWaitList, eventWaitList, event);
+        cpuDataTransferHandler(transferProperties, eventsRequest, retVal);
+        return retVal;
+    }
+
     auto &builder = BuiltIns::getInstance().getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferToImage3d,
                                                                           this->getContext(), this->getDevice());
 
@@ -114,6 +128,9 @@ cl_int CommandQueueHw<GfxFamily>::enqueueWriteImage(
         numEventsInWaitList,
         eventWaitList,
         event);
+    if (event) {
+        castToObjectOrAbort<Event>(*event)->setTransferSize(dstImage->calculateTransferSize(region));
+    }
 
     builder.releaseOwnership();
 
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/transfer_planner.h"
+#include "runtime/helpers/basic_math.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+
+namespace OCLRT {
+
+constexpr double TransferCostModel::decay;
+constexpr double TransferPlanner::hysteresis;
+const uint32_t TransferPlanner::minSamplesForCalibration;
+
+void TransferCostModel::addSample(size_t size, uint64_t durationNs) {
+    auto x = static_cast<double>(size);
+    auto y = static_cast<double>(durationNs);
+    weight = weight * decay + 1.0;
+    sumX = sumX * decay + x;
+    sumY = sumY * decay + y;
+    sumXX = sumXX * decay + x * x;
+    sumXY = sumXY * decay + x * y;
+    sampleCount++;
+}
+
+double TransferCostModel::estimate(size_t size) const {
+    if (weight == 0.0) {
+        return 0.0;
+    }
+    auto x = static_cast<double>(size);
+    auto denominator = weight * sumXX - sumX * sumX;
+    if (denominator <= 1e-9 * weight * sumXX) {
+        // all samples have the same size, assume the cost is proportional to it
+        return sumX > 0.0 ? sumY / sumX * x : sumY / weight;
+    }
+    auto slope = (weight * sumXY - sumX * sumY) / denominator;
+    auto intercept = (sumY - slope * sumX) / weight;
+    if (slope < 0.0) {
+        slope = 0.0;
+        intercept = sumY / weight;
+    } else if (intercept < 0.0) {
+        intercept = 0.0;
+        slope = sumXY / sumXX;
+    }
+    return intercept + slope * x;
+}
+
+TransferPath TransferPlanner::selectPath(size_t size, TransferPath defaultPath) {
+    switch (DebugManager.flags.ForceTransferPath.get()) {
+    case 0:
+        return TransferPath::CPU;
+    case 1:
+        return TransferPath::GPU;
+    default:
+        break;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (cpuModel.getSampleCount() < minSamplesForCalibration ||
+        gpuModel.getSampleCount() < minSamplesForCalibration) {
+        return defaultPath;
+    }
+
+    auto sizeClass = getSizeClass(size);
+    auto &selectedPath = selectedPaths[sizeClass];
+    if (!pathSelected[sizeClass]) {
+        selectedPath = defaultPath;
+        pathSelected[sizeClass] = true;
+    }
+
+    auto cpuCost = cpuModel.estimate(size);
+    auto gpuCost = gpuModel.estimate(size);
+    if (selectedPath == TransferPath::CPU && cpuCost > gpuCost * hysteresis) {
+        selectedPath = TransferPath::GPU;
+    } else if (selectedPath == TransferPath::GPU && gpuCost > cpuCost * hysteresis) {
+        selectedPath = TransferPath::CPU;
+    }
+    return selectedPath;
+}
+
+void TransferPlanner::recordCpuTransfer(size_t size, uint64_t durationNs) {
+    std::lock_guard<std::mutex> lock(mutex);
+    cpuModel.addSample(size, durationNs);
+}
+
+void TransferPlanner::recordGpuTransfer(size_t size, uint64_t durationNs) {
+    std::lock_guard<std::mutex> lock(mutex);
+    gpuModel.addSample(size, durationNs);
+}
+
+double TransferPlanner::estimateCpuCost(size_t size) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return cpuModel.estimate(size);
+}
+
+double TransferPlanner::estimateGpuCost(size_t size) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return gpuModel.estimate(size);
+}
+
+bool TransferPlanner::isCalibrated() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return cpuModel.getSampleCount() >= minSamplesForCalibration &&
+           gpuModel.getSampleCount() >= minSamplesForCalibration;
+}
+
+size_t TransferPlanner::getSizeClass(size_t size) {
+    return size == 0 ? 0 : static_cast<size_t>(Math::log2(static_cast<uint64_t>(size))) + 1;
+}
+} // namespace OCLRT
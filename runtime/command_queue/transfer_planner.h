@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace OCLRT {
+
+enum class TransferPath : uint32_t {
+    CPU,
+    GPU
+};
+
+// Linear cost model (duration = latency + size / throughput) fitted with
+// exponentially weighted least squares, so old samples fade out over time.
+class TransferCostModel {
+  public:
+    void addSample(size_t size, uint64_t durationNs);
+    double estimate(size_t size) const;
+    uint32_t getSampleCount() const { return sampleCount; }
+
+    static constexpr double decay = 0.9;
+
+  protected:
+    uint32_t sampleCount = 0;
+    double weight = 0.0;
+    double sumX = 0.0;
+    double sumY = 0.0;
+    double sumXX = 0.0;
+    double sumXY = 0.0;
+};
+
+// Chooses between the CPU copy path and the GPU copy kernel of read/write
+// transfers from measured costs. Until both paths are calibrated the static
+// heuristics of the memory object decide. A size class only switches path when
+// the other one is estimated cheaper by the hysteresis factor.
+class TransferPlanner {
+  public:
+    TransferPath selectPath(size_t size, TransferPath defaultPath);
+
+    void recordCpuTransfer(size_t size, uint64_t durationNs);
+    void recordGpuTransfer(size_t size, uint64_t durationNs);
+
+    double estimateCpuCost(size_t size);
+    double estimateGpuCost(size_t size);
+    bool isCalibrated();
+
+    static const uint32_t minSamplesForCalibration = 4;
+    static constexpr double hysteresis = 1.25;
+
+  protected:
+    static const size_t numSizeClasses = 65;
+    static size_t getSizeClass(size_t size);
+
+    std::mutex mutex;
+    TransferCostModel cpuModel;
+    TransferCostModel gpuModel;
+    std::array<bool, numSizeClasses> pathSelected = {};
+    std::array<TransferPath, numSizeClasses> selectedPaths = {};
+};
+} // namespace OCLRT
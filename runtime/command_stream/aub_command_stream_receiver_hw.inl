@@ -224,18 +224,19 @@ FlushStamp AUBCommandStreamReceiverHw<GfxFamily>::flush(BatchBuffer &batchBuffer
 
     // Write our batch buffer
     auto pBatchBuffer = ptrOffset(batchBuffer.commandBufferAllocation->getUnderlyingBuffer(), batchBuffer.startOffset);
+    auto batchBufferGpuAddress = static_cast<uintptr_t>(batchBuffer.commandBufferAllocation->getGpuAddress() + batchBuffer.startOffset);
     auto currentOffset = batchBuffer.usedSize;
     DEBUG_BREAK_IF(currentOffset < batchBuffer.startOffset);
     auto sizeBatchBuffer = currentOffset - batchBuffer.startOffset;
     {
         {
             std::ostringstream str;
-            str << "ppgtt: " << std::hex << std::showbase << pBatchBuffer;
+            str << "ppgtt: " << std::hex << std::showbase << batchBufferGpuAddress;
             stream.addComment(str.str().c_str());
         }
 
-        auto physBatchBuffer = ppgtt.map(reinterpret_cast<uintptr_t>(pBatchBuffer), sizeBatchBuffer);
-        AUB::reserveAddressPPGTT(stream, reinterpret_cast<uintptr_t>(pBatchBuffer), sizeBatchBuffer, physBatchBuffer);
+        auto physBatchBuffer = ppgtt.map(batchBufferGpuAddress, sizeBatchBuffer);
+        AUB::reserveAddressPPGTT(stream, batchBufferGpuAddress, sizeBatchBuffer, physBatchBuffer);
 
         AUB::addMemoryWrite(
             stream,
@@ -290,7 +291,7 @@ FlushStamp AUBCommandStreamReceiverHw<GfxFamily>::flush(BatchBuffer &batchBuffer
 
         // Add our BBS
         auto bbs = MI_BATCH_BUFFER_START::sInit();
-        bbs.setBatchBufferStartAddressGraphicsaddress472(AUB::ptrToPPGTT(pBatchBuffer));
+        bbs.setBatchBufferStartAddressGraphicsaddress472(batchBufferGpuAddress);
         bbs.setAddressSpaceIndicator(MI_BATCH_BUFFER_START::ADDRESS_SPACE_INDICATOR_PPGTT);
         *(MI_BATCH_BUFFER_START *)pTail = bbs;
         pTail = ((MI_BATCH_BUFFER_START *)pTail) + 1;
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_stream/aub_dump_worker.h"
+#include "runtime/command_stream/command_stream_receiver.h"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/helpers/string.h"
+
+namespace OCLRT {
+
+AubDumpWorker::AubDumpWorker(CommandStreamReceiver &aubCsr, size_t maxStagedSize)
+    : aubCsr(aubCsr), maxStagedSize(maxStagedSize) {
+    worker = std::thread(&AubDumpWorker::run, this);
+}
+
+AubDumpWorker::~AubDumpWorker() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stop = true;
+    }
+    jobSubmitted.notify_one();
+    // the worker replays every queued job before it exits
+    worker.join();
+}
+
+bool AubDumpWorker::isAubWritable(GraphicsAllocation &gfxAllocation) {
+    return (gfxAllocation.getUnderlyingBufferSize() != 0) &&
+           !(gfxAllocation.getAllocationType() & GraphicsAllocation::ALLOCATION_TYPE_NON_AUB_WRITABLE);
+}
+
+std::shared_ptr<AubDumpWorker::StagedResidency> AubDumpWorker::stageResidency(ResidencyContainer &allocationsForResidency) {
+    size_t size = 0;
+    for (auto &gfxAllocation : allocationsForResidency) {
+        if (isAubWritable(*gfxAllocation)) {
+            size += gfxAllocation->getUnderlyingBufferSize();
+        }
+    }
+    if (size > maxStagedSize) {
+        return nullptr;
+    }
+
+    auto stagedResidency = std::make_shared<StagedResidency>();
+    stagedResidency->size = size;
+    for (auto &gfxAllocation : allocationsForResidency) {
+        if (!isAubWritable(*gfxAllocation)) {
+            continue;
+        }
+        auto allocationSize = gfxAllocation->getUnderlyingBufferSize();
+        std::unique_ptr<char[]> data(new char[allocationSize]);
+        memcpy_s(data.get(), allocationSize, gfxAllocation->getUnderlyingBuffer(), allocationSize);
+
+        auto allocType = gfxAllocation->getAllocationType();
+        std::unique_ptr<GraphicsAllocation> stagedAllocation(new GraphicsAllocation(data.get(), gfxAllocation->getGpuAddress(), 0, allocationSize));
+        stagedAllocation->setAllocationType(allocType);
+
+        // buffers and images are dumped only once, as AUBCommandStreamReceiverHw::writeMemory does
+        if (!!(allocType & GraphicsAllocation::ALLOCATION_TYPE_BUFFER) ||
+            !!(allocType & GraphicsAllocation::ALLOCATION_TYPE_IMAGE)) {
+            gfxAllocation->setAllocationType(allocType | GraphicsAllocation::ALLOCATION_TYPE_NON_AUB_WRITABLE);
+        }
+
+        stagedResidency->residency.push_back(stagedAllocation.get());
+        stagedResidency->allocations.push_back(std::move(stagedAllocation));
+        stagedResidency->data.push_back(std::move(data));
+    }
+    return stagedResidency;
+}
+
+void AubDumpWorker::stageCommandBuffer(Job &job, const BatchBuffer &batchBuffer) {
+    auto commandBuffer = batchBuffer.commandBufferAllocation;
+    auto size = batchBuffer.usedSize - batchBuffer.startOffset;
+
+    job.commandBufferData.reset(new char[size]);
+    memcpy_s(job.commandBufferData.get(), size, ptrOffset(commandBuffer->getUnderlyingBuffer(), batchBuffer.startOffset), size);
+
+    // staged copy keeps the GPU address the batch buffer was submitted from
+    job.commandBufferAllocation.reset(new GraphicsAllocation(job.commandBufferData.get(), commandBuffer->getGpuAddress() + batchBuffer.startOffset, 0, size));
+
+    job.batchBuffer = batchBuffer;
+    job.batchBuffer.commandBufferAllocation = job.commandBufferAllocation.get();
+    job.batchBuffer.startOffset = 0;
+    job.batchBuffer.usedSize = size;
+    job.batchBuffer.stream = nullptr;
+    job.size += size;
+}
+
+void AubDumpWorker::submit(std::unique_ptr<Job> job) {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    // back-pressure: wait for the worker to retire older snapshots when the staging budget is exceeded
+    jobCompleted.wait(lock, [&] { return (stagedSize + job->size <= maxStagedSize) || (queue.empty() && !busy); });
+    stagedSize += job->size;
+    queue.push_back(std::move(job));
+    jobSubmitted.notify_one();
+}
+
+void AubDumpWorker::drain() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    jobCompleted.wait(lock, [&] { return queue.empty() && !busy; });
+}
+
+size_t AubDumpWorker::peekStagedSize() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return stagedSize;
+}
+
+void AubDumpWorker::replay(Job &job) {
+    auto residency = job.stagedResidency ? &job.stagedResidency->residency : nullptr;
+    if (job.processResidency) {
+        aubCsr.processResidency(residency);
+    }
+    if (job.commandBufferAllocation) {
+        aubCsr.flush(job.batchBuffer, job.engineType, residency);
+    }
+}
+
+void AubDumpWorker::run() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true) {
+        jobSubmitted.wait(lock, [&] { return stop || !queue.empty(); });
+        if (queue.empty()) {
+            return;
+        }
+        auto job = std::move(queue.front());
+        queue.pop_front();
+        busy = true;
+        lock.unlock();
+
+        replay(*job);
+        auto jobSize = job->size;
+        job.reset();
+
+        lock.lock();
+        busy = false;
+        stagedSize -= jobSize;
+        jobCompleted.notify_all();
+    }
+}
+} // namespace OCLRT
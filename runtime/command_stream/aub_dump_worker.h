@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/command_stream/submissions_aggregator.h"
+#include "runtime/helpers/engine_node.h"
+#include "runtime/memory_manager/graphics_allocation.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OCLRT {
+class CommandStreamReceiver;
+
+// Replays AUB dumps of a CsrBase + AUB command stream receiver on a dedicated thread.
+// Allocation contents are snapshotted at submission time, so the dump matches what
+// a synchronous dump would have written even if the memory changes afterwards.
+class AubDumpWorker {
+  public:
+    struct StagedResidency {
+        std::vector<std::unique_ptr<char[]>> data;
+        std::vector<std::unique_ptr<GraphicsAllocation>> allocations;
+        ResidencyContainer residency;
+        size_t size = 0;
+    };
+
+    struct Job {
+        std::shared_ptr<StagedResidency> stagedResidency;
+        bool processResidency = false;
+        std::unique_ptr<char[]> commandBufferData;
+        std::unique_ptr<GraphicsAllocation> commandBufferAllocation;
+        BatchBuffer batchBuffer;
+        EngineType engineType = EngineType::ENGINE_RCS;
+        size_t size = 0;
+    };
+
+    AubDumpWorker(CommandStreamReceiver &aubCsr, size_t maxStagedSize);
+    ~AubDumpWorker();
+
+    AubDumpWorker(const AubDumpWorker &) = delete;
+    AubDumpWorker &operator=(const AubDumpWorker &) = delete;
+
+    // returns nullptr when the snapshot would not fit in the staging budget
+    std::shared_ptr<StagedResidency> stageResidency(ResidencyContainer &allocationsForResidency);
+    void stageCommandBuffer(Job &job, const BatchBuffer &batchBuffer);
+
+    void submit(std::unique_ptr<Job> job);
+    void drain();
+
+    size_t getMaxStagedSize() const { return maxStagedSize; }
+    size_t peekStagedSize();
+
+  protected:
+    static bool isAubWritable(GraphicsAllocation &gfxAllocation);
+    void replay(Job &job);
+    void run();
+
+    CommandStreamReceiver &aubCsr;
+    const size_t maxStagedSize;
+    size_t stagedSize = 0;
+    bool busy = false;
+    bool stop = false;
+    std::deque<std::unique_ptr<Job>> queue;
+    std::mutex queueMutex;
+    std::condition_variable jobSubmitted;
+    std::condition_variable jobCompleted;
+    std::thread worker;
+};
+} // namespace OCLRT
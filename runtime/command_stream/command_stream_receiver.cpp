@@ -168,6 +168,17 @@ void CommandStreamReceiver::cleanupResources() {
         scratchAllocation = nullptr;
     }
 
+    if (privateSurfaceAllocation) {
+        memoryManager->freeGraphicsMemory(privateSurfaceAllocation);
+    }
+    for (auto &holder : privateSurfaceHolders) {
+        if (holder.first != privateSurfaceAllocation) {
+            memoryManager->freeGraphicsMemory(holder.first);
+        }
+    }
+    privateSurfaceHolders.clear();
+    privateSurfaceAllocation = nullptr;
+
     if (commandStream.getBase()) {
         memoryManager->freeGraphicsMemory(commandStream.getGraphicsAllocation());
         commandStream.replaceGraphicsAllocation(nullptr);
@@ -208,6 +219,48 @@ void CommandStreamReceiver::setRequiredScratchSize(uint32_t newRequiredScratchSi
     }
 }
 
+GraphicsAllocation *CommandStreamReceiver::obtainPrivateSurface(size_t requiredSize) {
+    std::lock_guard<std::mutex> lock(privateSurfaceMtx);
+    if (privateSurfaceAllocation && privateSurfaceAllocation->getUnderlyingBufferSize() >= requiredSize) {
+        return privateSurfaceAllocation;
+    }
+
+    auto newPrivateSurface = getMemoryManager()->createGraphicsAllocationWithRequiredBitness(requiredSize, nullptr);
+    if (newPrivateSurface == nullptr) {
+        return nullptr;
+    }
+
+    // a surface held by blocked commands is retired when the last of them releases it
+    if (privateSurfaceAllocation && privateSurfaceHolders.find(privateSurfaceAllocation) == privateSurfaceHolders.end()) {
+        // tasks submitted so far may still use the smaller surface
+        getMemoryManager()->storeAllocation(std::unique_ptr<GraphicsAllocation>(privateSurfaceAllocation), TEMPORARY_ALLOCATION, this->taskCount);
+    }
+    privateSurfaceAllocation = newPrivateSurface;
+    return privateSurfaceAllocation;
+}
+
+void CommandStreamReceiver::holdPrivateSurface(GraphicsAllocation &surface) {
+    std::lock_guard<std::mutex> lock(privateSurfaceMtx);
+    // only surfaces handed out by the pool are tracked
+    if (&surface == privateSurfaceAllocation || privateSurfaceHolders.find(&surface) != privateSurfaceHolders.end()) {
+        privateSurfaceHolders[&surface]++;
+    }
+}
+
+void CommandStreamReceiver::releasePrivateSurface(GraphicsAllocation &surface) {
+    std::lock_guard<std::mutex> lock(privateSurfaceMtx);
+    auto holder = privateSurfaceHolders.find(&surface);
+    if (holder == privateSurfaceHolders.end() || --holder->second > 0) {
+        return;
+    }
+    privateSurfaceHolders.erase(holder);
+
+    if (&surface != privateSurfaceAllocation) {
+        // the releasing command has been submitted (or aborted) with a task count not above the current one
+        getMemoryManager()->storeAllocation(std::unique_ptr<GraphicsAllocation>(&surface), TEMPORARY_ALLOCATION, this->taskCount);
+    }
+}
+
 size_t CommandStreamReceiver::getInstructionHeapCmdStreamReceiverReservedSize() const {
     return PreemptionHelper::getInstructionHeapSipKernelReservedSize(*memoryManager->device);
 }
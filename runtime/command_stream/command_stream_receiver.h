@@ -29,6 +29,8 @@
 #include "runtime/command_stream/csr_definitions.h"
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
+#include <unordered_map>
 
 namespace OCLRT {
 class Device;
@@ -105,6 +107,13 @@ class CommandStreamReceiver {
     void setRequiredScratchSize(uint32_t newRequiredScratchSize);
     GraphicsAllocation *getScratchAllocation() { return scratchAllocation; }
 
+    // private memory surface shared by all kernels submitted through this CSR
+    GraphicsAllocation *obtainPrivateSurface(size_t requiredSize);
+    GraphicsAllocation *getPrivateSurface() { return privateSurfaceAllocation; }
+    // blocked commands keep the private surface they were patched with alive until they are submitted
+    void holdPrivateSurface(GraphicsAllocation &surface);
+    void releasePrivateSurface(GraphicsAllocation &surface);
+
     void setPreemptionCsrAllocation(GraphicsAllocation *allocation) { preemptionCsrAllocation = allocation; }
 
     void cleanupResources();
@@ -157,6 +166,9 @@ class CommandStreamReceiver {
     uint32_t lastSentThreadAribtrationPolicy = ThreadArbitrationPolicy::threadArbitrationPolicyNotPresent;
 
     GraphicsAllocation *scratchAllocation = nullptr;
+    GraphicsAllocation *privateSurfaceAllocation = nullptr;
+    std::unordered_map<GraphicsAllocation *, uint32_t> privateSurfaceHolders;
+    std::mutex privateSurfaceMtx;
     GraphicsAllocation *preemptionCsrAllocation = nullptr;
 
     MemoryManager *memoryManager = nullptr;
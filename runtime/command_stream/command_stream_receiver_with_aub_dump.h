@@ -21,7 +21,9 @@
  */
 
 #pragma once
+#include "runtime/command_stream/aub_dump_worker.h"
 #include "runtime/command_stream/command_stream_receiver.h"
+#include <memory>
 
 namespace OCLRT {
 
@@ -40,6 +42,12 @@ class CommandStreamReceiverWithAUBDump : public BaseCSR {
     MemoryManager *createMemoryManager(bool enable64kbPages) override;
 
     CommandStreamReceiver *aubCSR = nullptr;
+    std::unique_ptr<AubDumpWorker> aubDumpWorker;
+
+  protected:
+    // residency snapshot taken by processResidency inside flush, replayed again by the AUB flush
+    std::shared_ptr<AubDumpWorker::StagedResidency> stagedResidencyForFlush;
+    bool flushInProgress = false;
 };
 
 } // namespace OCLRT
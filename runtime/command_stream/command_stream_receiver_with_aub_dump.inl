@@ -23,6 +23,8 @@
 #include "runtime/command_stream/command_stream_receiver_with_aub_dump.h"
 #include "runtime/command_stream/aub_command_stream_receiver.h"
 #include "runtime/command_stream/tbx_command_stream_receiver.h"
+#include "runtime/memory_manager/memory_constants.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 
 namespace OCLRT {
 
@@ -32,16 +34,44 @@ template <typename BaseCSR>
 CommandStreamReceiverWithAUBDump<BaseCSR>::CommandStreamReceiverWithAUBDump(const HardwareInfo &hwInfoIn)
     : BaseCSR(hwInfoIn, nullptr) {
     aubCSR = AUBCommandStreamReceiver::create(hwInfoIn, "aubfile", false);
+    if (aubCSR && DebugManager.flags.EnableAsyncAubDump.get()) {
+        auto maxStagedSize = static_cast<size_t>(DebugManager.flags.AsyncAubDumpStagingSizeMb.get() * MemoryConstants::megaByte);
+        aubDumpWorker.reset(new AubDumpWorker(*aubCSR, maxStagedSize));
+    }
 }
 
 template <typename BaseCSR>
 CommandStreamReceiverWithAUBDump<BaseCSR>::~CommandStreamReceiverWithAUBDump() {
+    aubDumpWorker.reset();
     delete aubCSR;
 }
 
 template <typename BaseCSR>
 FlushStamp CommandStreamReceiverWithAUBDump<BaseCSR>::flush(BatchBuffer &batchBuffer, EngineType engineOrdinal, ResidencyContainer *allocationsForResidency) {
+    flushInProgress = true;
     FlushStamp flushStamp = BaseCSR::flush(batchBuffer, engineOrdinal, allocationsForResidency);
+    flushInProgress = false;
+
+    if (aubCSR && aubDumpWorker) {
+        std::unique_ptr<AubDumpWorker::Job> job(new AubDumpWorker::Job());
+        job->stagedResidency = std::move(stagedResidencyForFlush);
+        if (!job->stagedResidency) {
+            auto &residencyAllocations = allocationsForResidency ? *allocationsForResidency : this->getMemoryManager()->getResidencyAllocations();
+            job->stagedResidency = aubDumpWorker->stageResidency(residencyAllocations);
+            if (job->stagedResidency) {
+                job->size = job->stagedResidency->size;
+            }
+        }
+        if (job->stagedResidency) {
+            job->engineType = engineOrdinal;
+            aubDumpWorker->stageCommandBuffer(*job, batchBuffer);
+            aubDumpWorker->submit(std::move(job));
+            return flushStamp;
+        }
+        // snapshot does not fit in the staging budget, dump synchronously after older snapshots
+        aubDumpWorker->drain();
+    }
+
     if (aubCSR) {
         aubCSR->flush(batchBuffer, engineOrdinal, allocationsForResidency);
     }
@@ -51,6 +81,24 @@ FlushStamp CommandStreamReceiverWithAUBDump<BaseCSR>::flush(BatchBuffer &batchBu
 template <typename BaseCSR>
 void CommandStreamReceiverWithAUBDump<BaseCSR>::processResidency(ResidencyContainer *allocationsForResidency) {
     BaseCSR::processResidency(allocationsForResidency);
+
+    if (aubCSR && aubDumpWorker) {
+        auto &residencyAllocations = allocationsForResidency ? *allocationsForResidency : this->getMemoryManager()->getResidencyAllocations();
+        auto stagedResidency = aubDumpWorker->stageResidency(residencyAllocations);
+        if (stagedResidency) {
+            std::unique_ptr<AubDumpWorker::Job> job(new AubDumpWorker::Job());
+            job->stagedResidency = stagedResidency;
+            job->processResidency = true;
+            job->size = stagedResidency->size;
+            aubDumpWorker->submit(std::move(job));
+            if (flushInProgress) {
+                stagedResidencyForFlush = std::move(stagedResidency);
+            }
+            return;
+        }
+        aubDumpWorker->drain();
+    }
+
     if (aubCSR) {
         aubCSR->processResidency(allocationsForResidency);
     }
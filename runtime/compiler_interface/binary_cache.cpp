@@ -27,6 +27,7 @@
 #include <runtime/helpers/file_io.h>
 #include <runtime/helpers/hash.h>
 #include <runtime/helpers/hw_info.h>
+#include <runtime/helpers/string.h>
 #include <runtime/os_interface/os_inc_base.h>
 #include <runtime/program/program.h>
 
@@ -86,6 +87,66 @@ bool BinaryCache::cacheBinary(const std::string kernelFileHash, const char *pBin
     return true;
 }
 
+bool BinaryCache::loadCachedData(const std::string kernelFileHash, std::vector<char> &data) {
+    void *pData = nullptr;
+    size_t dataSize = 0;
+
+    std::string hashFilePath = CL_CACHE_LOCATION;
+    hashFilePath.append(Os::fileSeparator);
+    hashFilePath.append(kernelFileHash + ".cl_cache");
+
+    {
+        std::lock_guard<std::mutex> lock(cacheAccessMtx);
+        dataSize = loadDataFromFile(hashFilePath.c_str(), pData);
+    }
+
+    if ((pData == nullptr) || (dataSize == 0)) {
+        deleteDataReadFromFile(pData);
+        return false;
+    }
+    data.assign(static_cast<char *>(pData), static_cast<char *>(pData) + dataSize);
+
+    deleteDataReadFromFile(pData);
+
+    return true;
+}
+
+bool BinaryCache::cacheCheckedBinary(const std::string kernelFileHash, const char *pBinary, uint32_t binarySize) {
+    if (pBinary == nullptr || binarySize == 0) {
+        return false;
+    }
+
+    CheckedBinaryHeader header = {};
+    header.magic = checkedBinaryMagic;
+    header.binarySize = binarySize;
+    header.checksum = Hash::hash(pBinary, binarySize);
+
+    std::vector<char> data(sizeof(header) + binarySize);
+    memcpy_s(data.data(), data.size(), &header, sizeof(header));
+    memcpy_s(data.data() + sizeof(header), data.size() - sizeof(header), pBinary, binarySize);
+
+    return cacheBinary(kernelFileHash, data.data(), static_cast<uint32_t>(data.size()));
+}
+
+bool BinaryCache::loadCheckedBinary(const std::string kernelFileHash, std::vector<char> &binary) {
+    std::vector<char> data;
+    if ((false == loadCachedData(kernelFileHash, data)) || (data.size() <= sizeof(CheckedBinaryHeader))) {
+        return false;
+    }
+
+    CheckedBinaryHeader header = {};
+    memcpy_s(&header, sizeof(header), data.data(), sizeof(header));
+    auto pBinary = data.data() + sizeof(header);
+    if ((header.magic != checkedBinaryMagic) ||
+        (header.binarySize != data.size() - sizeof(header)) ||
+        (header.checksum != Hash::hash(pBinary, header.binarySize))) {
+        return false;
+    }
+
+    binary.assign(pBinary, pBinary + header.binarySize);
+    return true;
+}
+
 bool BinaryCache::loadCachedBinary(const std::string kernelFileHash, Program &program) {
     void *pBinary = nullptr;
     size_t binarySize = 0;
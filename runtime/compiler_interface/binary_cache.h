@@ -26,6 +26,7 @@
 #include <cstring>
 #include <string>
 #include <mutex>
+#include <vector>
 
 #include "runtime/utilities/arrayref.h"
 
@@ -42,8 +43,20 @@ class BinaryCache {
 
     virtual bool cacheBinary(const std::string kernelFileHash, const char *pBinary, uint32_t binarySize);
     virtual bool loadCachedBinary(const std::string kernelFileHash, Program &program);
+    virtual bool loadCachedData(const std::string kernelFileHash, std::vector<char> &data);
+
+    // entries stored with a size and checksum header, rejected on load when either does not match
+    bool cacheCheckedBinary(const std::string kernelFileHash, const char *pBinary, uint32_t binarySize);
+    bool loadCheckedBinary(const std::string kernelFileHash, std::vector<char> &binary);
 
   protected:
+    struct CheckedBinaryHeader {
+        uint32_t magic;
+        uint32_t binarySize;
+        uint64_t checksum;
+    };
+    static const uint32_t checkedBinaryMagic = 0x4e434243; // "CBCN"
+
     static std::mutex cacheAccessMtx;
 };
 
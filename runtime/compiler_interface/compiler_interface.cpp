@@ -80,7 +80,7 @@ cl_int CompilerInterface::build(
 
         CIF::RAII::UPtr_t<CIF::Builtins::BufferSimple> intermediateRepresentation;
         if (highLevelCodeType != IGC::CodeType::undefined) {
-            auto fclTranslationCtx = createFclTranslationCtx(device, highLevelCodeType, intermediateCodeType);
+            auto fclTranslationCtx = acquireFclTranslationCtx(device, highLevelCodeType, intermediateCodeType);
             auto fclOutput = translate(fclTranslationCtx.get(), inSrc.get(),
                                        fclOptions.get(), fclInternalOptions.get());
 
@@ -112,11 +112,32 @@ cl_int CompilerInterface::build(
             binaryLoaded = cache->loadCachedBinary(kernelFileHash, program);
         }
         if (!binaryLoaded) {
-            auto igcTranslationCtx = createIgcTranslationCtx(device, intermediateCodeType, IGC::CodeType::oclGenBin);
+            std::shared_ptr<InFlightBuild> inFlightBuild;
+            if (enableCaching) {
+                bool isOwner = false;
+                inFlightBuild = joinInFlightBuild(kernelFileHash, isOwner);
+                if (!isOwner) {
+                    auto retVal = waitForInFlightBuild(*inFlightBuild, program, device);
+                    if (retVal != CL_SUCCESS) {
+                        return retVal;
+                    }
+                    continue;
+                }
+            }
+
+            auto igcTranslationCtx = acquireIgcTranslationCtx(device, intermediateCodeType, IGC::CodeType::oclGenBin);
 
             auto igcOutput = translate(igcTranslationCtx.get(), intermediateRepresentation.get(),
                                        fclOptions.get(), fclInternalOptions.get());
 
+            if (enableCaching && (igcOutput != nullptr) && igcOutput->Successful()) {
+                cache->cacheBinary(kernelFileHash, igcOutput->GetOutput()->GetMemory<char>(), static_cast<uint32_t>(igcOutput->GetOutput()->GetSizeRaw()));
+            }
+
+            if (inFlightBuild != nullptr) {
+                completeInFlightBuild(kernelFileHash, *inFlightBuild, igcOutput.get());
+            }
+
             if (igcOutput == nullptr) {
                 return CL_OUT_OF_HOST_MEMORY;
             }
@@ -126,10 +147,6 @@ cl_int CompilerInterface::build(
                 return CL_BUILD_PROGRAM_FAILURE;
             }
 
-            if (enableCaching) {
-                cache->cacheBinary(kernelFileHash, igcOutput->GetOutput()->GetMemory<char>(), static_cast<uint32_t>(igcOutput->GetOutput()->GetSizeRaw()));
-            }
-
             program.storeGenBinary(igcOutput->GetOutput()->GetMemory<char>(), igcOutput->GetOutput()->GetSizeRaw());
             program.updateBuildLog(&device, igcOutput->GetBuildLog()->GetMemory<char>(), igcOutput->GetBuildLog()->GetSizeRaw());
             if (igcOutput->GetDebugData()->GetSizeRaw() != 0) {
@@ -171,7 +188,7 @@ cl_int CompilerInterface::compile(
             auto fclOptions = CIF::Builtins::CreateConstBuffer(fclMain.get(), inputArgs.pOptions, inputArgs.OptionsSize);
             auto fclInternalOptions = CIF::Builtins::CreateConstBuffer(fclMain.get(), inputArgs.pInternalOptions, inputArgs.InternalOptionsSize);
 
-            auto fclTranslationCtx = createFclTranslationCtx(device, inType, outType);
+            auto fclTranslationCtx = acquireFclTranslationCtx(device, inType, outType);
 
             auto fclOutput = translate(fclTranslationCtx.get(), fclSrc.get(),
                                        fclOptions.get(), fclInternalOptions.get());
@@ -227,7 +244,7 @@ cl_int CompilerInterface::link(
             IGC::CodeType::CodeType_t inType = translationChain[ti - 1];
             IGC::CodeType::CodeType_t outType = translationChain[ti];
 
-            auto igcTranslationCtx = createIgcTranslationCtx(device, inType, outType);
+            auto igcTranslationCtx = acquireIgcTranslationCtx(device, inType, outType);
             currOut = translate(igcTranslationCtx.get(), currSrc.get(),
                                 igcOptions.get(), igcInternalOptions.get());
 
@@ -266,7 +283,7 @@ cl_int CompilerInterface::createLibrary(
         auto igcOptions = CIF::Builtins::CreateConstBuffer(igcMain.get(), inputArgs.pOptions, inputArgs.OptionsSize);
         auto igcInternalOptions = CIF::Builtins::CreateConstBuffer(igcMain.get(), inputArgs.pInternalOptions, inputArgs.InternalOptionsSize);
 
-        auto igcTranslationCtx = createIgcTranslationCtx(device, IGC::CodeType::elf, IGC::CodeType::llvmBc);
+        auto igcTranslationCtx = acquireIgcTranslationCtx(device, IGC::CodeType::elf, IGC::CodeType::llvmBc);
 
         auto igcOutput = translate(igcTranslationCtx.get(), igcSrc.get(),
                                    igcOptions.get(), igcInternalOptions.get());
@@ -299,7 +316,7 @@ cl_int CompilerInterface::getSipKernelBinary(SipKernelType kernel, const Device
     auto igcOptions = CIF::Builtins::CreateConstBuffer(igcMain.get(), nullptr, 0);
     auto igcInternalOptions = CIF::Builtins::CreateConstBuffer(igcMain.get(), sipInternalOptions.c_str(), sipInternalOptions.size() + 1);
 
-    auto igcTranslationCtx = createIgcTranslationCtx(device, IGC::CodeType::llvmLl, IGC::CodeType::oclGenBin);
+    auto igcTranslationCtx = acquireIgcTranslationCtx(device, IGC::CodeType::llvmLl, IGC::CodeType::oclGenBin);
 
     auto igcOutput = translate(igcTranslationCtx.get(), igcSrc.get(),
                                igcOptions.get(), igcInternalOptions.get());
@@ -326,6 +343,65 @@ bool CompilerInterface::initialize() {
     return compilersModulesSuccessfulyLoaded;
 }
 
+std::shared_ptr<CompilerInterface::InFlightBuild> CompilerInterface::joinInFlightBuild(const std::string &kernelFileHash, bool &isOwner) {
+    std::lock_guard<std::mutex> lock(inFlightBuildsMtx);
+    auto &inFlightBuild = inFlightBuilds[kernelFileHash];
+    isOwner = (inFlightBuild == nullptr);
+    if (isOwner) {
+        inFlightBuild = std::make_shared<InFlightBuild>();
+    } else {
+        std::lock_guard<std::mutex> buildLock(inFlightBuild->mtx);
+        inFlightBuild->numWaiters++;
+    }
+    return inFlightBuild;
+}
+
+void CompilerInterface::completeInFlightBuild(const std::string &kernelFileHash, InFlightBuild &inFlightBuild, IGC::OclTranslationOutputTagOCL *output) {
+    {
+        std::lock_guard<std::mutex> lock(inFlightBuildsMtx);
+        inFlightBuilds.erase(kernelFileHash);
+    }
+
+    std::lock_guard<std::mutex> buildLock(inFlightBuild.mtx);
+    if (output == nullptr) {
+        inFlightBuild.retVal = CL_OUT_OF_HOST_MEMORY;
+    } else {
+        auto buildLog = output->GetBuildLog();
+        inFlightBuild.buildLog.assign(buildLog->GetMemory<char>(), buildLog->GetMemory<char>() + buildLog->GetSizeRaw());
+        if (output->Successful()) {
+            auto genBinary = output->GetOutput();
+            auto debugData = output->GetDebugData();
+            inFlightBuild.genBinary.assign(genBinary->GetMemory<char>(), genBinary->GetMemory<char>() + genBinary->GetSizeRaw());
+            inFlightBuild.debugData.assign(debugData->GetMemory<char>(), debugData->GetMemory<char>() + debugData->GetSizeRaw());
+            inFlightBuild.retVal = CL_SUCCESS;
+        } else {
+            inFlightBuild.retVal = CL_BUILD_PROGRAM_FAILURE;
+        }
+    }
+    inFlightBuild.done = true;
+    inFlightBuild.completed.notify_all();
+}
+
+cl_int CompilerInterface::waitForInFlightBuild(InFlightBuild &inFlightBuild, Program &program, const Device &device) {
+    std::unique_lock<std::mutex> buildLock(inFlightBuild.mtx);
+    inFlightBuild.completed.wait(buildLock, [&inFlightBuild] { return inFlightBuild.done; });
+
+    if (inFlightBuild.retVal == CL_OUT_OF_HOST_MEMORY) {
+        return inFlightBuild.retVal;
+    }
+
+    program.updateBuildLog(&device, inFlightBuild.buildLog.data(), inFlightBuild.buildLog.size());
+    if (inFlightBuild.retVal != CL_SUCCESS) {
+        return inFlightBuild.retVal;
+    }
+
+    program.storeGenBinary(inFlightBuild.genBinary.data(), inFlightBuild.genBinary.size());
+    if (inFlightBuild.debugData.size() != 0) {
+        program.storeDebugData(inFlightBuild.debugData.data(), inFlightBuild.debugData.size());
+    }
+    return CL_SUCCESS;
+}
+
 BinaryCache *CompilerInterface::replaceBinaryCache(BinaryCache *newCache) {
     auto res = cache.release();
     this->cache.reset(newCache);
@@ -333,15 +409,28 @@ BinaryCache *CompilerInterface::replaceBinaryCache(BinaryCache *newCache) {
     return res;
 }
 
-CIF::RAII::UPtr_t<IGC::FclOclTranslationCtxTagOCL> CompilerInterface::createFclTranslationCtx(const Device &device, IGC::CodeType::CodeType_t inType, IGC::CodeType::CodeType_t outType) {
-    auto it = fclDeviceContexts.find(&device);
-    if (it != fclDeviceContexts.end()) {
-        return it->second->CreateTranslationCtx(inType, outType);
+CompilerInterface::FclTranslationCtxPool::Handle CompilerInterface::acquireFclTranslationCtx(const Device &device, IGC::CodeType::CodeType_t inType, IGC::CodeType::CodeType_t outType) {
+    auto key = std::make_tuple(&device, inType, outType);
+    auto translationCtx = fclTranslationCtxPool.acquire(key);
+    if (translationCtx == nullptr) {
+        translationCtx = createFclTranslationCtx(device, inType, outType);
+    }
+    return FclTranslationCtxPool::Handle(fclTranslationCtxPool, key, std::move(translationCtx));
+}
+
+CompilerInterface::IgcTranslationCtxPool::Handle CompilerInterface::acquireIgcTranslationCtx(const Device &device, IGC::CodeType::CodeType_t inType, IGC::CodeType::CodeType_t outType) {
+    auto key = std::make_tuple(&device, inType, outType);
+    auto translationCtx = igcTranslationCtxPool.acquire(key);
+    if (translationCtx == nullptr) {
+        translationCtx = createIgcTranslationCtx(device, inType, outType);
     }
+    return IgcTranslationCtxPool::Handle(igcTranslationCtxPool, key, std::move(translationCtx));
+}
 
+CIF::RAII::UPtr_t<IGC::FclOclTranslationCtxTagOCL> CompilerInterface::createFclTranslationCtx(const Device &device, IGC::CodeType::CodeType_t inType, IGC::CodeType::CodeType_t outType) {
     {
         auto ulock = this->lock();
-        it = fclDeviceContexts.find(&device);
+        auto it = fclDeviceContexts.find(&device);
         if (it != fclDeviceContexts.end()) {
             return it->second->CreateTranslationCtx(inType, outType);
         }
@@ -368,14 +457,9 @@ CIF::RAII::UPtr_t<IGC::FclOclTranslationCtxTagOCL> CompilerInterface::createFclT
 }
 
 CIF::RAII::UPtr_t<IGC::IgcOclTranslationCtxTagOCL> CompilerInterface::createIgcTranslationCtx(const Device &device, IGC::CodeType::CodeType_t inType, IGC::CodeType::CodeType_t outType) {
-    auto it = igcDeviceContexts.find(&device);
-    if (it != igcDeviceContexts.end()) {
-        return it->second->CreateTranslationCtx(inType, outType);
-    }
-
     {
         auto ulock = this->lock();
-        it = igcDeviceContexts.find(&device);
+        auto it = igcDeviceContexts.find(&device);
         if (it != igcDeviceContexts.end()) {
             return it->second->CreateTranslationCtx(inType, outType);
         }
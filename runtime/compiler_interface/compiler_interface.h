@@ -26,13 +26,20 @@
 #include "ocl_igc_interface/code_type.h"
 #include "ocl_igc_interface/igc_ocl_device_ctx.h"
 #include "ocl_igc_interface/fcl_ocl_device_ctx.h"
+#include "ocl_igc_interface/ocl_translation_output.h"
 #include "runtime/built_ins/sip.h"
 #include "runtime/compiler_interface/binary_cache.h"
 #include "runtime/os_interface/os_library.h"
 
 #include "CL/cl_platform.h"
+#include <condition_variable>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 namespace OCLRT {
 class Device;
@@ -50,6 +57,68 @@ struct TranslationArgs {
     void *GTPinInput = nullptr;             // input structure for GTPin requests
 };
 
+// Translation contexts are not thread-safe, so each one is lent to a single translation at a time
+// and returned to the pool of its device and code-type pair afterwards.
+template <typename TranslationCtx>
+class TranslationCtxPool {
+  public:
+    using CtxUptr = CIF::RAII::UPtr_t<TranslationCtx>;
+    using Key = std::tuple<const Device *, IGC::CodeType::CodeType_t, IGC::CodeType::CodeType_t>;
+
+    class Handle {
+      public:
+        Handle(TranslationCtxPool &pool, const Key &key, CtxUptr ctx)
+            : pool(&pool), key(key), ctx(std::move(ctx)) {
+        }
+        Handle(Handle &&other)
+            : pool(other.pool), key(other.key), ctx(std::move(other.ctx)) {
+        }
+        Handle(const Handle &) = delete;
+        Handle &operator=(const Handle &) = delete;
+        ~Handle() {
+            pool->release(key, std::move(ctx));
+        }
+
+        TranslationCtx *get() const {
+            return ctx.get();
+        }
+
+      protected:
+        TranslationCtxPool *pool;
+        Key key;
+        CtxUptr ctx;
+    };
+
+    CtxUptr acquire(const Key &key) {
+        std::lock_guard<std::mutex> lock(poolMtx);
+        auto it = idleContexts.find(key);
+        if ((it == idleContexts.end()) || it->second.empty()) {
+            return nullptr;
+        }
+        auto ctx = std::move(it->second.back());
+        it->second.pop_back();
+        return ctx;
+    }
+
+    void release(const Key &key, CtxUptr ctx) {
+        if (ctx == nullptr) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(poolMtx);
+        idleContexts[key].push_back(std::move(ctx));
+    }
+
+    size_t getNumIdle(const Key &key) {
+        std::lock_guard<std::mutex> lock(poolMtx);
+        auto it = idleContexts.find(key);
+        return (it != idleContexts.end()) ? it->second.size() : 0u;
+    }
+
+  protected:
+    std::mutex poolMtx;
+    std::map<Key, std::vector<CtxUptr>> idleContexts;
+};
+
 class CompilerInterface {
   public:
     CompilerInterface(const CompilerInterface &) = delete;
@@ -118,6 +187,36 @@ class CompilerInterface {
     std::map<const Device *, fclDevCtxUptr> fclDeviceContexts;
     CIF::RAII::UPtr_t<IGC::FclOclTranslationCtxTagOCL> fclBaseTranslationCtx = nullptr;
 
+    using FclTranslationCtxPool = TranslationCtxPool<IGC::FclOclTranslationCtxTagOCL>;
+    using IgcTranslationCtxPool = TranslationCtxPool<IGC::IgcOclTranslationCtxTagOCL>;
+    FclTranslationCtxPool fclTranslationCtxPool;
+    IgcTranslationCtxPool igcTranslationCtxPool;
+
+    FclTranslationCtxPool::Handle acquireFclTranslationCtx(const Device &device,
+                                                           IGC::CodeType::CodeType_t inType,
+                                                           IGC::CodeType::CodeType_t outType);
+    IgcTranslationCtxPool::Handle acquireIgcTranslationCtx(const Device &device,
+                                                           IGC::CodeType::CodeType_t inType,
+                                                           IGC::CodeType::CodeType_t outType);
+
+    // identical builds (same cache hash) running concurrently wait for a single compilation
+    struct InFlightBuild {
+        std::mutex mtx;
+        std::condition_variable completed;
+        bool done = false;
+        uint32_t numWaiters = 0;
+        cl_int retVal = CL_SUCCESS;
+        std::vector<char> genBinary;
+        std::vector<char> debugData;
+        std::vector<char> buildLog;
+    };
+    std::mutex inFlightBuildsMtx;
+    std::unordered_map<std::string, std::shared_ptr<InFlightBuild>> inFlightBuilds;
+
+    std::shared_ptr<InFlightBuild> joinInFlightBuild(const std::string &kernelFileHash, bool &isOwner);
+    void completeInFlightBuild(const std::string &kernelFileHash, InFlightBuild &inFlightBuild, IGC::OclTranslationOutputTagOCL *output);
+    cl_int waitForInFlightBuild(InFlightBuild &inFlightBuild, Program &program, const Device &device);
+
     MOCKABLE_VIRTUAL CIF::RAII::UPtr_t<IGC::FclOclTranslationCtxTagOCL> createFclTranslationCtx(const Device &device,
                                                                                                 IGC::CodeType::CodeType_t inType,
                                                                                                 IGC::CodeType::CodeType_t outType);
@@ -105,8 +105,10 @@ Device::~Device() {
     tagAllocation = nullptr;
     delete memoryManager;
     memoryManager = nullptr;
-    BuiltIns::shutDown();
-    CompilerInterface::shutdown();
+    if (releaseGlobalsOnDestruction) {
+        BuiltIns::shutDown();
+        CompilerInterface::shutdown();
+    }
 }
 
 bool Device::createDeviceImpl(const HardwareInfo *pHwInfo,
@@ -198,6 +200,7 @@ void *Device::getSLMWindowStartAddress() {
 }
 
 void Device::prepareSLMWindow() {
+    std::lock_guard<std::mutex> lock(slmWindowMutex);
     if (this->slmWindowStartAddress == nullptr) {
         this->slmWindowStartAddress = memoryManager->allocateSystemMemory(MemoryConstants::slmWindowSize, MemoryConstants::slmWindowAlignment);
     }
@@ -22,11 +22,16 @@
 
 #pragma once
 #include "runtime/api/cl_types.h"
+#include "runtime/built_ins/sip.h"
+#include "runtime/command_queue/transfer_planner.h"
 #include "runtime/device/device_info_map.h"
 #include "runtime/helpers/base_object.h"
 #include "runtime/helpers/hw_info.h"
 #include "runtime/helpers/engine_node.h"
 #include "runtime/os_interface/performance_counters.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace OCLRT {
@@ -56,6 +61,8 @@ class Device : public BaseObject<_cl_device_id> {
         pHwInfo = getDeviceInitHwInfo(pHwInfo);
         T *device = new T(*pHwInfo);
         if (false == createDeviceImpl(pHwInfo, isRootDevice, *device)) {
+            // devices may be created concurrently, a failed one must not release globals used by the others
+            device->releaseGlobalsOnDestruction = false;
             delete device;
             return nullptr;
         }
@@ -91,7 +98,7 @@ class Device : public BaseObject<_cl_device_id> {
         deviceInfo.force32BitAddressess = value;
     }
 
-    CommandStreamReceiver &getCommandStreamReceiver();
+    CommandStreamReceiver &getCommandStreamReceiver() const;
     CommandStreamReceiver *peekCommandStreamReceiver();
 
     volatile uint32_t *getTagAddress() const;
@@ -129,11 +136,37 @@ class Device : public BaseObject<_cl_device_id> {
     static decltype(&PerformanceCounters::create) createPerformanceCountersFunc;
     PreemptionMode getPreemptionMode() const { return preemptionMode; }
     GraphicsAllocation *getPreemptionAllocation() const { return preemptionAllocation; }
+    TransferPlanner &getTransferPlanner() { return transferPlanner; }
     MOCKABLE_VIRTUAL const WhitelistedRegisters &getWhitelistedRegisters() { return hwInfo.capabilityTable.whitelistedRegisters; }
     std::vector<unsigned int> simultaneousInterops;
     std::string deviceExtensions;
     bool getEnabled64kbPages();
 
+    // sip kernel resolved by BuiltIns for this device, tagged with the id of the resolving BuiltIns instance
+    class ResolvedSipKernel {
+      public:
+        const SipKernel *find(uint32_t builtInsId) const {
+            auto entry = current.load(std::memory_order_acquire);
+            return (entry != nullptr && entry->builtInsId == builtInsId) ? entry->kernel : nullptr;
+        }
+        void publish(const SipKernel *kernel, uint32_t builtInsId) {
+            std::lock_guard<std::mutex> lock(publishMtx);
+            entries.push_back(std::unique_ptr<Entry>(new Entry{kernel, builtInsId}));
+            current.store(entries.back().get(), std::memory_order_release);
+        }
+
+      protected:
+        // kernel and owner are published together, replaced entries live as long as the device
+        struct Entry {
+            const SipKernel *kernel;
+            uint32_t builtInsId;
+        };
+        std::atomic<const Entry *> current{nullptr};
+        std::vector<std::unique_ptr<Entry>> entries;
+        std::mutex publishMtx;
+    };
+    ResolvedSipKernel &getResolvedSipKernel(SipKernelType type) const { return resolvedSipKernels[static_cast<uint32_t>(type)]; }
+
   protected:
     Device() = delete;
     Device(const HardwareInfo &hwInfo,
@@ -156,17 +189,22 @@ class Device : public BaseObject<_cl_device_id> {
     volatile uint32_t *tagAddress;
     GraphicsAllocation *tagAllocation;
     GraphicsAllocation *preemptionAllocation;
+    mutable ResolvedSipKernel resolvedSipKernels[static_cast<uint32_t>(SipKernelType::COUNT)];
     std::unique_ptr<OSTime> osTime;
     std::unique_ptr<DriverInfo> driverInfo;
     std::unique_ptr<PerformanceCounters> performanceCounters;
+    TransferPlanner transferPlanner;
     uint64_t programCount = 0u;
 
     void *slmWindowStartAddress;
+    // kernels of a program may be decoded on several threads
+    std::mutex slmWindowMutex;
 
     std::string exposedBuiltinKernels = "";
 
     PreemptionMode preemptionMode;
     EngineType engineType;
+    bool releaseGlobalsOnDestruction = true;
 };
 
 template <cl_device_info Param>
@@ -177,7 +215,7 @@ inline void Device::getCap(const void *&src,
     retSize = size = DeviceInfoTable::Map<Param>::size;
 }
 
-inline CommandStreamReceiver &Device::getCommandStreamReceiver() {
+inline CommandStreamReceiver &Device::getCommandStreamReceiver() const {
     return *commandStreamReceiver;
 }
 
@@ -106,5 +106,7 @@ class DeviceQueueHw : public DeviceQueue {
 
     LinearStream slbCS;
     IGIL_CommandQueue *igilQueue = nullptr;
+    bool slbDummyCommandsValid = false;
+    size_t lastResetBytesTouched = 0;
 };
 } // namespace OCLRT
@@ -48,8 +48,15 @@ void DeviceQueueHw<GfxFamily>::resetDeviceQueue() {
     auto &caps = device->getDeviceInfo();
     auto igilEventPool = reinterpret_cast<IGIL_EventPool *>(eventPoolBuffer->getUnderlyingBuffer());
 
-    memset(eventPoolBuffer->getUnderlyingBuffer(), 0x0, eventPoolBuffer->getUnderlyingBufferSize());
+    // device events are handed out from the pool head, only clear the ones used since the previous reset
+    auto usedEvents = static_cast<uint32_t>(igilEventPool->m_head);
+    size_t eventPoolBytesToClear = eventPoolBuffer->getUnderlyingBufferSize();
+    if (usedEvents < caps.maxOnDeviceEvents) {
+        eventPoolBytesToClear = sizeof(IGIL_EventPool) + usedEvents * sizeof(IGIL_DeviceEvent);
+    }
+    memset(eventPoolBuffer->getUnderlyingBuffer(), 0x0, eventPoolBytesToClear);
     igilEventPool->m_size = caps.maxOnDeviceEvents;
+    lastResetBytesTouched = eventPoolBytesToClear;
 
     auto igilCmdQueue = reinterpret_cast<IGIL_CommandQueue *>(queueBuffer->getUnderlyingBuffer());
     igilQueue = igilCmdQueue;
@@ -139,8 +146,12 @@ void DeviceQueueHw<GfxFamily>::buildSlbDummyCommands() {
         //if SLBENDoffset is the at the end then BB_START added after scheduler did not corrupt anything so no need to regenerate
         numEnqueues = (slbEndOffset == static_cast<int>(commandsSize)) ? 0 : 1;
         slbCS.getSpace(slbEndOffset);
+    } else if (slbDummyCommandsValid) {
+        //SLB was not dispatched since the last build, the scheduler could not have modified it
+        numEnqueues = 0;
     }
 
+    auto slbUsedBeforeCommands = slbCS.getUsed();
     for (size_t i = 0; i < numEnqueues; i++) {
         auto mediaStateFlush = slbCS.getSpaceForCmd<MEDIA_STATE_FLUSH>();
         *mediaStateFlush = MEDIA_STATE_FLUSH::sInit();
@@ -194,6 +205,7 @@ void DeviceQueueHw<GfxFamily>::buildSlbDummyCommands() {
         auto prefetch = slbCS.getSpace(getCSPrefetchSize());
         memset(prefetch, 0x0, getCSPrefetchSize());
     }
+    lastResetBytesTouched += slbCS.getUsed() - slbUsedBeforeCommands;
 
     // always the same BBStart position (after 128 enqueues)
     auto bbStartOffset = (commandsSize * 128) - slbCS.getUsed();
@@ -206,10 +218,14 @@ void DeviceQueueHw<GfxFamily>::buildSlbDummyCommands() {
 
     igilCmdQueue->m_controls.m_CleanupSectionSize = 0;
     igilQueue->m_controls.m_CleanupSectionAddress = 0;
+    slbDummyCommandsValid = true;
 }
 
 template <typename GfxFamily>
 void DeviceQueueHw<GfxFamily>::addExecutionModelCleanUpSection(Kernel *parentKernel, HwTimeStamps *hwTimeStamp, uint32_t taskCount) {
+    // SLB is handed to the scheduler with this dispatch
+    slbDummyCommandsValid = false;
+
     // CleanUp Section
     auto offset = slbCS.getUsed();
     auto alignmentSize = alignUp(offset, MemoryConstants::pageSize) - offset;
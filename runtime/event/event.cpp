@@ -327,6 +327,7 @@ void Event::updateExecutionStatus() {
 
     if ((cmdQueue != nullptr) && (cmdQueue->isCompleted(getCompletionStamp()))) {
         transitionExecutionStatus(CL_COMPLETE);
+        reportTransferTime();
         executeCallbacks(CL_COMPLETE);
         unblockEventsBlockedByThis(CL_COMPLETE);
         cmdQueue->getDevice().getMemoryManager()->cleanAllocationList(this->taskCount, TEMPORARY_ALLOCATION);
@@ -336,6 +337,18 @@ void Event::updateExecutionStatus() {
     transitionExecutionStatus(CL_SUBMITTED);
 }
 
+void Event::reportTransferTime() {
+    auto size = transferSize.exchange(0);
+    if (size == 0 || !isProfilingEnabled() || !calcProfilingData()) {
+        return;
+    }
+    // only the execution of the copy kernel is accounted, waiting for preceding work
+    // delays the CPU path as much as the GPU one
+    if (endTimeStamp > startTimeStamp) {
+        cmdQueue->getDevice().getTransferPlanner().recordGpuTransfer(size, endTimeStamp - startTimeStamp);
+    }
+}
+
 void Event::addChild(Event &childEvent) {
     childEvent.parentCount++;
     childEvent.incRefInternal();
@@ -125,6 +125,11 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
     HwTimeStamps *getHwTimeStamp();
     GraphicsAllocation *getHwTimeStampAllocation();
 
+    // size of the read/write transfer done by the GPU copy kernel, its execution time
+    // feeds the device transfer planner once the event completes
+    void setTransferSize(size_t size) { this->transferSize = size; }
+    size_t peekTransferSize() const { return transferSize; }
+
     bool isPerfCountersEnabled() {
         return perfCountersEnabled;
     }
@@ -333,6 +338,8 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
     // executes all callbacks associated with this event
     void executeCallbacks(int32_t executionStatus);
 
+    void reportTransferTime();
+
     // transitions event to new execution state
     // guarantees that newStatus <= oldStatus
     void transitionExecutionStatus(int32_t newExecutionStatus) const {
@@ -375,6 +382,7 @@ class Event : public BaseObject<_cl_event>, public IDNode<Event> {
     uint64_t endTimeStamp;
     uint64_t completeTimeStamp;
     TagNode<HwTimeStamps> *timeStampNode;
+    std::atomic<size_t> transferSize{0};
     bool perfCountersEnabled;
     TagNode<HwPerfCounter> *perfCounterNode;
     InstrPmRegsCfg *perfConfigurationData;
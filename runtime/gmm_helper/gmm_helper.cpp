@@ -21,6 +21,7 @@
  */
 
 #include "runtime/gmm_helper/gmm_helper.h"
+#include "runtime/gmm_helper/image_layout_cache.h"
 #include "runtime/gmm_helper/resource_info.h"
 #include "runtime/helpers/get_info.h"
 #include "runtime/helpers/aligned_memory.h"
@@ -188,6 +189,12 @@ void Gmm::queryImageParams(ImageInfo &imgInfo, const HardwareInfo &hwInfo) {
 
     this->gmmResourceInfo.reset(GmmResourceInfo::create(&this->resourceParams));
 
+    bool useLayoutCache = DebugManager.flags.EnableImageLayoutCache.get();
+    auto layoutKey = ImageLayoutCache::createKey(this->resourceParams, imgInfo.plane, hwInfo.pPlatform->eRenderCoreFamily);
+    if (useLayoutCache && ImageLayoutCache::getInstance().find(layoutKey, imgInfo)) {
+        return;
+    }
+
     imgInfo.size = this->gmmResourceInfo->getSizeAllocation();
 
     imgInfo.rowPitch = this->gmmResourceInfo->getRenderPitch();
@@ -238,7 +245,10 @@ void Gmm::queryImageParams(ImageInfo &imgInfo, const HardwareInfo &hwInfo) {
     }
 
     imgInfo.qPitch = queryQPitch(hwInfo.pPlatform->eRenderCoreFamily, this->resourceParams.Type);
-    return;
+
+    if (useLayoutCache) {
+        ImageLayoutCache::getInstance().insert(layoutKey, imgInfo);
+    }
 }
 
 void Gmm::queryImgFromBufferParams(ImageInfo &imgInfo, GraphicsAllocation *gfxAlloc) {
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/gmm_helper/image_layout_cache.h"
+#include "runtime/helpers/surface_formats.h"
+#include <cstring>
+
+namespace OCLRT {
+
+const size_t ImageLayoutCache::maxEntries;
+
+bool ImageLayoutCache::Key::operator==(const Key &other) const {
+    return memcmp(this, &other, sizeof(Key)) == 0;
+}
+
+size_t ImageLayoutCache::KeyHash::operator()(const Key &key) const {
+    // FNV-1a over the key bytes, padding is zeroed in createKey
+    auto bytes = reinterpret_cast<const uint8_t *>(&key);
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < sizeof(Key); i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return static_cast<size_t>(hash);
+}
+
+ImageLayoutCache &ImageLayoutCache::getInstance() {
+    static ImageLayoutCache layoutCache;
+    return layoutCache;
+}
+
+ImageLayoutCache::Key ImageLayoutCache::createKey(const GMM_RESCREATE_PARAMS &resourceParams, GMM_YUV_PLANE plane, GFXCORE_FAMILY gfxFamily) {
+    Key key;
+    memset(&key, 0, sizeof(Key));
+    key.baseWidth = static_cast<uint64_t>(resourceParams.BaseWidth);
+    key.overridePitch = static_cast<uint64_t>(resourceParams.OverridePitch);
+    key.baseHeight = static_cast<uint32_t>(resourceParams.BaseHeight);
+    key.depth = static_cast<uint32_t>(resourceParams.Depth);
+    key.arraySize = static_cast<uint32_t>(resourceParams.ArraySize);
+    key.maxLod = static_cast<uint32_t>(resourceParams.MaxLod);
+    key.type = static_cast<uint32_t>(resourceParams.Type);
+    key.format = static_cast<uint32_t>(resourceParams.Format);
+    key.plane = static_cast<uint32_t>(plane);
+    key.gfxFamily = static_cast<uint32_t>(gfxFamily);
+    key.flags = resourceParams.Flags;
+    return key;
+}
+
+bool ImageLayoutCache::find(const Key &key, ImageInfo &imgInfo) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = layouts.find(key);
+    if (it == layouts.end()) {
+        misses++;
+        return false;
+    }
+    hits++;
+
+    const auto &layout = it->second;
+    imgInfo.size = layout.size;
+    imgInfo.rowPitch = layout.rowPitch;
+    imgInfo.slicePitch = layout.slicePitch;
+    imgInfo.qPitch = layout.qPitch;
+    imgInfo.offset = layout.offset;
+    imgInfo.xOffset = layout.xOffset;
+    imgInfo.yOffset = layout.yOffset;
+    imgInfo.yOffsetForUVPlane = layout.yOffsetForUVPlane;
+    return true;
+}
+
+void ImageLayoutCache::insert(const Key &key, const ImageInfo &imgInfo) {
+    Layout layout;
+    layout.size = imgInfo.size;
+    layout.rowPitch = imgInfo.rowPitch;
+    layout.slicePitch = imgInfo.slicePitch;
+    layout.qPitch = imgInfo.qPitch;
+    layout.offset = imgInfo.offset;
+    layout.xOffset = imgInfo.xOffset;
+    layout.yOffset = imgInfo.yOffset;
+    layout.yOffsetForUVPlane = imgInfo.yOffsetForUVPlane;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    if (layouts.size() >= maxEntries) {
+        layouts.clear();
+    }
+    layouts[key] = layout;
+}
+
+void ImageLayoutCache::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    layouts.clear();
+    hits = 0;
+    misses = 0;
+}
+
+size_t ImageLayoutCache::size() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return layouts.size();
+}
+
+uint64_t ImageLayoutCache::getHits() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return hits;
+}
+
+uint64_t ImageLayoutCache::getMisses() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return misses;
+}
+} // namespace OCLRT
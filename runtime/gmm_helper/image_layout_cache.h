@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/gmm_helper/gmm_lib.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace OCLRT {
+struct ImageInfo;
+
+// Process-wide memo of image layouts queried from GmmLib. Layout depends only on
+// the resource creation parameters, plane and core family, so images with the same
+// shape reuse pitch, size and offsets computed for the first one.
+class ImageLayoutCache {
+  public:
+    struct Key {
+        uint64_t baseWidth;
+        uint64_t overridePitch;
+        uint32_t baseHeight;
+        uint32_t depth;
+        uint32_t arraySize;
+        uint32_t maxLod;
+        uint32_t type;
+        uint32_t format;
+        uint32_t plane;
+        uint32_t gfxFamily;
+        GMM_RESOURCE_FLAG flags;
+
+        bool operator==(const Key &other) const;
+    };
+
+    struct Layout {
+        size_t size;
+        size_t rowPitch;
+        size_t slicePitch;
+        uint32_t qPitch;
+        uint32_t offset;
+        uint32_t xOffset;
+        uint32_t yOffset;
+        uint32_t yOffsetForUVPlane;
+    };
+
+    static const size_t maxEntries = 4096;
+
+    static ImageLayoutCache &getInstance();
+    static Key createKey(const GMM_RESCREATE_PARAMS &resourceParams, GMM_YUV_PLANE plane, GFXCORE_FAMILY gfxFamily);
+
+    bool find(const Key &key, ImageInfo &imgInfo);
+    void insert(const Key &key, const ImageInfo &imgInfo);
+    void clear();
+
+    size_t size();
+    uint64_t getHits();
+    uint64_t getMisses();
+
+  protected:
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    std::mutex mtx;
+    std::unordered_map<Key, Layout, KeyHash> layouts;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
+} // namespace OCLRT
@@ -31,6 +31,7 @@
 #include "runtime/platform/platform.h"
 #include "runtime/program/program.h"
 #include "runtime/sampler/sampler.h"
+#include "runtime/utilities/slab_allocator.h"
 
 // *********************************************************************** //
 // *** PLEASE LIMIT THIS FILE TO THE IMPLEMENTATIONS OF new AND delete *** //
@@ -40,24 +41,31 @@
 
 namespace OCLRT {
 
+template <typename B>
+using BaseObjectAllocator = SizeClassSlabAllocator<BaseObject<B>>;
+
 template <typename B>
 void *BaseObject<B>::operator new(size_t sz) {
-    return ::operator new(sz);
+    void *ptr = BaseObjectAllocator<B>::allocate(sz);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
 }
 
 template <typename B>
 void BaseObject<B>::operator delete(void *ptr, size_t allocationSize) {
-    return ::operator delete(ptr);
+    BaseObjectAllocator<B>::release(ptr);
 }
 
 template <typename B>
 void *BaseObject<B>::operator new(size_t sz, const std::nothrow_t &tag) noexcept {
-    return ::operator new(sz, tag);
+    return BaseObjectAllocator<B>::allocate(sz);
 }
 
 template <typename B>
 void BaseObject<B>::operator delete(void *ptr, const std::nothrow_t &tag) noexcept {
-    return ::operator delete(ptr, tag);
+    BaseObjectAllocator<B>::release(ptr);
 }
 
 template class BaseObject<_cl_accelerator_intel>;
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/blocked_commands_pool.h"
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/task_information.h"
+
+namespace OCLRT {
+const size_t BlockedCommandsPool::commandStorageHeaderSize;
+
+namespace {
+template <typename StreamType>
+std::unique_ptr<StreamType> createStream(size_t size) {
+    return std::unique_ptr<StreamType>(new StreamType(alignedMalloc(size, MemoryConstants::pageSize), size));
+}
+} // namespace
+
+BlockedCommandsPool::~BlockedCommandsPool() {
+    for (auto kernelOperation : freeKernelOperations) {
+        delete kernelOperation;
+    }
+    freeKernelOperations.clear();
+
+    for (auto storage : freeSurfaceStorage) {
+        delete storage;
+    }
+    freeSurfaceStorage.clear();
+
+    for (auto block : freeCommandStorage) {
+        ::operator delete(block);
+    }
+    freeCommandStorage.clear();
+}
+
+KernelOperation *BlockedCommandsPool::obtainKernelOperation(size_t commandStreamSize, size_t dshSize, size_t ishSize, size_t iohSize, size_t sshSize) {
+    KernelOperation *kernelOperation = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!freeKernelOperations.empty()) {
+            kernelOperation = freeKernelOperations.back();
+            freeKernelOperations.pop_back();
+        }
+    }
+
+    if (kernelOperation == nullptr) {
+        kernelOperation = new KernelOperation(createStream<LinearStream>(commandStreamSize), createStream<IndirectHeap>(dshSize),
+                                              createStream<IndirectHeap>(ishSize), createStream<IndirectHeap>(iohSize),
+                                              createStream<IndirectHeap>(sshSize));
+        kernelOperation->pool = this;
+        return kernelOperation;
+    }
+
+    reuseStream(*kernelOperation->commandStream, commandStreamSize);
+    reuseStream(*kernelOperation->dsh, dshSize);
+    reuseStream(*kernelOperation->ish, ishSize);
+    reuseStream(*kernelOperation->ioh, iohSize);
+    reuseStream(*kernelOperation->ssh, sshSize);
+    kernelOperation->instructionHeapSizeEM = 0;
+    kernelOperation->surfaceStateHeapSizeEM = 0;
+    return kernelOperation;
+}
+
+void BlockedCommandsPool::returnKernelOperation(KernelOperation *kernelOperation) {
+    DEBUG_BREAK_IF(kernelOperation->pool != this);
+    for (auto surface : kernelOperation->pooledSurfaces) {
+        destroySurface(surface);
+    }
+    kernelOperation->pooledSurfaces.clear();
+
+    std::lock_guard<std::mutex> lock(mtx);
+    freeKernelOperations.push_back(kernelOperation);
+}
+
+Surface *BlockedCommandsPool::duplicateSurface(Surface &surface) {
+    auto storage = obtainSurfaceStorage();
+    auto surfaceCopy = surface.duplicateInto(storage);
+    if (surfaceCopy == nullptr) {
+        releaseSurfaceStorage(storage);
+    }
+    return surfaceCopy;
+}
+
+void BlockedCommandsPool::destroySurface(Surface *surface) {
+    // storage was handed out for the most derived object
+    auto storage = dynamic_cast<void *>(surface);
+    surface->~Surface();
+    releaseSurfaceStorage(storage);
+}
+
+void BlockedCommandsPool::releaseSurfaceStorage(void *storage) {
+    std::lock_guard<std::mutex> lock(mtx);
+    freeSurfaceStorage.push_back(reinterpret_cast<SurfaceStorage *>(storage));
+}
+
+void *BlockedCommandsPool::obtainSurfaceStorage() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!freeSurfaceStorage.empty()) {
+            auto storage = freeSurfaceStorage.back();
+            freeSurfaceStorage.pop_back();
+            return storage;
+        }
+    }
+    return new SurfaceStorage;
+}
+
+void *BlockedCommandsPool::obtainCommandStorage(BlockedCommandsPool *pool, size_t size) {
+    void *block = pool ? pool->takeFreeCommandStorage(size) : nullptr;
+    if (block == nullptr) {
+        block = ::operator new(commandStorageHeaderSize + size);
+    }
+    auto header = reinterpret_cast<CommandStorageHeader *>(block);
+    header->pool = pool;
+    header->size = size;
+    return reinterpret_cast<char *>(block) + commandStorageHeaderSize;
+}
+
+void BlockedCommandsPool::releaseCommandStorage(void *storage) {
+    if (storage == nullptr) {
+        return;
+    }
+    auto block = reinterpret_cast<char *>(storage) - commandStorageHeaderSize;
+    auto header = reinterpret_cast<CommandStorageHeader *>(block);
+    if (header->pool && header->pool->keepFreeCommandStorage(block, header->size)) {
+        return;
+    }
+    ::operator delete(block);
+}
+
+void *BlockedCommandsPool::takeFreeCommandStorage(size_t size) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (size != commandStorageSize || freeCommandStorage.empty()) {
+        return nullptr;
+    }
+    auto block = freeCommandStorage.back();
+    freeCommandStorage.pop_back();
+    return block;
+}
+
+bool BlockedCommandsPool::keepFreeCommandStorage(void *block, size_t size) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (commandStorageSize == 0) {
+        commandStorageSize = size;
+    }
+    if (size != commandStorageSize) {
+        return false;
+    }
+    freeCommandStorage.push_back(block);
+    return true;
+}
+
+void BlockedCommandsPool::reuseStream(LinearStream &stream, size_t requiredSize) {
+    if (stream.getMaxAvailableSpace() < requiredSize) {
+        alignedFree(stream.getBase());
+        stream.replaceBuffer(alignedMalloc(requiredSize, MemoryConstants::pageSize), requiredSize);
+    } else {
+        stream.replaceBuffer(stream.getBase(), stream.getMaxAvailableSpace());
+    }
+}
+} // namespace OCLRT
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/memory_manager/surface.h"
+
+#include <cstddef>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace OCLRT {
+class LinearStream;
+struct KernelOperation;
+
+// Recycles storage used by commands blocked on user events: the commands themselves,
+// KernelOperation objects with their command stream / heap buffers and surface wrappers.
+class BlockedCommandsPool {
+  public:
+    BlockedCommandsPool() = default;
+    ~BlockedCommandsPool();
+
+    BlockedCommandsPool(const BlockedCommandsPool &) = delete;
+    BlockedCommandsPool &operator=(const BlockedCommandsPool &) = delete;
+
+    KernelOperation *obtainKernelOperation(size_t commandStreamSize, size_t dshSize, size_t ishSize, size_t iohSize, size_t sshSize);
+    void returnKernelOperation(KernelOperation *kernelOperation);
+
+    template <typename SurfaceType, typename... Args>
+    Surface *createSurface(Args &&... args) {
+        static_assert(sizeof(SurfaceType) <= sizeof(SurfaceStorage), "surface type doesn't fit into pooled storage");
+        return new (obtainSurfaceStorage()) SurfaceType(std::forward<Args>(args)...);
+    }
+    // copy of surface in pooled storage, nullptr when its type has no in-place copy
+    Surface *duplicateSurface(Surface &surface);
+    void destroySurface(Surface *surface);
+
+    // storage for a command object, taken from pool when it is given; the storage
+    // remembers its pool, so releasing it needs only the pointer
+    static void *obtainCommandStorage(BlockedCommandsPool *pool, size_t size);
+    static void releaseCommandStorage(void *storage);
+
+    size_t peekFreeKernelOperationsCount() const {
+        return freeKernelOperations.size();
+    }
+    size_t peekFreeSurfaceStorageCount() const {
+        return freeSurfaceStorage.size();
+    }
+    size_t peekFreeCommandStorageCount() const {
+        return freeCommandStorage.size();
+    }
+
+  protected:
+    using SurfaceStorage = std::aligned_union<0, GeneralSurface, PrivateSurface, MemObjSurface, HostPtrSurface, NullSurface>::type;
+
+    void *obtainSurfaceStorage();
+    void releaseSurfaceStorage(void *storage);
+    static void reuseStream(LinearStream &stream, size_t requiredSize);
+
+    struct CommandStorageHeader {
+        BlockedCommandsPool *pool;
+        size_t size;
+    };
+    static const size_t commandStorageHeaderSize = (sizeof(CommandStorageHeader) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+    void *takeFreeCommandStorage(size_t size);
+    bool keepFreeCommandStorage(void *block, size_t size);
+
+    std::mutex mtx;
+    std::vector<KernelOperation *> freeKernelOperations;
+    std::vector<SurfaceStorage *> freeSurfaceStorage;
+    // blocks of one command type are recycled, the first command size obtained fixes it
+    std::vector<void *> freeCommandStorage;
+    size_t commandStorageSize = 0;
+};
+} // namespace OCLRT
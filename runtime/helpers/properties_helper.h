@@ -60,6 +60,13 @@ struct TransferProperties {
     void *ptr;
     size_t *retRowPitch;
     size_t *retSlicePitch;
+    // host pitches of read/write image and buffer rect transfers
+    size_t hostRowPitch = 0;
+    size_t hostSlicePitch = 0;
+    // read/write buffer rect transfers, offset holds the buffer origin and size the region
+    const size_t *hostOrigin = nullptr;
+    size_t memObjRowPitch = 0;
+    size_t memObjSlicePitch = 0;
 };
 
 } // namespace OCLRT
@@ -26,14 +26,21 @@
 #include "runtime/command_queue/enqueue_common.h"
 #include "runtime/device/device.h"
 #include "runtime/device_queue/device_queue.h"
+#include "runtime/event/event.h"
 #include "runtime/mem_obj/image.h"
 #include "runtime/memory_manager/surface.h"
 #include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/blocked_commands_pool.h"
+#include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/string.h"
 #include "runtime/helpers/task_information.h"
+#include <chrono>
 
 namespace OCLRT {
 KernelOperation::~KernelOperation() {
+    for (auto surface : pooledSurfaces) {
+        pool->destroySurface(surface);
+    }
     alignedFree(dsh->getBase());
     alignedFree(ish->getBase());
     if (doNotFreeISH) {
@@ -139,11 +146,30 @@ CommandComputeKernel::~CommandComputeKernel() {
     if (kernelOperation->ioh.get() == kernelOperation->dsh.get()) {
         kernelOperation->doNotFreeISH = true;
     }
+    if (kernelOperation->pool) {
+        kernelOperation->pool->returnKernelOperation(kernelOperation.release());
+    }
     if (kernel) {
         kernel->decRefInternal();
     }
 }
 
+void *CommandComputeKernel::operator new(size_t size) {
+    return BlockedCommandsPool::obtainCommandStorage(nullptr, size);
+}
+
+void *CommandComputeKernel::operator new(size_t size, BlockedCommandsPool *pool) {
+    return BlockedCommandsPool::obtainCommandStorage(pool, size);
+}
+
+void CommandComputeKernel::operator delete(void *ptr) {
+    BlockedCommandsPool::releaseCommandStorage(ptr);
+}
+
+void CommandComputeKernel::operator delete(void *ptr, BlockedCommandsPool *pool) {
+    BlockedCommandsPool::releaseCommandStorage(ptr);
+}
+
 CompletionStamp &CommandComputeKernel::submit(uint32_t taskLevel, bool terminated) {
     if (terminated) {
         return completionStamp;
@@ -217,10 +243,12 @@ CompletionStamp &CommandComputeKernel::submit(uint32_t taskLevel, bool terminate
     ssh.getSpace(kernelOperation->ssh->getUsed());
 
     auto requiresCoherency = false;
-    for (auto &surface : surfaces) {
-        DEBUG_BREAK_IF(!surface);
-        surface->makeResident(commandStreamReceiver);
-        requiresCoherency |= surface->IsCoherent;
+    for (auto surfaceList : {&surfaces, &kernelOperation->pooledSurfaces}) {
+        for (auto &surface : *surfaceList) {
+            DEBUG_BREAK_IF(!surface);
+            surface->makeResident(commandStreamReceiver);
+            requiresCoherency |= surface->IsCoherent;
+        }
     }
 
     if (printfHandler) {
@@ -276,10 +304,13 @@ CompletionStamp &CommandComputeKernel::submit(uint32_t taskLevel, bool terminate
                                                       taskLevel,
                                                       dispatchFlags);
 
+    commandQueue.markIndirectHeapsUsedByTask(completionStamp.taskCount);
     commandQueue.waitUntilComplete(completionStamp.taskCount, completionStamp.flushStamp);
 
-    for (auto &surface : surfaces) {
-        surface->setCompletionStamp(completionStamp, nullptr, nullptr);
+    for (auto surfaceList : {&surfaces, &kernelOperation->pooledSurfaces}) {
+        for (auto &surface : *surfaceList) {
+            surface->setCompletionStamp(completionStamp, nullptr, nullptr);
+        }
     }
 
     if (printfHandler) {
@@ -322,4 +353,42 @@ CompletionStamp &CommandMarker::submit(uint32_t taskLevel, bool terminated) {
 
     return completionStamp;
 }
+
+CommandCpuTransfer::CommandCpuTransfer(CommandQueue &cmdQ, Event &transferEvent, MemObj &memObj, bool toMemObj,
+                                       size_t offset, size_t size, void *ptr, uint32_t taskCountToWait, FlushStamp flushStampToWait)
+    : cmdQ(cmdQ), transferEvent(transferEvent), memObj(memObj), toMemObj(toMemObj), offset(offset), size(size), ptr(ptr) {
+    memObj.incRefInternal();
+    completionStamp.taskCount = taskCountToWait;
+    completionStamp.flushStamp = flushStampToWait;
+}
+
+CommandCpuTransfer::~CommandCpuTransfer() {
+    memObj.decRefInternal();
+}
+
+CompletionStamp &CommandCpuTransfer::submit(uint32_t taskLevel, bool terminated) {
+    if (terminated) {
+        return completionStamp;
+    }
+
+    // GPU work enqueued before the transfer
+    if (completionStamp.taskCount != 0) {
+        cmdQ.waitUntilComplete(completionStamp.taskCount, completionStamp.flushStamp);
+    }
+
+    auto transferStart = std::chrono::steady_clock::now();
+    auto memObjPtr = ptrOffset(memObj.getCpuAddressForMemoryTransfer(), offset);
+    if (toMemObj) {
+        memcpy_s(memObjPtr, size, ptr, size);
+    } else {
+        memcpy_s(ptr, size, memObjPtr, size);
+    }
+    auto transferTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - transferStart);
+    cmdQ.getDevice().getTransferPlanner().recordCpuTransfer(size, static_cast<uint64_t>(transferTime.count()));
+
+    // the transfer event has no parents, commands blocked by it continue from the current task level
+    completionStamp.taskLevel = cmdQ.getDevice().getCommandStreamReceiver().peekTaskLevel();
+    transferEvent.taskLevel = completionStamp.taskLevel;
+    return completionStamp;
+}
 } // namespace OCLRT
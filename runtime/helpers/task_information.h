@@ -30,8 +30,10 @@
 #include <vector>
 
 namespace OCLRT {
+class BlockedCommandsPool;
 class CommandQueue;
 class CommandStreamReceiver;
+class Event;
 class Kernel;
 class MemObj;
 class Surface;
@@ -89,6 +91,10 @@ struct KernelOperation {
     size_t instructionHeapSizeEM;
     size_t surfaceStateHeapSizeEM;
     bool doNotFreeISH;
+
+    // set when storage is recycled through the queue's BlockedCommandsPool
+    BlockedCommandsPool *pool = nullptr;
+    std::vector<Surface *> pooledSurfaces;
 };
 
 class CommandComputeKernel : public Command {
@@ -98,6 +104,12 @@ class CommandComputeKernel : public Command {
 
     ~CommandComputeKernel() override;
 
+    // blocked enqueues place the command in their queue's BlockedCommandsPool
+    static void *operator new(size_t size);
+    static void *operator new(size_t size, BlockedCommandsPool *pool);
+    static void operator delete(void *ptr);
+    static void operator delete(void *ptr, BlockedCommandsPool *pool);
+
     CompletionStamp &submit(uint32_t taskLevel, bool terminated) override;
 
     LinearStream *getCommandStream() override {
@@ -131,4 +143,22 @@ class CommandMarker : public Command {
     unsigned int clCommandType;
     unsigned int commandSize;
 };
+
+// copies between a zero-copy buffer and host memory on the CPU, submitted by the queue's CpuTransferWorker
+class CommandCpuTransfer : public Command {
+  public:
+    CommandCpuTransfer(CommandQueue &cmdQ, Event &transferEvent, MemObj &memObj, bool toMemObj,
+                       size_t offset, size_t size, void *ptr, uint32_t taskCountToWait, FlushStamp flushStampToWait);
+    ~CommandCpuTransfer() override;
+    CompletionStamp &submit(uint32_t taskLevel, bool terminated) override;
+
+  private:
+    CommandQueue &cmdQ;
+    Event &transferEvent;
+    MemObj &memObj;
+    bool toMemObj;
+    size_t offset;
+    size_t size;
+    void *ptr;
+};
 } // namespace OCLRT
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/tiling.h"
+#include "runtime/helpers/debug_helpers.h"
+#include "runtime/utilities/cpu_info.h"
+#include <algorithm>
+#include <cstring>
+
+namespace OCLRT {
+
+const size_t TilingHelper::tileSize;
+const size_t TilingHelper::tileXWidth;
+const size_t TilingHelper::tileXHeight;
+const size_t TilingHelper::tileYWidth;
+const size_t TilingHelper::tileYHeight;
+const size_t TilingHelper::tileYColumnWidth;
+
+void (*TilingHelper::swizzleTileYSpan)(const TiledSurface &dst, size_t dstX, size_t dstY,
+                                       const uint8_t *src, size_t srcRowPitch, size_t widthInBytes, size_t height) = OCLRT::swizzleTileYSpan<OWordCopySse4>;
+void (*TilingHelper::unswizzleTileYSpan)(const TiledSurface &src, size_t srcX, size_t srcY,
+                                         uint8_t *dst, size_t dstRowPitch, size_t widthInBytes, size_t height) = OCLRT::unswizzleTileYSpan<OWordCopySse4>;
+
+// Initialize the span copies based on CPU capabilities
+TilingHelper::TilingHelper() {
+    bool supportsAVX2 = CpuInfo::getInstance().isFeatureSupported(CpuInfo::featureAvX2);
+    if (supportsAVX2) {
+        TilingHelper::swizzleTileYSpan = OCLRT::swizzleTileYSpan<OWordCopyAvx2>;
+        TilingHelper::unswizzleTileYSpan = OCLRT::unswizzleTileYSpan<OWordCopyAvx2>;
+    }
+}
+
+TilingHelper TilingHelper::initializer;
+
+size_t TilingHelper::getTileWidth(TileMode tileMode) {
+    switch (tileMode) {
+    case TileMode::TileX:
+        return tileXWidth;
+    case TileMode::TileY:
+        return tileYWidth;
+    default:
+        return 1;
+    }
+}
+
+size_t TilingHelper::getTileHeight(TileMode tileMode) {
+    switch (tileMode) {
+    case TileMode::TileX:
+        return tileXHeight;
+    case TileMode::TileY:
+        return tileYHeight;
+    default:
+        return 1;
+    }
+}
+
+size_t TilingHelper::getTiledOffset(const TiledSurface &surface, size_t x, size_t y) {
+    if (surface.tileMode == TileMode::Linear) {
+        return y * surface.pitch + x;
+    }
+    auto tileWidth = getTileWidth(surface.tileMode);
+    auto tileHeight = getTileHeight(surface.tileMode);
+    DEBUG_BREAK_IF(surface.pitch % tileWidth != 0);
+
+    auto tilesPerRow = surface.pitch / tileWidth;
+    auto tileBase = ((y / tileHeight) * tilesPerRow + (x / tileWidth)) * tileSize;
+    auto xInTile = x % tileWidth;
+    auto yInTile = y % tileHeight;
+
+    if (surface.tileMode == TileMode::TileX) {
+        return tileBase + yInTile * tileXWidth + xInTile;
+    }
+    return tileBase + (xInTile / tileYColumnWidth) * (tileYHeight * tileYColumnWidth) +
+           yInTile * tileYColumnWidth + (xInTile % tileYColumnWidth);
+}
+
+void TilingHelper::swizzle(const TiledSurface &dst, size_t dstX, size_t dstY,
+                           const void *src, size_t srcRowPitch, size_t widthInBytes, size_t height) {
+    auto srcBytes = reinterpret_cast<const uint8_t *>(src);
+    auto dstBase = reinterpret_cast<uint8_t *>(dst.base);
+
+    if (dst.tileMode == TileMode::TileY) {
+        swizzleTileYSpan(dst, dstX, dstY, srcBytes, srcRowPitch, widthInBytes, height);
+        return;
+    }
+
+    // X-tile rows are contiguous up to the tile width
+    auto spanWidth = dst.tileMode == TileMode::TileX ? tileXWidth : dst.pitch;
+    for (size_t row = 0; row < height; row++) {
+        auto srcRow = srcBytes + row * srcRowPitch;
+        for (size_t x = dstX; x < dstX + widthInBytes;) {
+            auto segmentEnd = std::min((x / spanWidth + 1) * spanWidth, dstX + widthInBytes);
+            memcpy(dstBase + getTiledOffset(dst, x, dstY + row), srcRow + (x - dstX), segmentEnd - x);
+            x = segmentEnd;
+        }
+    }
+}
+
+void TilingHelper::unswizzle(const TiledSurface &src, size_t srcX, size_t srcY,
+                             void *dst, size_t dstRowPitch, size_t widthInBytes, size_t height) {
+    auto dstBytes = reinterpret_cast<uint8_t *>(dst);
+    auto srcBase = reinterpret_cast<const uint8_t *>(src.base);
+
+    if (src.tileMode == TileMode::TileY) {
+        unswizzleTileYSpan(src, srcX, srcY, dstBytes, dstRowPitch, widthInBytes, height);
+        return;
+    }
+
+    auto spanWidth = src.tileMode == TileMode::TileX ? tileXWidth : src.pitch;
+    for (size_t row = 0; row < height; row++) {
+        auto dstRow = dstBytes + row * dstRowPitch;
+        for (size_t x = srcX; x < srcX + widthInBytes;) {
+            auto segmentEnd = std::min((x / spanWidth + 1) * spanWidth, srcX + widthInBytes);
+            memcpy(dstRow + (x - srcX), srcBase + getTiledOffset(src, x, srcY + row), segmentEnd - x);
+            x = segmentEnd;
+        }
+    }
+}
+} // namespace OCLRT
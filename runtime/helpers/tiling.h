@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace OCLRT {
+
+enum class TileMode : uint32_t {
+    Linear,
+    TileX,
+    TileY
+};
+
+// CPU view of a tiled surface. Tiles are 4KB and laid out row-major with
+// the surface pitch; X tiles are 512B x 8 rows stored row by row, Y tiles
+// are 128B x 32 rows stored as eight 16B-wide columns.
+struct TiledSurface {
+    void *base;
+    size_t pitch;
+    TileMode tileMode;
+};
+
+struct TilingHelper {
+    static const size_t tileSize = 4096;
+    static const size_t tileXWidth = 512;
+    static const size_t tileXHeight = 8;
+    static const size_t tileYWidth = 128;
+    static const size_t tileYHeight = 32;
+    static const size_t tileYColumnWidth = 16;
+
+    static size_t getTileWidth(TileMode tileMode);
+    static size_t getTileHeight(TileMode tileMode);
+    static size_t getTiledOffset(const TiledSurface &surface, size_t x, size_t y);
+
+    // Copies a widthInBytes x height region between linear memory and a
+    // tiled surface; x is in bytes, y in rows of the tiled surface
+    static void swizzle(const TiledSurface &dst, size_t dstX, size_t dstY,
+                        const void *src, size_t srcRowPitch, size_t widthInBytes, size_t height);
+    static void unswizzle(const TiledSurface &src, size_t srcX, size_t srcY,
+                          void *dst, size_t dstRowPitch, size_t widthInBytes, size_t height);
+
+    // Y-tile span copies; selected at startup based on CpuInfo
+    static void (*swizzleTileYSpan)(const TiledSurface &dst, size_t dstX, size_t dstY,
+                                    const uint8_t *src, size_t srcRowPitch, size_t widthInBytes, size_t height);
+    static void (*unswizzleTileYSpan)(const TiledSurface &src, size_t srcX, size_t srcY,
+                                      uint8_t *dst, size_t dstRowPitch, size_t widthInBytes, size_t height);
+
+    static TilingHelper initializer;
+
+  private:
+    TilingHelper();
+};
+
+template <typename OWordCopy>
+void swizzleTileYSpan(const TiledSurface &dst, size_t dstX, size_t dstY,
+                      const uint8_t *src, size_t srcRowPitch, size_t widthInBytes, size_t height);
+template <typename OWordCopy>
+void unswizzleTileYSpan(const TiledSurface &src, size_t srcX, size_t srcY,
+                        uint8_t *dst, size_t dstRowPitch, size_t widthInBytes, size_t height);
+
+struct OWordCopySse4;
+struct OWordCopyAvx2;
+} // namespace OCLRT
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/tiling.h"
+#include <algorithm>
+#include <cstring>
+
+namespace OCLRT {
+
+// OWordCopy provides copyRow (one 16B row) and copyRows (rowsPerStep
+// vertically adjacent 16B rows, contiguous on the tiled side)
+template <typename OWordCopy>
+void swizzleTileYSpan(const TiledSurface &dst, size_t dstX, size_t dstY,
+                      const uint8_t *src, size_t srcRowPitch, size_t widthInBytes, size_t height) {
+    auto dstBase = reinterpret_cast<uint8_t *>(dst.base);
+    const size_t columnWidth = TilingHelper::tileYColumnWidth;
+
+    for (size_t row = 0; row < height;) {
+        auto y = dstY + row;
+        auto rowsLeftInTile = TilingHelper::tileYHeight - (y % TilingHelper::tileYHeight);
+        auto step = std::min(std::min(rowsLeftInTile, height - row), OWordCopy::rowsPerStep);
+        auto srcRow = src + row * srcRowPitch;
+
+        for (size_t x = dstX; x < dstX + widthInBytes;) {
+            auto segmentEnd = std::min((x / columnWidth + 1) * columnWidth, dstX + widthInBytes);
+            auto length = segmentEnd - x;
+            auto tiled = dstBase + TilingHelper::getTiledOffset(dst, x, y);
+            auto linear = srcRow + (x - dstX);
+
+            if (length == columnWidth && step == OWordCopy::rowsPerStep) {
+                OWordCopy::copyRows(tiled, columnWidth, linear, srcRowPitch);
+            } else {
+                for (size_t i = 0; i < step; i++) {
+                    if (length == columnWidth) {
+                        OWordCopy::copyRow(tiled + i * columnWidth, linear + i * srcRowPitch);
+                    } else {
+                        memcpy(tiled + i * columnWidth, linear + i * srcRowPitch, length);
+                    }
+                }
+            }
+            x = segmentEnd;
+        }
+        row += step;
+    }
+}
+
+template <typename OWordCopy>
+void unswizzleTileYSpan(const TiledSurface &src, size_t srcX, size_t srcY,
+                        uint8_t *dst, size_t dstRowPitch, size_t widthInBytes, size_t height) {
+    auto srcBase = reinterpret_cast<const uint8_t *>(src.base);
+    const size_t columnWidth = TilingHelper::tileYColumnWidth;
+
+    for (size_t row = 0; row < height;) {
+        auto y = srcY + row;
+        auto rowsLeftInTile = TilingHelper::tileYHeight - (y % TilingHelper::tileYHeight);
+        auto step = std::min(std::min(rowsLeftInTile, height - row), OWordCopy::rowsPerStep);
+        auto dstRow = dst + row * dstRowPitch;
+
+        for (size_t x = srcX; x < srcX + widthInBytes;) {
+            auto segmentEnd = std::min((x / columnWidth + 1) * columnWidth, srcX + widthInBytes);
+            auto length = segmentEnd - x;
+            auto tiled = srcBase + TilingHelper::getTiledOffset(src, x, y);
+            auto linear = dstRow + (x - srcX);
+
+            if (length == columnWidth && step == OWordCopy::rowsPerStep) {
+                OWordCopy::copyRows(linear, dstRowPitch, tiled, columnWidth);
+            } else {
+                for (size_t i = 0; i < step; i++) {
+                    if (length == columnWidth) {
+                        OWordCopy::copyRow(linear + i * dstRowPitch, tiled + i * columnWidth);
+                    } else {
+                        memcpy(linear + i * dstRowPitch, tiled + i * columnWidth, length);
+                    }
+                }
+            }
+            x = segmentEnd;
+        }
+        row += step;
+    }
+}
+} // namespace OCLRT
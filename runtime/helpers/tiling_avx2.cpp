@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if __AVX2__
+#include "runtime/helpers/tiling.inl"
+#include <immintrin.h>
+
+namespace OCLRT {
+
+// Two vertically adjacent rows of a Y-tile OWord column are contiguous in
+// memory, so a row pair moves as a single 32B access on the tiled side
+struct OWordCopyAvx2 {
+    static const size_t rowsPerStep = 2;
+
+    static inline void copyRow(uint8_t *dst, const uint8_t *src) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
+    }
+
+    static inline void copyRows(uint8_t *dst, size_t dstPitch, const uint8_t *src, size_t srcPitch) {
+        __m256i pair;
+        if (srcPitch == TilingHelper::tileYColumnWidth) {
+            pair = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+        } else {
+            auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+            auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + srcPitch));
+            pair = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        }
+        if (dstPitch == TilingHelper::tileYColumnWidth) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), pair);
+        } else {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm256_castsi256_si128(pair));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + dstPitch), _mm256_extracti128_si256(pair, 1));
+        }
+    }
+};
+
+const size_t OWordCopyAvx2::rowsPerStep;
+
+template void swizzleTileYSpan<OWordCopyAvx2>(const TiledSurface &dst, size_t dstX, size_t dstY,
+                                              const uint8_t *src, size_t srcRowPitch, size_t widthInBytes, size_t height);
+template void unswizzleTileYSpan<OWordCopyAvx2>(const TiledSurface &src, size_t srcX, size_t srcY,
+                                                uint8_t *dst, size_t dstRowPitch, size_t widthInBytes, size_t height);
+} // namespace OCLRT
+#endif
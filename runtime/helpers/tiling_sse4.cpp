@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/tiling.inl"
+#include <immintrin.h>
+
+namespace OCLRT {
+
+struct OWordCopySse4 {
+    static const size_t rowsPerStep = 1;
+
+    static inline void copyRow(uint8_t *dst, const uint8_t *src) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
+    }
+
+    static inline void copyRows(uint8_t *dst, size_t dstPitch, const uint8_t *src, size_t srcPitch) {
+        copyRow(dst, src);
+    }
+};
+
+const size_t OWordCopySse4::rowsPerStep;
+
+template void swizzleTileYSpan<OWordCopySse4>(const TiledSurface &dst, size_t dstX, size_t dstY,
+                                              const uint8_t *src, size_t srcRowPitch, size_t widthInBytes, size_t height);
+template void unswizzleTileYSpan<OWordCopySse4>(const TiledSurface &src, size_t srcX, size_t srcY,
+                                                uint8_t *dst, size_t dstRowPitch, size_t widthInBytes, size_t height);
+} // namespace OCLRT
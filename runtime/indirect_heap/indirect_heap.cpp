@@ -21,6 +21,7 @@
  */
 
 #include "indirect_heap.h"
+#include <algorithm>
 
 namespace OCLRT {
 
@@ -29,4 +30,53 @@ IndirectHeap::IndirectHeap(GraphicsAllocation *gfxAllocation) : BaseClass(gfxAll
 
 IndirectHeap::IndirectHeap(void *buffer, size_t bufferSize) : BaseClass(buffer, bufferSize) {
 }
+
+void IndirectHeap::markUsedByTask(uint32_t taskCount) {
+    if (!usageTracked) {
+        return;
+    }
+    if (sizeUsed < markedOffset) {
+        markedOffset = 0;
+    }
+    if (sizeUsed > markedOffset) {
+        inFlightRanges.push_back({markedOffset, sizeUsed, taskCount});
+        markedOffset = sizeUsed;
+    }
+}
+
+void IndirectHeap::reclaimCompletedUsage(uint32_t completedTaskCount) {
+    while (!inFlightRanges.empty() && inFlightRanges.front().taskCount <= completedTaskCount) {
+        inFlightRanges.pop_front();
+    }
+}
+
+uint32_t IndirectHeap::getTaskCountToReuse(size_t size) const {
+    uint32_t taskCountToReuse = 0;
+    if (size == 0) {
+        return taskCountToReuse;
+    }
+    // Ranges of the current lap all end at or below sizeUsed, so only data left
+    // over from the previous lap can overlap the requested space.
+    size_t requestedStart = sizeUsed;
+    size_t requestedEnd = requestedStart + size;
+    for (auto &range : inFlightRanges) {
+        if (range.start < requestedEnd && range.end > requestedStart) {
+            taskCountToReuse = std::max(taskCountToReuse, range.taskCount);
+        }
+    }
+    return taskCountToReuse;
+}
+
+void IndirectHeap::rewind(uint32_t pendingTaskCount, size_t startOffset) {
+    DEBUG_BREAK_IF(!usageTracked || startOffset > maxAvailableSpace);
+    // Anything written since the last flush belongs to the task being built.
+    markUsedByTask(pendingTaskCount);
+    sizeUsed = startOffset;
+    markedOffset = startOffset;
+}
+
+void IndirectHeap::resetUsageTracking() {
+    inFlightRanges.clear();
+    markedOffset = 0;
+}
 }
@@ -25,6 +25,8 @@
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/basic_math.h"
+#include <cstdint>
+#include <deque>
 
 namespace OCLRT {
 class GraphicsAllocation;
@@ -54,6 +56,29 @@ class IndirectHeap : public LinearStream {
     IndirectHeap &operator=(const IndirectHeap &) = delete;
 
     void align(size_t alignment);
+
+    // Ring reuse of a fixed-base heap. Space consumed since the previous flush is
+    // tagged with the submitting task count and reclaimed when that task completes,
+    // so the heap can wrap without changing its base address.
+    void enableUsageTracking() { usageTracked = true; }
+    bool isUsageTracked() const { return usageTracked; }
+    void markUsedByTask(uint32_t taskCount);
+    void reclaimCompletedUsage(uint32_t completedTaskCount);
+    uint32_t getTaskCountToReuse(size_t size) const;
+    void rewind(uint32_t pendingTaskCount, size_t startOffset);
+    void resetUsageTracking();
+    size_t peekInFlightRangesCount() const { return inFlightRanges.size(); }
+
+  protected:
+    struct UsedRange {
+        size_t start;
+        size_t end;
+        uint32_t taskCount;
+    };
+
+    std::deque<UsedRange> inFlightRanges;
+    size_t markedOffset = 0;
+    bool usageTracked = false;
 };
 
 inline void IndirectHeap::align(size_t alignment) {
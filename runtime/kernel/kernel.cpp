@@ -32,12 +32,14 @@
 #include "runtime/execution_model/device_enqueue.h"
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/helpers/basic_math.h"
+#include "runtime/helpers/blocked_commands_pool.h"
 #include "runtime/helpers/debug_helpers.h"
 #include "runtime/helpers/get_info.h"
 #include "runtime/helpers/hw_helper.h"
 #include "runtime/helpers/per_thread_data.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/sampler_helpers.h"
+#include "runtime/kernel/kernel_template.h"
 #include "runtime/mem_obj/buffer.h"
 #include "runtime/mem_obj/image.h"
 #include "runtime/mem_obj/pipe.h"
@@ -113,10 +115,8 @@ Kernel::~Kernel() {
     crossThreadData = nullptr;
     crossThreadDataSize = 0;
 
-    if (privateSurface) {
-        device.getMemoryManager()->checkGpuUsageAndDestroyGraphicsAllocations(privateSurface);
-        privateSurface = nullptr;
-    }
+    // private surface is owned by the command stream receiver pool
+    privateSurface = nullptr;
 
     if (kernelReflectionSurface) {
         device.getMemoryManager()->freeGraphicsMemory(kernelReflectionSurface);
@@ -255,7 +255,10 @@ cl_int Kernel::initialize() {
             privateSurfaceSize *= device.getDeviceInfo().computeUnitsUsedForScratch * getKernelInfo().getMaxSimdSize();
             DEBUG_BREAK_IF(privateSurfaceSize == 0);
 
-            privateSurface = device.getMemoryManager()->createGraphicsAllocationWithRequiredBitness(privateSurfaceSize, nullptr);
+            {
+                TakeOwnershipWrapper<const Device> deviceOwnership(device);
+                privateSurface = device.getCommandStreamReceiver().obtainPrivateSurface(privateSurfaceSize);
+            }
             if (privateSurface == nullptr) {
                 retVal = CL_OUT_OF_RESOURCES;
                 break;
@@ -306,37 +309,24 @@ cl_int Kernel::initialize() {
         auto numArgs = kernelInfo.kernelArgInfo.size();
         kernelArguments.resize(numArgs);
         slmSizes.resize(numArgs);
-        kernelArgHandlers.resize(numArgs);
+
+        // kernels created from a built program reuse the handlers resolved once per kernel info
+        auto kernelTemplate = kernelInfo.kernelTemplate;
+        if (kernelTemplate && kernelTemplate->argHandlers.size() == numArgs) {
+            kernelArgHandlers = kernelTemplate->argHandlers;
+        } else {
+            kernelTemplate = nullptr;
+            kernelArgHandlers.resize(numArgs);
+        }
 
         for (uint32_t i = 0; i < numArgs; ++i) {
             storeKernelArg(i, NONE_OBJ, nullptr, nullptr, 0);
             slmSizes[i] = 0;
 
-            // set the argument handler
-            auto &argInfo = kernelInfo.kernelArgInfo[i];
-            if (argInfo.addressQualifier == CL_KERNEL_ARG_ADDRESS_LOCAL) {
-                kernelArgHandlers[i] = &Kernel::setArgLocal;
-            } else if (argInfo.isAccelerator) {
-                kernelArgHandlers[i] = &Kernel::setArgAccelerator;
-            } else if (argInfo.typeQualifierStr.find("pipe") != std::string::npos) {
-                kernelArgHandlers[i] = &Kernel::setArgPipe;
-                kernelArguments[i].type = PIPE_OBJ;
-            } else if ((argInfo.typeStr.find("*") != std::string::npos) || argInfo.isBuffer) {
-                kernelArgHandlers[i] = &Kernel::setArgBuffer;
-                kernelArguments[i].type = BUFFER_OBJ;
-            } else if (argInfo.isImage) {
-                kernelArgHandlers[i] = &Kernel::setArgImage;
-                kernelArguments[i].type = IMAGE_OBJ;
-                DEBUG_BREAK_IF(argInfo.typeStr.find("image") == std::string::npos);
-            } else if (argInfo.isSampler) {
-                kernelArgHandlers[i] = &Kernel::setArgSampler;
-                kernelArguments[i].type = SAMPLER_OBJ;
-                DEBUG_BREAK_IF(!(*argInfo.typeStr.c_str() == '\0' || argInfo.typeStr.find("sampler") != std::string::npos));
-            } else if (argInfo.isDeviceQueue) {
-                kernelArgHandlers[i] = &Kernel::setArgDevQueue;
-                kernelArguments[i].type = DEVICE_QUEUE_OBJ;
+            if (kernelTemplate) {
+                kernelArguments[i].type = kernelTemplate->argTypes[i];
             } else {
-                kernelArgHandlers[i] = &Kernel::setArgImmediate;
+                resolveArgHandler(kernelInfo.kernelArgInfo[i], kernelArgHandlers[i], kernelArguments[i].type);
             }
         }
 
@@ -351,6 +341,33 @@ cl_int Kernel::initialize() {
     return retVal;
 }
 
+void Kernel::resolveArgHandler(const KernelArgInfo &argInfo, KernelArgHandler &handler, kernelArgType &type) {
+    if (argInfo.addressQualifier == CL_KERNEL_ARG_ADDRESS_LOCAL) {
+        handler = &Kernel::setArgLocal;
+    } else if (argInfo.isAccelerator) {
+        handler = &Kernel::setArgAccelerator;
+    } else if (argInfo.typeQualifierStr.find("pipe") != std::string::npos) {
+        handler = &Kernel::setArgPipe;
+        type = PIPE_OBJ;
+    } else if ((argInfo.typeStr.find("*") != std::string::npos) || argInfo.isBuffer) {
+        handler = &Kernel::setArgBuffer;
+        type = BUFFER_OBJ;
+    } else if (argInfo.isImage) {
+        handler = &Kernel::setArgImage;
+        type = IMAGE_OBJ;
+        DEBUG_BREAK_IF(argInfo.typeStr.find("image") == std::string::npos);
+    } else if (argInfo.isSampler) {
+        handler = &Kernel::setArgSampler;
+        type = SAMPLER_OBJ;
+        DEBUG_BREAK_IF(!(*argInfo.typeStr.c_str() == '\0' || argInfo.typeStr.find("sampler") != std::string::npos));
+    } else if (argInfo.isDeviceQueue) {
+        handler = &Kernel::setArgDevQueue;
+        type = DEVICE_QUEUE_OBJ;
+    } else {
+        handler = &Kernel::setArgImmediate;
+    }
+}
+
 cl_int Kernel::cloneKernel(Kernel *pSourceKernel) {
     // copy cross thread data to store arguments set to source kernel with clSetKernelArg on immediate data (non-pointer types)
     memcpy_s(crossThreadData, crossThreadDataSize, pSourceKernel->crossThreadData, pSourceKernel->crossThreadDataSize);
@@ -385,7 +402,7 @@ cl_int Kernel::cloneKernel(Kernel *pSourceKernel) {
 
     // copy additional information other than argument values set to source kernel with clSetKernelExecInfo
     for (auto gfxAlloc : pSourceKernel->kernelSvmGfxAllocations) {
-        kernelSvmGfxAllocations.push_back(gfxAlloc);
+        setKernelExecInfo(gfxAlloc);
     }
 
     return CL_SUCCESS;
@@ -853,6 +870,7 @@ void Kernel::storeKernelArg(uint32_t argIndex, kernelArgType argType, const void
     kernelArguments[argIndex].size = argSize;
     kernelArguments[argIndex].pSvmAlloc = argSvmAlloc;
     kernelArguments[argIndex].svmFlags = argSvmFlags;
+    invalidateResolvedResidency();
 }
 
 const void *Kernel::getKernelArg(uint32_t argIndex) const {
@@ -865,50 +883,61 @@ const Kernel::SimpleKernelArgInfo &Kernel::getKernelArgInfo(uint32_t argIndex) c
 
 void Kernel::setKernelExecInfo(GraphicsAllocation *argValue) {
     kernelSvmGfxAllocations.push_back(argValue);
+    invalidateResolvedResidency();
 }
 
 void Kernel::clearKernelExecInfo() {
     kernelSvmGfxAllocations.clear();
+    invalidateResolvedResidency();
 }
 
-inline void Kernel::makeArgsResident(CommandStreamReceiver &commandStreamReceiver) {
+const std::vector<Kernel::ResolvedResidencyEntry> &Kernel::getResolvedResidency() {
+    if (resolvedResidencyValid) {
+        return resolvedResidency;
+    }
+
+    resolvedResidency.clear();
+    for (auto gfxAlloc : kernelSvmGfxAllocations) {
+        resolvedResidency.push_back({gfxAlloc, nullptr});
+    }
 
     auto numArgs = kernelInfo.kernelArgInfo.size();
     for (decltype(numArgs) argIndex = 0; argIndex < numArgs; argIndex++) {
         if (kernelArguments[argIndex].object) {
             if (kernelArguments[argIndex].type == SVM_ALLOC_OBJ) {
                 auto pSVMAlloc = (GraphicsAllocation *)kernelArguments[argIndex].object;
-                commandStreamReceiver.makeResident(*pSVMAlloc);
+                resolvedResidency.push_back({pSVMAlloc, nullptr});
             } else if (Kernel::isMemObj(kernelArguments[argIndex].type)) {
                 auto clMem = (const cl_mem)kernelArguments[argIndex].object;
                 auto memObj = castToObjectOrAbort<MemObj>(clMem);
                 DEBUG_BREAK_IF(memObj == nullptr);
-                if (memObj->isImageFromImage()) {
-                    commandStreamReceiver.setSamplerCacheFlushRequired(CommandStreamReceiver::SamplerCacheFlushState::samplerCacheFlushBefore);
-                }
-                commandStreamReceiver.makeResident(*memObj->getGraphicsAllocation());
-                if (memObj->getMcsAllocation()) {
-                    commandStreamReceiver.makeResident(*memObj->getMcsAllocation());
-                }
+                resolvedResidency.push_back({nullptr, memObj});
             }
         }
     }
+    resolvedResidencyValid = true;
+    return resolvedResidency;
 }
 
 void Kernel::updateWithCompletionStamp(CommandStreamReceiver &commandStreamReceiver, CompletionStamp *completionStamp) {
-    auto numArgs = kernelInfo.kernelArgInfo.size();
-    for (decltype(numArgs) argIndex = 0; argIndex < numArgs; argIndex++) {
-        if (kernelArguments[argIndex].object) {
-            if (Kernel::isMemObj(kernelArguments[argIndex].type)) {
-                auto clMem = (const cl_mem)kernelArguments[argIndex].object;
-                auto memObj = castToObjectOrAbort<MemObj>(clMem);
-                DEBUG_BREAK_IF(memObj == nullptr);
-                memObj->setCompletionStamp(*completionStamp, nullptr, nullptr);
-            }
+    for (auto &entry : getResolvedResidency()) {
+        if (entry.memObj) {
+            entry.memObj->setCompletionStamp(*completionStamp, nullptr, nullptr);
         }
     }
 }
 
+void Kernel::patchPrivateSurface(GraphicsAllocation &pooledSurface) {
+    const auto &patch = kernelInfo.patchInfo.pAllocateStatelessPrivateSurface;
+    if (privateSurfaceSize == 0 || patch == nullptr) {
+        return;
+    }
+
+    DEBUG_BREAK_IF(pooledSurface.getUnderlyingBufferSize() < privateSurfaceSize);
+    privateSurface = &pooledSurface;
+    patchWithImplicitSurface(reinterpret_cast<void *>(privateSurface->getGpuAddressToPatch()), *privateSurface, *patch);
+}
+
 void Kernel::makeResident(CommandStreamReceiver &commandStreamReceiver) {
     if (privateSurface) {
         commandStreamReceiver.makeResident(*privateSurface);
@@ -922,46 +951,48 @@ void Kernel::makeResident(CommandStreamReceiver &commandStreamReceiver) {
         commandStreamReceiver.makeResident(*(program->getGlobalSurface()));
     }
 
-    for (auto gfxAlloc : kernelSvmGfxAllocations) {
-        commandStreamReceiver.makeResident(*gfxAlloc);
+    for (auto &entry : getResolvedResidency()) {
+        if (entry.memObj) {
+            if (entry.memObj->isImageFromImage()) {
+                commandStreamReceiver.setSamplerCacheFlushRequired(CommandStreamReceiver::SamplerCacheFlushState::samplerCacheFlushBefore);
+            }
+            commandStreamReceiver.makeResident(*entry.memObj->getGraphicsAllocation());
+            if (entry.memObj->getMcsAllocation()) {
+                commandStreamReceiver.makeResident(*entry.memObj->getMcsAllocation());
+            }
+        } else {
+            commandStreamReceiver.makeResident(*entry.graphicsAllocation);
+        }
     }
+}
 
-    makeArgsResident(commandStreamReceiver);
+template <typename SurfaceType, typename... Args>
+static Surface *createResidencySurface(BlockedCommandsPool *surfacesPool, Args &&... args) {
+    if (surfacesPool) {
+        return surfacesPool->createSurface<SurfaceType>(std::forward<Args>(args)...);
+    }
+    return new SurfaceType(std::forward<Args>(args)...);
 }
 
-void Kernel::getResidency(std::vector<Surface *> &dst) {
+void Kernel::getResidency(std::vector<Surface *> &dst, BlockedCommandsPool *surfacesPool) {
     if (privateSurface) {
-        GeneralSurface *surface = new GeneralSurface(privateSurface);
-        dst.push_back(surface);
+        // keeps the pooled surface alive even if the pool grows before the blocked command is submitted
+        dst.push_back(createResidencySurface<PrivateSurface>(surfacesPool, privateSurface, device.getCommandStreamReceiver()));
     }
 
     if (program->getConstantSurface()) {
-        GeneralSurface *surface = new GeneralSurface(program->getConstantSurface());
-        dst.push_back(surface);
+        dst.push_back(createResidencySurface<GeneralSurface>(surfacesPool, program->getConstantSurface()));
     }
 
     if (program->getGlobalSurface()) {
-        GeneralSurface *surface = new GeneralSurface(program->getGlobalSurface());
-        dst.push_back(surface);
-    }
-
-    for (auto gfxAlloc : kernelSvmGfxAllocations) {
-        GeneralSurface *surface = new GeneralSurface(gfxAlloc);
-        dst.push_back(surface);
+        dst.push_back(createResidencySurface<GeneralSurface>(surfacesPool, program->getGlobalSurface()));
     }
 
-    auto numArgs = kernelInfo.kernelArgInfo.size();
-    for (decltype(numArgs) argIndex = 0; argIndex < numArgs; argIndex++) {
-        if (kernelArguments[argIndex].object) {
-            if (kernelArguments[argIndex].type == SVM_ALLOC_OBJ) {
-                auto pSVMAlloc = (GraphicsAllocation *)kernelArguments[argIndex].object;
-                dst.push_back(new GeneralSurface(pSVMAlloc));
-            } else if (Kernel::isMemObj(kernelArguments[argIndex].type)) {
-                auto clMem = (const cl_mem)kernelArguments[argIndex].object;
-                auto memObj = castToObject<MemObj>(clMem);
-                DEBUG_BREAK_IF(memObj == nullptr);
-                dst.push_back(new MemObjSurface(memObj));
-            }
+    for (auto &entry : getResolvedResidency()) {
+        if (entry.memObj) {
+            dst.push_back(createResidencySurface<MemObjSurface>(surfacesPool, entry.memObj));
+        } else {
+            dst.push_back(createResidencySurface<GeneralSurface>(surfacesPool, entry.graphicsAllocation));
         }
     }
 }
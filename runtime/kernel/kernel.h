@@ -31,8 +31,10 @@
 #include <vector>
 
 namespace OCLRT {
+class BlockedCommandsPool;
 struct CompletionStamp;
 class GraphicsAllocation;
+class MemObj;
 class Surface;
 class PrintfHandler;
 
@@ -225,6 +227,7 @@ class Kernel : public BaseObject<_cl_kernel> {
 
     // Handlers
     void setKernelArgHandler(uint32_t argIndex, KernelArgHandler handler);
+    static void resolveArgHandler(const KernelArgInfo &argInfo, KernelArgHandler &handler, kernelArgType &type);
 
     void unsetArg(uint32_t argIndex);
 
@@ -275,8 +278,11 @@ class Kernel : public BaseObject<_cl_kernel> {
 
     //residency for kernel surfaces
     void makeResident(CommandStreamReceiver &commandStreamReceiver);
+    // the pool may have been grown for another kernel since this one was patched
+    void patchPrivateSurface(GraphicsAllocation &pooledSurface);
+    uint32_t getPrivateSurfaceSize() const { return privateSurfaceSize; }
     void updateWithCompletionStamp(CommandStreamReceiver &commandStreamReceiver, CompletionStamp *completionStamp);
-    void getResidency(std::vector<Surface *> &dst);
+    void getResidency(std::vector<Surface *> &dst, BlockedCommandsPool *surfacesPool = nullptr);
     bool requiresCoherency();
     void resetSharedObjectsPatchAddresses();
     bool isUsingSharedObjArgs() { return usingSharedObjArgs; }
@@ -411,7 +417,13 @@ class Kernel : public BaseObject<_cl_kernel> {
     };
 
   protected:
-    void makeArgsResident(CommandStreamReceiver &commandStreamReceiver);
+    struct ResolvedResidencyEntry {
+        GraphicsAllocation *graphicsAllocation; // exec info or svm alloc argument
+        MemObj *memObj;                         // buffer, image or pipe argument
+    };
+
+    const std::vector<ResolvedResidencyEntry> &getResolvedResidency();
+    void invalidateResolvedResidency() { resolvedResidencyValid = false; }
 
     void *patchBufferOffset(const KernelArgInfo &argInfo, void *svmPtr, GraphicsAllocation *svmAlloc);
 
@@ -447,5 +459,9 @@ class Kernel : public BaseObject<_cl_kernel> {
 
     bool usingSharedObjArgs;
     uint32_t patchedArgumentsNum = 0;
+
+    // exec info allocations followed by argument objects, resolved once per argument change
+    std::vector<ResolvedResidencyEntry> resolvedResidency;
+    bool resolvedResidencyValid = false;
 };
 } // namespace OCLRT
@@ -313,12 +313,37 @@ size_t Buffer::calculateHostPtrSize(const size_t *origin, const size_t *region,
     return hostPtrSize;
 }
 
+void Buffer::transferRectOnCpu(void *hostPtr, const size_t *bufferOrigin, const size_t *hostOrigin, const size_t *region,
+                               size_t bufferRowPitch, size_t bufferSlicePitch, size_t hostRowPitch, size_t hostSlicePitch, bool toBuffer) {
+    auto bufferPtr = getCpuAddressForMemoryTransfer();
+    for (size_t z = 0; z < region[2]; z++) {
+        for (size_t y = 0; y < region[1]; y++) {
+            auto bufferRow = ptrOffset(bufferPtr, (bufferOrigin[2] + z) * bufferSlicePitch + (bufferOrigin[1] + y) * bufferRowPitch + bufferOrigin[0]);
+            auto hostRow = ptrOffset(hostPtr, (hostOrigin[2] + z) * hostSlicePitch + (hostOrigin[1] + y) * hostRowPitch + hostOrigin[0]);
+            if (toBuffer) {
+                memcpy_s(bufferRow, region[0], hostRow, region[0]);
+            } else {
+                memcpy_s(hostRow, region[0], bufferRow, region[0]);
+            }
+        }
+    }
+}
+
+bool Buffer::isReadWriteOnCpuPossible(cl_bool blocking, cl_uint numEventsInWaitList) {
+    return (blocking == CL_TRUE && numEventsInWaitList == 0 && !forceDisallowCPUCopy) && graphicsAllocation->peekSharedHandle() == 0;
+}
+
 bool Buffer::isReadWriteOnCpuAllowed(cl_bool blocking, cl_uint numEventsInWaitList, void *ptr, size_t size) {
-    return (blocking == CL_TRUE && numEventsInWaitList == 0 && !forceDisallowCPUCopy) && graphicsAllocation->peekSharedHandle() == 0 &&
+    return isReadWriteOnCpuPossible(blocking, numEventsInWaitList) &&
            (isMemObjZeroCopy() || (reinterpret_cast<uintptr_t>(ptr) & (MemoryConstants::cacheLineSize - 1)) != 0) &&
            (!context->getDevice(0)->getDeviceInfo().platformLP || (size <= maxBufferSizeForReadWriteOnCpu));
 }
 
+bool Buffer::isAsyncReadWriteOnCpuPossible(cl_bool blocking) {
+    return DebugManager.flags.EnableAsyncCpuTransfers.get() && blocking == CL_FALSE && isMemObjZeroCopy() &&
+           !forceDisallowCPUCopy && graphicsAllocation->peekSharedHandle() == 0;
+}
+
 Buffer *Buffer::createBufferHw(Context *context,
                                cl_mem_flags flags,
                                size_t size,
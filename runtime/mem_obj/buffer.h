@@ -25,6 +25,10 @@
 #include "runtime/mem_obj/mem_obj.h"
 #include "runtime/helpers/basic_math.h"
 #include "igfxfmid.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace OCLRT {
 class Buffer;
@@ -103,7 +107,12 @@ class Buffer : public MemObj {
     void transferDataToHostPtr(std::array<size_t, 3> copySize, std::array<size_t, 3> copyOffset) override;
     void transferDataFromHostPtr(std::array<size_t, 3> copySize, std::array<size_t, 3> copyOffset) override;
 
+    void transferRectOnCpu(void *hostPtr, const size_t *bufferOrigin, const size_t *hostOrigin, const size_t *region,
+                           size_t bufferRowPitch, size_t bufferSlicePitch, size_t hostRowPitch, size_t hostSlicePitch, bool toBuffer);
+
+    bool isReadWriteOnCpuPossible(cl_bool blocking, cl_uint numEventsInWaitList);
     bool isReadWriteOnCpuAllowed(cl_bool blocking, cl_uint numEventsInWaitList, void *ptr, size_t size);
+    bool isAsyncReadWriteOnCpuPossible(cl_bool blocking);
 
   protected:
     Buffer(Context *context,
@@ -146,6 +155,7 @@ class BufferHw : public Buffer {
                  zeroCopy, isHostPtrSVM, isObjectRedescribed) {}
 
     void setArgStateful(void *memory) override;
+    static void encodeSurfaceState(void *memory, uint64_t bufferAddress, size_t bufferSize, size_t surfaceSize, cl_mem_flags flags);
 
     static Buffer *create(Context *context,
                           cl_mem_flags flags,
@@ -171,5 +181,36 @@ class BufferHw : public Buffer {
 
     typedef typename GfxFamily::RENDER_SURFACE_STATE SURFACE_STATE;
     typename SURFACE_STATE::SURFACE_TYPE surfaceType;
+
+  protected:
+    static const size_t surfaceStateDwords = sizeof(SURFACE_STATE) / sizeof(uint32_t);
+
+    // bits programmed by encodeSurfaceState for one allocation,
+    // remaining bits are kept from the kernel's surface state heap
+    struct SurfaceStateCacheEntry {
+        GraphicsAllocation *graphicsAllocation;
+        uint64_t bufferAddress;
+        size_t bufferSize;
+        uint32_t mask[surfaceStateDwords];
+        uint32_t value[surfaceStateDwords];
+
+        bool matches(GraphicsAllocation *allocation, uint64_t address, size_t size) const {
+            return graphicsAllocation == allocation && bufferAddress == address && bufferSize == size;
+        }
+    };
+
+  public:
+    const SurfaceStateCacheEntry *peekSurfaceStateCache() const { return surfaceStateCache.load(std::memory_order_acquire); }
+
+  protected:
+    // published entries are immutable, kernels sharing this buffer read them without locking;
+    // replaced entries stay alive until the buffer is destroyed since a reader may still hold them
+    std::atomic<const SurfaceStateCacheEntry *> surfaceStateCache{nullptr};
+    std::vector<std::unique_ptr<SurfaceStateCacheEntry>> surfaceStateCacheEntries;
+    // key seen once before an entry is built for it, guarded by surfaceStateCacheMtx
+    GraphicsAllocation *lastSeenGraphicsAllocation = nullptr;
+    uint64_t lastSeenBufferAddress = 0;
+    size_t lastSeenBufferSize = 0;
+    std::mutex surfaceStateCacheMtx;
 };
 } // namespace OCLRT
@@ -25,6 +25,7 @@
 #include "runtime/helpers/aligned_memory.h"
 #include "runtime/mem_obj/buffer.h"
 #include "runtime/gmm_helper/gmm_helper.h"
+#include <cstring>
 
 namespace OCLRT {
 
@@ -39,25 +40,70 @@ union SURFACE_STATE_BUFFER_LENGTH {
 
 template <typename GfxFamily>
 void BufferHw<GfxFamily>::setArgStateful(void *memory) {
+    // The graphics allocation for Host Ptr surface will be created in makeResident call and GPU address is expected to be the same as CPU address
+    auto graphicsAllocation = getGraphicsAllocation();
+    auto bufferAddress = (graphicsAllocation != nullptr) ? graphicsAllocation->getGpuAddress() : reinterpret_cast<uint64_t>(getHostPtr());
+    bufferAddress += this->offset;
+
+    auto bufferSize = (graphicsAllocation != nullptr) ? graphicsAllocation->getUnderlyingBufferSize() : getSize();
+
+    auto cache = surfaceStateCache.load(std::memory_order_acquire);
+    if (cache == nullptr || !cache->matches(graphicsAllocation, bufferAddress, bufferSize)) {
+        std::lock_guard<std::mutex> lock(surfaceStateCacheMtx);
+        cache = surfaceStateCache.load(std::memory_order_relaxed);
+        if (cache == nullptr || !cache->matches(graphicsAllocation, bufferAddress, bufferSize)) {
+            if (lastSeenGraphicsAllocation != graphicsAllocation || lastSeenBufferAddress != bufferAddress || lastSeenBufferSize != bufferSize) {
+                lastSeenGraphicsAllocation = graphicsAllocation;
+                lastSeenBufferAddress = bufferAddress;
+                lastSeenBufferSize = bufferSize;
+                // first use of this allocation, temporary buffers created for svm arguments never get here twice
+                encodeSurfaceState(memory, bufferAddress, bufferSize, getSize(), getFlags());
+                return;
+            }
 
+            // encode over cleared and over set state, bits equal in both are the ones programmed for this buffer
+            SURFACE_STATE clearedState;
+            SURFACE_STATE setState;
+            memset(&clearedState, 0, sizeof(SURFACE_STATE));
+            memset(&setState, 0xff, sizeof(SURFACE_STATE));
+            encodeSurfaceState(&clearedState, bufferAddress, bufferSize, getSize(), getFlags());
+            encodeSurfaceState(&setState, bufferAddress, bufferSize, getSize(), getFlags());
+
+            std::unique_ptr<SurfaceStateCacheEntry> entry(new SurfaceStateCacheEntry);
+            entry->graphicsAllocation = graphicsAllocation;
+            entry->bufferAddress = bufferAddress;
+            entry->bufferSize = bufferSize;
+            auto clearedDwords = reinterpret_cast<const uint32_t *>(&clearedState);
+            auto setDwords = reinterpret_cast<const uint32_t *>(&setState);
+            for (size_t i = 0; i < surfaceStateDwords; i++) {
+                entry->mask[i] = ~(clearedDwords[i] ^ setDwords[i]);
+                entry->value[i] = clearedDwords[i] & entry->mask[i];
+            }
+            cache = entry.get();
+            surfaceStateCacheEntries.push_back(std::move(entry));
+            surfaceStateCache.store(cache, std::memory_order_release);
+        }
+    }
+
+    auto surfaceStateDwordsPtr = reinterpret_cast<uint32_t *>(memory);
+    for (size_t i = 0; i < surfaceStateDwords; i++) {
+        surfaceStateDwordsPtr[i] = (surfaceStateDwordsPtr[i] & ~cache->mask[i]) | cache->value[i];
+    }
+}
+
+template <typename GfxFamily>
+void BufferHw<GfxFamily>::encodeSurfaceState(void *memory, uint64_t bufferAddress, size_t bufferSize, size_t surfaceSize, cl_mem_flags flags) {
     using RENDER_SURFACE_STATE = typename GfxFamily::RENDER_SURFACE_STATE;
     using SURFACE_FORMAT = typename RENDER_SURFACE_STATE::SURFACE_FORMAT;
     auto surfaceState = reinterpret_cast<RENDER_SURFACE_STATE *>(memory);
-    auto surfaceSize = alignUp(getSize(), 4);
 
     SURFACE_STATE_BUFFER_LENGTH Length = {0};
-    Length.Length = static_cast<uint32_t>(surfaceSize - 1);
+    Length.Length = static_cast<uint32_t>(alignUp(surfaceSize, 4) - 1);
 
     surfaceState->setWidth(Length.SurfaceState.Width + 1);
     surfaceState->setHeight(Length.SurfaceState.Height + 1);
     surfaceState->setDepth(Length.SurfaceState.Depth + 1);
 
-    // The graphics allocation for Host Ptr surface will be created in makeResident call and GPU address is expected to be the same as CPU address
-    auto bufferAddress = (getGraphicsAllocation() != nullptr) ? getGraphicsAllocation()->getGpuAddress() : reinterpret_cast<uint64_t>(getHostPtr());
-    bufferAddress += this->offset;
-
-    auto bufferSize = (getGraphicsAllocation() != nullptr) ? getGraphicsAllocation()->getUnderlyingBufferSize() : getSize();
-
     if (bufferAddress != 0) {
         surfaceState->setSurfaceType(RENDER_SURFACE_STATE::SURFACE_TYPE_SURFTYPE_BUFFER);
     } else {
@@ -72,7 +118,7 @@ void BufferHw<GfxFamily>::setArgStateful(void *memory) {
     surfaceState->setVerticalLineStrideOffset(0);
 
     if ((isAligned<MemoryConstants::cacheLineSize>(bufferAddress) && isAligned<MemoryConstants::cacheLineSize>(bufferSize)) ||
-        ((getFlags() & CL_MEM_READ_ONLY)) != 0) {
+        ((flags & CL_MEM_READ_ONLY)) != 0) {
         surfaceState->setMemoryObjectControlState(Gmm::getMOCS(GMM_RESOURCE_USAGE_OCL_BUFFER));
     } else {
         surfaceState->setMemoryObjectControlState(Gmm::getMOCS(GMM_RESOURCE_USAGE_OCL_BUFFER_CACHELINE_MISALIGNED));
@@ -31,6 +31,7 @@
 #include "runtime/helpers/hw_info.h"
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/helpers/string.h"
+#include "runtime/helpers/tiling.h"
 #include "runtime/mem_obj/image.h"
 #include "runtime/mem_obj/buffer.h"
 #include "runtime/memory_manager/memory_manager.h"
@@ -38,6 +39,7 @@
 #include "runtime/gmm_helper/gmm_helper.h"
 #include "runtime/gmm_helper/resource_info.h"
 #include "igfxfmid.h"
+#include <algorithm>
 #include <map>
 
 namespace OCLRT {
@@ -338,6 +340,9 @@ Image *Image::create(Context *context,
 
                 if (IsNV12Image(&image->getImageFormat())) {
                     errcodeRet = image->writeNV12Planes(hostPtr, hostPtrRowPitch);
+                } else if (image->isTiledCopyOnCpuAllowed() &&
+                           image->writeTiledOnCpu(hostPtr, hostPtrRowPitch, hostPtrSlicePitch, &copyOrigin[0], &copyRegion[0])) {
+                    errcodeRet = CL_SUCCESS;
                 } else {
                     errcodeRet = cmdQ->enqueueWriteImage(image, CL_TRUE, &copyOrigin[0], &copyRegion[0],
                                                          hostPtrRowPitch, hostPtrSlicePitch,
@@ -854,6 +859,109 @@ void Image::transferDataFromHostPtr(std::array<size_t, 3> copySize, std::array<s
                  copySize, copyOffset);
 }
 
+namespace {
+bool getCpuTileMode(GraphicsAllocation *graphicsAllocation, TileMode &tileMode) {
+    if (graphicsAllocation->gmm == nullptr || graphicsAllocation->gmm->isRenderCompressed) {
+        return false;
+    }
+    switch (graphicsAllocation->gmm->gmmResourceInfo->getTileType()) {
+    case GMM_TILED_X:
+        tileMode = TileMode::TileX;
+        return true;
+    case GMM_TILED_Y:
+        tileMode = TileMode::TileY;
+        return true;
+    default:
+        return false;
+    }
+}
+} // namespace
+
+bool Image::isTiledCopyOnCpuAllowed() const {
+    TileMode tileMode;
+    if (DebugManager.flags.EnableCpuImageTiling.get() == 0 ||
+        !isTiledImage ||
+        !context->getMemoryManager()->isResourceLockable() ||
+        !getCpuTileMode(graphicsAllocation, tileMode)) {
+        return false;
+    }
+    // Only whole, single-level surfaces; planes and sub-images carry render offsets
+    if (IsNV12Image(&imageFormat) || mipLevel != 0 || imageDesc.num_mip_levels > 1 ||
+        surfaceOffsets.offset != 0 || surfaceOffsets.xOffset != 0 || surfaceOffsets.yOffset != 0) {
+        return false;
+    }
+
+    auto pitch = imageDesc.image_row_pitch;
+    auto tileHeight = TilingHelper::getTileHeight(tileMode);
+    if (pitch == 0 || pitch % TilingHelper::getTileWidth(tileMode) != 0) {
+        return false;
+    }
+
+    size_t slices = 1;
+    if (imageDesc.image_type == CL_MEM_OBJECT_IMAGE3D) {
+        slices = imageDesc.image_depth;
+    } else if (imageDesc.image_type == CL_MEM_OBJECT_IMAGE2D_ARRAY) {
+        slices = imageDesc.image_array_size;
+    }
+    if (slices > 1 && (qPitch == 0 || qPitch % tileHeight != 0)) {
+        return false;
+    }
+    auto rows = (slices - 1) * qPitch + imageDesc.image_height;
+    return alignUp(rows, tileHeight) * pitch <= graphicsAllocation->getUnderlyingBufferSize();
+}
+
+bool Image::isReadWriteOnCpuPossible(cl_bool blocking, cl_uint numEventsInWaitList) const {
+    return blocking == CL_TRUE && numEventsInWaitList == 0 && graphicsAllocation->peekSharedHandle() == 0 &&
+           isTiledCopyOnCpuAllowed();
+}
+
+bool Image::isReadWriteOnCpuAllowed(cl_bool blocking, cl_uint numEventsInWaitList, const size_t *region) const {
+    return calculateTransferSize(region) <= maxImageSizeForReadWriteOnCpu && isReadWriteOnCpuPossible(blocking, numEventsInWaitList);
+}
+
+size_t Image::calculateTransferSize(const size_t *region) const {
+    return region[0] * region[1] * region[2] * surfaceFormatInfo.ImageElementSizeInBytes;
+}
+
+bool Image::writeTiledOnCpu(const void *srcPtr, size_t srcRowPitch, size_t srcSlicePitch, const size_t *origin, const size_t *region) {
+    return copyTiledOnCpu(const_cast<void *>(srcPtr), srcRowPitch, srcSlicePitch, origin, region, true);
+}
+
+bool Image::readTiledOnCpu(void *dstPtr, size_t dstRowPitch, size_t dstSlicePitch, const size_t *origin, const size_t *region) {
+    return copyTiledOnCpu(dstPtr, dstRowPitch, dstSlicePitch, origin, region, false);
+}
+
+bool Image::copyTiledOnCpu(void *hostPtr, size_t hostRowPitch, size_t hostSlicePitch, const size_t *origin, const size_t *region, bool toImage) {
+    TileMode tileMode;
+    if (!getCpuTileMode(graphicsAllocation, tileMode)) {
+        return false;
+    }
+    auto memoryManager = context->getMemoryManager();
+    auto lockedPtr = memoryManager->lockResource(graphicsAllocation);
+    if (lockedPtr == nullptr) {
+        return false;
+    }
+
+    auto bytesPerPixel = surfaceFormatInfo.ImageElementSizeInBytes;
+    auto widthInBytes = region[0] * bytesPerPixel;
+    hostRowPitch = hostRowPitch ? hostRowPitch : widthInBytes;
+    hostSlicePitch = hostSlicePitch ? hostSlicePitch : hostRowPitch * region[1];
+
+    TiledSurface surface = {lockedPtr, imageDesc.image_row_pitch, tileMode};
+    for (size_t slice = 0; slice < region[2]; slice++) {
+        auto y = (origin[2] + slice) * qPitch + origin[1];
+        auto hostSlice = ptrOffset(hostPtr, slice * hostSlicePitch);
+        if (toImage) {
+            TilingHelper::swizzle(surface, origin[0] * bytesPerPixel, y, hostSlice, hostRowPitch, widthInBytes, region[1]);
+        } else {
+            TilingHelper::unswizzle(surface, origin[0] * bytesPerPixel, y, hostSlice, hostRowPitch, widthInBytes, region[1]);
+        }
+    }
+
+    memoryManager->unlockResource(graphicsAllocation);
+    return true;
+}
+
 cl_int Image::writeNV12Planes(const void *hostPtr, size_t hostPtrRowPitch) {
     CommandQueue *cmdQ = context->getSpecialQueue();
     size_t origin[3] = {0, 0, 0};
@@ -915,55 +1023,95 @@ cl_int Image::writeNV12Planes(const void *hostPtr, size_t hostPtrRowPitch) {
     return retVal;
 }
 
+namespace {
+// Direct-indexed view of a surface format table. Core channel orders and data types
+// are looked up in a dense table, extension formats fall back to a linear scan.
+class SurfaceFormatIndex {
+  public:
+    SurfaceFormatIndex(const SurfaceFormatInfo *surfaceFormatTable, size_t numSurfaceFormats)
+        : surfaceFormatTable(surfaceFormatTable), numSurfaceFormats(numSurfaceFormats) {
+        for (auto &row : indices) {
+            std::fill(row, row + numDataTypes, noFormat);
+        }
+        for (size_t index = 0; index < numSurfaceFormats; index++) {
+            const auto &format = surfaceFormatTable[index].OCLImageFormat;
+            size_t order = 0, dataType = 0;
+            if (getDenseIndex(format, order, dataType) && indices[order][dataType] == noFormat) {
+                indices[order][dataType] = static_cast<uint16_t>(index);
+            }
+        }
+    }
+
+    const SurfaceFormatInfo *find(const cl_image_format &imageFormat) const {
+        size_t order = 0, dataType = 0;
+        if (getDenseIndex(imageFormat, order, dataType)) {
+            auto index = indices[order][dataType];
+            return index == noFormat ? nullptr : &surfaceFormatTable[index];
+        }
+        for (size_t index = 0; index < numSurfaceFormats; index++) {
+            const auto &surfaceFormat = surfaceFormatTable[index].OCLImageFormat;
+            if (surfaceFormat.image_channel_data_type == imageFormat.image_channel_data_type &&
+                surfaceFormat.image_channel_order == imageFormat.image_channel_order) {
+                return &surfaceFormatTable[index];
+            }
+        }
+        return nullptr;
+    }
+
+  protected:
+    static const size_t numChannelOrders = 32;
+    static const size_t numDataTypes = 32;
+    static const uint16_t noFormat = 0xffff;
+
+    static bool getDenseIndex(const cl_image_format &imageFormat, size_t &order, size_t &dataType) {
+        order = static_cast<size_t>(imageFormat.image_channel_order - CL_R);
+        dataType = static_cast<size_t>(imageFormat.image_channel_data_type - CL_SNORM_INT8);
+        return imageFormat.image_channel_order >= CL_R && order < numChannelOrders &&
+               imageFormat.image_channel_data_type >= CL_SNORM_INT8 && dataType < numDataTypes;
+    }
+
+    const SurfaceFormatInfo *surfaceFormatTable;
+    size_t numSurfaceFormats;
+    uint16_t indices[numChannelOrders][numDataTypes];
+};
+
+const uint16_t SurfaceFormatIndex::noFormat;
+} // namespace
+
 const SurfaceFormatInfo *Image::getSurfaceFormatFromTable(cl_mem_flags flags, const cl_image_format *imageFormat) {
     if (!imageFormat) {
         return nullptr;
     }
-    const SurfaceFormatInfo *surfaceFormatTable = nullptr;
-    size_t numSurfaceFormats = 0;
     bool isDepthFormat = Image::isDepthFormat(*imageFormat);
 
     if (IsNV12Image(imageFormat)) {
 #if SUPPORT_YUV
-        surfaceFormatTable = planarYuvSurfaceFormats;
-        numSurfaceFormats = numPlanarYuvSurfaceFormats;
+        static const SurfaceFormatIndex planarYuvIndex(planarYuvSurfaceFormats, numPlanarYuvSurfaceFormats);
+        return planarYuvIndex.find(*imageFormat);
 #else
         return nullptr;
 #endif
     } else if (IsPackedYuvImage(imageFormat)) {
 #if SUPPORT_YUV
-        surfaceFormatTable = packedYuvSurfaceFormats;
-        numSurfaceFormats = numPackedYuvSurfaceFormats;
+        static const SurfaceFormatIndex packedYuvIndex(packedYuvSurfaceFormats, numPackedYuvSurfaceFormats);
+        return packedYuvIndex.find(*imageFormat);
 #else
         return nullptr;
 #endif
-    } else if ((flags & CL_MEM_READ_ONLY) == CL_MEM_READ_ONLY) {
-        surfaceFormatTable = isDepthFormat ? readOnlyDepthSurfaceFormats : readOnlySurfaceFormats;
-        numSurfaceFormats = isDepthFormat ? numReadOnlyDepthSurfaceFormats : numReadOnlySurfaceFormats;
-    } else if ((flags & CL_MEM_WRITE_ONLY) == CL_MEM_WRITE_ONLY) {
-        surfaceFormatTable = isDepthFormat ? readWriteDepthSurfaceFormats : writeOnlySurfaceFormats;
-        numSurfaceFormats = isDepthFormat ? numReadWriteDepthSurfaceFormats : numWriteOnlySurfaceFormats;
-    } else {
-        surfaceFormatTable = isDepthFormat ? readWriteDepthSurfaceFormats : readWriteSurfaceFormats;
-        numSurfaceFormats = isDepthFormat ? numReadWriteDepthSurfaceFormats : numReadWriteSurfaceFormats;
     }
 
-    // Find a matching surface format
-    size_t indexSurfaceFormat = 0;
-    while (indexSurfaceFormat < numSurfaceFormats) {
-        const auto &surfaceFormat = surfaceFormatTable[indexSurfaceFormat].OCLImageFormat;
-        if (surfaceFormat.image_channel_data_type == imageFormat->image_channel_data_type &&
-            surfaceFormat.image_channel_order == imageFormat->image_channel_order) {
-            break;
-        }
-        ++indexSurfaceFormat;
-    }
+    static const SurfaceFormatIndex readOnlyIndex(readOnlySurfaceFormats, numReadOnlySurfaceFormats);
+    static const SurfaceFormatIndex writeOnlyIndex(writeOnlySurfaceFormats, numWriteOnlySurfaceFormats);
+    static const SurfaceFormatIndex readWriteIndex(readWriteSurfaceFormats, numReadWriteSurfaceFormats);
+    static const SurfaceFormatIndex readOnlyDepthIndex(readOnlyDepthSurfaceFormats, numReadOnlyDepthSurfaceFormats);
+    static const SurfaceFormatIndex readWriteDepthIndex(readWriteDepthSurfaceFormats, numReadWriteDepthSurfaceFormats);
 
-    if (indexSurfaceFormat >= numSurfaceFormats) {
-        return nullptr;
+    if ((flags & CL_MEM_READ_ONLY) == CL_MEM_READ_ONLY) {
+        return isDepthFormat ? readOnlyDepthIndex.find(*imageFormat) : readOnlyIndex.find(*imageFormat);
+    } else if ((flags & CL_MEM_WRITE_ONLY) == CL_MEM_WRITE_ONLY) {
+        return isDepthFormat ? readWriteDepthIndex.find(*imageFormat) : writeOnlyIndex.find(*imageFormat);
     }
-
-    return &surfaceFormatTable[indexSurfaceFormat];
+    return isDepthFormat ? readWriteDepthIndex.find(*imageFormat) : readWriteIndex.find(*imageFormat);
 }
 
 bool Image::isImage2d(cl_mem_object_type imageType) {
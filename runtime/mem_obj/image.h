@@ -22,6 +22,7 @@
 
 #pragma once
 #include "runtime/mem_obj/mem_obj.h"
+#include "runtime/helpers/basic_math.h"
 #include "runtime/helpers/string.h"
 #include "runtime/helpers/surface_formats.h"
 #include "runtime/helpers/validators.h"
@@ -175,6 +176,13 @@ class Image : public MemObj {
     static const SurfaceFormatInfo *getSurfaceFormatFromTable(cl_mem_flags flags, const cl_image_format *imageFormat);
 
     cl_int writeNV12Planes(const void *hostPtr, size_t hostPtrRowPitch);
+    bool isTiledCopyOnCpuAllowed() const;
+    bool isReadWriteOnCpuPossible(cl_bool blocking, cl_uint numEventsInWaitList) const;
+    bool isReadWriteOnCpuAllowed(cl_bool blocking, cl_uint numEventsInWaitList, const size_t *region) const;
+    size_t calculateTransferSize(const size_t *region) const;
+    bool writeTiledOnCpu(const void *srcPtr, size_t srcRowPitch, size_t srcSlicePitch, const size_t *origin, const size_t *region);
+    bool readTiledOnCpu(void *dstPtr, size_t dstRowPitch, size_t dstSlicePitch, const size_t *origin, const size_t *region);
+    const static size_t maxImageSizeForReadWriteOnCpu = 64 * KB;
     void setMcsSurfaceInfo(McsSurfaceInfo &info) { mcsSurfaceInfo = info; }
     const McsSurfaceInfo &getMcsSurfaceInfo() { return mcsSurfaceInfo; }
 
@@ -201,6 +209,8 @@ class Image : public MemObj {
                       void *src, size_t srcRowPitch, size_t srcSlicePitch,
                       std::array<size_t, 3> &copyRegion, std::array<size_t, 3> &copyOrigin);
 
+    bool copyTiledOnCpu(void *hostPtr, size_t hostRowPitch, size_t hostSlicePitch, const size_t *origin, const size_t *region, bool toImage);
+
     cl_image_format imageFormat;
     cl_image_desc imageDesc;
     SurfaceFormatInfo surfaceFormatInfo;
@@ -67,7 +67,8 @@ MemObj::~MemObj() {
     }
 
     if (memoryManager) {
-        if (graphicsAllocation && !associatedMemObject && !isObjectRedescribed && !isHostPtrSVM) {
+        bool allocationRetainedBySharing = sharingHandler && sharingHandler->retainsGraphicsAllocation();
+        if (graphicsAllocation && !associatedMemObject && !isObjectRedescribed && !isHostPtrSVM && !allocationRetainedBySharing) {
             bool doAsyncDestrucions = DebugManager.flags.EnableAsyncDestroyAllocations.get();
             if (!doAsyncDestrucions) {
                 needWait = true;
@@ -115,6 +115,7 @@ class MemoryManager {
 
     virtual void *lockResource(GraphicsAllocation *graphicsAllocation) = 0;
     virtual void unlockResource(GraphicsAllocation *graphicsAllocation) = 0;
+    virtual bool isResourceLockable() const { return false; }
 
     void cleanGraphicsMemoryCreatedFromHostPtr(GraphicsAllocation *);
     GraphicsAllocation *createGraphicsAllocationWithPadding(GraphicsAllocation *inputGraphicsAllocation, size_t sizeWithPadding);
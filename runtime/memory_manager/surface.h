@@ -25,6 +25,8 @@
 #include "runtime/mem_obj/mem_obj.h"
 #include "runtime/memory_manager/graphics_allocation.h"
 
+#include <new>
+
 namespace OCLRT {
 
 class Surface {
@@ -34,6 +36,8 @@ class Surface {
     virtual void makeResident(CommandStreamReceiver &csr) = 0;
     virtual void setCompletionStamp(CompletionStamp &cs, Device *pDevice, CommandQueue *pCmdQ) = 0;
     virtual Surface *duplicate() = 0;
+    // copy constructed in caller provided storage, nullptr when the type can't be copied that way
+    virtual Surface *duplicateInto(void *storage) { return nullptr; }
     const bool IsCoherent;
 };
 
@@ -45,6 +49,7 @@ class NullSurface : public Surface {
     void makeResident(CommandStreamReceiver &csr) override{};
     void setCompletionStamp(CompletionStamp &cs, Device *pDevice, CommandQueue *pCmdQ) override{};
     Surface *duplicate() override { return new NullSurface(); };
+    Surface *duplicateInto(void *storage) override { return new (storage) NullSurface(); };
 };
 
 class HostPtrSurface : public Surface {
@@ -70,6 +75,9 @@ class HostPtrSurface : public Surface {
     Surface *duplicate() override {
         return new HostPtrSurface(this->memoryPointer, this->surfaceSize, this->gfxAllocation);
     };
+    Surface *duplicateInto(void *storage) override {
+        return new (storage) HostPtrSurface(this->memoryPointer, this->surfaceSize, this->gfxAllocation);
+    };
 
     void *getMemoryPointer() const {
         return memoryPointer;
@@ -113,6 +121,9 @@ class MemObjSurface : public Surface {
     Surface *duplicate() override {
         return new MemObjSurface(this->memory_object);
     };
+    Surface *duplicateInto(void *storage) override {
+        return new (storage) MemObjSurface(this->memory_object);
+    };
 
   protected:
     class MemObj *memory_object;
@@ -132,8 +143,25 @@ class GeneralSurface : public Surface {
         gfxAllocation->taskCount = cs.taskCount;
     };
     Surface *duplicate() override { return new GeneralSurface(gfxAllocation); };
+    Surface *duplicateInto(void *storage) override { return new (storage) GeneralSurface(gfxAllocation); };
 
   protected:
     GraphicsAllocation *gfxAllocation;
 };
+
+class PrivateSurface : public GeneralSurface {
+  public:
+    PrivateSurface(GraphicsAllocation *gfxAlloc, CommandStreamReceiver &csr) : GeneralSurface(gfxAlloc), csr(csr) {
+        csr.holdPrivateSurface(*gfxAllocation);
+    }
+    ~PrivateSurface() override {
+        csr.releasePrivateSurface(*gfxAllocation);
+    }
+
+    Surface *duplicate() override { return new PrivateSurface(gfxAllocation, csr); };
+    Surface *duplicateInto(void *storage) override { return new (storage) PrivateSurface(gfxAllocation, csr); };
+
+  protected:
+    CommandStreamReceiver &csr;
+};
 } // namespace OCLRT
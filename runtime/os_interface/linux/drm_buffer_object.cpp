@@ -50,10 +50,20 @@ BufferObject::BufferObject(Drm *drm, int handle, bool isAllocated) : drm(drm), r
     this->stride = 0;
 
     execObjectsStorage = nullptr;
+    execObjectsGenerations = nullptr;
+    reuseResidencyExecObjects = false;
 
     this->size = 0;
     this->address = nullptr;
     this->offset64 = 0;
+    this->generation = obtainGeneration();
+}
+
+// 0 is never used so that zeroed generation storage always marks exec object as stale
+std::atomic<uint64_t> BufferObject::nextGeneration(1);
+
+uint64_t BufferObject::obtainGeneration() {
+    return nextGeneration++;
 }
 
 uint32_t BufferObject::getRefCount() const {
@@ -63,6 +73,7 @@ uint32_t BufferObject::getRefCount() const {
 bool BufferObject::softPin(uint64_t offset) {
     this->isSoftpin = true;
     this->offset64 = offset;
+    this->generation = obtainGeneration();
 
     return true;
 };
@@ -83,6 +94,7 @@ bool BufferObject::close() {
     }
 
     this->handle = -1;
+    this->generation = obtainGeneration();
 
     return true;
 }
@@ -142,9 +154,19 @@ void BufferObject::fillExecObject(drm_i915_gem_exec_object2 &execObject) {
     execObject.rsvd2 = 0;
 }
 
+void BufferObject::fillExecObject(drm_i915_gem_exec_object2 *storage, uint64_t *generations, int idx) {
+    if (generations) {
+        if (generations[idx] == this->generation) {
+            return;
+        }
+        generations[idx] = this->generation;
+    }
+    fillExecObject(storage[idx]);
+}
+
 void BufferObject::processRelocs(int &idx) {
     for (size_t i = 0; i < this->residency.size(); i++) {
-        residency[i]->fillExecObject(execObjectsStorage[idx]);
+        residency[i]->fillExecObject(execObjectsStorage, execObjectsGenerations, idx);
         idx++;
     }
 }
@@ -153,8 +175,13 @@ int BufferObject::exec(uint32_t used, size_t startOffset, unsigned int flags, bo
     drm_i915_gem_execbuffer2 execbuf;
 
     int idx = 0;
-    processRelocs(idx);
-    this->fillExecObject(execObjectsStorage[idx]);
+    if (reuseResidencyExecObjects) {
+        // residency exec objects were filled by a previous exec and are still valid
+        idx = static_cast<int>(residency.size());
+    } else {
+        processRelocs(idx);
+    }
+    this->fillExecObject(execObjectsStorage, execObjectsGenerations, idx);
     idx++;
 
     memset(&execbuf, 0, sizeof(execbuf));
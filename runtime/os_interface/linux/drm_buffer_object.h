@@ -72,15 +72,26 @@ class BufferObject {
     size_t peekSize() { return size; }
     int peekHandle() { return handle; }
     void *peekAddress() { return address; }
-    void setAddress(void *address) { this->address = address; }
+    void setAddress(void *address) {
+        this->address = address;
+        this->generation = obtainGeneration();
+    }
     void setUnmapSize(uint64_t unmapSize) { this->unmapSize = unmapSize; }
     uint64_t peekUnmapSize() { return unmapSize; }
     void swapResidencyVector(ResidencyVector *residencyVect) {
         std::swap(this->residency, *residencyVect);
     }
-    void setExecObjectsStorage(drm_i915_gem_exec_object2 *storage) {
+    // When generations are passed, exec objects already filled for the same BO state are not refilled.
+    // reuseResidency skips the residency part of the storage altogether, it must hold the exec objects
+    // of the same residency filled while no BO state has changed.
+    void setExecObjectsStorage(drm_i915_gem_exec_object2 *storage, uint64_t *generations = nullptr, bool reuseResidency = false) {
         execObjectsStorage = storage;
+        execObjectsGenerations = generations;
+        reuseResidencyExecObjects = reuseResidency;
     }
+    uint64_t peekGeneration() const { return generation; }
+    // changes whenever state of any BO that goes into its exec object changes
+    static uint64_t peekGenerationCounter() { return nextGeneration.load(); }
     ResidencyVector *getResidency() { return &residency; }
     StorageAllocatorType peekAllocationType() { return storageAllocatorType; }
     void setAllocationType(StorageAllocatorType allocatorType) { this->storageAllocatorType = allocatorType; }
@@ -94,6 +105,13 @@ class BufferObject {
 
     ResidencyVector residency;
     drm_i915_gem_exec_object2 *execObjectsStorage;
+    uint64_t *execObjectsGenerations;
+    bool reuseResidencyExecObjects;
+
+    // unique for every BO state that affects its exec object, changed whenever such state is modified
+    uint64_t generation;
+    static uint64_t obtainGeneration();
+    static std::atomic<uint64_t> nextGeneration;
 
     int handle; // i915 gem object handle
     bool isSoftpin;
@@ -104,6 +122,7 @@ class BufferObject {
     uint32_t stride;
 
     void fillExecObject(drm_i915_gem_exec_object2 &execObject);
+    void fillExecObject(drm_i915_gem_exec_object2 *storage, uint64_t *generations, int idx);
     void processRelocs(int &idx);
 
     uint64_t offset64; // last-seen GPU offset
@@ -70,6 +70,13 @@ class DrmCommandStreamReceiver : public DeviceCommandStreamReceiver<GfxFamily> {
 
     std::vector<BufferObject *> residency;
     std::vector<drm_i915_gem_exec_object2> execObjectsStorage;
+    // BO generation each exec object was filled with, unchanged entries are reused between flushes
+    std::vector<uint64_t> execObjectsGenerations;
+    // residency of the last exec and BO generation counter it was filled at; a flush with the same
+    // residency and no BO state change since then sends the previous exec objects without touching BOs
+    std::vector<BufferObject *> execResidency;
+    uint64_t execResidencyGeneration = 0;
+    bool residencyMatchesExecResidency = true;
     Drm *drm;
     gemCloseWorkerMode gemCloseWorkerOperationMode;
     bool mediaVfeStateLowPriorityDirty = true;
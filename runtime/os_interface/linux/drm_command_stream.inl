@@ -43,6 +43,7 @@ DrmCommandStreamReceiver<GfxFamily>::DrmCommandStreamReceiver(const HardwareInfo
     this->drm = drm ? drm : Drm::get(0);
     residency.reserve(512);
     execObjectsStorage.reserve(512);
+    execObjectsGenerations.reserve(512);
     CommandStreamReceiver::osInterface = std::unique_ptr<OSInterface>(new OSInterface());
     CommandStreamReceiver::osInterface.get()->get()->setDrm(this->drm);
 }
@@ -66,12 +67,29 @@ FlushStamp DrmCommandStreamReceiver<GfxFamily>::flush(BatchBuffer &batchBuffer,
         this->processResidency(allocationsForResidency);
         // Residency hold all allocation except command buffer, hence + 1
         auto requiredSize = this->residency.size() + 1;
+        bool execObjectsValid = true;
         if (requiredSize > this->execObjectsStorage.size()) {
             this->execObjectsStorage.resize(requiredSize);
+            execObjectsValid = false;
         }
+        if (!execObjectsValid || this->execObjectsGenerations.size() != this->execObjectsStorage.size()) {
+            // storage may have been moved, refill all exec objects
+            this->execObjectsGenerations.assign(this->execObjectsStorage.size(), 0);
+            execObjectsValid = false;
+        }
+
+        auto generationCounter = BufferObject::peekGenerationCounter();
+        bool reuseResidency = execObjectsValid && this->residencyMatchesExecResidency &&
+                              this->residency.size() == this->execResidency.size() &&
+                              this->execResidencyGeneration == generationCounter;
+        if (!reuseResidency) {
+            this->execResidency.assign(this->residency.begin(), this->residency.end());
+        }
+        this->execResidencyGeneration = generationCounter;
+        this->residencyMatchesExecResidency = true;
 
         bb->swapResidencyVector(&this->residency);
-        bb->setExecObjectsStorage(this->execObjectsStorage.data());
+        bb->setExecObjectsStorage(this->execObjectsStorage.data(), this->execObjectsGenerations.data(), reuseResidency);
         this->residency.reserve(512);
 
         bb->exec(static_cast<uint32_t>(alignUp(batchBuffer.usedSize - batchBuffer.startOffset, 8)),
@@ -109,6 +127,10 @@ void DrmCommandStreamReceiver<GfxFamily>::makeResident(BufferObject *bo) {
         if (this->gemCloseWorkerOperationMode == gemCloseWorkerMode::gemCloseWorkerConsumingCommandBuffers) {
             bo->reference();
         }
+        auto position = residency.size();
+        if (position >= execResidency.size() || execResidency[position] != bo) {
+            residencyMatchesExecResidency = false;
+        }
         residency.push_back(bo);
     }
 }
@@ -145,6 +167,7 @@ void DrmCommandStreamReceiver<GfxFamily>::makeNonResident(GraphicsAllocation &gf
                 }
             }
             this->residency.clear();
+            this->residencyMatchesExecResidency = true;
         }
         if (gfxAllocation.fragmentsStorage.fragmentCount) {
             for (auto fragmentId = 0u; fragmentId < gfxAllocation.fragmentsStorage.fragmentCount; fragmentId++) {
@@ -24,6 +24,10 @@
 #include "runtime/os_interface/os_library.h"
 #include "os_library.h"
 #include <dlfcn.h>
+#include <sys/stat.h>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
 
 namespace OCLRT {
 OsLibrary *OsLibrary::load(const std::string &name) {
@@ -37,6 +41,36 @@ OsLibrary *OsLibrary::load(const std::string &name) {
     }
     return ptr;
 }
+
+std::string OsLibrary::getFileStamp(const std::string &name) {
+    std::vector<std::string> candidates;
+    if (name.find('/') != std::string::npos) {
+        candidates.push_back(name);
+    } else {
+        auto libraryPath = getenv("LD_LIBRARY_PATH");
+        std::stringstream paths(libraryPath != nullptr ? libraryPath : "");
+        std::string path;
+        while (std::getline(paths, path, ':')) {
+            if (!path.empty()) {
+                candidates.push_back(path + "/" + name);
+            }
+        }
+        for (auto defaultPath : {"/usr/local/lib", "/usr/local/lib64", "/usr/lib/x86_64-linux-gnu", "/usr/lib64", "/usr/lib", "/lib64", "/lib"}) {
+            candidates.push_back(std::string(defaultPath) + "/" + name);
+        }
+    }
+
+    for (auto &candidate : candidates) {
+        struct stat fileStat;
+        if (stat(candidate.c_str(), &fileStat) == 0) {
+            std::stringstream stamp;
+            stamp << fileStat.st_size << " " << fileStat.st_mtime;
+            return stamp.str();
+        }
+    }
+    return "";
+}
+
 namespace Linux {
 
 OsLibrary::OsLibrary(const std::string &name) {
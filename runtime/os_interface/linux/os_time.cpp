@@ -20,14 +20,21 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <algorithm>
 #include <time.h>
 #include "runtime/os_interface/linux/drm_neo.h"
 #include "drm/i915_drm.h"
 #include "runtime/os_interface/linux/os_interface.h"
 #include "runtime/os_interface/linux/os_time.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 
 namespace OCLRT {
 
+const uint64_t OSTimeLinux::defaultCalibrationIntervalNs;
+const uint64_t OSTimeLinux::minCalibrationWindowNs;
+const uint64_t OSTimeLinux::minExtrapolationErrorNs;
+const uint64_t OSTimeLinux::readLatencyErrorFactor;
+
 OSTimeLinux::OSTimeLinux(OSInterface *osInterface) {
     this->osInterface = osInterface;
     resolutionFunc = &clock_getres;
@@ -37,6 +44,9 @@ OSTimeLinux::OSTimeLinux(OSInterface *osInterface) {
     } else {
         pDrm = Drm::get(0);
     }
+    if (DebugManager.flags.GpuTimeCalibrationIntervalUs.get() != -1) {
+        calibrationIntervalNs = static_cast<uint64_t>(DebugManager.flags.GpuTimeCalibrationIntervalUs.get()) * 1000;
+    }
     timestampTypeDetect();
 }
 
@@ -124,7 +134,11 @@ bool OSTimeLinux::getGpuTimeSplitted(uint64_t *timestamp) {
     return true;
 }
 
-bool OSTimeLinux::getCpuGpuTime(TimeStampData *pGpuCpuTime) {
+bool OSTimeLinux::sampleCpuGpuTime(TimeStampData *pGpuCpuTime, uint64_t &readLatencyNs) {
+    uint64_t cpuTimeBeforeRead = 0;
+    if (!getCpuTime(&cpuTimeBeforeRead)) {
+        return false;
+    }
     if (!(this->*getGpuTime)(&pGpuCpuTime->GPUTimeStamp)) {
         return false;
     }
@@ -132,9 +146,89 @@ bool OSTimeLinux::getCpuGpuTime(TimeStampData *pGpuCpuTime) {
         return false;
     }
 
+    readLatencyNs = pGpuCpuTime->CPUTimeinNS - cpuTimeBeforeRead;
     return true;
 }
 
+bool OSTimeLinux::getCpuGpuTime(TimeStampData *pGpuCpuTime) {
+    uint64_t readLatencyNs = 0;
+    if (calibrationIntervalNs == 0) {
+        return sampleCpuGpuTime(pGpuCpuTime, readLatencyNs);
+    }
+
+    std::lock_guard<std::mutex> lock(calibrationMutex);
+    if (calibration.valid) {
+        uint64_t cpuTime = 0;
+        if (!getCpuTime(&cpuTime)) {
+            return false;
+        }
+        if (cpuTime - calibration.lastSample.CPUTimeinNS < calibrationIntervalNs) {
+            pGpuCpuTime->CPUTimeinNS = cpuTime;
+            pGpuCpuTime->GPUTimeStamp = clampToLastReturnedGpuTime(extrapolateGpuTime(cpuTime));
+            return true;
+        }
+    }
+
+    TimeStampData sample;
+    if (!sampleCpuGpuTime(&sample, readLatencyNs)) {
+        return false;
+    }
+    updateCalibration(sample, readLatencyNs);
+    pGpuCpuTime->CPUTimeinNS = sample.CPUTimeinNS;
+    pGpuCpuTime->GPUTimeStamp = clampToLastReturnedGpuTime(sample.GPUTimeStamp);
+    return true;
+}
+
+void OSTimeLinux::updateCalibration(const TimeStampData &sample, uint64_t readLatencyNs) {
+    if (calibration.valid) {
+        auto predicted = extrapolateGpuTime(sample.CPUTimeinNS);
+        auto error = predicted > sample.GPUTimeStamp ? predicted - sample.GPUTimeStamp : sample.GPUTimeStamp - predicted;
+        auto maxErrorNs = minExtrapolationErrorNs + readLatencyErrorFactor * (readLatencyNs + calibration.lastSampleReadLatencyNs);
+        auto maxErrorTicks = std::max(1.0, maxErrorNs * calibration.gpuTicksPerNs);
+        if (static_cast<double>(error) > maxErrorTicks) {
+            // model drifted (or the register wrapped), start a new fit
+            calibration.valid = false;
+            calibration.hasAnchor = false;
+        }
+    }
+
+    if (!calibration.hasAnchor ||
+        sample.CPUTimeinNS < calibration.anchor.CPUTimeinNS ||
+        sample.GPUTimeStamp < calibration.anchor.GPUTimeStamp) {
+        calibration.anchor = sample;
+        calibration.hasAnchor = true;
+        calibration.valid = false;
+    }
+    calibration.lastSample = sample;
+    calibration.lastSampleReadLatencyNs = readLatencyNs;
+
+    auto window = sample.CPUTimeinNS - calibration.anchor.CPUTimeinNS;
+    if (window >= minCalibrationWindowNs) {
+        calibration.gpuTicksPerNs = static_cast<double>(sample.GPUTimeStamp - calibration.anchor.GPUTimeStamp) / window;
+        calibration.valid = true;
+    }
+}
+
+uint64_t OSTimeLinux::extrapolateGpuTime(uint64_t cpuTimeInNs) const {
+    auto elapsedNs = cpuTimeInNs - calibration.lastSample.CPUTimeinNS;
+    auto gpuTime = calibration.lastSample.GPUTimeStamp + static_cast<uint64_t>(elapsedNs * calibration.gpuTicksPerNs);
+    return gpuTime & ((1ull << timestampSizeInBits) - 1);
+}
+
+uint64_t OSTimeLinux::clampToLastReturnedGpuTime(uint64_t gpuTime) {
+    if (calibration.hasReturnedGpuTime) {
+        // a step back of less than half the counter range is a correction, not a wrap
+        auto timestampMask = (1ull << timestampSizeInBits) - 1;
+        auto stepBack = (calibration.lastReturnedGpuTime - gpuTime) & timestampMask;
+        if (stepBack != 0 && stepBack < (timestampMask >> 1)) {
+            gpuTime = calibration.lastReturnedGpuTime;
+        }
+    }
+    calibration.lastReturnedGpuTime = gpuTime;
+    calibration.hasReturnedGpuTime = true;
+    return gpuTime;
+}
+
 std::unique_ptr<OSTime> OSTime::create(OSInterface *osInterface) {
     return std::unique_ptr<OSTime>(new OSTimeLinux(osInterface));
 }
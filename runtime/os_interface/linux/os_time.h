@@ -23,6 +23,8 @@
 #pragma once
 #include "runtime/os_interface/os_time.h"
 
+#include <mutex>
+
 #define OCLRT_NUM_TIMESTAMP_BITS (36)
 #define OCLRT_NUM_TIMESTAMP_BITS_FALLBACK (32)
 #define TIMESTAMP_HIGH_REG 0x0235C
@@ -46,13 +48,43 @@ class OSTimeLinux : public OSTime {
     double getDynamicDeviceTimerResolution(HardwareInfo const &hwInfo) const override;
     uint64_t getCpuRawTimestamp() override;
 
+    static const uint64_t defaultCalibrationIntervalNs = 10000000;
+    static const uint64_t minCalibrationWindowNs = 1000000;
+    // Drift tolerated before the fit is restarted: a floor covering clock
+    // jitter plus a multiple of the register read latency of both samples
+    static const uint64_t minExtrapolationErrorNs = 20000;
+    static const uint64_t readLatencyErrorFactor = 4;
+
   protected:
+    // Linear model of GPU ticks over CPU time, fitted between the anchor
+    // sample (start of the current fit) and the most recent register read
+    struct GpuTimeCalibration {
+        TimeStampData anchor = {0, 0};
+        TimeStampData lastSample = {0, 0};
+        uint64_t lastSampleReadLatencyNs = 0;
+        double gpuTicksPerNs = 0.0;
+        bool hasAnchor = false;
+        bool valid = false;
+        // last GPU time handed out, so a refresh never steps the clock back
+        uint64_t lastReturnedGpuTime = 0;
+        bool hasReturnedGpuTime = false;
+    };
+
+    bool sampleCpuGpuTime(TimeStampData *pGpuCpuTime, uint64_t &readLatencyNs);
+    void updateCalibration(const TimeStampData &sample, uint64_t readLatencyNs);
+    uint64_t extrapolateGpuTime(uint64_t cpuTimeInNs) const;
+    uint64_t clampToLastReturnedGpuTime(uint64_t gpuTime);
+
     typedef int (*resolutionFunc_t)(clockid_t, struct timespec *);
     typedef int (*getTimeFunc_t)(clockid_t, struct timespec *);
     Drm *pDrm;
     unsigned timestampSizeInBits;
     resolutionFunc_t resolutionFunc;
     getTimeFunc_t getTimeFunc;
+
+    uint64_t calibrationIntervalNs = defaultCalibrationIntervalNs;
+    GpuTimeCalibration calibration;
+    std::mutex calibrationMutex;
 };
 
 } // namespace OCLRT
@@ -33,6 +33,9 @@ class OsLibrary {
     virtual ~OsLibrary() = default;
 
     static OsLibrary *load(const std::string &name);
+    // size and modification time of the library file, found the way load would search for it but without loading it;
+    // empty when the file can't be found
+    static std::string getFileStamp(const std::string &name);
 
     virtual void *getProcAddress(const std::string &procName) = 0;
     virtual bool isLoaded() = 0;
@@ -36,6 +36,21 @@ OsLibrary *OsLibrary::load(const std::string &name) {
     return ptr;
 }
 
+std::string OsLibrary::getFileStamp(const std::string &name) {
+    // libraries loaded from the driver store change together with the driver version
+    char path[MAX_PATH];
+    if (::SearchPathA(nullptr, name.c_str(), nullptr, MAX_PATH, path, nullptr) == 0) {
+        return "";
+    }
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!::GetFileAttributesExA(path, GetFileExInfoStandard, &attributes)) {
+        return "";
+    }
+    uint64_t size = (static_cast<uint64_t>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+    uint64_t lastWrite = (static_cast<uint64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+    return std::to_string(size) + " " + std::to_string(lastWrite);
+}
+
 namespace Windows {
 
 OsLibrary::OsLibrary(const std::string &name) {
@@ -52,6 +52,7 @@ class WddmMemoryManager : public MemoryManager {
     GraphicsAllocation *allocateGraphicsMemoryForImage(ImageInfo &imgInfo, Gmm *gmm) override;
     void *lockResource(GraphicsAllocation *graphicsAllocation) override;
     void unlockResource(GraphicsAllocation *graphicsAllocation) override;
+    bool isResourceLockable() const override { return true; }
 
     bool makeResidentResidencyAllocations(ResidencyContainer *allocationsForResidency);
     void makeNonResidentEvictionAllocations();
@@ -22,21 +22,28 @@
 
 #include "platform.h"
 #include "runtime/api/api.h"
+#include "runtime/built_ins/built_ins.h"
 #include "runtime/compiler_interface/compiler_interface.h"
 #include "CL/cl_ext.h"
+#include "runtime/context/context.h"
 #include "runtime/device/device.h"
 #include "runtime/helpers/debug_helpers.h"
 #include "runtime/helpers/get_info.h"
 #include "runtime/helpers/options.h"
 #include "runtime/helpers/string.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/os_interface/device_factory.h"
 #include "runtime/event/async_events_handler.h"
 #include "runtime/sharings/sharing_factory.h"
 #include "runtime/platform/extensions.h"
 #include "CL/cl_ext.h"
+#include <algorithm>
+#include <atomic>
 
 namespace OCLRT {
 
+const size_t maxDeviceInitThreads = 4;
+
 Platform platformImpl;
 bool getDevices(HardwareInfo **hwInfo, size_t &numDevicesReturned);
 
@@ -128,36 +135,102 @@ bool Platform::initialize(size_t numDevices,
     this->platformInfo = new PlatformInfo;
 
     this->devices.resize(numDevicesReturned);
+    if (!createDevices(hwInfoConst, numDevicesReturned)) {
+        for (auto dev : this->devices) {
+            delete dev;
+        }
+        this->devices.clear();
+        delete platformInfo;
+        platformInfo = nullptr;
+        state = StateNone;
+        return false;
+    }
+
     for (size_t deviceOrdinal = 0; deviceOrdinal < numDevicesReturned; ++deviceOrdinal) {
-        auto pDevice = Device::create<OCLRT::Device>(hwInfoConst[deviceOrdinal]);
-        DEBUG_BREAK_IF(!pDevice);
-        if (pDevice) {
-            this->devices[deviceOrdinal] = pDevice;
+        auto pDevice = this->devices[deviceOrdinal];
+
+        this->platformInfo->extensions = pDevice->getDeviceInfo().deviceExtensions;
+
+        switch (pDevice->getEnabledClVersion()) {
+        case 21:
+            this->platformInfo->version = "OpenCL 2.1 ";
+            break;
+        case 20:
+            this->platformInfo->version = "OpenCL 2.0 ";
+            break;
+        default:
+            this->platformInfo->version = "OpenCL 1.2 ";
+            break;
+        }
 
-            this->platformInfo->extensions = pDevice->getDeviceInfo().deviceExtensions;
+        compilerExtensions = convertEnabledExtensionsToCompilerInternalOptions(pDevice->getDeviceInfo().deviceExtensions);
+    }
 
-            switch (pDevice->getEnabledClVersion()) {
-            case 21:
-                this->platformInfo->version = "OpenCL 2.1 ";
-                break;
-            case 20:
-                this->platformInfo->version = "OpenCL 2.0 ";
-                break;
-            default:
-                this->platformInfo->version = "OpenCL 1.2 ";
+    this->fillGlobalDispatchTable();
+
+    state = StateInited;
+
+    if (DebugManager.flags.EnableBuiltinsWarmUp.get() && numDevicesReturned > 0) {
+        builtinsWarmUpThread = std::thread(&Platform::warmUpBuiltins, this, this->devices[0]);
+    }
+    return true;
+}
+
+bool Platform::createDevices(const HardwareInfo **hwInfo, size_t numDevices) {
+    std::atomic<size_t> nextDeviceOrdinal(0);
+    std::atomic<bool> creationFailed(false);
+
+    // each device is stored under its ordinal, so the order does not depend on which worker created it
+    auto createDevicesFunc = [&] {
+        for (size_t deviceOrdinal = nextDeviceOrdinal++; deviceOrdinal < numDevices; deviceOrdinal = nextDeviceOrdinal++) {
+            if (creationFailed) {
                 break;
             }
-
-            compilerExtensions = convertEnabledExtensionsToCompilerInternalOptions(pDevice->getDeviceInfo().deviceExtensions);
-        } else {
-            return false;
+            auto pDevice = Device::create<OCLRT::Device>(hwInfo[deviceOrdinal]);
+            DEBUG_BREAK_IF(!pDevice);
+            this->devices[deviceOrdinal] = pDevice;
+            if (!pDevice) {
+                creationFailed = true;
+            }
         }
+    };
+
+    std::vector<std::thread> workers;
+    auto numThreads = getDeviceInitThreadsCount(numDevices);
+    for (size_t i = 1; i < numThreads; i++) {
+        workers.emplace_back(createDevicesFunc);
+    }
+    createDevicesFunc();
+    for (auto &worker : workers) {
+        worker.join();
     }
 
-    this->fillGlobalDispatchTable();
+    return !creationFailed;
+}
 
-    state = StateInited;
-    return true;
+size_t Platform::getDeviceInitThreadsCount(size_t numDevices) {
+    size_t numThreads = std::min(static_cast<size_t>(std::thread::hardware_concurrency()), maxDeviceInitThreads);
+    if (DebugManager.flags.DeviceInitThreads.get() != -1) {
+        numThreads = static_cast<size_t>(std::max(DebugManager.flags.DeviceInitThreads.get(), 1));
+    }
+    return std::max(std::min(numThreads, numDevices), static_cast<size_t>(1));
+}
+
+void Platform::warmUpBuiltins(Device *device) {
+    cl_int retVal = CL_SUCCESS;
+    cl_device_id clDevice = device;
+    auto context = Context::create<Context>(nullptr, DeviceVector(&clDevice, 1), nullptr, nullptr, retVal);
+    if (context) {
+        BuiltIns::getInstance().warmUpBuiltinDispatchInfoBuilders(*context, *device);
+        builtinsContext = context;
+    }
+}
+
+void Platform::waitForBuiltinsWarmUp() {
+    TakeOwnershipWrapper<Platform> platformOwnership(*this);
+    if (builtinsWarmUpThread.joinable()) {
+        builtinsWarmUpThread.join();
+    }
 }
 
 void Platform::fillGlobalDispatchTable() {
@@ -174,10 +247,19 @@ void Platform::shutdown() {
     asyncEventsHandler->closeThread();
     TakeOwnershipWrapper<Platform> platformOwnership(*this);
 
+    if (builtinsWarmUpThread.joinable()) {
+        builtinsWarmUpThread.join();
+    }
+
     if (state == StateNone) {
         return;
     }
 
+    if (builtinsContext) {
+        builtinsContext->release();
+        builtinsContext = nullptr;
+    }
+
     for (auto dev : this->devices) {
         delete dev;
     }
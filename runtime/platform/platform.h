@@ -27,11 +27,13 @@
 #include "runtime/device/device_vector.h"
 #include "runtime/helpers/base_object.h"
 #include <condition_variable>
+#include <thread>
 #include <vector>
 
 namespace OCLRT {
 
 class CompilerInterface;
+class Context;
 class Device;
 class AsyncEventsHandler;
 struct HardwareInfo;
@@ -67,6 +69,7 @@ class Platform : public BaseObject<_cl_platform_id> {
     const PlatformInfo &getPlatformInfo() const;
     AsyncEventsHandler *getAsyncEventsHandler();
     void createAsyncEventsHandler(AsyncEventsHandler *handler);
+    void waitForBuiltinsWarmUp();
 
   protected:
     enum {
@@ -76,11 +79,17 @@ class Platform : public BaseObject<_cl_platform_id> {
     };
     cl_uint state = StateNone;
     void fillGlobalDispatchTable();
+    bool createDevices(const HardwareInfo **hwInfo, size_t numDevices);
+    static size_t getDeviceInitThreadsCount(size_t numDevices);
+    void warmUpBuiltins(Device *device);
 
     PlatformInfo *platformInfo = nullptr;
     DeviceVector devices;
     std::string compilerExtensions;
     std::unique_ptr<AsyncEventsHandler> asyncEventsHandler;
+    std::thread builtinsWarmUpThread;
+    // builtin programs keep the context they were built with, so it lives as long as the devices
+    Context *builtinsContext = nullptr;
 };
 
 Platform *platform();
@@ -28,6 +28,7 @@
 #include "runtime/mem_obj/buffer.h"
 #include "runtime/mem_obj/image.h"
 #include "runtime/kernel/kernel.h"
+#include "runtime/kernel/kernel_template.h"
 #include "runtime/sampler/sampler.h"
 #include "runtime/helpers/string.h"
 #include <cstdint>
@@ -220,6 +221,7 @@ KernelInfo::~KernelInfo() {
     }
     patchInfo.stringDataMap.clear();
     delete[] crossThreadData;
+    delete kernelTemplate;
 }
 
 cl_int KernelInfo::storeArgInfo(const SPatchKernelArgumentInfo *pkernelArgInfo) {
@@ -28,6 +28,7 @@
 #include "patch_info.h"
 #include "runtime/helpers/hw_info.h"
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cmath>
 #include <vector>
@@ -40,6 +41,7 @@ class BuiltinDispatchInfoBuilder;
 class Device;
 class Kernel;
 struct KernelInfo;
+struct KernelTemplate;
 class DispatchInfo;
 struct KernelArgumentType;
 
@@ -233,8 +235,12 @@ struct KernelInfo {
     size_t requiredSubGroupSize = 0;
     uint32_t gpuPointerSize = 0;
     const BuiltinDispatchInfoBuilder *builtinDispatchBuilder = nullptr;
+    const KernelTemplate *kernelTemplate = nullptr;
     uint32_t argumentsToPatchNum = 0;
     uint32_t systemKernelOffset = 0;
     uint64_t kernelId = 0;
+    // kernels indexed with lazy patch list decoding are decoded by Program on first lookup
+    std::atomic<bool> patchListDecoded{true};
+    cl_int patchListDecodingStatus = CL_SUCCESS;
 };
 } // namespace OCLRT
@@ -30,8 +30,11 @@
 #include "patch_shared.h"
 #include "program.h"
 #include "runtime/kernel/kernel.h"
+#include "runtime/kernel/kernel_template.h"
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 using namespace iOpenCL;
 
@@ -44,10 +47,20 @@ const KernelInfo *Program::getKernelInfo(
         return nullptr;
     }
 
-    auto it = std::find_if(kernelInfoArray.begin(), kernelInfoArray.end(),
-                           [=](const KernelInfo *kInfo) { return (0 == strcmp(kInfo->name.c_str(), kernelName)); });
+    auto it = kernelInfosByName.find(kernelName);
+    if ((it == kernelInfosByName.end()) || !ensurePatchListDecoded(*it->second)) {
+        return nullptr;
+    }
+    return it->second;
+}
 
-    return (it != kernelInfoArray.end()) ? *it : nullptr;
+void Program::indexKernelInfosByName() {
+    kernelInfosByName.clear();
+    kernelInfosByName.reserve(kernelInfoArray.size());
+    for (auto kernelInfo : kernelInfoArray) {
+        // first kernel of a given name wins, as with a scan of kernelInfoArray
+        kernelInfosByName.emplace(kernelInfo->name, kernelInfo);
+    }
 }
 
 size_t Program::getNumKernels() const {
@@ -56,7 +69,8 @@ size_t Program::getNumKernels() const {
 
 const KernelInfo *Program::getKernelInfo(size_t ordinal) const {
     DEBUG_BREAK_IF(ordinal >= kernelInfoArray.size());
-    return kernelInfoArray[ordinal];
+    auto kernelInfo = kernelInfoArray[ordinal];
+    return ensurePatchListDecoded(*kernelInfo) ? kernelInfo : nullptr;
 }
 
 std::string Program::getKernelNamesString() const {
@@ -74,6 +88,7 @@ std::string Program::getKernelNamesString() const {
 
 size_t Program::processKernel(
     const void *pKernelBlob,
+    bool decodePatchList,
     cl_int &retVal) {
     size_t sizeProcessed = 0;
 
@@ -108,16 +123,7 @@ size_t Program::processKernel(
 
         pKernelInfo->heapInfo.pPatchList = pCurKernelPtr;
 
-        retVal = parsePatchList(*pKernelInfo);
-        if (retVal != CL_SUCCESS) {
-            delete pKernelInfo;
-
-            sizeProcessed = ptrDiff(pCurKernelPtr, pKernelBlob);
-            break;
-        }
-
         auto pKernelHeader = pKernelInfo->heapInfo.pKernelHeader;
-        auto pKernel = ptrOffset(pKernelBlob, sizeof(SKernelBinaryHeaderCommon));
 
         if (genBinary)
             pKernelInfo->gpuPointerSize = reinterpret_cast<const SProgramBinaryHeader *>(genBinary)->GPUPointerSizeInBytes;
@@ -132,28 +138,115 @@ size_t Program::processKernel(
 
         pKernelInfo->heapInfo.blobSize = kernelSize + sizeof(SKernelBinaryHeaderCommon);
 
-        uint32_t kernelCheckSum = pKernelInfo->heapInfo.pKernelHeader->CheckSum;
+        if (decodePatchList) {
+            retVal = decodeKernel(*pKernelInfo);
+            if (retVal != CL_SUCCESS) {
+                delete pKernelInfo;
 
-        uint64_t hashValue = Hash::hash(reinterpret_cast<const char *>(pKernel), kernelSize);
-
-        uint32_t calcCheckSum = hashValue & 0xFFFFFFFF;
-        pKernelInfo->isValid = (calcCheckSum == kernelCheckSum);
+                sizeProcessed = ptrDiff(pCurKernelPtr, pKernelBlob);
+                break;
+            }
+            addBlockKernelParent(*pKernelInfo);
+        } else {
+            pKernelInfo->patchListDecoded = false;
+        }
 
         retVal = CL_SUCCESS;
         sizeProcessed = sizeof(SKernelBinaryHeaderCommon) + kernelSize;
         kernelInfoArray.push_back(pKernelInfo);
-        if (pKernelInfo->hasDeviceEnqueue()) {
-            parentKernelInfoArray.push_back(pKernelInfo);
-        }
-        if (pKernelInfo->requiresSubgroupIndependentForwardProgress()) {
-            subgroupKernelInfoArray.push_back(pKernelInfo);
-        }
     } while (false);
 
     return sizeProcessed;
 }
 
-cl_int Program::parsePatchList(KernelInfo &kernelInfo) {
+cl_int Program::decodeKernel(KernelInfo &kernelInfo) const {
+    auto retVal = parsePatchList(kernelInfo);
+    if (retVal != CL_SUCCESS) {
+        return retVal;
+    }
+
+    kernelInfo.kernelTemplate = KernelTemplate::create(kernelInfo);
+
+    auto pKernel = ptrOffset(kernelInfo.heapInfo.pBlob, sizeof(SKernelBinaryHeaderCommon));
+    auto kernelSize = kernelInfo.heapInfo.blobSize - sizeof(SKernelBinaryHeaderCommon);
+    uint32_t kernelCheckSum = kernelInfo.heapInfo.pKernelHeader->CheckSum;
+
+    uint64_t hashValue = Hash::hash(reinterpret_cast<const char *>(pKernel), kernelSize);
+
+    uint32_t calcCheckSum = hashValue & 0xFFFFFFFF;
+    kernelInfo.isValid = (calcCheckSum == kernelCheckSum);
+
+    return CL_SUCCESS;
+}
+
+bool Program::ensurePatchListDecoded(KernelInfo &kernelInfo) const {
+    if (!kernelInfo.patchListDecoded) {
+        std::lock_guard<std::mutex> lock(kernelDecodingMutex);
+        if (!kernelInfo.patchListDecoded) {
+            kernelInfo.patchListDecodingStatus = decodeKernel(kernelInfo);
+            kernelInfo.patchListDecoded = true;
+        }
+    }
+    return kernelInfo.patchListDecodingStatus == CL_SUCCESS;
+}
+
+cl_int Program::decodeKernels() {
+    auto numKernels = kernelInfoArray.size();
+    std::vector<cl_int> decodingStatus(numKernels, CL_SUCCESS);
+    std::atomic<size_t> nextKernel{0};
+
+    auto decode = [&]() {
+        for (auto i = nextKernel++; i < numKernels; i = nextKernel++) {
+            decodingStatus[i] = decodeKernel(*kernelInfoArray[i]);
+        }
+    };
+
+    // patch token logs stay readable when kernels are decoded one after another
+    size_t numThreads = DebugManager.flags.LogPatchTokens.get() ? 1u : std::max(std::thread::hardware_concurrency(), 1u);
+    numThreads = std::min(numThreads, numKernels);
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < numThreads; i++) {
+        workers.emplace_back(decode);
+    }
+    decode();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    for (size_t i = 0; i < numKernels; i++) {
+        if (decodingStatus[i] != CL_SUCCESS) {
+            // leave the kernels a serial decode would have processed before the failing one
+            for (auto j = i; j < numKernels; j++) {
+                delete kernelInfoArray[j];
+            }
+            kernelInfoArray.resize(i);
+            return decodingStatus[i];
+        }
+        kernelInfoArray[i]->patchListDecoded = true;
+        addBlockKernelParent(*kernelInfoArray[i]);
+    }
+    return CL_SUCCESS;
+}
+
+bool Program::hasBlockKernels() const {
+    for (auto &kernelInfo : kernelInfoArray) {
+        if (kernelInfo->name.rfind("_dispatch_") != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Program::addBlockKernelParent(KernelInfo &kernelInfo) {
+    if (kernelInfo.hasDeviceEnqueue()) {
+        parentKernelInfoArray.push_back(&kernelInfo);
+    }
+    if (kernelInfo.requiresSubgroupIndependentForwardProgress()) {
+        subgroupKernelInfoArray.push_back(&kernelInfo);
+    }
+}
+
+cl_int Program::parsePatchList(KernelInfo &kernelInfo) const {
     cl_int retVal = CL_SUCCESS;
 
     auto pPatchList = kernelInfo.heapInfo.pPatchList;
@@ -951,14 +1044,24 @@ cl_int Program::processGenBinary() {
 
         pCurBinaryPtr = ptrOffset(pCurBinaryPtr, pGenBinaryHeader->PatchListSize);
 
+        auto decodingMode = static_cast<PatchListDecoding>(DebugManager.flags.KernelPatchListDecoding.get());
+        bool decodeWhileIndexing = (decodingMode != PatchListDecoding::Lazy) && (decodingMode != PatchListDecoding::EagerParallel);
+
         auto numKernels = pGenBinaryHeader->NumberOfKernels;
         for (uint32_t i = 0; i < numKernels && retVal == CL_SUCCESS; i++) {
 
-            size_t bytesProcessed = processKernel(pCurBinaryPtr, retVal);
+            size_t bytesProcessed = processKernel(pCurBinaryPtr, decodeWhileIndexing, retVal);
             pCurBinaryPtr = ptrOffset(pCurBinaryPtr, bytesProcessed);
         }
+
+        // block kernels are separated from their parents by patch list attributes, so they cannot wait for a lookup
+        if ((retVal == CL_SUCCESS) && !decodeWhileIndexing &&
+            ((decodingMode == PatchListDecoding::EagerParallel) || hasBlockKernels())) {
+            retVal = decodeKernels();
+        }
     } while (false);
 
+    indexKernelInfosByName();
     return retVal;
 }
 
@@ -372,6 +372,7 @@ void Program::separateBlockKernels() {
         }
     }
     allKernelInfos.clear();
+    indexKernelInfosByName();
 }
 
 void Program::allocateBlockPrivateSurfaces() {
@@ -34,6 +34,7 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <mutex>
 
 #define OCLRT_ALIGN(a, b) ((((a) % (b)) != 0) ? ((a) - ((a) % (b)) + (b)) : (a))
 
@@ -47,6 +48,13 @@ struct OpenCLObjectMapper<_cl_program> {
 
 bool isSafeToSkipUnhandledToken(unsigned int token);
 
+// values of the KernelPatchListDecoding debug flag
+enum class PatchListDecoding : int32_t {
+    Eager = 0,
+    Lazy = 1,
+    EagerParallel = 2
+};
+
 class Program : public BaseObject<_cl_program> {
   public:
     static const cl_ulong objectMagic = 0x5651C89100AAACFELL;
@@ -255,9 +263,16 @@ class Program : public BaseObject<_cl_program> {
 
     MOCKABLE_VIRTUAL cl_int rebuildProgramFromLLVM();
 
-    cl_int parsePatchList(KernelInfo &pKernelInfo);
+    cl_int parsePatchList(KernelInfo &pKernelInfo) const;
 
-    size_t processKernel(const void *pKernelBlob, cl_int &retVal);
+    size_t processKernel(const void *pKernelBlob, bool decodePatchList, cl_int &retVal);
+
+    cl_int decodeKernel(KernelInfo &kernelInfo) const;
+    bool ensurePatchListDecoded(KernelInfo &kernelInfo) const;
+    cl_int decodeKernels();
+    void indexKernelInfosByName();
+    bool hasBlockKernels() const;
+    void addBlockKernelParent(KernelInfo &kernelInfo);
 
     void storeBinary(char *&pDst, size_t &dstSize, const void *pSrc, const size_t srcSize);
 
@@ -291,6 +306,7 @@ class Program : public BaseObject<_cl_program> {
     size_t                    debugDataSize;
 
     std::vector<KernelInfo*>  kernelInfoArray;
+    std::unordered_map<std::string, KernelInfo*> kernelInfosByName;
     std::vector<KernelInfo*>  parentKernelInfoArray;
     std::vector<KernelInfo*>  subgroupKernelInfoArray;
     BlockKernelManager *      blockKernelManager;
@@ -324,6 +340,8 @@ class Program : public BaseObject<_cl_program> {
 
     bool                      isBuiltIn;
 
+    mutable std::mutex        kernelDecodingMutex;
+
     friend class OfflineCompiler;
     // clang-format on
 };
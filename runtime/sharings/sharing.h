@@ -55,6 +55,8 @@ class SharingHandler {
     virtual ~SharingHandler() = default;
 
     virtual void getMemObjectInfo(size_t &paramValueSize, void *&paramValue){};
+    // true when the handler, not the memory object, owns the graphics allocation
+    virtual bool retainsGraphicsAllocation() const { return false; }
 
   protected:
     virtual void synchronizeHandler(UpdateData *updateData);
@@ -21,6 +21,7 @@
  */
 #include "runtime/os_interface/debug_settings_manager.h"
 #include "va_sharing_functions.h"
+#include "runtime/sharings/va/va_surface_cache.h"
 #include <dlfcn.h>
 
 namespace Os {
@@ -32,7 +33,7 @@ std::function<void *(const char *, int)> VASharingFunctions::fdlopen = dlopen;
 std::function<void *(void *handle, const char *symbol)> VASharingFunctions::fdlsym = dlsym;
 std::function<int(void *handle)> VASharingFunctions::fdlclose = dlclose;
 
-VASharingFunctions::VASharingFunctions(VADisplay vaDisplay) : vaDisplay(vaDisplay) {
+VASharingFunctions::VASharingFunctions(VADisplay vaDisplay) : vaDisplay(vaDisplay), surfaceCache(new VASurfaceCache) {
     initFunctions();
 };
 
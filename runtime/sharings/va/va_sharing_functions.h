@@ -24,8 +24,11 @@
 #include "runtime/sharings/sharing.h"
 #include "runtime/sharings/va/va_sharing_defines.h"
 #include <functional>
+#include <memory>
 
 namespace OCLRT {
+class VASurfaceCache;
+
 class VASharingFunctions : public SharingFunctions {
   public:
     VASharingFunctions(VADisplay vaDisplay);
@@ -63,6 +66,8 @@ class VASharingFunctions : public SharingFunctions {
         return nullptr;
     }
 
+    VASurfaceCache &getSurfaceCache() { return *surfaceCache; }
+
     void initFunctions();
     static std::function<void *(const char *, int)> fdlopen;
     static std::function<void *(void *handle, const char *symbol)> fdlsym;
@@ -79,5 +84,6 @@ class VASharingFunctions : public SharingFunctions {
     VASyncSurfacePFN vaSyncSurfacePFN;
     VAExtGetSurfaceHandlePFN vaExtGetSurfaceHandlePFN;
     VAGetLibFuncPFN vaGetLibFuncPFN;
+    std::unique_ptr<VASurfaceCache> surfaceCache;
 };
 }
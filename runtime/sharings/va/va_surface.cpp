@@ -35,46 +35,74 @@ Image *VASurface::createSharedVaSurface(Context *context, VASharingFunctions *sh
                                         cl_uint plane, cl_int *errcodeRet) {
     ErrorCodeHelper errorCode(errcodeRet, CL_SUCCESS);
 
-    const auto &hwInfo = context->getDevice(0)->getHardwareInfo();
-    auto memoryManager = context->getMemoryManager();
     unsigned int sharedHandle = 0;
-    VAImage vaImage = {};
-    cl_image_desc imgDesc = {};
     cl_image_format gmmImgFormat = {CL_NV12_INTEL, CL_UNORM_INT8};
     cl_image_format imgFormat = {};
-    const SurfaceFormatInfo *gmmSurfaceFormat = nullptr;
-    const SurfaceFormatInfo *imgSurfaceFormat = nullptr;
-    ImageInfo imgInfo = {0};
-    VAImageID imageId = 0;
     McsSurfaceInfo mcsSurfaceInfo = {};
 
+    auto gmmSurfaceFormat = Image::getSurfaceFormatFromTable(flags, &gmmImgFormat);
+
+    if (plane == 0) {
+        imgFormat = {CL_R, CL_UNORM_INT8};
+    } else if (plane == 1) {
+        imgFormat = {CL_RG, CL_UNORM_INT8};
+    } else {
+        imgFormat = {CL_NV12_INTEL, CL_UNORM_INT8};
+    }
+
+    auto imgSurfaceFormat = Image::getSurfaceFormatFromTable(flags, &imgFormat);
+
+    sharingFunctions->extGetSurfaceHandle(surface, &sharedHandle);
+
+    auto &surfaceCache = sharingFunctions->getSurfaceCache();
+    auto surfaceImport = surfaceCache.find(*surface, plane, sharedHandle, gmmSurfaceFormat);
+    if (!surfaceImport) {
+        surfaceImport = importSurface(context, sharingFunctions, surface, plane, sharedHandle, gmmSurfaceFormat);
+        surfaceCache.insert(surfaceImport);
+    }
+
+    cl_image_desc imgDesc = surfaceImport->imgDesc;
+    ImageInfo imgInfo = surfaceImport->imgInfo;
+    imgInfo.imgDesc = &imgDesc;
+    imgInfo.surfaceFormat = imgSurfaceFormat;
+
+    auto graphicsAllocation = surfaceImport->graphicsAllocation;
+    auto vaSurface = new VASurface(sharingFunctions, surfaceImport->imageId, plane, surface, context->getInteropUserSyncEnabled(), surfaceImport);
+
+    auto image = Image::createSharedImage(context, vaSurface, mcsSurfaceInfo, graphicsAllocation, nullptr, flags, imgInfo, __GMM_NO_CUBE_MAP, 0);
+    image->setMediaPlaneType(plane);
+    return image;
+}
+
+std::shared_ptr<VASurfaceImport> VASurface::importSurface(Context *context, VASharingFunctions *sharingFunctions,
+                                                          VASurfaceID *surface, cl_uint plane, unsigned int sharedHandle,
+                                                          const SurfaceFormatInfo *gmmSurfaceFormat) {
+    const auto &hwInfo = context->getDevice(0)->getHardwareInfo();
+    auto memoryManager = context->getMemoryManager();
+    VAImage vaImage = {};
+
+    std::shared_ptr<VASurfaceImport> surfaceImport(new VASurfaceImport);
+    auto &imgDesc = surfaceImport->imgDesc;
+    auto &imgInfo = surfaceImport->imgInfo;
+
     sharingFunctions->deriveImage(*surface, &vaImage);
 
-    imageId = vaImage.image_id;
     imgInfo.imgDesc = &imgDesc;
     imgDesc.image_width = vaImage.width;
     imgDesc.image_height = vaImage.height;
     imgDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
-    gmmSurfaceFormat = Image::getSurfaceFormatFromTable(flags, &gmmImgFormat);
     imgInfo.surfaceFormat = gmmSurfaceFormat;
 
     if (plane == 0) {
         imgInfo.plane = GMM_PLANE_Y;
-        imgFormat = {CL_R, CL_UNORM_INT8};
     } else if (plane == 1) {
         imgInfo.plane = GMM_PLANE_U;
-        imgFormat = {CL_RG, CL_UNORM_INT8};
     } else {
-        imgFormat = {CL_NV12_INTEL, CL_UNORM_INT8};
         imgInfo.plane = GMM_NO_PLANE;
     }
 
-    imgSurfaceFormat = Image::getSurfaceFormatFromTable(flags, &imgFormat);
-
     sharingFunctions->destroyImage(vaImage.image_id);
 
-    sharingFunctions->extGetSurfaceHandle(surface, &sharedHandle);
-
     auto alloc = memoryManager->createGraphicsAllocationFromSharedHandle(sharedHandle, false, true);
 
     Gmm *gmm = Gmm::createGmmAndQueryImgParams(imgInfo, hwInfo);
@@ -84,17 +112,19 @@ Image *VASurface::createSharedVaSurface(Context *context, VASharingFunctions *sh
     imgDesc.image_row_pitch = imgInfo.rowPitch;
     imgDesc.image_slice_pitch = 0u;
     imgInfo.slicePitch = 0u;
-    imgInfo.surfaceFormat = imgSurfaceFormat;
     if (plane == 1) {
         imgDesc.image_width /= 2;
         imgDesc.image_height /= 2;
     }
 
-    auto vaSurface = new VASurface(sharingFunctions, imageId, plane, surface, context->getInteropUserSyncEnabled());
-
-    auto image = Image::createSharedImage(context, vaSurface, mcsSurfaceInfo, alloc, nullptr, flags, imgInfo, __GMM_NO_CUBE_MAP, 0);
-    image->setMediaPlaneType(plane);
-    return image;
+    surfaceImport->memoryManager = memoryManager;
+    surfaceImport->graphicsAllocation = alloc;
+    surfaceImport->surfaceId = *surface;
+    surfaceImport->plane = plane;
+    surfaceImport->sharedHandle = sharedHandle;
+    surfaceImport->imageId = vaImage.image_id;
+    surfaceImport->gmmSurfaceFormat = gmmSurfaceFormat;
+    return surfaceImport;
 }
 
 void VASurface::synchronizeObject(UpdateData *updateData) {
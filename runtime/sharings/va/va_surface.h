@@ -23,6 +23,9 @@
 #pragma once
 #include "runtime/sharings/va/va_sharing.h"
 #include "runtime/mem_obj/image.h"
+#include "runtime/sharings/va/va_surface_cache.h"
+
+#include <memory>
 
 namespace OCLRT {
 class Context;
@@ -38,13 +41,22 @@ class VASurface : VASharing {
 
     void getMemObjectInfo(size_t &paramValueSize, void *&paramValue) override;
 
+    bool retainsGraphicsAllocation() const override { return true; }
+
   protected:
     VASurface(VASharingFunctions *sharingFunctions, VAImageID imageId,
-              cl_uint plane, VASurfaceID *surfaceId, bool interopUserSync)
-        : VASharing(sharingFunctions, imageId), plane(plane), surfaceId(surfaceId), interopUserSync(interopUserSync){};
+              cl_uint plane, VASurfaceID *surfaceId, bool interopUserSync,
+              std::shared_ptr<VASurfaceImport> surfaceImport)
+        : VASharing(sharingFunctions, imageId), plane(plane), surfaceId(surfaceId), interopUserSync(interopUserSync),
+          surfaceImport(std::move(surfaceImport)){};
+
+    static std::shared_ptr<VASurfaceImport> importSurface(Context *context, VASharingFunctions *sharingFunctions,
+                                                          VASurfaceID *surface, cl_uint plane, unsigned int sharedHandle,
+                                                          const SurfaceFormatInfo *gmmSurfaceFormat);
 
     cl_uint plane;
     VASurfaceID *surfaceId;
     bool interopUserSync;
+    std::shared_ptr<VASurfaceImport> surfaceImport;
 };
 }
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/sharings/va/va_surface_cache.h"
+#include "runtime/memory_manager/memory_manager.h"
+
+namespace OCLRT {
+
+const size_t VASurfaceCache::defaultMaxCachedImports;
+
+VASurfaceImport::~VASurfaceImport() {
+    if (graphicsAllocation) {
+        memoryManager->checkGpuUsageAndDestroyGraphicsAllocations(graphicsAllocation);
+    }
+}
+
+std::shared_ptr<VASurfaceImport> VASurfaceCache::find(VASurfaceID surfaceId, cl_uint plane, unsigned int sharedHandle,
+                                                      const SurfaceFormatInfo *gmmSurfaceFormat) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = imports.find(ImportKey(surfaceId, plane));
+    if (it == imports.end()) {
+        return nullptr;
+    }
+    auto &cachedImport = it->second;
+    if (cachedImport.surfaceImport->sharedHandle != sharedHandle || cachedImport.surfaceImport->gmmSurfaceFormat != gmmSurfaceFormat) {
+        // images still using the stale import keep it alive
+        imports.erase(it);
+        return nullptr;
+    }
+    cachedImport.lastUse = ++useCounter;
+    return cachedImport.surfaceImport;
+}
+
+void VASurfaceCache::insert(std::shared_ptr<VASurfaceImport> surfaceImport) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto key = ImportKey(surfaceImport->surfaceId, surfaceImport->plane);
+    imports[key] = CachedImport{std::move(surfaceImport), ++useCounter};
+    while (imports.size() > maxCachedImports) {
+        evictLeastRecentlyUsed();
+    }
+}
+
+size_t VASurfaceCache::size() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return imports.size();
+}
+
+void VASurfaceCache::evictLeastRecentlyUsed() {
+    auto leastRecentlyUsed = imports.begin();
+    for (auto it = imports.begin(); it != imports.end(); ++it) {
+        if (it->second.lastUse < leastRecentlyUsed->second.lastUse) {
+            leastRecentlyUsed = it;
+        }
+    }
+    imports.erase(leastRecentlyUsed);
+}
+} // namespace OCLRT
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/api/cl_types.h"
+#include "runtime/helpers/surface_formats.h"
+#include "runtime/sharings/va/va_sharing_defines.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace OCLRT {
+class GraphicsAllocation;
+class MemoryManager;
+
+// Imported plane of a VA surface: shared allocation (with its Gmm) and the
+// image layout queried for it. Freed when neither the cache nor any image
+// created from it references it anymore.
+struct VASurfaceImport {
+    ~VASurfaceImport();
+
+    MemoryManager *memoryManager = nullptr;
+    GraphicsAllocation *graphicsAllocation = nullptr;
+    VASurfaceID surfaceId = 0;
+    cl_uint plane = 0;
+    unsigned int sharedHandle = 0;
+    VAImageID imageId = 0;
+    const SurfaceFormatInfo *gmmSurfaceFormat = nullptr;
+    cl_image_desc imgDesc = {};
+    ImageInfo imgInfo = {};
+};
+
+// Per-context cache of VA surface imports keyed by VASurfaceID and plane.
+// The cache keeps its imports alive after their last image is released, so
+// recreating an image of a surface doesn't import it again. An entry is reused
+// only while the surface still reports the same shared handle: VA gives no
+// notification when a surface dies, so a destroyed and reallocated surface id
+// replaces its stale import on the next lookup. Past maxCachedImports entries
+// the least recently used one is evicted; the rest go with the context.
+class VASurfaceCache {
+  public:
+    static const size_t defaultMaxCachedImports = 128;
+
+    VASurfaceCache(size_t maxCachedImports = defaultMaxCachedImports) : maxCachedImports(maxCachedImports) {}
+
+    std::shared_ptr<VASurfaceImport> find(VASurfaceID surfaceId, cl_uint plane, unsigned int sharedHandle,
+                                          const SurfaceFormatInfo *gmmSurfaceFormat);
+    void insert(std::shared_ptr<VASurfaceImport> surfaceImport);
+    size_t size();
+
+  protected:
+    void evictLeastRecentlyUsed();
+
+    typedef std::pair<VASurfaceID, cl_uint> ImportKey;
+    struct CachedImport {
+        std::shared_ptr<VASurfaceImport> surfaceImport;
+        uint64_t lastUse;
+    };
+
+    const size_t maxCachedImports;
+    std::mutex mtx;
+    std::map<ImportKey, CachedImport> imports;
+    uint64_t useCounter = 0;
+};
+} // namespace OCLRT
@@ -49,8 +49,12 @@ TbxSocketsImp::TbxSocketsImp(std::ostream &err)
     : cerrStream(err) {
 }
 
+const size_t TbxSocketsImp::maxBatchSize;
+const size_t TbxSocketsImp::noPendingWrite;
+
 void TbxSocketsImp::close() {
     if (0 != m_socket) {
+        flushWriteData();
 #ifdef WIN32
         ::shutdown(m_socket, 0x02 /*SD_BOTH*/);
 
@@ -159,7 +163,7 @@ bool TbxSocketsImp::readMMIO(uint32_t offset, uint32_t *data) {
         cmd.u.mmio_req.msg_type = MSG_TYPE_MMIO;
         cmd.u.mmio_req.size = sizeof(uint32_t);
 
-        success = sendWriteData(&cmd, sizeof(HAS_HDR) + cmd.hdr.size);
+        success = queueWriteData(&cmd, sizeof(HAS_HDR) + cmd.hdr.size) && flushWriteData();
         if (!success) {
             break;
         }
@@ -196,7 +200,7 @@ bool TbxSocketsImp::writeMMIO(uint32_t offset, uint32_t value) {
     cmd.u.mmio_req.write = 1;
     cmd.u.mmio_req.size = sizeof(uint32_t);
 
-    return sendWriteData(&cmd, sizeof(HAS_HDR) + cmd.hdr.size);
+    return queueWriteData(&cmd, sizeof(HAS_HDR) + cmd.hdr.size);
 }
 
 bool TbxSocketsImp::readMemory(uint64_t addrOffset, void *data, size_t size) {
@@ -215,7 +219,7 @@ bool TbxSocketsImp::readMemory(uint64_t addrOffset, void *data, size_t size) {
 
     bool success;
     do {
-        success = sendWriteData(&cmd, sizeof(HAS_HDR) + sizeof(HAS_READ_DATA_REQ));
+        success = queueWriteData(&cmd, sizeof(HAS_HDR) + sizeof(HAS_READ_DATA_REQ)) && flushWriteData();
         if (!success) {
             break;
         }
@@ -240,6 +244,21 @@ bool TbxSocketsImp::readMemory(uint64_t addrOffset, void *data, size_t size) {
 }
 
 bool TbxSocketsImp::writeMemory(uint64_t physAddr, const void *data, size_t size) {
+    // extend the previous request when this write continues it
+    if (pendingWriteOffset != noPendingWrite && pendingWriteEnd == physAddr &&
+        batch.size() + size <= maxBatchSize) {
+        HAS_MSG pending;
+        memcpy_s(&pending, sizeof(HAS_HDR) + sizeof(HAS_WRITE_DATA_REQ), &batch[pendingWriteOffset], sizeof(HAS_HDR) + sizeof(HAS_WRITE_DATA_REQ));
+        pending.u.write_req.size += static_cast<uint32_t>(size);
+        memcpy_s(&batch[pendingWriteOffset], sizeof(HAS_HDR) + sizeof(HAS_WRITE_DATA_REQ), &pending, sizeof(HAS_HDR) + sizeof(HAS_WRITE_DATA_REQ));
+
+        auto offset = batch.size();
+        batch.resize(offset + size);
+        memcpy_s(&batch[offset], size, data, size);
+        pendingWriteEnd += size;
+        return true;
+    }
+
     HAS_MSG cmd;
     memset(&cmd, 0, sizeof(cmd));
     cmd.hdr.msg_type = HAS_WRITE_DATA_REQ_TYPE;
@@ -256,16 +275,24 @@ bool TbxSocketsImp::writeMemory(uint64_t physAddr, const void *data, size_t size
 
     bool success;
     do {
-        success = sendWriteData(&cmd, sizeof(HAS_HDR) + sizeof(HAS_WRITE_DATA_REQ));
+        success = queueWriteData(&cmd, sizeof(HAS_HDR) + sizeof(HAS_WRITE_DATA_REQ));
         if (!success) {
             break;
         }
+        auto requestOffset = batch.size() - (sizeof(HAS_HDR) + sizeof(HAS_WRITE_DATA_REQ));
+        auto payloadOffset = batch.size();
 
-        success = sendWriteData(data, size);
+        success = queueWriteData(data, size);
         if (!success) {
             cerrStream << "Problem sending write data?" << std::endl;
             break;
         }
+
+        // request and payload are still queued together, keep it open for merging
+        if (batch.size() == payloadOffset + size) {
+            pendingWriteOffset = requestOffset;
+            pendingWriteEnd = physAddr + size;
+        }
     } while (false);
 
     DEBUG_BREAK_IF(!success);
@@ -283,7 +310,36 @@ bool TbxSocketsImp::writeGTT(uint32_t offset, uint64_t entry) {
     cmd.u.gtt64_req.data = static_cast<uint32_t>(entry & 0xffffffff);
     cmd.u.gtt64_req.data_h = static_cast<uint32_t>(entry >> 32);
 
-    return sendWriteData(&cmd, sizeof(HAS_HDR) + cmd.hdr.size);
+    return queueWriteData(&cmd, sizeof(HAS_HDR) + cmd.hdr.size);
+}
+
+bool TbxSocketsImp::queueWriteData(const void *buffer, size_t sizeInBytes) {
+    pendingWriteOffset = noPendingWrite;
+
+    if (batch.size() + sizeInBytes > maxBatchSize) {
+        if (!flushWriteData()) {
+            return false;
+        }
+        if (sizeInBytes > maxBatchSize) {
+            return sendWriteData(buffer, sizeInBytes);
+        }
+    }
+
+    auto offset = batch.size();
+    batch.resize(offset + sizeInBytes);
+    memcpy_s(&batch[offset], sizeInBytes, buffer, sizeInBytes);
+    return true;
+}
+
+bool TbxSocketsImp::flushWriteData() {
+    pendingWriteOffset = noPendingWrite;
+    if (batch.empty()) {
+        return true;
+    }
+
+    auto success = sendWriteData(batch.data(), batch.size());
+    batch.clear();
+    return success;
 }
 
 bool TbxSocketsImp::sendWriteData(const void *buffer, size_t sizeInBytes) {
@@ -23,6 +23,7 @@
 #include "runtime/tbx/tbx_sockets.h"
 #include "os_socket.h"
 #include <iostream>
+#include <vector>
 
 namespace OCLRT {
 
@@ -42,18 +43,31 @@ class TbxSocketsImp : public TbxSockets {
     bool readMMIO(uint32_t offset, uint32_t *data) override;
     bool writeMMIO(uint32_t offset, uint32_t data) override;
 
+    // Write requests are queued and sent in batches, a batch goes out
+    // before any request that waits for a response
+    static const size_t maxBatchSize = 1024 * 1024;
+
   protected:
     std::ostream &cerrStream;
     SOCKET m_socket = 0;
 
     bool connectToServer(const std::string &hostNameOrIp, uint16_t port);
-    bool sendWriteData(const void *buffer, size_t sizeInBytes);
+    MOCKABLE_VIRTUAL bool sendWriteData(const void *buffer, size_t sizeInBytes);
     bool getResponseData(void *buffer, size_t sizeInBytes);
 
+    bool queueWriteData(const void *buffer, size_t sizeInBytes);
+    bool flushWriteData();
+
     inline uint32_t getNextTransID() { return transID++; }
 
     void logErrorInfo(const char *tag);
 
     uint32_t transID = 0;
+
+    std::vector<char> batch;
+    static const size_t noPendingWrite = static_cast<size_t>(-1);
+    // offset in batch of the write data request that is still open for merging
+    size_t pendingWriteOffset = noPendingWrite;
+    uint64_t pendingWriteEnd = 0;
 };
 } // namespace OCLRT
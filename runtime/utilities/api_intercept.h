@@ -23,9 +23,14 @@
 #pragma once
 #include "runtime/utilities/perf_profiler.h"
 #include "runtime/os_interface/debug_settings_manager.h"
+#include "runtime/utilities/api_tracer.h"
 
-#define API_ENTER(retValPointer) \
-    DebugSettingsApiEnterWrapper<DebugManager.debugLoggingAvailable()> ApiWrapperForSingleCall(__FUNCTION__, retValPointer)
+#define API_ENTER(retValPointer)                                                                                             \
+    DebugSettingsApiEnterWrapper<DebugManager.debugLoggingAvailable()> ApiWrapperForSingleCall(__FUNCTION__, retValPointer); \
+    static const uint32_t apiTraceIdForSingleCall = ApiTraceNames::registerName(__FUNCTION__);                               \
+    ApiTraceScope apiTraceScopeForSingleCall(apiTraceIdForSingleCall, retValPointer)
+#define API_TRACE_HANDLES(queue, object) \
+    apiTraceScopeForSingleCall.setHandles(queue, object)
 #define SYSTEM_ENTER()
 #define SYSTEM_LEAVE(id)
 #define WAIT_ENTER()
@@ -33,6 +38,7 @@
 
 #if OCL_RUNTIME_PROFILING == 1
 #undef API_ENTER
+#undef API_TRACE_HANDLES
 #undef SYSTEM_ENTER
 #undef SYSTEM_LEAVE
 #undef WAIT_ENTER
@@ -40,6 +46,7 @@
 
 #define API_ENTER(x) \
     PerfProfilerApiWrapper globalPerfProfilersWrapperInstanceForSingleApiFunction(__FUNCTION__)
+#define API_TRACE_HANDLES(queue, object)
 
 #define SYSTEM_ENTER()      \
     PerfProfiler::create(); \
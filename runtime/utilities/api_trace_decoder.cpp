@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/api_trace_decoder.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace OCLRT {
+
+bool ApiTraceDecoder::load(std::istream &input) {
+    records.clear();
+    apiNames.clear();
+
+    ApiTrace::FileHeader header = {};
+    if (!input.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        header.magic != ApiTrace::fileMagic ||
+        header.version != ApiTrace::fileVersion ||
+        header.recordSize != sizeof(ApiTrace::Record)) {
+        return false;
+    }
+
+    ApiTrace::ChunkHeader chunk = {};
+    while (input.read(reinterpret_cast<char *>(&chunk), sizeof(chunk))) {
+        if (chunk.type == ApiTrace::ChunkType::ApiName) {
+            uint32_t apiId = 0;
+            if (chunk.size < sizeof(apiId) || !input.read(reinterpret_cast<char *>(&apiId), sizeof(apiId))) {
+                return false;
+            }
+            std::string name(chunk.size - sizeof(apiId), '\0');
+            if (!input.read(&name[0], name.size())) {
+                return false;
+            }
+            if (apiNames.size() <= apiId) {
+                apiNames.resize(apiId + 1);
+            }
+            apiNames[apiId] = std::move(name);
+        } else if (chunk.type == ApiTrace::ChunkType::Records) {
+            if (chunk.size % sizeof(ApiTrace::Record) != 0) {
+                return false;
+            }
+            auto first = records.size();
+            records.resize(first + chunk.size / sizeof(ApiTrace::Record));
+            if (!input.read(reinterpret_cast<char *>(records.data() + first), chunk.size)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    // each flush is ordered on its own, merge them into one timeline
+    std::stable_sort(records.begin(), records.end(), [](const ApiTrace::Record &lhs, const ApiTrace::Record &rhs) {
+        return lhs.startNs < rhs.startNs;
+    });
+    return input.eof();
+}
+
+const std::string &ApiTraceDecoder::getApiName(uint32_t apiId) const {
+    if (apiId < apiNames.size() && !apiNames[apiId].empty()) {
+        return apiNames[apiId];
+    }
+    return unknownApiName;
+}
+
+void ApiTraceDecoder::writeChromeTrace(std::ostream &output) const {
+    auto baseNs = records.empty() ? 0u : records.front().startNs;
+
+    output << "{\"traceEvents\":[";
+    const char *separator = "\n";
+    for (auto &record : records) {
+        output << separator << "{\"name\":\"" << getApiName(record.apiId) << "\",\"cat\":\"api\",\"ph\":\"X\""
+               << ",\"pid\":0,\"tid\":" << record.threadId
+               << std::fixed << std::setprecision(3)
+               << ",\"ts\":" << static_cast<double>(record.startNs - baseNs) / 1000.0
+               << ",\"dur\":" << static_cast<double>(record.durationNs) / 1000.0
+               << ",\"args\":{\"queue\":\"0x" << std::hex << record.queue
+               << "\",\"object\":\"0x" << record.object << std::dec
+               << "\",\"retVal\":" << record.retVal << "}}";
+        separator = ",\n";
+    }
+    output << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+} // namespace OCLRT
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/utilities/api_trace_format.h"
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace OCLRT {
+
+// Reads binary files produced by ApiTracer and converts them to
+// the Chrome trace event format (chrome://tracing, Perfetto).
+class ApiTraceDecoder {
+  public:
+    bool load(std::istream &input);
+
+    const std::vector<ApiTrace::Record> &getRecords() const { return records; }
+    const std::string &getApiName(uint32_t apiId) const;
+
+    void writeChromeTrace(std::ostream &output) const;
+
+  protected:
+    std::vector<ApiTrace::Record> records;
+    std::vector<std::string> apiNames;
+    std::string unknownApiName = "unknown";
+};
+} // namespace OCLRT
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace OCLRT {
+namespace ApiTrace {
+// Trace file layout: FileHeader followed by a sequence of chunks, each being
+// a ChunkHeader and its payload. ApiName chunks always precede the first
+// Records chunk referencing their id.
+constexpr uint32_t fileMagic = 0x52544c43; // "CLTR"
+constexpr uint32_t fileVersion = 1;
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t reserved;
+};
+
+enum class ChunkType : uint32_t {
+    ApiName = 1, // uint32_t apiId followed by the name, not null terminated
+    Records = 2  // array of Record
+};
+
+struct ChunkHeader {
+    ChunkType type;
+    uint32_t size;
+};
+
+struct Record {
+    uint64_t startNs;
+    uint64_t durationNs;
+    uint64_t queue;
+    uint64_t object;
+    uint32_t apiId;
+    uint32_t threadId;
+    int32_t retVal;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 16, "trace file header must not change size");
+static_assert(sizeof(ChunkHeader) == 8, "trace chunk header must not change size");
+static_assert(sizeof(Record) == 48, "trace record must not change size");
+} // namespace ApiTrace
+} // namespace OCLRT
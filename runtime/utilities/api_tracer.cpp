@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/api_tracer.h"
+#include "runtime/helpers/basic_math.h"
+#include "runtime/os_interface/debug_settings_manager.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace OCLRT {
+
+namespace {
+std::mutex apiNamesMutex;
+std::vector<const char *> apiNames;
+std::atomic<uint64_t> tracerIdCounter{0};
+
+struct CurrentThreadRing {
+    ~CurrentThreadRing() {
+        if (ring != nullptr) {
+            ApiTracer::releaseRingOfExitedThread(tracerId, *ring);
+        }
+    }
+
+    uint64_t tracerId = 0;
+    ApiTraceRing *ring = nullptr;
+};
+thread_local CurrentThreadRing currentThreadRing;
+
+// the global tracer is never destroyed, API calls can still reach it during static destruction
+std::atomic<ApiTracer *> globalTracer{nullptr};
+std::once_flag globalTracerCreated;
+
+ApiTracer *createGlobalTracer() {
+    if (!DebugManager.flags.EnableApiTracing.get()) {
+        return nullptr;
+    }
+    std::unique_ptr<std::ofstream> traceFile(new std::ofstream(DebugManager.flags.ApiTraceFile.get(), std::ios::binary | std::ios::trunc));
+    if (!traceFile->is_open()) {
+        return nullptr;
+    }
+    std::unique_ptr<ApiTracer> tracer(new ApiTracer(std::move(traceFile)));
+    tracer->startFlusher(std::chrono::milliseconds(DebugManager.flags.ApiTraceFlushPeriodMs.get()));
+    return tracer.release();
+}
+} // namespace
+
+std::mutex ApiTracer::liveTracersMutex;
+ApiTracer *ApiTracer::liveTracers = nullptr;
+
+uint32_t ApiTraceNames::registerName(const char *name) {
+    std::lock_guard<std::mutex> lock(apiNamesMutex);
+    for (uint32_t id = 0; id < apiNames.size(); id++) {
+        if (apiNames[id] == name || strcmp(apiNames[id], name) == 0) {
+            return id;
+        }
+    }
+    apiNames.push_back(name);
+    return static_cast<uint32_t>(apiNames.size() - 1);
+}
+
+size_t ApiTraceNames::getNames(std::vector<const char *> &names, size_t firstId) {
+    std::lock_guard<std::mutex> lock(apiNamesMutex);
+    for (auto id = firstId; id < apiNames.size(); id++) {
+        names.push_back(apiNames[id]);
+    }
+    return apiNames.size();
+}
+
+ApiTraceRing::ApiTraceRing(uint32_t threadId, size_t capacity) : threadId(threadId) {
+    capacity = Math::nextPowerOfTwo(static_cast<uint32_t>(std::max(capacity, static_cast<size_t>(2))));
+    records.reset(new ApiTrace::Record[capacity]);
+    mask = capacity - 1;
+}
+
+size_t ApiTraceRing::drain(std::vector<ApiTrace::Record> &out) {
+    auto read = readIndex.load(std::memory_order_relaxed);
+    auto write = writeIndex.load(std::memory_order_acquire);
+    auto count = static_cast<size_t>(write - read);
+    for (; read != write; read++) {
+        out.push_back(records[read & mask]);
+    }
+    readIndex.store(read, std::memory_order_release);
+    return count;
+}
+
+ApiTracer::ApiTracer(std::unique_ptr<std::ostream> stream, size_t ringCapacity)
+    : tracerId(++tracerIdCounter), ringCapacity(ringCapacity), stream(std::move(stream)) {
+    ApiTrace::FileHeader header = {ApiTrace::fileMagic, ApiTrace::fileVersion, sizeof(ApiTrace::Record), 0};
+    this->stream->write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    std::lock_guard<std::mutex> lock(liveTracersMutex);
+    nextLiveTracer = liveTracers;
+    liveTracers = this;
+}
+
+ApiTracer::~ApiTracer() {
+    {
+        std::lock_guard<std::mutex> lock(liveTracersMutex);
+        auto link = &liveTracers;
+        while (*link != this) {
+            link = &(*link)->nextLiveTracer;
+        }
+        *link = nextLiveTracer;
+    }
+    stopFlusher();
+    flush();
+}
+
+ApiTracer *ApiTracer::getGlobal() {
+    createGlobalOnce();
+    return globalTracer.load(std::memory_order_acquire);
+}
+
+void ApiTracer::createGlobalOnce() {
+    std::call_once(globalTracerCreated, []() {
+        auto tracer = createGlobalTracer();
+        if (tracer != nullptr) {
+            globalTracer.store(tracer, std::memory_order_release);
+            atexit(ApiTracer::shutdownGlobal);
+        }
+    });
+}
+
+ApiTracer *ApiTracer::replaceGlobal(ApiTracer *newTracer) {
+    createGlobalOnce();
+    return globalTracer.exchange(newTracer, std::memory_order_acq_rel);
+}
+
+void ApiTracer::shutdownGlobal() {
+    // later calls trace nothing, calls already holding the tracer keep a valid object
+    auto tracer = globalTracer.exchange(nullptr, std::memory_order_acq_rel);
+    if (tracer != nullptr) {
+        tracer->stopFlusher();
+        tracer->flush();
+    }
+}
+
+ApiTraceRing &ApiTracer::getRingForCurrentThread() {
+    if (currentThreadRing.tracerId != tracerId) {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        ApiTraceRing *ring = nullptr;
+        if (!freeRings.empty()) {
+            // unflushed records of the exited thread stay queued ahead of the new ones
+            ring = freeRings.back();
+            freeRings.pop_back();
+            ring->setThreadId(nextThreadId++);
+        } else {
+            rings.emplace_back(new ApiTraceRing(nextThreadId++, ringCapacity));
+            ring = rings.back().get();
+        }
+        currentThreadRing.tracerId = tracerId;
+        currentThreadRing.ring = ring;
+    }
+    return *currentThreadRing.ring;
+}
+
+void ApiTracer::releaseRingOfExitedThread(uint64_t tracerId, ApiTraceRing &ring) {
+    // the tracer may already be gone, its rings were flushed and freed with it
+    std::lock_guard<std::mutex> tracersLock(liveTracersMutex);
+    for (auto tracer = liveTracers; tracer != nullptr; tracer = tracer->nextLiveTracer) {
+        if (tracer->tracerId == tracerId) {
+            std::lock_guard<std::mutex> lock(tracer->ringsMutex);
+            tracer->freeRings.push_back(&ring);
+            return;
+        }
+    }
+}
+
+size_t ApiTracer::peekRingsCount() {
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    return rings.size();
+}
+
+void ApiTracer::record(uint32_t apiId, uint64_t startNs, uint64_t durationNs, const void *queue, const void *object, int32_t retVal) {
+    auto &ring = getRingForCurrentThread();
+    ApiTrace::Record record = {startNs,
+                               durationNs,
+                               reinterpret_cast<uintptr_t>(queue),
+                               reinterpret_cast<uintptr_t>(object),
+                               apiId,
+                               ring.getThreadId(),
+                               retVal,
+                               0};
+    ring.push(record);
+}
+
+void ApiTracer::writeApiNames() {
+    newApiNames.clear();
+    auto namesCount = ApiTraceNames::getNames(newApiNames, apiNamesWritten);
+    for (auto name : newApiNames) {
+        auto apiId = static_cast<uint32_t>(apiNamesWritten++);
+        auto nameLength = static_cast<uint32_t>(strlen(name));
+        ApiTrace::ChunkHeader chunk = {ApiTrace::ChunkType::ApiName, static_cast<uint32_t>(sizeof(apiId)) + nameLength};
+        stream->write(reinterpret_cast<const char *>(&chunk), sizeof(chunk));
+        stream->write(reinterpret_cast<const char *>(&apiId), sizeof(apiId));
+        stream->write(name, nameLength);
+    }
+    apiNamesWritten = namesCount;
+}
+
+void ApiTracer::flush() {
+    std::lock_guard<std::mutex> streamLock(streamMutex);
+    drainedRecords.clear();
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        for (auto &ring : rings) {
+            ring->drain(drainedRecords);
+        }
+    }
+    if (drainedRecords.empty()) {
+        return;
+    }
+
+    // records of one flush are written in timestamp order, the decoder merges flushes
+    std::stable_sort(drainedRecords.begin(), drainedRecords.end(), [](const ApiTrace::Record &lhs, const ApiTrace::Record &rhs) {
+        return lhs.startNs < rhs.startNs;
+    });
+
+    writeApiNames();
+
+    ApiTrace::ChunkHeader chunk = {ApiTrace::ChunkType::Records, static_cast<uint32_t>(drainedRecords.size() * sizeof(ApiTrace::Record))};
+    stream->write(reinterpret_cast<const char *>(&chunk), sizeof(chunk));
+    stream->write(reinterpret_cast<const char *>(drainedRecords.data()), chunk.size);
+    stream->flush();
+}
+
+void ApiTracer::startFlusher(std::chrono::milliseconds period) {
+    std::lock_guard<std::mutex> lock(flusherMutex);
+    if (flusherThread.joinable()) {
+        return;
+    }
+    stopRequested = false;
+    flusherThread = std::thread([this, period] { flushFunction(period); });
+}
+
+void ApiTracer::stopFlusher() {
+    {
+        std::lock_guard<std::mutex> lock(flusherMutex);
+        stopRequested = true;
+    }
+    flusherCondition.notify_one();
+    if (flusherThread.joinable()) {
+        flusherThread.join();
+    }
+}
+
+void ApiTracer::flushFunction(std::chrono::milliseconds period) {
+    std::unique_lock<std::mutex> lock(flusherMutex);
+    while (!stopRequested) {
+        flusherCondition.wait_for(lock, period, [this] { return stopRequested; });
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+uint64_t ApiTracer::peekDroppedCount() {
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    uint64_t droppedCount = 0;
+    for (auto &ring : rings) {
+        droppedCount += ring->peekDroppedCount();
+    }
+    return droppedCount;
+}
+} // namespace OCLRT
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include "runtime/utilities/api_trace_format.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace OCLRT {
+
+// Process wide table of traced api names, ids are stable for the process lifetime.
+class ApiTraceNames {
+  public:
+    static uint32_t registerName(const char *name);
+    static size_t getNames(std::vector<const char *> &names, size_t firstId);
+};
+
+// Single producer (owning thread), single consumer (flusher) ring of trace records.
+// When the consumer falls behind, new records are dropped and counted.
+class ApiTraceRing {
+  public:
+    static const size_t defaultCapacity = 4096;
+
+    ApiTraceRing(uint32_t threadId, size_t capacity);
+    ApiTraceRing(const ApiTraceRing &) = delete;
+    ApiTraceRing &operator=(const ApiTraceRing &) = delete;
+
+    bool push(const ApiTrace::Record &record) {
+        auto write = writeIndex.load(std::memory_order_relaxed);
+        if (write - readIndex.load(std::memory_order_acquire) > mask) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        records[write & mask] = record;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t drain(std::vector<ApiTrace::Record> &out);
+
+    uint32_t getThreadId() const { return threadId; }
+    void setThreadId(uint32_t newThreadId) { threadId = newThreadId; }
+    size_t getCapacity() const { return mask + 1; }
+    uint64_t peekDroppedCount() const { return droppedCount.load(std::memory_order_relaxed); }
+
+  protected:
+    std::unique_ptr<ApiTrace::Record[]> records;
+    size_t mask;
+    uint32_t threadId;
+    std::atomic<uint64_t> writeIndex{0};
+    std::atomic<uint64_t> readIndex{0};
+    std::atomic<uint64_t> droppedCount{0};
+};
+
+class ApiTracer {
+  public:
+    ApiTracer(std::unique_ptr<std::ostream> stream, size_t ringCapacity = ApiTraceRing::defaultCapacity);
+    ~ApiTracer();
+    ApiTracer(const ApiTracer &) = delete;
+    ApiTracer &operator=(const ApiTracer &) = delete;
+
+    static ApiTracer *getGlobal();
+    // Registered with atexit, flushes the global tracer and stops handing it out.
+    static void shutdownGlobal();
+    static ApiTracer *replaceGlobal(ApiTracer *newTracer);
+
+    static uint64_t getTimestampNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void record(uint32_t apiId, uint64_t startNs, uint64_t durationNs, const void *queue, const void *object, int32_t retVal);
+    ApiTraceRing &getRingForCurrentThread();
+    // Called on thread exit, the ring is handed to the next thread which starts tracing.
+    static void releaseRingOfExitedThread(uint64_t tracerId, ApiTraceRing &ring);
+
+    void flush();
+    void startFlusher(std::chrono::milliseconds period);
+    void stopFlusher();
+
+    std::ostream *getStream() { return stream.get(); }
+    uint64_t peekDroppedCount();
+    size_t peekRingsCount();
+
+  protected:
+    static void createGlobalOnce();
+    void flushFunction(std::chrono::milliseconds period);
+    void writeApiNames();
+
+    const uint64_t tracerId;
+    const size_t ringCapacity;
+
+    std::mutex ringsMutex;
+    std::vector<std::unique_ptr<ApiTraceRing>> rings;
+    std::vector<ApiTraceRing *> freeRings;
+    uint32_t nextThreadId = 0;
+
+    static std::mutex liveTracersMutex;
+    static ApiTracer *liveTracers;
+    ApiTracer *nextLiveTracer = nullptr;
+
+    std::mutex streamMutex;
+    std::unique_ptr<std::ostream> stream;
+    std::vector<ApiTrace::Record> drainedRecords;
+    std::vector<const char *> newApiNames;
+    size_t apiNamesWritten = 0;
+
+    std::mutex flusherMutex;
+    std::condition_variable flusherCondition;
+    std::thread flusherThread;
+    bool stopRequested = false;
+};
+
+class ApiTraceScope {
+  public:
+    ApiTraceScope(uint32_t apiId, const int *retVal)
+        : tracer(ApiTracer::getGlobal()), apiId(apiId), retVal(retVal) {
+        if (tracer) {
+            startNs = ApiTracer::getTimestampNs();
+        }
+    }
+
+    ~ApiTraceScope() {
+        if (tracer) {
+            tracer->record(apiId, startNs, ApiTracer::getTimestampNs() - startNs, queue, object, retVal ? *retVal : 0);
+        }
+    }
+
+    void setHandles(const void *queue, const void *object) {
+        this->queue = queue;
+        this->object = object;
+    }
+
+  protected:
+    ApiTracer *tracer;
+    uint32_t apiId;
+    const int *retVal;
+    uint64_t startNs = 0;
+    const void *queue = nullptr;
+    const void *object = nullptr;
+};
+} // namespace OCLRT
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/slab_allocator.h"
+#include "runtime/helpers/aligned_memory.h"
+
+namespace OCLRT {
+
+const size_t SlabAllocator::blockAlignment;
+const size_t SlabCache::capacity;
+
+SlabAllocator::SlabAllocator(size_t blockSize, size_t blocksPerSlab)
+    : blockSize(alignUp(blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize, blockAlignment)),
+      blocksPerSlab(blocksPerSlab ? blocksPerSlab : 1) {
+}
+
+SlabAllocator::~SlabAllocator() {
+    while (slabs) {
+        auto next = slabs->next;
+        delete[] reinterpret_cast<uint8_t *>(slabs);
+        slabs = next;
+    }
+}
+
+bool SlabAllocator::addSlab() {
+    auto memory = new (std::nothrow) uint8_t[blockAlignment + blockSize * blocksPerSlab];
+    if (memory == nullptr) {
+        return false;
+    }
+    auto slab = reinterpret_cast<Slab *>(memory);
+    slab->next = slabs;
+    slabs = slab;
+    slabCount++;
+
+    auto firstBlock = memory + blockAlignment;
+    for (size_t i = blocksPerSlab; i > 0; i--) {
+        auto block = reinterpret_cast<FreeBlock *>(firstBlock + (i - 1) * blockSize);
+        block->next = freeList;
+        freeList = block;
+    }
+    freeBlockCount += blocksPerSlab;
+    return true;
+}
+
+void *SlabAllocator::allocate() {
+    void *block = nullptr;
+    allocateBatch(&block, 1);
+    return block;
+}
+
+void SlabAllocator::release(void *block) {
+    releaseBatch(&block, 1);
+}
+
+size_t SlabAllocator::allocateBatch(void **blocks, size_t count) {
+    std::lock_guard<std::mutex> lock(mtx);
+    size_t allocated = 0;
+    while (allocated < count) {
+        if (freeList == nullptr && !addSlab()) {
+            break;
+        }
+        blocks[allocated++] = freeList;
+        freeList = freeList->next;
+        freeBlockCount--;
+    }
+    return allocated;
+}
+
+void SlabAllocator::releaseBatch(void *const *blocks, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mtx);
+    for (size_t i = 0; i < count; i++) {
+        auto block = static_cast<FreeBlock *>(blocks[i]);
+        block->next = freeList;
+        freeList = block;
+    }
+    freeBlockCount += count;
+}
+
+size_t SlabAllocator::getSlabCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return slabCount;
+}
+
+size_t SlabAllocator::getFreeBlockCount() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return freeBlockCount;
+}
+} // namespace OCLRT
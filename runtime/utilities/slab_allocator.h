@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace OCLRT {
+
+// Fixed-size block allocator carving blocks out of larger slabs.
+// Freed blocks are kept on an intrusive free list and reused; slabs are
+// returned to the heap only when the allocator is destroyed.
+class SlabAllocator {
+  public:
+    SlabAllocator(size_t blockSize, size_t blocksPerSlab);
+    ~SlabAllocator();
+
+    SlabAllocator(const SlabAllocator &) = delete;
+    SlabAllocator &operator=(const SlabAllocator &) = delete;
+
+    void *allocate();
+    void release(void *block);
+
+    // Moves up to count blocks into / out of the free list under a single lock
+    size_t allocateBatch(void **blocks, size_t count);
+    void releaseBatch(void *const *blocks, size_t count);
+
+    size_t getBlockSize() const { return blockSize; }
+    size_t getBlocksPerSlab() const { return blocksPerSlab; }
+    size_t getSlabCount();
+    size_t getFreeBlockCount();
+
+    static const size_t blockAlignment = 16;
+
+  protected:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+    struct Slab {
+        Slab *next;
+    };
+
+    bool addSlab();
+
+    const size_t blockSize;
+    const size_t blocksPerSlab;
+
+    std::mutex mtx;
+    FreeBlock *freeList = nullptr;
+    Slab *slabs = nullptr;
+    size_t slabCount = 0;
+    size_t freeBlockCount = 0;
+};
+
+// Small per-thread stash of blocks in front of a shared SlabAllocator.
+// Blocks move between the stash and the shared free list in half-capacity
+// batches, so steady alloc/free traffic on one thread never takes the lock.
+struct SlabCache {
+    static const size_t capacity = 32;
+
+    void *allocate(SlabAllocator &allocator) {
+        if (count == 0) {
+            count = allocator.allocateBatch(blocks, capacity / 2);
+            if (count == 0) {
+                return nullptr;
+            }
+        }
+        return blocks[--count];
+    }
+
+    void release(SlabAllocator &allocator, void *block) {
+        if (count == capacity) {
+            allocator.releaseBatch(blocks + capacity / 2, capacity / 2);
+            count = capacity / 2;
+        }
+        blocks[count++] = block;
+    }
+
+    void flush(SlabAllocator &allocator) {
+        allocator.releaseBatch(blocks, count);
+        count = 0;
+    }
+
+    void *blocks[capacity];
+    size_t count = 0;
+};
+
+// Power-of-two size classes of slab allocators, one set per Tag type, with a
+// SlabCache per size class on every thread. Each block carries a small header
+// recording its size class, so release() doesn't need the allocation size.
+// Requests above the largest class fall back to the global heap.
+// The shared allocators are never destroyed: objects may be released from
+// static destructors after all thread-local caches are gone.
+template <typename Tag>
+class SizeClassSlabAllocator {
+  public:
+    static const size_t headerSize = SlabAllocator::blockAlignment;
+    static const uint32_t minBlockSizeShift = 6;
+    static const uint32_t numSizeClasses = 8;
+    static const uint32_t heapSizeClass = numSizeClasses;
+    static const size_t slabSize = 64 * 1024;
+
+    static void *allocate(size_t size) noexcept {
+        auto sizeClass = getSizeClass(size);
+        void *block = nullptr;
+        if (sizeClass == heapSizeClass) {
+            block = ::operator new(size + headerSize, std::nothrow);
+        } else {
+            auto &allocator = getSharedAllocator(sizeClass);
+            if (threadCachesReleased) {
+                block = allocator.allocate();
+            } else {
+                block = getThreadCaches().caches[sizeClass].allocate(allocator);
+            }
+        }
+        if (block == nullptr) {
+            return nullptr;
+        }
+        *static_cast<uint32_t *>(block) = sizeClass;
+        return static_cast<uint8_t *>(block) + headerSize;
+    }
+
+    static void release(void *ptr) noexcept {
+        if (ptr == nullptr) {
+            return;
+        }
+        void *block = static_cast<uint8_t *>(ptr) - headerSize;
+        auto sizeClass = *static_cast<uint32_t *>(block);
+        if (sizeClass == heapSizeClass) {
+            ::operator delete(block);
+            return;
+        }
+        auto &allocator = getSharedAllocator(sizeClass);
+        if (threadCachesReleased) {
+            allocator.release(block);
+        } else {
+            getThreadCaches().caches[sizeClass].release(allocator, block);
+        }
+    }
+
+    static uint32_t getSizeClass(size_t size) {
+        size_t blockSize = size_t(1) << minBlockSizeShift;
+        for (uint32_t sizeClass = 0; sizeClass < numSizeClasses; sizeClass++, blockSize <<= 1) {
+            if (size + headerSize <= blockSize) {
+                return sizeClass;
+            }
+        }
+        return heapSizeClass;
+    }
+
+  protected:
+    struct ThreadCaches {
+        ~ThreadCaches() {
+            for (uint32_t sizeClass = 0; sizeClass < numSizeClasses; sizeClass++) {
+                caches[sizeClass].flush(getSharedAllocator(sizeClass));
+            }
+            threadCachesReleased = true;
+        }
+        SlabCache caches[numSizeClasses];
+    };
+
+    static ThreadCaches &getThreadCaches() {
+        static thread_local ThreadCaches threadCaches;
+        return threadCaches;
+    }
+
+    static SlabAllocator &getSharedAllocator(uint32_t sizeClass) {
+        static SlabAllocator **allocators = createSharedAllocators();
+        return *allocators[sizeClass];
+    }
+
+    static SlabAllocator **createSharedAllocators() {
+        auto allocators = new SlabAllocator *[numSizeClasses];
+        for (uint32_t sizeClass = 0; sizeClass < numSizeClasses; sizeClass++) {
+            size_t blockSize = size_t(1) << (minBlockSizeShift + sizeClass);
+            allocators[sizeClass] = new SlabAllocator(blockSize, slabSize / blockSize);
+        }
+        return allocators;
+    }
+
+    static thread_local bool threadCachesReleased;
+};
+
+template <typename Tag>
+const size_t SizeClassSlabAllocator<Tag>::headerSize;
+template <typename Tag>
+const uint32_t SizeClassSlabAllocator<Tag>::minBlockSizeShift;
+template <typename Tag>
+const uint32_t SizeClassSlabAllocator<Tag>::numSizeClasses;
+template <typename Tag>
+const uint32_t SizeClassSlabAllocator<Tag>::heapSizeClass;
+template <typename Tag>
+const size_t SizeClassSlabAllocator<Tag>::slabSize;
+template <typename Tag>
+thread_local bool SizeClassSlabAllocator<Tag>::threadCachesReleased = false;
+} // namespace OCLRT
@@ -31,7 +31,9 @@
 #include "runtime/platform/platform.h"
 #include "runtime/program/program.h"
 #include "runtime/sampler/sampler.h"
+#include "runtime/utilities/slab_allocator.h"
 
+#include <atomic>
 #include <mutex>
 
 // *********************************************************************** //
@@ -41,28 +43,70 @@
 
 unsigned int numBaseObjects = 0;
 std::mutex numBaseObjectsMutex;
+// set by tests that exercise the runtime's slab allocator, the per-test leak listener must be off for them
+std::atomic<bool> baseObjectsFromSlabAllocator(false);
 
 namespace OCLRT {
 
+namespace {
+// heap blocks carry the same header as slab blocks, so objects created before
+// a test switched allocators are still released to the right one
+const uint32_t heapBlockMarker = 0xffffffffu;
+
+template <typename B>
+using RuntimeAllocator = SizeClassSlabAllocator<BaseObject<B>>;
+
+template <typename B>
+void *allocateBaseObject(size_t sz, bool throwOnFailure) {
+    if (baseObjectsFromSlabAllocator) {
+        auto ptr = RuntimeAllocator<B>::allocate(sz);
+        if (ptr == nullptr && throwOnFailure) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+    auto headerSize = RuntimeAllocator<B>::headerSize;
+    void *block = throwOnFailure ? ::operator new(sz + headerSize) : ::operator new(sz + headerSize, std::nothrow);
+    if (block == nullptr) {
+        return nullptr;
+    }
+    *static_cast<uint32_t *>(block) = heapBlockMarker;
+    return static_cast<uint8_t *>(block) + headerSize;
+}
+
+template <typename B>
+void releaseBaseObject(void *ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+    void *block = static_cast<uint8_t *>(ptr) - RuntimeAllocator<B>::headerSize;
+    if (*static_cast<uint32_t *>(block) == heapBlockMarker) {
+        ::operator delete(block);
+        return;
+    }
+    RuntimeAllocator<B>::release(ptr);
+}
+} // namespace
+
 template <typename B>
 void *BaseObject<B>::operator new(size_t sz) {
+    auto ptr = allocateBaseObject<B>(sz, true);
     std::lock_guard<std::mutex> lock(numBaseObjectsMutex);
     ++numBaseObjects;
-    void *ptr = ::operator new(sz);
     return ptr;
 }
 
 template <typename B>
 void BaseObject<B>::operator delete(void *ptr, size_t) {
+    releaseBaseObject<B>(ptr);
     std::lock_guard<std::mutex> lock(numBaseObjectsMutex);
     --numBaseObjects;
-    return ::operator delete(ptr);
 }
 
 template <typename B>
 void *BaseObject<B>::operator new(size_t sz, const std::nothrow_t &tag) noexcept {
+    auto ptr = allocateBaseObject<B>(sz, false);
     std::lock_guard<std::mutex> lock(numBaseObjectsMutex);
-    void *ptr = ::operator new(sz, tag);
     if (ptr)
         ++numBaseObjects;
     return ptr;
@@ -70,9 +114,9 @@ void *BaseObject<B>::operator new(size_t sz, const std::nothrow_t &tag) noexcept
 
 template <typename B>
 void BaseObject<B>::operator delete(void *ptr, const std::nothrow_t &tag) noexcept {
+    releaseBaseObject<B>(ptr);
     std::lock_guard<std::mutex> lock(numBaseObjectsMutex);
     --numBaseObjects;
-    return ::operator delete(ptr, tag);
 }
 
 template class BaseObject<_cl_accelerator_intel>;
@@ -23,6 +23,10 @@
 #include "gtest/gtest.h"
 #include "runtime/builtin_kernels_simulation/opencl_c.h"
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 //#include "unit_tests/test_files/4265157215134882557.cl"
 
 namespace BuiltinKernelsSimulation {
@@ -64,6 +68,82 @@ __kernel void CopyImage3dToBuffer16Bytes(__read_only image3d_t input,
     }
 }
 
+template <typename ElementT>
+__kernel void CopyBufferRect2d(__global const ElementT *src,
+                               __global ElementT *dst,
+                               uint4 SrcOrigin,
+                               uint4 DstOrigin,
+                               uint2 SrcPitch,
+                               uint2 DstPitch) {
+    int x = get_global_id(0);
+    int y = get_global_id(1);
+
+    uint LSrcOffset = x + SrcOrigin.x + ((y + SrcOrigin.y) * SrcPitch.x);
+    uint LDstOffset = x + DstOrigin.x + ((y + DstOrigin.y) * DstPitch.x);
+
+    *(dst + LDstOffset) = *(src + LSrcOffset);
+}
+
+template <typename ElementT>
+__kernel void CopyBufferRect3d(__global const ElementT *src,
+                               __global ElementT *dst,
+                               uint4 SrcOrigin,
+                               uint4 DstOrigin,
+                               uint2 SrcPitch,
+                               uint2 DstPitch) {
+    int x = get_global_id(0);
+    int y = get_global_id(1);
+    int z = get_global_id(2);
+
+    uint LSrcOffset = x + SrcOrigin.x + ((y + SrcOrigin.y) * SrcPitch.x) + ((z + SrcOrigin.z) * SrcPitch.y);
+    uint LDstOffset = x + DstOrigin.x + ((y + DstOrigin.y) * DstPitch.x) + ((z + DstOrigin.z) * DstPitch.y);
+
+    *(dst + LDstOffset) = *(src + LSrcOffset);
+}
+
+__kernel void CopyBufferToBufferLeftLeftover(const __global uchar *pSrc,
+                                             __global uchar *pDst,
+                                             uint srcOffsetInBytes,
+                                             uint dstOffsetInBytes) {
+    unsigned int gid = get_global_id(0);
+    pDst[gid + dstOffsetInBytes] = pSrc[gid + srcOffsetInBytes];
+}
+
+__kernel void CopyBufferToBufferMiddle(const __global uint *pSrc,
+                                       __global uint *pDst,
+                                       uint srcOffsetInBytes,
+                                       uint dstOffsetInBytes) {
+    unsigned int gid = get_global_id(0);
+    pDst += dstOffsetInBytes >> 2;
+    pSrc += srcOffsetInBytes >> 2;
+    for (uint i = 0; i < 4; i++) {
+        pDst[gid * 4 + i] = pSrc[gid * 4 + i];
+    }
+}
+
+__kernel void CopyBufferToBufferMiddleMisaligned(const __global uchar *pSrc,
+                                                 __global uint *pDst,
+                                                 uint srcOffsetInBytes,
+                                                 uint dstOffsetInBytes,
+                                                 uint misalignmentInBits) {
+    unsigned int gid = get_global_id(0);
+    pDst += dstOffsetInBytes >> 2;
+    const __global uint *pAlignedSrc = (const __global uint *)(pSrc + srcOffsetInBytes - (misalignmentInBits >> 3));
+    for (uint i = 0; i < 4; i++) {
+        uint loaded = pAlignedSrc[gid * 4 + i];
+        uint shifted = pAlignedSrc[gid * 4 + i + 1];
+        pDst[gid * 4 + i] = (loaded >> misalignmentInBits) | (shifted << (32 - misalignmentInBits));
+    }
+}
+
+__kernel void CopyBufferToBufferRightLeftover(const __global uchar *pSrc,
+                                              __global uchar *pDst,
+                                              uint srcOffsetInBytes,
+                                              uint dstOffsetInBytes) {
+    unsigned int gid = get_global_id(0);
+    pDst[gid + dstOffsetInBytes] = pSrc[gid + srcOffsetInBytes];
+}
+
 TEST(BuiltInKernelTests, ReadImage) {
 
     uint width = 3;
@@ -138,4 +218,152 @@ TEST(BuiltInKernelTests, ReadImage) {
     delete[] ptrDst;
     delete[] ptrZero;
 }
+
+struct alignas(16) AlignedStorageChunk {
+    uchar bytes[16];
+};
+
+template <typename ElementT>
+void verifyCopyBufferRect(std::mt19937 &generator, bool is3D) {
+    const uint elementSize = sizeof(ElementT);
+    auto random = [&generator](uint min, uint max) {
+        return std::uniform_int_distribution<uint>(min, max)(generator);
+    };
+
+    // geometry in bytes, x extents and pitches kept multiples of the element size
+    uint region[3] = {random(1, 8) * elementSize, random(1, 5), is3D ? random(1, 3) : 1};
+    uint srcOrigin[3] = {random(0, 4) * elementSize, random(0, 3), is3D ? random(0, 2) : 0};
+    uint dstOrigin[3] = {random(0, 4) * elementSize, random(0, 3), is3D ? random(0, 2) : 0};
+    uint srcRowPitch = srcOrigin[0] + region[0] + random(0, 3) * elementSize;
+    uint dstRowPitch = dstOrigin[0] + region[0] + random(0, 3) * elementSize;
+    uint srcSlicePitch = srcRowPitch * (srcOrigin[1] + region[1] + random(0, 2));
+    uint dstSlicePitch = dstRowPitch * (dstOrigin[1] + region[1] + random(0, 2));
+    size_t srcSize = srcSlicePitch * (srcOrigin[2] + region[2]);
+    size_t dstSize = dstSlicePitch * (dstOrigin[2] + region[2]);
+
+    std::vector<AlignedStorageChunk> srcStorage((srcSize + 15) / 16);
+    std::vector<AlignedStorageChunk> dstStorage((dstSize + 15) / 16);
+    auto src = reinterpret_cast<uchar *>(srcStorage.data());
+    auto dst = reinterpret_cast<uchar *>(dstStorage.data());
+    for (size_t i = 0; i < srcSize; i++) {
+        src[i] = static_cast<uchar>(random(0, 255));
+    }
+    memset(dst, 0xcd, dstSize);
+
+    std::vector<uchar> expected(dst, dst + dstSize);
+    for (uint z = 0; z < region[2]; z++) {
+        for (uint y = 0; y < region[1]; y++) {
+            memcpy(expected.data() + dstOrigin[0] + (y + dstOrigin[1]) * dstRowPitch + (z + dstOrigin[2]) * dstSlicePitch,
+                   src + srcOrigin[0] + (y + srcOrigin[1]) * srcRowPitch + (z + srcOrigin[2]) * srcSlicePitch,
+                   region[0]);
+        }
+    }
+
+    uint4 kSrcOrigin(srcOrigin[0] / elementSize, srcOrigin[1], srcOrigin[2], 0);
+    uint4 kDstOrigin(dstOrigin[0] / elementSize, dstOrigin[1], dstOrigin[2], 0);
+    uint2 kSrcPitch(srcRowPitch / elementSize, srcSlicePitch / elementSize);
+    uint2 kDstPitch(dstRowPitch / elementSize, dstSlicePitch / elementSize);
+
+    localID[0] = 0;
+    localID[1] = 0;
+    localID[2] = 0;
+    localSize[0] = region[0] / elementSize;
+    localSize[1] = region[1];
+    localSize[2] = region[2];
+
+    for (globalID[2] = 0; globalID[2] < region[2]; globalID[2]++) {
+        for (globalID[1] = 0; globalID[1] < region[1]; globalID[1]++) {
+            for (globalID[0] = 0; globalID[0] < region[0] / elementSize; globalID[0]++) {
+                if (is3D) {
+                    CopyBufferRect3d(reinterpret_cast<const ElementT *>(src), reinterpret_cast<ElementT *>(dst),
+                                     kSrcOrigin, kDstOrigin, kSrcPitch, kDstPitch);
+                } else {
+                    CopyBufferRect2d(reinterpret_cast<const ElementT *>(src), reinterpret_cast<ElementT *>(dst),
+                                     kSrcOrigin, kDstOrigin, kSrcPitch, kDstPitch);
+                }
+            }
+        }
+    }
+
+    EXPECT_EQ(0, memcmp(expected.data(), dst, dstSize)) << "Rect not copied properly with " << elementSize << "-byte elements!\n";
+}
+
+TEST(BuiltInKernelTests, givenRandomRectGeometriesWhenCopyBufferRectKernelsOfEveryElementSizeRunThenResultMatchesRowByRowMemcpy) {
+    std::mt19937 generator(0x5eed);
+
+    for (int iteration = 0; iteration < 64; iteration++) {
+        for (bool is3D : {false, true}) {
+            verifyCopyBufferRect<uchar>(generator, is3D);
+            verifyCopyBufferRect<uint>(generator, is3D);
+            verifyCopyBufferRect<uint2>(generator, is3D);
+            verifyCopyBufferRect<uint4>(generator, is3D);
+        }
+    }
+}
+
+TEST(BuiltInKernelTests, givenAnySrcAndDstAlignmentWhenCopyBufferToBufferSplitRunsThenResultMatchesMemcpy) {
+    const size_t cacheLineSize = 64;
+    const size_t guardSize = 64;
+    const size_t maxSize = 4 * cacheLineSize;
+    const size_t storageSize = guardSize + 16 + maxSize + guardSize;
+
+    std::vector<AlignedStorageChunk> srcStorage(storageSize / 16);
+    std::vector<AlignedStorageChunk> dstStorage(storageSize / 16);
+    auto srcBase = reinterpret_cast<uchar *>(srcStorage.data());
+    auto dstBase = reinterpret_cast<uchar *>(dstStorage.data());
+    std::vector<uchar> expected(storageSize);
+
+    for (size_t i = 0; i < storageSize; i++) {
+        srcBase[i] = static_cast<uchar>(i * 7 + 3);
+    }
+
+    localID[0] = 0;
+    localID[1] = 0;
+    localID[2] = 0;
+    globalID[1] = 0;
+    globalID[2] = 0;
+
+    for (uint srcMisalignment = 0; srcMisalignment < 16; srcMisalignment++) {
+        for (uint dstMisalignment = 0; dstMisalignment < 16; dstMisalignment++) {
+            for (uint size = 0; size <= maxSize; size++) {
+                uint srcOffset = static_cast<uint>(guardSize) + srcMisalignment;
+                uint dstOffset = static_cast<uint>(guardSize) + dstMisalignment;
+
+                memset(dstBase, 0xcd, storageSize);
+                memset(expected.data(), 0xcd, storageSize);
+                memcpy(expected.data() + dstOffset, srcBase + srcOffset, size);
+
+                // same split as BuiltInOp<CopyBufferToBuffer>::buildDispatchInfos
+                uintptr_t start = reinterpret_cast<uintptr_t>(dstBase) + dstOffset;
+                uint leftSize = static_cast<uint>(start % cacheLineSize);
+                leftSize = (leftSize > 0) ? static_cast<uint>(cacheLineSize - leftSize) : 0;
+                leftSize = std::min(leftSize, size);
+                uint rightSize = static_cast<uint>((start + size) % cacheLineSize);
+                rightSize = std::min(rightSize, size - leftSize);
+                uint middleSizeBytes = size - leftSize - rightSize;
+                uint misalignment = static_cast<uint>((reinterpret_cast<uintptr_t>(srcBase) + srcOffset + leftSize) % sizeof(uint));
+
+                localSize[0] = leftSize;
+                for (globalID[0] = 0; globalID[0] < leftSize; globalID[0]++) {
+                    CopyBufferToBufferLeftLeftover(srcBase, dstBase, srcOffset, dstOffset);
+                }
+                localSize[0] = middleSizeBytes / 16;
+                for (globalID[0] = 0; globalID[0] < middleSizeBytes / 16; globalID[0]++) {
+                    if (misalignment != 0) {
+                        CopyBufferToBufferMiddleMisaligned(srcBase, reinterpret_cast<uint *>(dstBase), srcOffset + leftSize, dstOffset + leftSize, misalignment * 8);
+                    } else {
+                        CopyBufferToBufferMiddle(reinterpret_cast<const uint *>(srcBase), reinterpret_cast<uint *>(dstBase), srcOffset + leftSize, dstOffset + leftSize);
+                    }
+                }
+                localSize[0] = rightSize;
+                for (globalID[0] = 0; globalID[0] < rightSize; globalID[0]++) {
+                    CopyBufferToBufferRightLeftover(srcBase, dstBase, srcOffset + leftSize + middleSizeBytes, dstOffset + leftSize + middleSizeBytes);
+                }
+
+                ASSERT_EQ(0, memcmp(expected.data(), dstBase, storageSize)) << "Data not copied properly for src % 16 = " << srcMisalignment
+                                                                            << ", dst % 16 = " << dstMisalignment << ", size = " << size << "\n";
+            }
+        }
+    }
+}
 }
@@ -26,6 +26,7 @@
 #include "runtime/built_ins/vme_dispatch_builder.h"
 #include "runtime/helpers/file_io.h"
 #include "runtime/helpers/hash.h"
+#include "runtime/helpers/ptr_math.h"
 #include "runtime/kernel/kernel.h"
 #include "runtime/platform/platform.h"
 #include "unit_tests/global_environment.h"
@@ -35,9 +36,13 @@
 #include "unit_tests/fixtures/context_fixture.h"
 #include "unit_tests/fixtures/image_fixture.h"
 #include "unit_tests/fixtures/run_kernel_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include <string>
+#include <thread>
 #include "runtime/helpers/string.h"
+#include "runtime/compiler_interface/binary_cache.h"
 #include "unit_tests/mocks/mock_buffer.h"
+#include "unit_tests/mocks/mock_builtins.h"
 #include "unit_tests/mocks/mock_compilers.h"
 #include "unit_tests/mocks/mock_kernel.h"
 #include "runtime/helpers/dispatch_info_builder.h"
@@ -304,7 +309,76 @@ TEST_F(BuiltInTests, BuiltinDispatchInfoBuilderCopyBufferToBufferWithSourceOffse
 
     const DispatchInfo *dispatchInfo = multiDispatchInfo.begin();
 
+    EXPECT_EQ(dispatchInfo->getKernel()->getKernelInfo().name, "CopyBufferToBufferMiddleMisaligned");
+
+    size_t middleElSize = sizeof(uint32_t) * 4;
+    EXPECT_EQ(Vec3<size_t>(src.getSize() / middleElSize, 1, 1), dispatchInfo->getGWS());
+}
+
+TEST_F(BuiltInTests, givenHostPtrsMisalignedRelativeToEachOtherWhenBuildingCopyBufferToBufferDispatchInfosThenMiddleIsCopiedWithFunnelShiftKernel) {
+    BuiltinDispatchInfoBuilder &builder = pBuiltIns->getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferToBuffer, *pContext, *pDevice);
+
+    auto size = 4 * MemoryConstants::cacheLineSize;
+    auto srcAllocation = alignedMalloc(size + MemoryConstants::cacheLineSize, MemoryConstants::cacheLineSize);
+    auto dstAllocation = alignedMalloc(size + MemoryConstants::cacheLineSize, MemoryConstants::cacheLineSize);
+    auto srcPtr = ptrOffset(srcAllocation, 3);
+    auto dstPtr = ptrOffset(dstAllocation, 5);
+
+    MultiDispatchInfo multiDispatchInfo;
+    BuiltinDispatchInfoBuilder::BuiltinOpParams builtinOpsParams;
+
+    builtinOpsParams.srcPtr = srcPtr;
+    builtinOpsParams.dstPtr = dstPtr;
+    builtinOpsParams.size = {size, 0, 0};
+
+    ASSERT_TRUE(builder.buildDispatchInfos(multiDispatchInfo, builtinOpsParams));
+
+    ASSERT_EQ(3u, multiDispatchInfo.size());
+
+    size_t leftSize = MemoryConstants::cacheLineSize - 5;
+    size_t rightSize = 5;
+    size_t middleElSize = sizeof(uint32_t) * 4;
+    size_t middleSize = (size - leftSize - rightSize) / middleElSize;
+
+    const DispatchInfo *dispatchInfo = multiDispatchInfo.begin();
     EXPECT_EQ(dispatchInfo->getKernel()->getKernelInfo().name, "CopyBufferToBufferLeftLeftover");
+    EXPECT_EQ(Vec3<size_t>(leftSize, 1, 1), dispatchInfo->getGWS());
+
+    dispatchInfo++;
+    EXPECT_EQ(dispatchInfo->getKernel()->getKernelInfo().name, "CopyBufferToBufferMiddleMisaligned");
+    EXPECT_EQ(Vec3<size_t>(middleSize, 1, 1), dispatchInfo->getGWS());
+
+    dispatchInfo++;
+    EXPECT_EQ(dispatchInfo->getKernel()->getKernelInfo().name, "CopyBufferToBufferRightLeftover");
+    EXPECT_EQ(Vec3<size_t>(rightSize, 1, 1), dispatchInfo->getGWS());
+
+    alignedFree(srcAllocation);
+    alignedFree(dstAllocation);
+}
+
+TEST_F(BuiltInTests, givenHostPtrsWithDwordRelativeAlignmentWhenBuildingCopyBufferToBufferDispatchInfosThenRegularMiddleKernelIsUsed) {
+    BuiltinDispatchInfoBuilder &builder = pBuiltIns->getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferToBuffer, *pContext, *pDevice);
+
+    auto size = 4 * MemoryConstants::cacheLineSize;
+    auto srcAllocation = alignedMalloc(size + MemoryConstants::cacheLineSize, MemoryConstants::cacheLineSize);
+    auto dstAllocation = alignedMalloc(size + MemoryConstants::cacheLineSize, MemoryConstants::cacheLineSize);
+
+    MultiDispatchInfo multiDispatchInfo;
+    BuiltinDispatchInfoBuilder::BuiltinOpParams builtinOpsParams;
+
+    builtinOpsParams.srcPtr = ptrOffset(srcAllocation, 9);
+    builtinOpsParams.dstPtr = ptrOffset(dstAllocation, 5);
+    builtinOpsParams.size = {size, 0, 0};
+
+    ASSERT_TRUE(builder.buildDispatchInfos(multiDispatchInfo, builtinOpsParams));
+
+    ASSERT_EQ(3u, multiDispatchInfo.size());
+
+    const DispatchInfo *dispatchInfo = multiDispatchInfo.begin() + 1;
+    EXPECT_EQ(dispatchInfo->getKernel()->getKernelInfo().name, "CopyBufferToBufferMiddle");
+
+    alignedFree(srcAllocation);
+    alignedFree(dstAllocation);
 }
 
 TEST_F(BuiltInTests, BuiltinDispatchInfoBuilderReadBufferAligned) {
@@ -377,6 +451,93 @@ TEST_F(BuiltInTests, BuiltinDispatchInfoBuilderWriteBufferAligned) {
     alignedFree(srcPtr);
 }
 
+TEST_F(BuiltInTests, givenRectCopyParamsWhenElementSizeIsQueriedThenWidestSizeDividingAddressesOriginsPitchesAndWidthIsReturned) {
+    auto srcPtr = alignedMalloc(MemoryConstants::pageSize, MemoryConstants::cacheLineSize);
+    auto dstPtr = alignedMalloc(MemoryConstants::pageSize, MemoryConstants::cacheLineSize);
+
+    BuiltinDispatchInfoBuilder::BuiltinOpParams builtinOpsParams;
+    builtinOpsParams.srcPtr = srcPtr;
+    builtinOpsParams.dstPtr = dstPtr;
+    builtinOpsParams.srcOffset = {32, 1, 0};
+    builtinOpsParams.dstOffset = {16, 2, 0};
+    builtinOpsParams.size = {64, 4, 1};
+    builtinOpsParams.srcRowPitch = 128;
+    builtinOpsParams.srcSlicePitch = 1024;
+    builtinOpsParams.dstRowPitch = 256;
+    builtinOpsParams.dstSlicePitch = 2048;
+    EXPECT_EQ(16u, getCopyBufferRectElementSize(builtinOpsParams));
+
+    builtinOpsParams.dstOffset.x = 8;
+    EXPECT_EQ(8u, getCopyBufferRectElementSize(builtinOpsParams));
+
+    builtinOpsParams.srcRowPitch = 132;
+    EXPECT_EQ(4u, getCopyBufferRectElementSize(builtinOpsParams));
+
+    builtinOpsParams.size.x = 63;
+    EXPECT_EQ(1u, getCopyBufferRectElementSize(builtinOpsParams));
+
+    builtinOpsParams.size.x = 64;
+    builtinOpsParams.srcPtr = ptrOffset(srcPtr, 2);
+    EXPECT_EQ(1u, getCopyBufferRectElementSize(builtinOpsParams));
+
+    alignedFree(srcPtr);
+    alignedFree(dstPtr);
+}
+
+TEST_F(BuiltInTests, givenAlignedRectCopyWhenBuildingDispatchInfosThenWideElementKernelIsUsedWithRegionInElements) {
+    BuiltinDispatchInfoBuilder &builder = pBuiltIns->getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferRect, *pContext, *pDevice);
+
+    auto srcPtr = alignedMalloc(MemoryConstants::pageSize, MemoryConstants::cacheLineSize);
+    auto dstPtr = alignedMalloc(MemoryConstants::pageSize, MemoryConstants::cacheLineSize);
+
+    MultiDispatchInfo multiDispatchInfo;
+    BuiltinDispatchInfoBuilder::BuiltinOpParams builtinOpsParams;
+    builtinOpsParams.srcPtr = srcPtr;
+    builtinOpsParams.dstPtr = dstPtr;
+    builtinOpsParams.size = {64, 4, 1};
+    builtinOpsParams.srcRowPitch = 128;
+    builtinOpsParams.srcSlicePitch = 512;
+    builtinOpsParams.dstRowPitch = 128;
+    builtinOpsParams.dstSlicePitch = 512;
+
+    ASSERT_TRUE(builder.buildDispatchInfos(multiDispatchInfo, builtinOpsParams));
+    EXPECT_EQ(1u, multiDispatchInfo.size());
+
+    const DispatchInfo *dispatchInfo = multiDispatchInfo.begin();
+    EXPECT_EQ(dispatchInfo->getKernel()->getKernelInfo().name, "CopyBufferRect16Bytes2d");
+    EXPECT_EQ(Vec3<size_t>(4, 4, 1), dispatchInfo->getGWS());
+
+    alignedFree(srcPtr);
+    alignedFree(dstPtr);
+}
+
+TEST_F(BuiltInTests, givenRectCopyWithOddWidthWhenBuildingDispatchInfosThenByteKernelIsUsed) {
+    BuiltinDispatchInfoBuilder &builder = pBuiltIns->getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferRect, *pContext, *pDevice);
+
+    auto srcPtr = alignedMalloc(MemoryConstants::pageSize, MemoryConstants::cacheLineSize);
+    auto dstPtr = alignedMalloc(MemoryConstants::pageSize, MemoryConstants::cacheLineSize);
+
+    MultiDispatchInfo multiDispatchInfo;
+    BuiltinDispatchInfoBuilder::BuiltinOpParams builtinOpsParams;
+    builtinOpsParams.srcPtr = srcPtr;
+    builtinOpsParams.dstPtr = dstPtr;
+    builtinOpsParams.size = {63, 4, 2};
+    builtinOpsParams.srcRowPitch = 128;
+    builtinOpsParams.srcSlicePitch = 512;
+    builtinOpsParams.dstRowPitch = 128;
+    builtinOpsParams.dstSlicePitch = 512;
+
+    ASSERT_TRUE(builder.buildDispatchInfos(multiDispatchInfo, builtinOpsParams));
+    EXPECT_EQ(1u, multiDispatchInfo.size());
+
+    const DispatchInfo *dispatchInfo = multiDispatchInfo.begin();
+    EXPECT_EQ(dispatchInfo->getKernel()->getKernelInfo().name, "CopyBufferRectBytes3d");
+    EXPECT_EQ(Vec3<size_t>(63, 4, 2), dispatchInfo->getGWS());
+
+    alignedFree(srcPtr);
+    alignedFree(dstPtr);
+}
+
 TEST_F(BuiltInTests, BuiltinDispatchInfoBuilderGetBuilderTwice) {
     BuiltinDispatchInfoBuilder &builder1 = pBuiltIns->getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferToBuffer, *pContext, *pDevice);
     BuiltinDispatchInfoBuilder &builder2 = pBuiltIns->getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferToBuffer, *pContext, *pDevice);
@@ -394,6 +555,81 @@ TEST_F(BuiltInTests, BuiltinDispatchInfoBuilderGetBuilderForUnknownBuiltInOp) {
     EXPECT_TRUE(caughtException);
 }
 
+TEST_F(BuiltInTests, givenWarmedUpBuiltinsWhenBuilderIsRequestedThenNoProgramIsBuilt) {
+    const EBuiltInOps commonOperations[] = {EBuiltInOps::CopyBufferToBuffer, EBuiltInOps::CopyBufferRect, EBuiltInOps::FillBuffer,
+                                            EBuiltInOps::CopyBufferToImage3d, EBuiltInOps::CopyImage3dToBuffer,
+                                            EBuiltInOps::CopyImageToImage3d, EBuiltInOps::FillImage3d};
+
+    pBuiltIns->warmUpBuiltinDispatchInfoBuilders(*pContext, *pDevice);
+
+    auto programCount = pDevice->getProgramCount();
+    for (auto operation : commonOperations) {
+        auto warmedUpBuilder = pBuiltIns->BuiltinOpsBuilders[static_cast<uint32_t>(operation)].first.get();
+        EXPECT_NE(nullptr, warmedUpBuilder);
+        EXPECT_EQ(warmedUpBuilder, &pBuiltIns->getBuiltinDispatchInfoBuilder(operation, *pContext, *pDevice));
+    }
+    EXPECT_EQ(programCount, pDevice->getProgramCount());
+}
+
+TEST_F(BuiltInTests, givenWarmUpInProgressWhenBuilderIsRequestedThenBuilderIsCreatedOnce) {
+    std::thread warmUpThread([&] { pBuiltIns->warmUpBuiltinDispatchInfoBuilders(*pContext, *pDevice); });
+    auto &builder = pBuiltIns->getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferToBuffer, *pContext, *pDevice);
+    warmUpThread.join();
+
+    EXPECT_EQ(&builder, pBuiltIns->BuiltinOpsBuilders[static_cast<uint32_t>(EBuiltInOps::CopyBufferToBuffer)].first.get());
+}
+
+namespace {
+struct PlatformWithBuiltinsContext : public Platform {
+    using Platform::builtinsContext;
+};
+
+struct BuiltinDispatchInfoBuilderWithProgram : public BuiltinDispatchInfoBuilder {
+    using BuiltinDispatchInfoBuilder::prog;
+};
+} // namespace
+
+TEST_F(BuiltInTests, givenBuiltinsWarmUpEnabledWhenWarmUpFinishesThenWarmedUpProgramsKeepLiveContextUntilPlatformShutdown) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableBuiltinsWarmUp.set(true);
+
+    auto testedPlatform = new PlatformWithBuiltinsContext;
+    ASSERT_TRUE(testedPlatform->initialize(numPlatformDevices, platformDevices));
+    testedPlatform->waitForBuiltinsWarmUp();
+
+    auto warmedUpBuilder = BuiltIns::getInstance().BuiltinOpsBuilders[static_cast<uint32_t>(EBuiltInOps::CopyBufferToBuffer)].first.get();
+    ASSERT_NE(nullptr, warmedUpBuilder);
+    auto programContext = static_cast<BuiltinDispatchInfoBuilderWithProgram *>(warmedUpBuilder)->prog->getContextPtr();
+    ASSERT_NE(nullptr, testedPlatform->builtinsContext);
+    EXPECT_EQ(testedPlatform->builtinsContext, programContext);
+    EXPECT_EQ(1, programContext->getReference());
+
+    testedPlatform->shutdown();
+    EXPECT_EQ(nullptr, testedPlatform->builtinsContext);
+
+    delete testedPlatform;
+}
+
+TEST_F(BuiltInTests, givenBuiltinsWarmUpEnabledWhenPlatformIsInitializedThenFirstBuiltinRequestDoesNotBuildProgram) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableBuiltinsWarmUp.set(true);
+
+    auto testedPlatform = new Platform;
+    ASSERT_TRUE(testedPlatform->initialize(numPlatformDevices, platformDevices));
+    testedPlatform->waitForBuiltinsWarmUp();
+
+    auto platformDevice = testedPlatform->getDevice(0);
+    auto &builtIns = BuiltIns::getInstance();
+    auto warmedUpBuilder = builtIns.BuiltinOpsBuilders[static_cast<uint32_t>(EBuiltInOps::CopyBufferToBuffer)].first.get();
+    ASSERT_NE(nullptr, warmedUpBuilder);
+
+    auto programCount = platformDevice->getProgramCount();
+    EXPECT_EQ(warmedUpBuilder, &builtIns.getBuiltinDispatchInfoBuilder(EBuiltInOps::CopyBufferToBuffer, *pContext, *platformDevice));
+    EXPECT_EQ(programCount, platformDevice->getProgramCount());
+
+    delete testedPlatform;
+}
+
 TEST_F(BuiltInTests, getSchedulerKernel) {
     if (pDevice->getSupportedClVersion() >= 20) {
         Context &context = *pContext;
@@ -1500,3 +1736,172 @@ TEST_F(BuiltInTests, getSipKernelReturnsProgramCreatedOutOfIsaAcquiredFromCompil
     EXPECT_EQ(SipKernelType::Csr, mockCompilerInterface.requestedSipKernel);
     p->release();
 }
+
+class InMemoryBinaryCache : public BinaryCache {
+  public:
+    bool cacheBinary(const std::string kernelFileHash, const char *pBinary, uint32_t binarySize) override {
+        entries[kernelFileHash].assign(pBinary, pBinary + binarySize);
+        return true;
+    }
+
+    bool loadCachedData(const std::string kernelFileHash, std::vector<char> &data) override {
+        auto it = entries.find(kernelFileHash);
+        if (it == entries.end()) {
+            return false;
+        }
+        data = it->second;
+        return true;
+    }
+
+    std::map<std::string, std::vector<char>> entries;
+};
+
+TEST_F(BuiltInTests, givenSipBinaryCachedByPreviousBuiltInsWhenSipKernelIsRequestedThenCompilerIsNotInvoked) {
+    MockCompilerInterface mockCompilerInterface;
+    mockCompilerInterface.overrideGlobalCompilerInterface();
+    mockCompilerInterface.sipKernelBinaryOverride = mockCompilerInterface.getDummyGenBinary();
+    InMemoryBinaryCache sipBinaryCache;
+    auto device = pContext->getDevice(0);
+
+    const SipKernel *firstSipKernel = nullptr;
+    std::vector<char> firstSipBinary;
+    {
+        MockBuiltins builtIns;
+        delete builtIns.replaceSipBinaryCache(&sipBinaryCache);
+
+        firstSipKernel = &builtIns.getSipKernel(SipKernelType::Csr, *device);
+        firstSipBinary.assign(firstSipKernel->getBinary(), firstSipKernel->getBinary() + firstSipKernel->getBinarySize());
+        EXPECT_EQ(firstSipKernel, &builtIns.getSipKernel(SipKernelType::Csr, *device));
+        EXPECT_EQ(1u, mockCompilerInterface.sipKernelBinaryRequests);
+        EXPECT_EQ(1u, sipBinaryCache.entries.size());
+
+        builtIns.replaceSipBinaryCache(nullptr);
+    }
+
+    for (int creation = 0; creation < 3; creation++) {
+        MockBuiltins builtIns;
+        delete builtIns.replaceSipBinaryCache(&sipBinaryCache);
+
+        auto &sipKernel = builtIns.getSipKernel(SipKernelType::Csr, *device);
+        ASSERT_EQ(firstSipBinary.size(), sipKernel.getBinarySize());
+        EXPECT_EQ(0, memcmp(firstSipBinary.data(), sipKernel.getBinary(), sipKernel.getBinarySize()));
+
+        builtIns.replaceSipBinaryCache(nullptr);
+    }
+    EXPECT_EQ(1u, mockCompilerInterface.sipKernelBinaryRequests);
+}
+
+TEST_F(BuiltInTests, givenSipKernelResolvedForDeviceWhenItIsRequestedAgainThenResolvedKernelIsReturnedWithoutBuildingCacheName) {
+    MockCompilerInterface mockCompilerInterface;
+    mockCompilerInterface.overrideGlobalCompilerInterface();
+    mockCompilerInterface.sipKernelBinaryOverride = mockCompilerInterface.getDummyGenBinary();
+    InMemoryBinaryCache sipBinaryCache;
+    auto device = pContext->getDevice(0);
+
+    MockBuiltins builtIns;
+    delete builtIns.replaceSipBinaryCache(&sipBinaryCache);
+    auto &sipKernel = builtIns.getSipKernel(SipKernelType::Csr, *device);
+    EXPECT_EQ(&sipKernel, device->getResolvedSipKernel(SipKernelType::Csr).find(builtIns.instanceId));
+
+    // without a binary cache the cache name can't be built, so only the per-device entry can serve these
+    builtIns.replaceSipBinaryCache(nullptr);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(&sipKernel, &builtIns.getSipKernel(SipKernelType::Csr, *device));
+    }
+    EXPECT_EQ(1u, mockCompilerInterface.sipKernelBinaryRequests);
+}
+
+TEST_F(BuiltInTests, givenSipKernelResolvedForDeviceByOtherBuiltInsWhenItIsRequestedThenKernelOwnedByRequestedBuiltInsIsReturned) {
+    MockCompilerInterface mockCompilerInterface;
+    mockCompilerInterface.overrideGlobalCompilerInterface();
+    mockCompilerInterface.sipKernelBinaryOverride = mockCompilerInterface.getDummyGenBinary();
+    auto device = pContext->getDevice(0);
+
+    MockBuiltins firstBuiltIns;
+    MockBuiltins secondBuiltIns;
+    firstBuiltIns.setCacheingEnableState(false);
+    secondBuiltIns.setCacheingEnableState(false);
+
+    auto &firstSipKernel = firstBuiltIns.getSipKernel(SipKernelType::Csr, *device);
+    auto &secondSipKernel = secondBuiltIns.getSipKernel(SipKernelType::Csr, *device);
+    EXPECT_NE(&firstSipKernel, &secondSipKernel);
+
+    EXPECT_EQ(&firstSipKernel, &firstBuiltIns.getSipKernel(SipKernelType::Csr, *device));
+    EXPECT_EQ(&secondSipKernel, &secondBuiltIns.getSipKernel(SipKernelType::Csr, *device));
+}
+
+TEST_F(BuiltInTests, givenSipKernelResolvedForDeviceWhenOtherBuiltInsPublishesItsKernelThenFirstBuiltInsNoLongerFindsIt) {
+    Device::ResolvedSipKernel resolvedSipKernel;
+    SipKernel *firstKernel = reinterpret_cast<SipKernel *>(0x1000);
+    SipKernel *secondKernel = reinterpret_cast<SipKernel *>(0x2000);
+    EXPECT_EQ(nullptr, resolvedSipKernel.find(1u));
+
+    resolvedSipKernel.publish(firstKernel, 1u);
+    EXPECT_EQ(firstKernel, resolvedSipKernel.find(1u));
+    EXPECT_EQ(nullptr, resolvedSipKernel.find(2u));
+
+    resolvedSipKernel.publish(secondKernel, 2u);
+    EXPECT_EQ(nullptr, resolvedSipKernel.find(1u));
+    EXPECT_EQ(secondKernel, resolvedSipKernel.find(2u));
+}
+
+TEST_F(BuiltInTests, givenDifferentCompilerFileStampsWhenSipKernelCacheNameIsBuiltThenNamesDiffer) {
+    auto device = pContext->getDevice(0);
+    MockBuiltins builtIns;
+
+    builtIns.compilerFileStampOverride = "4096 1500000000";
+    auto firstName = builtIns.getSipKernelCacheName(SipKernelType::Csr, *device);
+    EXPECT_EQ(firstName, builtIns.getSipKernelCacheName(SipKernelType::Csr, *device));
+
+    builtIns.compilerFileStampOverride = "4096 1500000001";
+    EXPECT_NE(firstName, builtIns.getSipKernelCacheName(SipKernelType::Csr, *device));
+
+    builtIns.compilerFileStampOverride = "8192 1500000000";
+    EXPECT_NE(firstName, builtIns.getSipKernelCacheName(SipKernelType::Csr, *device));
+}
+
+TEST_F(BuiltInTests, givenCorruptedCachedSipBinaryWhenSipKernelIsRequestedThenEntryIsRejectedAndSipIsRecompiled) {
+    MockCompilerInterface mockCompilerInterface;
+    mockCompilerInterface.overrideGlobalCompilerInterface();
+    mockCompilerInterface.sipKernelBinaryOverride = mockCompilerInterface.getDummyGenBinary();
+    InMemoryBinaryCache sipBinaryCache;
+    auto device = pContext->getDevice(0);
+
+    {
+        MockBuiltins builtIns;
+        delete builtIns.replaceSipBinaryCache(&sipBinaryCache);
+        builtIns.getSipKernel(SipKernelType::Csr, *device);
+        builtIns.replaceSipBinaryCache(nullptr);
+    }
+    EXPECT_EQ(1u, mockCompilerInterface.sipKernelBinaryRequests);
+    ASSERT_EQ(1u, sipBinaryCache.entries.size());
+
+    auto &cachedEntry = sipBinaryCache.entries.begin()->second;
+    auto validEntry = cachedEntry;
+    cachedEntry[cachedEntry.size() / 2] ^= 0x1;
+
+    {
+        MockBuiltins builtIns;
+        delete builtIns.replaceSipBinaryCache(&sipBinaryCache);
+        builtIns.getSipKernel(SipKernelType::Csr, *device);
+        builtIns.replaceSipBinaryCache(nullptr);
+    }
+    EXPECT_EQ(2u, mockCompilerInterface.sipKernelBinaryRequests);
+    EXPECT_EQ(validEntry, sipBinaryCache.entries.begin()->second);
+}
+
+TEST_F(BuiltInTests, givenCacheingDisabledWhenSipKernelIsRequestedThenSipBinaryIsNotCached) {
+    MockCompilerInterface mockCompilerInterface;
+    mockCompilerInterface.overrideGlobalCompilerInterface();
+    mockCompilerInterface.sipKernelBinaryOverride = mockCompilerInterface.getDummyGenBinary();
+    InMemoryBinaryCache sipBinaryCache;
+
+    MockBuiltins builtIns;
+    builtIns.setCacheingEnableState(false);
+    delete builtIns.replaceSipBinaryCache(&sipBinaryCache);
+    builtIns.getSipKernel(SipKernelType::Csr, *pContext->getDevice(0));
+    builtIns.replaceSipBinaryCache(nullptr);
+
+    EXPECT_EQ(1u, mockCompilerInterface.sipKernelBinaryRequests);
+    EXPECT_TRUE(sipBinaryCache.entries.empty());
+}
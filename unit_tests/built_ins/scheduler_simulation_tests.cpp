@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/builtin_kernels_simulation/opencl_c.h"
+#include "runtime/builtin_kernels_simulation/scheduler_simulation.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <memory>
+
+using namespace BuiltinKernelsSimulation;
+
+TEST(SchedulerSimulationThreadPoolTest, givenNewThreadPoolThenWorkersAreCreatedOnFirstRun) {
+    SchedulerSimulationThreadPool threadPool;
+    EXPECT_FALSE(threadPool.isStarted());
+    EXPECT_EQ(std::thread::id(), threadPool.getThreadId(1));
+
+    threadPool.run([](uint32_t index) {});
+
+    EXPECT_TRUE(threadPool.isStarted());
+    EXPECT_NE(std::thread::id(), threadPool.getThreadId(1));
+    EXPECT_EQ(std::thread::id(), threadPool.getThreadId(0));
+    EXPECT_EQ(std::thread::id(), threadPool.getThreadId(NUM_OF_THREADS));
+}
+
+TEST(SchedulerSimulationThreadPoolTest, givenThreadPoolWhenRunIsCalledRepeatedlyThenEachLocalIdRunsOncePerRunOnTheSameThread) {
+    SchedulerSimulationThreadPool threadPool;
+    const uint32_t numRuns = 200;
+    std::atomic<uint32_t> runCount[NUM_OF_THREADS];
+    for (auto &count : runCount) {
+        count = 0;
+    }
+    std::thread::id threadIds[NUM_OF_THREADS];
+    bool sameThread[NUM_OF_THREADS];
+    for (auto &same : sameThread) {
+        same = true;
+    }
+
+    for (uint32_t run = 0; run < numRuns; run++) {
+        threadPool.run([&](uint32_t index) {
+            if (run == 0) {
+                threadIds[index] = std::this_thread::get_id();
+            } else if (threadIds[index] != std::this_thread::get_id()) {
+                sameThread[index] = false;
+            }
+            runCount[index]++;
+        });
+    }
+
+    EXPECT_EQ(std::this_thread::get_id(), threadIds[0]);
+    for (uint32_t i = 0; i < NUM_OF_THREADS; i++) {
+        EXPECT_EQ(numRuns, runCount[i]);
+        EXPECT_TRUE(sameThread[i]);
+        if (i > 0) {
+            EXPECT_EQ(threadPool.getThreadId(i), threadIds[i]);
+        }
+    }
+}
+
+TEST(SchedulerSimulationThreadPoolTest, givenGlobalBarrierWhenSimulationIsRunRepeatedlyThenResultsAreDeterministic) {
+    SchedulerSimulationThreadPool threadPool;
+    threadPool.start();
+
+    threadIDToLocalIDmap.clear();
+    threadIDToLocalIDmap[std::this_thread::get_id()] = 0;
+    for (uint32_t i = 1; i < NUM_OF_THREADS; i++) {
+        threadIDToLocalIDmap[threadPool.getThreadId(i)] = i;
+    }
+    pGlobalBarrier = threadPool.getGlobalBarrier();
+
+    uint32_t values[NUM_OF_THREADS];
+    uint32_t sums[NUM_OF_THREADS];
+    for (uint32_t run = 0; run < 100; run++) {
+        threadPool.run([&](uint32_t index) {
+            auto lid = get_local_id(0);
+            values[lid] = lid + run;
+            barrier(CLK_GLOBAL_MEM_FENCE);
+
+            uint32_t sum = 0;
+            for (uint32_t i = 0; i < NUM_OF_THREADS; i++) {
+                sum += values[i];
+            }
+            sums[index] = sum;
+            barrier(CLK_GLOBAL_MEM_FENCE);
+        });
+
+        uint32_t expectedSum = NUM_OF_THREADS * (NUM_OF_THREADS - 1) / 2 + NUM_OF_THREADS * run;
+        for (uint32_t i = 0; i < NUM_OF_THREADS; i++) {
+            EXPECT_EQ(i + run, values[i]);
+            EXPECT_EQ(expectedSum, sums[i]);
+        }
+    }
+
+    threadIDToLocalIDmap.clear();
+    pGlobalBarrier = nullptr;
+}
+
+TEST(SchedulerSimulationThreadPoolTest, givenFilledLocalIdMapWhenWorkersQueryIdsThenMapIsNotModified) {
+    SchedulerSimulationThreadPool threadPool;
+    threadPool.start();
+
+    threadIDToLocalIDmap.clear();
+    threadIDToLocalIDmap[std::this_thread::get_id()] = 0;
+    for (uint32_t i = 1; i < NUM_OF_THREADS; i++) {
+        threadIDToLocalIDmap[threadPool.getThreadId(i)] = i;
+    }
+
+    uint32_t globalIds[NUM_OF_THREADS];
+    threadPool.run([&](uint32_t index) {
+        globalIds[index] = get_global_id(0);
+    });
+    for (uint32_t i = 0; i < NUM_OF_THREADS; i++) {
+        EXPECT_EQ(i, globalIds[i]);
+    }
+
+    // a thread outside of the pool gets LID 0 and isn't added to the map
+    uint32_t unknownThreadId = 1;
+    std::thread([&] { unknownThreadId = get_global_id(0); }).join();
+    EXPECT_EQ(0u, unknownThreadId);
+    EXPECT_EQ(static_cast<size_t>(NUM_OF_THREADS), threadIDToLocalIDmap.size());
+
+    threadIDToLocalIDmap.clear();
+}
+
+TEST(SchedulerSimulationThreadPoolTest, givenStartedThreadPoolWhenDestroyedThenWorkersAreJoined) {
+    std::unique_ptr<SchedulerSimulationThreadPool> threadPool(new SchedulerSimulationThreadPool);
+    std::atomic<uint32_t> runCount(0);
+    threadPool->run([&](uint32_t index) { runCount++; });
+    threadPool->run([&](uint32_t index) { runCount++; });
+    threadPool.reset();
+
+    EXPECT_EQ(2u * NUM_OF_THREADS, runCount);
+}
+
+TEST(SchedulerSimulationThreadPoolTest, givenGlobalThreadPoolThenSameInstanceIsReturned) {
+    EXPECT_EQ(&SchedulerSimulationThreadPool::getInstance(), &SchedulerSimulationThreadPool::getInstance());
+}
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/cpu_transfer_worker.h"
+#include "runtime/device/device.h"
+#include "runtime/event/user_event.h"
+#include "unit_tests/command_queue/enqueue_read_buffer_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_csr.h"
+#include "unit_tests/mocks/mock_kernel.h"
+#include "test.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace OCLRT;
+
+struct AsyncCpuTransferTest : public EnqueueReadBufferTypeTest {
+    void SetUp() override {
+        EnqueueReadBufferTypeTest::SetUp();
+        DebugManager.flags.EnableAsyncCpuTransfers.set(true);
+        context->getDevice(0)->getMutableDeviceInfo()->cpuCopyAllowed = true;
+
+        cl_int retVal = CL_SUCCESS;
+        buffer.reset(Buffer::create(context, CL_MEM_READ_WRITE, size, nullptr, retVal));
+        ASSERT_EQ(CL_SUCCESS, retVal);
+        ASSERT_TRUE(buffer->isMemObjZeroCopy());
+        bufferPtr = static_cast<uint8_t *>(buffer->getCpuAddressForMemoryTransfer());
+        for (uint8_t i = 0; i < size; i++) {
+            bufferPtr[i] = i + 1;
+        }
+        memset(hostData, 0, sizeof(hostData));
+    }
+
+    void TearDown() override {
+        buffer.reset();
+        EnqueueReadBufferTypeTest::TearDown();
+    }
+
+    static const size_t size = 16;
+    DebugManagerStateRestore dbgRestore;
+    std::unique_ptr<Buffer> buffer;
+    uint8_t *bufferPtr = nullptr;
+    uint8_t hostData[size];
+};
+
+HWTEST_F(AsyncCpuTransferTest, givenAsyncCpuTransfersDisabledWhenNonBlockingReadIsEnqueuedThenWorkerIsNotCreated) {
+    DebugManager.flags.EnableAsyncCpuTransfers.set(false);
+
+    auto retVal = pCmdQ->enqueueReadBuffer(buffer.get(), CL_FALSE, 0, size, hostData, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(nullptr, pCmdQ->peekCpuTransferWorker());
+    pCmdQ->finish(true);
+}
+
+HWTEST_F(AsyncCpuTransferTest, givenForcedGpuTransferPathWhenNonBlockingReadIsEnqueuedThenWorkerIsNotCreated) {
+    DebugManager.flags.ForceTransferPath.set(1);
+
+    auto retVal = pCmdQ->enqueueReadBuffer(buffer.get(), CL_FALSE, 0, size, hostData, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(nullptr, pCmdQ->peekCpuTransferWorker());
+    pCmdQ->finish(true);
+}
+
+HWTEST_F(AsyncCpuTransferTest, givenUserEventDependencyWhenNonBlockingReadIsEnqueuedThenDataIsCopiedAfterUserEventCompletes) {
+    auto userEvent = new UserEvent(context);
+    cl_event waitList[] = {userEvent};
+    cl_event transferEvent = nullptr;
+
+    auto retVal = pCmdQ->enqueueReadBuffer(buffer.get(), CL_FALSE, 0, size, hostData, 1, waitList, &transferEvent);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    ASSERT_NE(nullptr, transferEvent);
+    ASSERT_NE(nullptr, pCmdQ->peekCpuTransferWorker());
+
+    auto pTransferEvent = castToObject<Event>(transferEvent);
+    EXPECT_EQ(static_cast<cl_command_type>(CL_COMMAND_READ_BUFFER), pTransferEvent->getCommandType());
+    EXPECT_EQ(CL_QUEUED, pTransferEvent->peekExecutionStatus());
+    EXPECT_TRUE(pCmdQ->isQueueBlocked());
+    EXPECT_EQ(0u, hostData[0]);
+
+    userEvent->setStatus(CL_COMPLETE);
+    pCmdQ->peekCpuTransferWorker()->drain();
+
+    EXPECT_EQ(CL_COMPLETE, pTransferEvent->peekExecutionStatus());
+    EXPECT_EQ(0, memcmp(hostData, bufferPtr, size));
+    EXPECT_FALSE(pCmdQ->isQueueBlocked());
+
+    clReleaseEvent(transferEvent);
+    userEvent->release();
+}
+
+HWTEST_F(AsyncCpuTransferTest, givenUserEventDependencyWhenWorkerWaitsForItThenItSleepsOnSubmissionCallbackOfTheEvent) {
+    auto userEvent = new UserEvent(context);
+    cl_event waitList[] = {userEvent};
+
+    auto retVal = pCmdQ->enqueueReadBuffer(buffer.get(), CL_FALSE, 0, size, hostData, 1, waitList, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    // the worker registers its wake up callback and goes to sleep, it doesn't poll the event
+    while (!userEvent->peekHasCallbacks(Event::ECallbackTarget::Submitted)) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(CL_QUEUED, userEvent->peekExecutionStatus());
+    EXPECT_EQ(0u, hostData[0]);
+
+    userEvent->setStatus(CL_COMPLETE);
+    pCmdQ->peekCpuTransferWorker()->drain();
+
+    EXPECT_FALSE(userEvent->peekHasCallbacks());
+    EXPECT_EQ(0, memcmp(hostData, bufferPtr, size));
+    EXPECT_FALSE(pCmdQ->isQueueBlocked());
+
+    userEvent->release();
+}
+
+HWTEST_F(AsyncCpuTransferTest, givenNonBlockingWriteWhenQueueIsFinishedThenDataIsWritten) {
+    memset(hostData, 0xff, sizeof(hostData));
+
+    auto retVal = pCmdQ->enqueueWriteBuffer(buffer.get(), CL_FALSE, 0, size, hostData, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_NE(nullptr, pCmdQ->peekCpuTransferWorker());
+
+    pCmdQ->finish(true);
+    EXPECT_EQ(0, memcmp(hostData, bufferPtr, size));
+}
+
+HWTEST_F(AsyncCpuTransferTest, givenTerminatedUserEventDependencyWhenNonBlockingWriteIsEnqueuedThenTransferIsAbortedAndDataIsNotWritten) {
+    auto userEvent = new UserEvent(context);
+    cl_event waitList[] = {userEvent};
+    cl_event transferEvent = nullptr;
+    memset(hostData, 0xff, sizeof(hostData));
+
+    auto retVal = pCmdQ->enqueueWriteBuffer(buffer.get(), CL_FALSE, 0, size, hostData, 1, waitList, &transferEvent);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    userEvent->setStatus(-1);
+    pCmdQ->peekCpuTransferWorker()->drain();
+
+    auto pTransferEvent = castToObject<Event>(transferEvent);
+    EXPECT_TRUE(pTransferEvent->isStatusCompletedByTermination());
+    EXPECT_EQ(1u, bufferPtr[0]);
+    EXPECT_FALSE(pCmdQ->isQueueBlocked());
+
+    clReleaseEvent(transferEvent);
+    userEvent->release();
+}
+
+HWTEST_F(AsyncCpuTransferTest, givenPendingAsyncTransferWhenMarkerIsEnqueuedThenMarkerIsBlockedUntilTransferCompletes) {
+    auto userEvent = new UserEvent(context);
+    cl_event waitList[] = {userEvent};
+    cl_event markerEvent = nullptr;
+
+    auto retVal = pCmdQ->enqueueReadBuffer(buffer.get(), CL_FALSE, 0, size, hostData, 1, waitList, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    retVal = pCmdQ->enqueueMarkerWithWaitList(0, nullptr, &markerEvent);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    auto pMarkerEvent = castToObject<Event>(markerEvent);
+    EXPECT_TRUE(pMarkerEvent->peekIsBlocked());
+
+    userEvent->setStatus(CL_COMPLETE);
+    pCmdQ->finish(true);
+
+    EXPECT_FALSE(pMarkerEvent->peekIsBlocked());
+    EXPECT_TRUE(pMarkerEvent->updateStatusAndCheckCompletion());
+    EXPECT_EQ(0, memcmp(hostData, bufferPtr, size));
+
+    clReleaseEvent(markerEvent);
+    userEvent->release();
+}
+
+HWTEST_F(AsyncCpuTransferTest, givenKernelWithPendingTagWhenNonBlockingZeroCopyReadIsEnqueuedThenDataIsCopiedOnlyAfterTagReachesKernelTaskCount) {
+    int32_t executionStamp = 0;
+    auto mockCsr = new MockCsr<FamilyType>(executionStamp);
+    pDevice->resetCommandStreamReceiver(mockCsr);
+    auto tagAddress = mockCsr->getTagAddress();
+    *tagAddress = 0;
+
+    MockKernelWithInternals mockKernel(*pDevice);
+    size_t gws = 1;
+    auto retVal = pCmdQ->enqueueKernel(mockKernel.mockKernel, 1, nullptr, &gws, nullptr, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    auto kernelTaskCount = pCmdQ->taskCount;
+    ASSERT_LT(*tagAddress, kernelTaskCount);
+
+    retVal = pCmdQ->enqueueReadBuffer(buffer.get(), CL_FALSE, 0, size, hostData, 0, nullptr, nullptr);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    ASSERT_NE(nullptr, pCmdQ->peekCpuTransferWorker());
+
+    // the worker waits for the kernel's task count, the buffer may still be written by the GPU
+    uint8_t zeroData[size] = {};
+    for (int i = 0; i < 10; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        EXPECT_EQ(0, memcmp(hostData, zeroData, size));
+    }
+
+    *tagAddress = kernelTaskCount;
+    pCmdQ->peekCpuTransferWorker()->drain();
+    EXPECT_EQ(0, memcmp(hostData, bufferPtr, size));
+}
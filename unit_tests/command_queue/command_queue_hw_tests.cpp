@@ -40,6 +40,7 @@
 #include "unit_tests/mocks/mock_csr.h"
 #include "unit_tests/mocks/mock_event.h"
 #include "unit_tests/mocks/mock_kernel.h"
+#include "unit_tests/mocks/mock_mdi.h"
 #include "unit_tests/mocks/mock_program.h"
 #include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "test.h"
@@ -380,6 +381,70 @@ HWTEST_F(CommandQueueHwTest, GivenNotCompleteUserEventPassedToEnqueueWhenEventIs
     mockCSR->getMemoryManager()->freeGraphicsMemory(constantSurface);
 }
 
+HWTEST_F(CommandQueueHwTest, givenMultiDispatchWhereLaterKernelNeedsBiggerPrivateSurfaceWhenEnqueuedThenAllKernelsArePatchedWithGrownSurface) {
+    SPatchAllocateStatelessPrivateSurface privateSurfaceToken = {};
+    privateSurfaceToken.DataParamOffset = 0;
+    privateSurfaceToken.DataParamSize = 8;
+
+    MockKernelWithInternals smallKernel(*pDevice);
+    MockKernelWithInternals bigKernel(*pDevice);
+    smallKernel.kernelInfo.patchInfo.pAllocateStatelessPrivateSurface = &privateSurfaceToken;
+    bigKernel.kernelInfo.patchInfo.pAllocateStatelessPrivateSurface = &privateSurfaceToken;
+
+    auto &csr = pDevice->getCommandStreamReceiver();
+    auto initialSurface = csr.obtainPrivateSurface(MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, initialSurface);
+    smallKernel.mockKernel->setPrivateSurface(initialSurface, MemoryConstants::pageSize);
+    bigKernel.mockKernel->setPrivateSurface(initialSurface, 4 * MemoryConstants::pageSize);
+
+    MockMultiDispatchInfo multiDispatchInfo(std::vector<Kernel *>({smallKernel.mockKernel, bigKernel.mockKernel}));
+    auto cmdQHw = static_cast<CommandQueueHw<FamilyType> *>(pCmdQ);
+    cmdQHw->template enqueueHandler<CL_COMMAND_NDRANGE_KERNEL>(nullptr, 0, false, multiDispatchInfo, 0, nullptr, nullptr);
+
+    auto grownSurface = csr.getPrivateSurface();
+    EXPECT_NE(initialSurface, grownSurface);
+    EXPECT_LE(4 * MemoryConstants::pageSize, grownSurface->getUnderlyingBufferSize());
+    for (auto kernel : {smallKernel.mockKernel, bigKernel.mockKernel}) {
+        EXPECT_EQ(grownSurface, kernel->getPrivateSurface());
+        auto patchedAddress = *reinterpret_cast<uint64_t *>(kernel->getCrossThreadData());
+        EXPECT_EQ(static_cast<uint64_t>(grownSurface->getGpuAddressToPatch()), patchedAddress);
+    }
+}
+
+HWTEST_F(CommandQueueHwTest, givenBlockedEnqueuePatchedWithPrivateSurfaceWhenPoolGrowsBeforeUnblockThenOldSurfaceIsRetiredOnlyAfterBlockedCommandIsSubmitted) {
+    SPatchAllocateStatelessPrivateSurface privateSurfaceToken = {};
+    privateSurfaceToken.DataParamOffset = 0;
+    privateSurfaceToken.DataParamSize = 8;
+
+    MockKernelWithInternals mockKernelWithInternals(*pDevice);
+    mockKernelWithInternals.kernelInfo.patchInfo.pAllocateStatelessPrivateSurface = &privateSurfaceToken;
+    auto mockKernel = mockKernelWithInternals.mockKernel;
+
+    auto &csr = pDevice->getCommandStreamReceiver();
+    auto memoryManager = pDevice->getMemoryManager();
+    auto heldSurface = csr.obtainPrivateSurface(MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, heldSurface);
+    mockKernel->setPrivateSurface(heldSurface, MemoryConstants::pageSize);
+
+    UserEvent userEvent(context);
+    cl_event blockedEvent = &userEvent;
+    size_t offset = 0;
+    size_t size = 1;
+    pCmdQ->enqueueKernel(mockKernel, 1, &offset, &size, &size, 1, &blockedEvent, nullptr);
+    EXPECT_EQ(heldSurface, mockKernel->getPrivateSurface());
+
+    auto grownSurface = csr.obtainPrivateSurface(4 * MemoryConstants::pageSize);
+    ASSERT_NE(nullptr, grownSurface);
+    EXPECT_NE(heldSurface, grownSurface);
+    EXPECT_FALSE(memoryManager->graphicsAllocations.peekContains(*heldSurface));
+
+    userEvent.setStatus(CL_COMPLETE);
+
+    EXPECT_TRUE(memoryManager->graphicsAllocations.peekContains(*heldSurface));
+    EXPECT_EQ(csr.peekTaskCount(), heldSurface->taskCount);
+    mockKernel->setPrivateSurface(nullptr, 0);
+}
+
 typedef CommandQueueHwTest BlockedCommandQueueTest;
 HWTEST_F(BlockedCommandQueueTest, givenCommandQueueWhichHasSomeUsedHeapsWhenBlockedCommandIsBeingSubmittedItReloadsThemToZeroToKeepProperOffsets) {
     DebugManagerStateRestore debugStateRestore;
@@ -598,6 +598,57 @@ TEST_P(CommandQueueIndirectHeapTest, GivenCommandQueueWithHeapWhenGraphicAllocat
     memoryManager->freeGraphicsMemory(allocation);
 }
 
+TEST_P(CommandQueueIndirectHeapTest, givenHeapUsedByCompletedTaskWhenItIsExhaustedThenSameAllocationIsReusedFromItsBeginning) {
+    const cl_queue_properties props[3] = {CL_QUEUE_PROPERTIES, 0, 0};
+    CommandQueue cmdQ(&context, pDevice, props);
+
+    auto &indirectHeap = cmdQ.getIndirectHeap(this->GetParam(), 100);
+    auto graphicsAllocation = indirectHeap.getGraphicsAllocation();
+    auto base = indirectHeap.getBase();
+    auto maxAvailableSpace = indirectHeap.getMaxAvailableSpace();
+    auto usedAfterAllocation = indirectHeap.getUsed();
+
+    indirectHeap.getSpace(indirectHeap.getAvailableSpace());
+    cmdQ.markIndirectHeapsUsedByTask(pDevice->getCommandStreamReceiver().peekTaskCount());
+
+    auto &reusedHeap = cmdQ.getIndirectHeap(this->GetParam(), 100);
+    EXPECT_EQ(&indirectHeap, &reusedHeap);
+    EXPECT_EQ(graphicsAllocation, reusedHeap.getGraphicsAllocation());
+    EXPECT_EQ(base, reusedHeap.getBase());
+    EXPECT_EQ(maxAvailableSpace, reusedHeap.getMaxAvailableSpace());
+    EXPECT_EQ(usedAfterAllocation, reusedHeap.getUsed());
+    EXPECT_EQ(0u, reusedHeap.peekInFlightRangesCount());
+    EXPECT_TRUE(pDevice->getMemoryManager()->allocationsForReuse.peekIsEmpty());
+}
+
+TEST_P(CommandQueueIndirectHeapTest, givenHeapExhaustedByTaskBeingBuiltWhenMoreSpaceIsRequestedThenNewAllocationIsObtained) {
+    const cl_queue_properties props[3] = {CL_QUEUE_PROPERTIES, 0, 0};
+    CommandQueue cmdQ(&context, pDevice, props);
+
+    auto &indirectHeap = cmdQ.getIndirectHeap(this->GetParam(), 100);
+    auto graphicsAllocation = indirectHeap.getGraphicsAllocation();
+    indirectHeap.getSpace(indirectHeap.getAvailableSpace());
+
+    cmdQ.getIndirectHeap(this->GetParam(), 100);
+    EXPECT_NE(graphicsAllocation, indirectHeap.getGraphicsAllocation());
+    EXPECT_EQ(0u, indirectHeap.peekInFlightRangesCount());
+    EXPECT_TRUE(pDevice->getMemoryManager()->allocationsForReuse.peekContains(*graphicsAllocation));
+}
+
+TEST_P(CommandQueueIndirectHeapTest, givenIndirectHeapWhenItIsReleasedThenUsageTrackingIsReset) {
+    const cl_queue_properties props[3] = {CL_QUEUE_PROPERTIES, 0, 0};
+    CommandQueue cmdQ(&context, pDevice, props);
+
+    auto &indirectHeap = cmdQ.getIndirectHeap(this->GetParam(), 100);
+    EXPECT_TRUE(indirectHeap.isUsageTracked());
+    indirectHeap.getSpace(100);
+    cmdQ.markIndirectHeapsUsedByTask(1);
+    EXPECT_EQ(1u, indirectHeap.peekInFlightRangesCount());
+
+    cmdQ.releaseIndirectHeap(this->GetParam());
+    EXPECT_EQ(0u, indirectHeap.peekInFlightRangesCount());
+}
+
 INSTANTIATE_TEST_CASE_P(
     Device,
     CommandQueueIndirectHeapTest,
@@ -23,6 +23,7 @@
 #include "runtime/built_ins/built_ins.h"
 #include "runtime/command_stream/thread_arbitration_policy.h"
 #include "runtime/gen_common/reg_configs.h"
+#include "runtime/helpers/array_count.h"
 #include "runtime/helpers/preamble.h"
 #include "runtime/memory_manager/graphics_allocation.h"
 #include "runtime/memory_manager/memory_constants.h"
@@ -1082,6 +1083,65 @@ HWTEST_F(EnqueueKernelTest, givenSecondEnqueueWithTheSameScratchRequirementWhenP
     EXPECT_EQ(csr.getScratchAllocation(), scratchAlloc);
 }
 
+HWTEST_F(EnqueueKernelTest, givenManyEnqueuesWrappingIndirectHeapsWhenTheyAreFlushedThenStateBaseAddressIsProgrammedOnlyOnce) {
+    typedef typename FamilyType::PARSE PARSE;
+    typedef typename PARSE::STATE_BASE_ADDRESS STATE_BASE_ADDRESS;
+
+    MockKernelWithInternals mockKernel(*pDevice);
+    // binding table makes every enqueue copy the kernel's surface states into SSH,
+    // interface descriptors go to DSH and cross thread data to IOH
+    SPatchBindingTableState bindingTableState = {};
+    bindingTableState.Count = 1;
+    bindingTableState.Offset = 64;
+    memset(mockKernel.sshLocal, 0, sizeof(mockKernel.sshLocal));
+    mockKernel.kernelInfo.patchInfo.bindingTableState = &bindingTableState;
+    size_t gws[3] = {1, 0, 0};
+    auto &csrCommandStream = pDevice->getCommandStreamReceiver().getCS(0);
+
+    const IndirectHeap::Type ringHeaps[] = {IndirectHeap::DYNAMIC_STATE, IndirectHeap::INDIRECT_OBJECT, IndirectHeap::SURFACE_STATE};
+    GraphicsAllocation *heapAllocations[ARRAY_COUNT(ringHeaps)] = {};
+    size_t heapConsumed[ARRAY_COUNT(ringHeaps)] = {};
+
+    size_t stateBaseAddressCount = 0;
+    for (int i = 0; i < 10000; i++) {
+        auto csrBase = csrCommandStream.getBase();
+        auto csrUsed = csrCommandStream.getUsed();
+
+        size_t heapUsedBefore[ARRAY_COUNT(ringHeaps)];
+        for (size_t heap = 0; heap < ARRAY_COUNT(ringHeaps); heap++) {
+            heapUsedBefore[heap] = pCmdQ->getIndirectHeap(ringHeaps[heap]).getUsed();
+        }
+
+        auto retVal = pCmdQ->enqueueKernel(mockKernel.mockKernel, 1, nullptr, gws, nullptr, 0, nullptr, nullptr);
+        ASSERT_EQ(CL_SUCCESS, retVal);
+
+        for (size_t heap = 0; heap < ARRAY_COUNT(ringHeaps); heap++) {
+            auto &indirectHeap = pCmdQ->getIndirectHeap(ringHeaps[heap]);
+            if (i == 0) {
+                heapAllocations[heap] = indirectHeap.getGraphicsAllocation();
+            }
+            EXPECT_EQ(heapAllocations[heap], indirectHeap.getGraphicsAllocation());
+            auto usedBefore = indirectHeap.getUsed() >= heapUsedBefore[heap] ? heapUsedBefore[heap] : 0;
+            heapConsumed[heap] += indirectHeap.getUsed() - usedBefore;
+        }
+
+        HardwareParse hwParser;
+        hwParser.parseCommands<FamilyType>(csrCommandStream, csrBase == csrCommandStream.getBase() ? csrUsed : 0);
+        auto itorCmd = find<STATE_BASE_ADDRESS *>(hwParser.cmdList.begin(), hwParser.cmdList.end());
+        while (itorCmd != hwParser.cmdList.end()) {
+            stateBaseAddressCount++;
+            itorCmd = find<STATE_BASE_ADDRESS *>(++itorCmd, hwParser.cmdList.end());
+        }
+    }
+
+    for (size_t heap = 0; heap < ARRAY_COUNT(ringHeaps); heap++) {
+        // every ring heap went around its allocation at least once
+        ASSERT_NE(nullptr, heapAllocations[heap]);
+        EXPECT_GT(heapConsumed[heap], heapAllocations[heap]->getUnderlyingBufferSize()) << "heap type " << ringHeaps[heap];
+    }
+    EXPECT_EQ(1u, stateBaseAddressCount);
+}
+
 HWTEST_F(EnqueueKernelTest, givenEnqueueWithGlobalWorkSizeWhenZeroValueIsPassedInDimensionThenTheKernelCommandWillTriviallySucceed) {
     size_t gws[3] = {0, 0, 0};
     MockKernelWithInternals mockKernel(*pDevice);
@@ -21,7 +21,9 @@
  */
 
 #include "unit_tests/command_queue/enqueue_read_buffer_fixture.h"
+#include "runtime/device/device.h"
 #include "runtime/helpers/basic_math.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "test.h"
 
 using namespace OCLRT;
@@ -286,4 +288,137 @@ HWTEST_F(ReadWriteBufferCpuCopyTest, cpuCopyCriteriaNotMet) {
     alignedFree(largeBufferPtr);
     alignedFree(alignedHostPtr);
     alignedFree(alignedBufferPtr);
-}
\ No newline at end of file
+}
+
+HWTEST_F(ReadWriteBufferCpuCopyTest, givenForcedGpuTransferPathWhenReadBufferMeetsCpuCopyCriteriaThenCpuCopyIsNotDone) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.ForceTransferPath.set(1);
+    cl_int retVal;
+    size_t size = 4;
+
+    auto deviceInfo = context->getDevice(0)->getMutableDeviceInfo();
+    deviceInfo->cpuCopyAllowed = true;
+
+    auto alignedReadPtr = alignedMalloc(size + 1, MemoryConstants::cacheLineSize);
+    memset(alignedReadPtr, 0x00, size + 1);
+    auto unalignedReadPtr = ptrOffset(alignedReadPtr, 1);
+
+    uint8_t bufferData[] = {1, 2, 3, 4};
+    std::unique_ptr<Buffer> buffer(Buffer::create(context, CL_MEM_COPY_HOST_PTR, size, bufferData, retVal));
+    EXPECT_EQ(retVal, CL_SUCCESS);
+    ASSERT_TRUE(buffer->isReadWriteOnCpuAllowed(CL_TRUE, 0, unalignedReadPtr, size));
+
+    retVal = pCmdQ->enqueueReadBuffer(buffer.get(), CL_TRUE, 0, size, unalignedReadPtr, 0, nullptr, nullptr);
+    EXPECT_EQ(retVal, CL_SUCCESS);
+
+    auto charPtr = static_cast<char *>(unalignedReadPtr);
+    for (size_t i = 0; i < size; i++) {
+        EXPECT_EQ(charPtr[i], 0);
+    }
+
+    alignedFree(alignedReadPtr);
+}
+
+HWTEST_F(ReadWriteBufferCpuCopyTest, givenTransferPlannerCalibratedForGpuWhenReadBufferMeetsCpuCopyCriteriaThenCpuCopyIsNotDone) {
+    cl_int retVal;
+    size_t size = 4;
+
+    auto deviceInfo = context->getDevice(0)->getMutableDeviceInfo();
+    deviceInfo->cpuCopyAllowed = true;
+
+    auto &transferPlanner = pCmdQ->getDevice().getTransferPlanner();
+    for (uint32_t i = 0; i < TransferPlanner::minSamplesForCalibration; i++) {
+        transferPlanner.recordCpuTransfer(size << i, 1000000 << i);
+        transferPlanner.recordGpuTransfer(size << i, 1 << i);
+    }
+    ASSERT_TRUE(transferPlanner.isCalibrated());
+
+    auto alignedReadPtr = alignedMalloc(size + 1, MemoryConstants::cacheLineSize);
+    memset(alignedReadPtr, 0x00, size + 1);
+    auto unalignedReadPtr = ptrOffset(alignedReadPtr, 1);
+
+    uint8_t bufferData[] = {1, 2, 3, 4};
+    std::unique_ptr<Buffer> buffer(Buffer::create(context, CL_MEM_COPY_HOST_PTR, size, bufferData, retVal));
+    EXPECT_EQ(retVal, CL_SUCCESS);
+    ASSERT_TRUE(buffer->isReadWriteOnCpuAllowed(CL_TRUE, 0, unalignedReadPtr, size));
+
+    retVal = pCmdQ->enqueueReadBuffer(buffer.get(), CL_TRUE, 0, size, unalignedReadPtr, 0, nullptr, nullptr);
+    EXPECT_EQ(retVal, CL_SUCCESS);
+
+    auto charPtr = static_cast<char *>(unalignedReadPtr);
+    for (size_t i = 0; i < size; i++) {
+        EXPECT_EQ(charPtr[i], 0);
+    }
+
+    alignedFree(alignedReadPtr);
+}
+
+HWTEST_F(ReadWriteBufferCpuCopyTest, givenCpuCopiesWhenReadBufferIsExecutedThenTransferPlannerIsCalibratedWithCpuTimings) {
+    cl_int retVal;
+    size_t size = 4;
+
+    auto deviceInfo = context->getDevice(0)->getMutableDeviceInfo();
+    deviceInfo->cpuCopyAllowed = true;
+
+    auto &transferPlanner = pCmdQ->getDevice().getTransferPlanner();
+    for (uint32_t i = 0; i < TransferPlanner::minSamplesForCalibration; i++) {
+        transferPlanner.recordGpuTransfer(size << i, 10000 << i);
+    }
+
+    auto alignedReadPtr = alignedMalloc(size + 1, MemoryConstants::cacheLineSize);
+    auto unalignedReadPtr = ptrOffset(alignedReadPtr, 1);
+
+    uint8_t bufferData[] = {1, 2, 3, 4};
+    std::unique_ptr<Buffer> buffer(Buffer::create(context, CL_MEM_COPY_HOST_PTR, size, bufferData, retVal));
+    EXPECT_EQ(retVal, CL_SUCCESS);
+
+    for (uint32_t i = 0; i < TransferPlanner::minSamplesForCalibration; i++) {
+        EXPECT_FALSE(transferPlanner.isCalibrated());
+        memset(alignedReadPtr, 0x00, size + 1);
+        retVal = pCmdQ->enqueueReadBuffer(buffer.get(), CL_TRUE, 0, size, unalignedReadPtr, 0, nullptr, nullptr);
+        EXPECT_EQ(retVal, CL_SUCCESS);
+        EXPECT_EQ(0, memcmp(unalignedReadPtr, bufferData, size));
+    }
+    EXPECT_TRUE(transferPlanner.isCalibrated());
+
+    alignedFree(alignedReadPtr);
+}
+
+HWTEST_F(ReadWriteBufferCpuCopyTest, givenForcedCpuTransferPathWhenBufferRectIsReadAndWrittenThenCopyIsDoneOnCpu) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.ForceTransferPath.set(0);
+    cl_int retVal;
+
+    auto deviceInfo = context->getDevice(0)->getMutableDeviceInfo();
+    deviceInfo->cpuCopyAllowed = true;
+
+    uint8_t bufferData[4 * 4];
+    for (uint8_t i = 0; i < sizeof(bufferData); i++) {
+        bufferData[i] = i;
+    }
+    std::unique_ptr<Buffer> buffer(Buffer::create(context, CL_MEM_COPY_HOST_PTR, sizeof(bufferData), bufferData, retVal));
+    EXPECT_EQ(retVal, CL_SUCCESS);
+
+    size_t bufferOrigin[] = {1, 1, 0};
+    size_t hostOrigin[] = {0, 1, 0};
+    size_t region[] = {2, 2, 1};
+    uint8_t hostData[3 * 3] = {};
+
+    retVal = pCmdQ->enqueueReadBufferRect(buffer.get(), CL_TRUE, bufferOrigin, hostOrigin, region,
+                                          4, 16, 3, 9, hostData, 0, nullptr, nullptr);
+    EXPECT_EQ(retVal, CL_SUCCESS);
+
+    uint8_t expectedHostData[3 * 3] = {0, 0, 0, 5, 6, 0, 9, 10, 0};
+    EXPECT_EQ(0, memcmp(expectedHostData, hostData, sizeof(hostData)));
+
+    memset(hostData, 0xff, sizeof(hostData));
+    retVal = pCmdQ->enqueueWriteBufferRect(buffer.get(), CL_TRUE, bufferOrigin, hostOrigin, region,
+                                           4, 16, 3, 9, hostData, 0, nullptr, nullptr);
+    EXPECT_EQ(retVal, CL_SUCCESS);
+
+    auto bufferPtr = static_cast<uint8_t *>(buffer->getCpuAddressForMemoryTransfer());
+    for (uint8_t i = 0; i < sizeof(bufferData); i++) {
+        bool written = (i == 5 || i == 6 || i == 9 || i == 10);
+        EXPECT_EQ(written ? 0xff : i, bufferPtr[i]);
+    }
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/transfer_planner.h"
+#include "runtime/helpers/basic_math.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "test.h"
+
+using namespace OCLRT;
+
+namespace {
+const size_t smallSize = 4 * KB;
+const size_t largeSize = 1 * MB;
+
+void calibrateCpu(TransferPlanner &planner, double latencyNs, double nsPerByte, uint32_t samples) {
+    for (uint32_t i = 0; i < samples; i++) {
+        auto size = (i % 2) ? largeSize : smallSize;
+        planner.recordCpuTransfer(size, static_cast<uint64_t>(latencyNs + nsPerByte * size));
+    }
+}
+
+void calibrateGpu(TransferPlanner &planner, double latencyNs, double nsPerByte, uint32_t samples) {
+    for (uint32_t i = 0; i < samples; i++) {
+        auto size = (i % 2) ? largeSize : smallSize;
+        planner.recordGpuTransfer(size, static_cast<uint64_t>(latencyNs + nsPerByte * size));
+    }
+}
+} // namespace
+
+TEST(TransferCostModelTest, givenEmptyModelWhenCostIsEstimatedThenZeroIsReturned) {
+    TransferCostModel model;
+    EXPECT_EQ(0u, model.getSampleCount());
+    EXPECT_EQ(0.0, model.estimate(largeSize));
+}
+
+TEST(TransferCostModelTest, givenSamplesOfDifferentSizesWhenCostIsEstimatedThenLatencyAndThroughputAreFitted) {
+    TransferCostModel model;
+    model.addSample(smallSize, 20000 + smallSize / 10);
+    model.addSample(largeSize, 20000 + largeSize / 10);
+    model.addSample(smallSize, 20000 + smallSize / 10);
+
+    EXPECT_EQ(3u, model.getSampleCount());
+    EXPECT_NEAR(20000.0, model.estimate(0), 1.0);
+    EXPECT_NEAR(20000.0 + 4 * MB / 10, model.estimate(4 * MB), 4.0);
+}
+
+TEST(TransferCostModelTest, givenSamplesOfSingleSizeWhenCostIsEstimatedThenCostIsProportionalToSize) {
+    TransferCostModel model;
+    model.addSample(smallSize, smallSize * 2);
+    model.addSample(smallSize, smallSize * 2);
+
+    EXPECT_NEAR(largeSize * 2.0, model.estimate(largeSize), 1.0);
+}
+
+TEST(TransferCostModelTest, givenTimingsChangedWhenNewSamplesAreAddedThenOldSamplesFadeOut) {
+    TransferCostModel model;
+    for (int i = 0; i < 10; i++) {
+        model.addSample(largeSize, largeSize);
+    }
+    for (int i = 0; i < 30; i++) {
+        model.addSample(largeSize, largeSize * 2);
+    }
+
+    EXPECT_NEAR(largeSize * 2.0, model.estimate(largeSize), largeSize * 0.05);
+}
+
+TEST(TransferPlannerTest, givenUncalibratedPlannerWhenPathIsSelectedThenDefaultPathIsReturned) {
+    TransferPlanner planner;
+    calibrateCpu(planner, 0, 1.0, TransferPlanner::minSamplesForCalibration);
+    calibrateGpu(planner, 20000, 0.1, TransferPlanner::minSamplesForCalibration - 1);
+
+    EXPECT_FALSE(planner.isCalibrated());
+    EXPECT_EQ(TransferPath::CPU, planner.selectPath(largeSize, TransferPath::CPU));
+    EXPECT_EQ(TransferPath::GPU, planner.selectPath(smallSize, TransferPath::GPU));
+
+    calibrateGpu(planner, 20000, 0.1, 1);
+    EXPECT_TRUE(planner.isCalibrated());
+}
+
+TEST(TransferPlannerTest, givenCalibratedPlannerWhenPathIsSelectedThenCheaperPathIsReturned) {
+    TransferPlanner planner;
+    // CPU copies 1 byte per ns, GPU copy has 20us latency and copies 10 bytes per ns
+    calibrateCpu(planner, 0, 1.0, TransferPlanner::minSamplesForCalibration);
+    calibrateGpu(planner, 20000, 0.1, TransferPlanner::minSamplesForCalibration);
+
+    EXPECT_LT(planner.estimateCpuCost(smallSize), planner.estimateGpuCost(smallSize));
+    EXPECT_GT(planner.estimateCpuCost(largeSize), planner.estimateGpuCost(largeSize));
+
+    EXPECT_EQ(TransferPath::CPU, planner.selectPath(smallSize, TransferPath::GPU));
+    EXPECT_EQ(TransferPath::GPU, planner.selectPath(largeSize, TransferPath::CPU));
+}
+
+TEST(TransferPlannerTest, givenCostsWithinHysteresisWhenPathIsSelectedThenPreviousPathIsKept) {
+    TransferPlanner planner;
+    // both paths cost about 22us for 22000 bytes
+    const size_t size = 22000;
+    calibrateCpu(planner, 0, 1.0, 40);
+    calibrateGpu(planner, 20000, 0.1, 40);
+
+    EXPECT_EQ(TransferPath::CPU, planner.selectPath(size, TransferPath::CPU));
+    // the size class keeps its path even if the static heuristics would choose the other one
+    EXPECT_EQ(TransferPath::CPU, planner.selectPath(size, TransferPath::GPU));
+
+    // CPU becomes 20% slower, not enough to switch
+    calibrateCpu(planner, 0, 1.2, 40);
+    EXPECT_EQ(TransferPath::CPU, planner.selectPath(size, TransferPath::CPU));
+
+    // CPU becomes twice as slow, GPU is selected
+    calibrateCpu(planner, 0, 2.0, 40);
+    EXPECT_EQ(TransferPath::GPU, planner.selectPath(size, TransferPath::CPU));
+
+    // CPU recovers to about the GPU cost, GPU is kept
+    calibrateCpu(planner, 0, 0.95, 40);
+    EXPECT_EQ(TransferPath::GPU, planner.selectPath(size, TransferPath::CPU));
+
+    // CPU becomes much faster, CPU is selected again
+    calibrateCpu(planner, 0, 0.5, 40);
+    EXPECT_EQ(TransferPath::CPU, planner.selectPath(size, TransferPath::GPU));
+}
+
+TEST(TransferPlannerTest, givenForcedTransferPathWhenPathIsSelectedThenForcedPathIsReturned) {
+    DebugManagerStateRestore dbgRestore;
+    TransferPlanner planner;
+
+    DebugManager.flags.ForceTransferPath.set(0);
+    EXPECT_EQ(TransferPath::CPU, planner.selectPath(largeSize, TransferPath::GPU));
+    DebugManager.flags.ForceTransferPath.set(1);
+    EXPECT_EQ(TransferPath::GPU, planner.selectPath(smallSize, TransferPath::CPU));
+
+    calibrateCpu(planner, 0, 1.0, TransferPlanner::minSamplesForCalibration);
+    calibrateGpu(planner, 20000, 0.1, TransferPlanner::minSamplesForCalibration);
+
+    DebugManager.flags.ForceTransferPath.set(0);
+    EXPECT_EQ(TransferPath::CPU, planner.selectPath(largeSize, TransferPath::GPU));
+    DebugManager.flags.ForceTransferPath.set(1);
+    EXPECT_EQ(TransferPath::GPU, planner.selectPath(smallSize, TransferPath::CPU));
+}
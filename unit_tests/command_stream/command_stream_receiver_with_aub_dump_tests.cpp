@@ -23,8 +23,15 @@
 #include "unit_tests/libult/ult_command_stream_receiver.h"
 #include "runtime/command_stream/command_stream_receiver_with_aub_dump.h"
 #include "runtime/command_stream/command_stream_receiver_with_aub_dump.inl"
+#include "runtime/helpers/ptr_math.h"
+#include "runtime/memory_manager/memory_constants.h"
+#include "runtime/memory_manager/os_agnostic_memory_manager.h"
 
 #include "test.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 using namespace OCLRT;
 
@@ -219,3 +226,197 @@ INSTANTIATE_TEST_CASE_P(
     CommandStreamReceiverWithAubDumpTest_Create,
     CommandStreamReceiverWithAubDumpTest,
     testing::ValuesIn(createAubCSR));
+
+struct MyMockCsrProcessingResidencyOnFlush : MyMockCsr {
+    MyMockCsrProcessingResidencyOnFlush(const HardwareInfo &hwInfoIn, void *ptr) : MyMockCsr(hwInfoIn, ptr) {
+    }
+
+    FlushStamp flush(BatchBuffer &batchBuffer, EngineType engineOrdinal, ResidencyContainer *allocationsForResidency) override {
+        this->processResidency(allocationsForResidency);
+        return MyMockCsr::flush(batchBuffer, engineOrdinal, allocationsForResidency);
+    }
+};
+
+// records what an AUB CSR would write, following the writeMemory rules of AUBCommandStreamReceiverHw
+struct RecordingAubCsr : MyMockCsr {
+    RecordingAubCsr(const HardwareInfo &hwInfoIn) : MyMockCsr(hwInfoIn, nullptr) {
+    }
+
+    FlushStamp flush(BatchBuffer &batchBuffer, EngineType engineOrdinal, ResidencyContainer *allocationsForResidency) override {
+        {
+            std::unique_lock<std::mutex> lock(flushMutex);
+            flushAllowed.wait_for(lock, std::chrono::seconds(10), [&] { return !blockFlush; });
+        }
+        processResidency(allocationsForResidency);
+        auto size = batchBuffer.usedSize - batchBuffer.startOffset;
+        record(batchBuffer.commandBufferAllocation->getGpuAddress() + batchBuffer.startOffset,
+               ptrOffset(batchBuffer.commandBufferAllocation->getUnderlyingBuffer(), batchBuffer.startOffset), size);
+        flushCount++;
+        return 0;
+    }
+
+    void processResidency(ResidencyContainer *allocationsForResidency) override {
+        for (auto &gfxAllocation : *allocationsForResidency) {
+            auto allocType = gfxAllocation->getAllocationType();
+            if ((gfxAllocation->getUnderlyingBufferSize() == 0) || !!(allocType & GraphicsAllocation::ALLOCATION_TYPE_NON_AUB_WRITABLE)) {
+                continue;
+            }
+            record(gfxAllocation->getGpuAddress(), gfxAllocation->getUnderlyingBuffer(), gfxAllocation->getUnderlyingBufferSize());
+            if (!!(allocType & GraphicsAllocation::ALLOCATION_TYPE_BUFFER)) {
+                gfxAllocation->setAllocationType(allocType | GraphicsAllocation::ALLOCATION_TYPE_NON_AUB_WRITABLE);
+            }
+        }
+    }
+
+    void record(uint64_t gpuAddress, const void *data, size_t size) {
+        auto bytes = reinterpret_cast<const char *>(&gpuAddress);
+        dump.insert(dump.end(), bytes, bytes + sizeof(gpuAddress));
+        dump.insert(dump.end(), reinterpret_cast<const char *>(data), reinterpret_cast<const char *>(data) + size);
+    }
+
+    void setBlockFlush(bool block) {
+        {
+            std::lock_guard<std::mutex> lock(flushMutex);
+            blockFlush = block;
+        }
+        flushAllowed.notify_all();
+    }
+
+    std::vector<char> dump;
+    std::atomic<uint32_t> flushCount{0};
+    bool blockFlush = false;
+    std::mutex flushMutex;
+    std::condition_variable flushAllowed;
+};
+
+struct CsrWithRecordingAubDump : CommandStreamReceiverWithAUBDump<MyMockCsrProcessingResidencyOnFlush> {
+    CsrWithRecordingAubDump(const HardwareInfo &hwInfoIn, size_t maxStagedSize)
+        : CommandStreamReceiverWithAUBDump<MyMockCsrProcessingResidencyOnFlush>(hwInfoIn) {
+        delete this->aubCSR;
+        this->aubCSR = new RecordingAubCsr(hwInfoIn);
+        if (maxStagedSize) {
+            this->aubDumpWorker.reset(new AubDumpWorker(*this->aubCSR, maxStagedSize));
+        }
+    }
+
+    RecordingAubCsr &getRecordingAubCsr() {
+        return static_cast<RecordingAubCsr &>(*this->aubCSR);
+    }
+};
+
+struct AsyncAubDumpTest : public ::testing::Test {
+    void SetUp() override {
+        memoryManager.reset(new OsAgnosticMemoryManager(false));
+
+        allocation = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+        buffer = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+        commandBuffer = memoryManager->allocateGraphicsMemory(MemoryConstants::pageSize, MemoryConstants::pageSize);
+        allocationsForResidency = {allocation, buffer};
+    }
+
+    void TearDown() override {
+        memoryManager->freeGraphicsMemory(allocation);
+        memoryManager->freeGraphicsMemory(buffer);
+        memoryManager->freeGraphicsMemory(commandBuffer);
+    }
+
+    void fill(char value) {
+        memset(allocation->getUnderlyingBuffer(), value, allocation->getUnderlyingBufferSize());
+        memset(buffer->getUnderlyingBuffer(), value + 1, buffer->getUnderlyingBufferSize());
+        memset(commandBuffer->getUnderlyingBuffer(), value + 2, commandBuffer->getUnderlyingBufferSize());
+    }
+
+    std::vector<char> runSubmissions(size_t maxStagedSize) {
+        buffer->setAllocationType(GraphicsAllocation::ALLOCATION_TYPE_BUFFER);
+        std::unique_ptr<CsrWithRecordingAubDump> csr(new CsrWithRecordingAubDump(DEFAULT_TEST_PLATFORM::hwInfo, maxStagedSize));
+        csr->setMemoryManager(memoryManager.get());
+        csr->aubCSR->setMemoryManager(memoryManager.get());
+
+        BatchBuffer firstBatchBuffer{commandBuffer, 0, false, false, QueueThrottle::MEDIUM, 256, nullptr};
+        BatchBuffer secondBatchBuffer{commandBuffer, 256, false, false, QueueThrottle::MEDIUM, 512, nullptr};
+
+        // keep the AUB CSR busy, so the asynchronous dump happens after the memory has changed
+        csr->getRecordingAubCsr().setBlockFlush(maxStagedSize != 0);
+        fill(0x10);
+        csr->flush(firstBatchBuffer, EngineType::ENGINE_RCS, &allocationsForResidency);
+        fill(0x20);
+        csr->flush(secondBatchBuffer, EngineType::ENGINE_RCS, &allocationsForResidency);
+        fill(0x30);
+        csr->getRecordingAubCsr().setBlockFlush(false);
+
+        if (csr->aubDumpWorker) {
+            csr->aubDumpWorker->drain();
+        }
+        EXPECT_EQ(2u, csr->getRecordingAubCsr().flushCount.load());
+        return csr->getRecordingAubCsr().dump;
+    }
+
+    std::unique_ptr<MemoryManager> memoryManager;
+    GraphicsAllocation *allocation = nullptr;
+    GraphicsAllocation *buffer = nullptr;
+    GraphicsAllocation *commandBuffer = nullptr;
+    ResidencyContainer allocationsForResidency;
+};
+
+HWTEST_F(AsyncAubDumpTest, givenAsyncAubDumpWhenAllocationsChangeAfterFlushThenDumpIsIdenticalToSynchronousDump) {
+    auto syncDump = runSubmissions(0);
+    auto asyncDump = runSubmissions(16 * MemoryConstants::megaByte);
+
+    EXPECT_FALSE(syncDump.empty());
+    EXPECT_EQ(syncDump, asyncDump);
+    EXPECT_TRUE(!!(buffer->getAllocationType() & GraphicsAllocation::ALLOCATION_TYPE_NON_AUB_WRITABLE));
+}
+
+HWTEST_F(AsyncAubDumpTest, givenAsyncAubDumpWhenAubCsrIsBusyThenFlushReturnsWithoutWaitingForDump) {
+    std::unique_ptr<CsrWithRecordingAubDump> csr(new CsrWithRecordingAubDump(DEFAULT_TEST_PLATFORM::hwInfo, 16 * MemoryConstants::megaByte));
+    csr->setMemoryManager(memoryManager.get());
+    csr->aubCSR->setMemoryManager(memoryManager.get());
+    auto &aubCsr = csr->getRecordingAubCsr();
+
+    BatchBuffer batchBuffer{commandBuffer, 0, false, false, QueueThrottle::MEDIUM, 256, nullptr};
+
+    aubCsr.setBlockFlush(true);
+    auto flushStamp = csr->flush(batchBuffer, EngineType::ENGINE_RCS, &allocationsForResidency);
+
+    EXPECT_EQ(csr->flushParametrization.flushStampToReturn, flushStamp);
+    EXPECT_TRUE(csr->flushParametrization.wasCalled);
+    EXPECT_EQ(0u, aubCsr.flushCount.load());
+    EXPECT_NE(0u, csr->aubDumpWorker->peekStagedSize());
+
+    aubCsr.setBlockFlush(false);
+    csr->aubDumpWorker->drain();
+    EXPECT_EQ(1u, aubCsr.flushCount.load());
+    EXPECT_EQ(0u, csr->aubDumpWorker->peekStagedSize());
+}
+
+HWTEST_F(AsyncAubDumpTest, givenAsyncAubDumpWhenSnapshotExceedsStagingBudgetThenDumpIsWrittenSynchronously) {
+    std::unique_ptr<CsrWithRecordingAubDump> csr(new CsrWithRecordingAubDump(DEFAULT_TEST_PLATFORM::hwInfo, MemoryConstants::pageSize));
+    csr->setMemoryManager(memoryManager.get());
+    csr->aubCSR->setMemoryManager(memoryManager.get());
+    auto &aubCsr = csr->getRecordingAubCsr();
+
+    BatchBuffer batchBuffer{commandBuffer, 0, false, false, QueueThrottle::MEDIUM, 256, nullptr};
+
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, &allocationsForResidency);
+
+    EXPECT_EQ(1u, aubCsr.flushCount.load());
+    EXPECT_EQ(0u, csr->aubDumpWorker->peekStagedSize());
+}
+
+HWTEST_F(AsyncAubDumpTest, givenAsyncAubDumpWhenWorkerIsDestroyedThenPendingSnapshotsAreDumped) {
+    std::unique_ptr<CsrWithRecordingAubDump> csr(new CsrWithRecordingAubDump(DEFAULT_TEST_PLATFORM::hwInfo, 16 * MemoryConstants::megaByte));
+    csr->setMemoryManager(memoryManager.get());
+    csr->aubCSR->setMemoryManager(memoryManager.get());
+    auto &aubCsr = csr->getRecordingAubCsr();
+
+    BatchBuffer batchBuffer{commandBuffer, 0, false, false, QueueThrottle::MEDIUM, 256, nullptr};
+
+    aubCsr.setBlockFlush(true);
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, &allocationsForResidency);
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, &allocationsForResidency);
+    EXPECT_EQ(0u, aubCsr.flushCount.load());
+
+    aubCsr.setBlockFlush(false);
+    csr->aubDumpWorker.reset();
+    EXPECT_EQ(2u, aubCsr.flushCount.load());
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/tbx/tbx_proto.h"
+#include "runtime/tbx/tbx_sockets_imp.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace {
+
+bool recvAll(int fd, void *buffer, size_t size) {
+    auto data = reinterpret_cast<char *>(buffer);
+    while (size > 0) {
+        auto received = ::recv(fd, data, size, 0);
+        if (received <= 0) {
+            return false;
+        }
+        data += received;
+        size -= received;
+    }
+    return true;
+}
+
+// Decodes the HAS stream coming from TbxSocketsImp and answers read requests
+struct FakeTbxServer {
+    struct WriteRequest {
+        uint64_t address;
+        size_t size;
+    };
+
+    explicit FakeTbxServer(int fd) : fd(fd), worker([this] { run(); }) {}
+
+    void join() { worker.join(); }
+
+    void run() {
+        HAS_MSG msg;
+        while (recvAll(fd, &msg.hdr, sizeof(HAS_HDR))) {
+            if (!recvAll(fd, &msg.u, msg.hdr.size)) {
+                break;
+            }
+            switch (msg.hdr.msg_type) {
+            case HAS_WRITE_DATA_REQ_TYPE: {
+                uint64_t address = (static_cast<uint64_t>(msg.u.write_req.address_h) << 32) | msg.u.write_req.address;
+                std::vector<uint8_t> payload(msg.u.write_req.size);
+                if (!recvAll(fd, payload.data(), payload.size())) {
+                    return;
+                }
+                for (size_t i = 0; i < payload.size(); i++) {
+                    memory[address + i] = payload[i];
+                }
+                writes.push_back({address, payload.size()});
+                break;
+            }
+            case HAS_GTT_REQ_TYPE:
+                gtt[msg.u.gtt64_req.offset] = (static_cast<uint64_t>(msg.u.gtt64_req.data_h) << 32) | msg.u.gtt64_req.data;
+                break;
+            case HAS_MMIO_REQ_TYPE:
+                if (msg.u.mmio_req.write) {
+                    mmio[msg.u.mmio_req.offset] = msg.u.mmio_req.data;
+                } else {
+                    HAS_MSG resp;
+                    memset(&resp, 0, sizeof(resp));
+                    resp.hdr.msg_type = HAS_MMIO_RES_TYPE;
+                    resp.hdr.trans_id = msg.hdr.trans_id;
+                    resp.hdr.size = sizeof(HAS_MMIO_RES);
+                    resp.u.mmio_res.data = mmio[msg.u.mmio_req.offset];
+                    ::send(fd, &resp, sizeof(HAS_HDR) + sizeof(HAS_MMIO_RES), 0);
+                }
+                break;
+            case HAS_READ_DATA_REQ_TYPE: {
+                uint64_t address = (static_cast<uint64_t>(msg.u.read_req.address_h) << 32) | msg.u.read_req.address;
+                HAS_MSG resp;
+                memset(&resp, 0, sizeof(resp));
+                resp.hdr.msg_type = HAS_READ_DATA_RES_TYPE;
+                resp.hdr.trans_id = msg.hdr.trans_id;
+                resp.hdr.size = sizeof(HAS_READ_DATA_RES);
+                resp.u.read_res.size = msg.u.read_req.size;
+                std::vector<uint8_t> payload(msg.u.read_req.size);
+                for (size_t i = 0; i < payload.size(); i++) {
+                    payload[i] = memory[address + i];
+                }
+                ::send(fd, &resp, sizeof(HAS_HDR) + sizeof(HAS_READ_DATA_RES), 0);
+                ::send(fd, payload.data(), payload.size(), 0);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+
+    int fd;
+    std::map<uint64_t, uint8_t> memory;
+    std::map<uint32_t, uint64_t> gtt;
+    std::map<uint32_t, uint32_t> mmio;
+    std::vector<WriteRequest> writes;
+    std::thread worker;
+};
+
+struct MockTbxSocketsImp : public TbxSocketsImp {
+    MockTbxSocketsImp(int fd) : TbxSocketsImp(err) {
+        m_socket = fd;
+    }
+
+    bool sendWriteData(const void *buffer, size_t sizeInBytes) override {
+        sendCalls++;
+        return TbxSocketsImp::sendWriteData(buffer, sizeInBytes);
+    }
+
+    std::stringstream err;
+    size_t sendCalls = 0;
+};
+
+struct TbxSocketsImpTest : public ::testing::Test {
+    void SetUp() override {
+        int fds[2];
+        ASSERT_EQ(0, ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+        sockets.reset(new MockTbxSocketsImp(fds[0]));
+        server.reset(new FakeTbxServer(fds[1]));
+    }
+
+    void TearDown() override {
+        sockets->close();
+        server->join();
+        ::close(server->fd);
+    }
+
+    std::unique_ptr<MockTbxSocketsImp> sockets;
+    std::unique_ptr<FakeTbxServer> server;
+};
+
+} // namespace
+
+TEST_F(TbxSocketsImpTest, contiguousPagesAreMergedIntoSingleWriteRequest) {
+    const size_t pageSize = 4096;
+    const size_t numPages = 16;
+    std::vector<uint8_t> data(pageSize * numPages);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    uint64_t baseAddress = 0x100000000ull;
+    for (size_t page = 0; page < numPages; page++) {
+        EXPECT_TRUE(sockets->writeMemory(baseAddress + page * pageSize, &data[page * pageSize], pageSize));
+    }
+    EXPECT_EQ(0u, sockets->sendCalls);
+
+    std::vector<uint8_t> readBack(data.size());
+    EXPECT_TRUE(sockets->readMemory(baseAddress, readBack.data(), readBack.size()));
+    EXPECT_EQ(1u, sockets->sendCalls);
+    EXPECT_EQ(data, readBack);
+
+    ASSERT_EQ(1u, server->writes.size());
+    EXPECT_EQ(baseAddress, server->writes[0].address);
+    EXPECT_EQ(data.size(), server->writes[0].size);
+}
+
+TEST_F(TbxSocketsImpTest, nonContiguousPagesAreSentAsSeparateWriteRequests) {
+    const size_t pageSize = 4096;
+    std::vector<uint8_t> data(pageSize, 0x5a);
+
+    EXPECT_TRUE(sockets->writeMemory(0x10000, data.data(), pageSize));
+    EXPECT_TRUE(sockets->writeMemory(0x10000 + 2 * pageSize, data.data(), pageSize));
+
+    uint32_t value = 0;
+    EXPECT_TRUE(sockets->readMMIO(0x2000, &value));
+    EXPECT_EQ(1u, sockets->sendCalls);
+
+    ASSERT_EQ(2u, server->writes.size());
+    EXPECT_EQ(0x10000u, server->writes[0].address);
+    EXPECT_EQ(0x10000u + 2 * pageSize, server->writes[1].address);
+    EXPECT_EQ(0x5a, server->memory[0x10000 + 2 * pageSize + pageSize - 1]);
+}
+
+TEST_F(TbxSocketsImpTest, writesInterleavedWithGttAndMmioDecodeInOrder) {
+    uint32_t page[1024];
+    for (uint32_t i = 0; i < 1024; i++) {
+        page[i] = i;
+    }
+
+    EXPECT_TRUE(sockets->writeGTT(0x10, 0x123456789ull));
+    EXPECT_TRUE(sockets->writeMemory(0x3000, page, sizeof(page)));
+    EXPECT_TRUE(sockets->writeMMIO(0x2000, 0xcafe));
+    EXPECT_TRUE(sockets->writeMemory(0x4000, page, sizeof(page)));
+
+    uint32_t value = 0;
+    EXPECT_TRUE(sockets->readMMIO(0x2000, &value));
+    EXPECT_EQ(0xcafeu, value);
+    EXPECT_EQ(1u, sockets->sendCalls);
+
+    // MMIO write in between keeps the pages as separate requests
+    ASSERT_EQ(2u, server->writes.size());
+    EXPECT_EQ(0x123456789ull, server->gtt[0x10 / sizeof(uint64_t)]);
+    EXPECT_EQ(0x3u, server->memory[0x4000 + 3 * sizeof(uint32_t)]);
+}
+
+TEST_F(TbxSocketsImpTest, batchIsFlushedWhenItExceedsMaxSize) {
+    const size_t chunkSize = TbxSocketsImp::maxBatchSize / 2;
+    std::vector<uint8_t> data(chunkSize, 0x11);
+
+    EXPECT_TRUE(sockets->writeMemory(0x0, data.data(), chunkSize));
+    EXPECT_TRUE(sockets->writeMemory(0x100000000ull, data.data(), chunkSize));
+    EXPECT_EQ(1u, sockets->sendCalls);
+
+    uint32_t value = 0;
+    EXPECT_TRUE(sockets->readMMIO(0x0, &value));
+    EXPECT_EQ(2u, sockets->sendCalls);
+    ASSERT_EQ(2u, server->writes.size());
+    EXPECT_EQ(0x11, server->memory[0x100000000ull + chunkSize - 1]);
+}
@@ -35,6 +35,7 @@
 #include <memory>
 #include <array>
 #include <list>
+#include <vector>
 
 #include "test.h"
 
@@ -345,6 +346,53 @@ TEST_F(BinaryCacheTests, cacheThenLoad) {
     EXPECT_TRUE(ret);
 }
 
+TEST_F(BinaryCacheTests, givenCheckedBinaryWhenLoadedThenOriginalBinaryIsReturned) {
+    static const char *hash = "SOME_CHECKED_HASH";
+    std::vector<char> data(32);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<char>(i);
+
+    bool ret = cache->cacheCheckedBinary(hash, data.data(), static_cast<uint32_t>(data.size()));
+    EXPECT_TRUE(ret);
+
+    std::vector<char> loaded;
+    ret = cache->loadCheckedBinary(hash, loaded);
+    EXPECT_TRUE(ret);
+    EXPECT_EQ(data, loaded);
+}
+
+TEST_F(BinaryCacheTests, givenCorruptedCheckedBinaryWhenLoadedThenEntryIsRejected) {
+    static const char *hash = "SOME_CORRUPTED_CHECKED_HASH";
+    std::vector<char> data(32);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<char>(i);
+
+    bool ret = cache->cacheCheckedBinary(hash, data.data(), static_cast<uint32_t>(data.size()));
+    EXPECT_TRUE(ret);
+
+    std::vector<char> stored;
+    ret = cache->loadCachedData(hash, stored);
+    ASSERT_TRUE(ret);
+    ASSERT_GT(stored.size(), data.size());
+
+    stored[stored.size() - 1] ^= 0x1;
+    ret = cache->cacheBinary(hash, stored.data(), static_cast<uint32_t>(stored.size()));
+    EXPECT_TRUE(ret);
+
+    std::vector<char> loaded;
+    EXPECT_FALSE(cache->loadCheckedBinary(hash, loaded));
+    EXPECT_TRUE(loaded.empty());
+
+    stored.resize(stored.size() - 1);
+    ret = cache->cacheBinary(hash, stored.data(), static_cast<uint32_t>(stored.size()));
+    EXPECT_TRUE(ret);
+    EXPECT_FALSE(cache->loadCheckedBinary(hash, loaded));
+
+    ret = cache->cacheBinary(hash, data.data(), static_cast<uint32_t>(data.size()));
+    EXPECT_TRUE(ret);
+    EXPECT_FALSE(cache->loadCheckedBinary(hash, loaded));
+}
+
 TEST_F(CompilerInterfaceCachedTests, canInjectCache) {
     std::unique_ptr<BinaryCache> cache(new BinaryCache());
     auto res1 = pCompilerInterface->replaceBinaryCache(cache.get());
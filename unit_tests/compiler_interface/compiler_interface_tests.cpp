@@ -37,6 +37,11 @@
 
 #include "gmock/gmock-matchers.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
 using namespace OCLRT;
 
 #if defined(_WIN32)
@@ -882,3 +887,166 @@ TEST_F(CompilerInterfaceTest, whenRequestingSipKernelBinaryThenProperInternalOpt
 
     gEnvironment->igcPopDebugVars();
 }
+
+TEST_F(CompilerInterfaceTest, GivenTranslationCtxUsedByBuildWhenBuildingAgainThenPooledTranslationCtxIsReused) {
+    auto device = this->pContext->getDevice(0);
+    EXPECT_EQ(0u, pCompilerInterface->getNumIdleIgcTranslationCtxs(*device, IGC::CodeType::llvmBc, IGC::CodeType::oclGenBin));
+
+    retVal = pCompilerInterface->build(*pProgram, inputArgs, false);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(1u, pCompilerInterface->getNumIdleIgcTranslationCtxs(*device, IGC::CodeType::llvmBc, IGC::CodeType::oclGenBin));
+
+    pCompilerInterface->failCreateIgcTranslationCtx = true;
+    retVal = pCompilerInterface->build(*pProgram, inputArgs, false);
+    pCompilerInterface->failCreateIgcTranslationCtx = false;
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    EXPECT_EQ(1u, pCompilerInterface->getNumIdleIgcTranslationCtxs(*device, IGC::CodeType::llvmBc, IGC::CodeType::oclGenBin));
+}
+
+class MissingBinaryCacheBarrier : public BinaryCache {
+  public:
+    MissingBinaryCacheBarrier(uint32_t numBuilds) : numBuilds(numBuilds) {
+    }
+
+    bool cacheBinary(const std::string kernelFileHash, const char *pBinary, uint32_t binarySize) override {
+        return false;
+    }
+
+    bool loadCachedBinary(const std::string kernelFileHash, Program &program) override {
+        // every build misses the cache at the same time
+        std::unique_lock<std::mutex> lock(barrierMtx);
+        numArrived++;
+        arrived.notify_all();
+        arrived.wait(lock, [this] { return numArrived >= numBuilds; });
+        return false;
+    }
+
+    std::mutex barrierMtx;
+    std::condition_variable arrived;
+    uint32_t numBuilds = 0;
+    uint32_t numArrived = 0;
+};
+
+struct IdenticalBuildsTranslateListener {
+    static void listener(void *data) {
+        auto listenerData = static_cast<IdenticalBuildsTranslateListener *>(data);
+        listenerData->numTranslations++;
+
+        // hold the compilation until every other build waits for it
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while ((listenerData->compilerInterface->getNumInFlightBuildWaiters() < listenerData->expectedWaiters) &&
+               (std::chrono::steady_clock::now() < deadline)) {
+            std::this_thread::yield();
+        }
+    }
+
+    MockCompilerInterface *compilerInterface = nullptr;
+    uint32_t expectedWaiters = 0;
+    std::atomic<uint32_t> numTranslations{0};
+};
+
+TEST_F(CompilerInterfaceTest, GivenConcurrentIdenticalBuildsWhenCachingIsEnabledThenIgcTranslatesOnceAndBuildsShareResult) {
+    constexpr uint32_t numBuilds = 4;
+    delete pCompilerInterface->replaceBinaryCache(new MissingBinaryCacheBarrier(numBuilds));
+
+    IdenticalBuildsTranslateListener listenerData;
+    listenerData.compilerInterface = pCompilerInterface.get();
+    listenerData.expectedWaiters = numBuilds - 1;
+
+    auto igcDebugVars = getIgcDebugVars();
+    igcDebugVars.translateListener = IdenticalBuildsTranslateListener::listener;
+    igcDebugVars.translateListenerData = &listenerData;
+    gEnvironment->igcPushDebugVars(igcDebugVars);
+
+    std::vector<std::unique_ptr<Program>> programs;
+    cl_int buildResults[numBuilds] = {};
+    std::vector<std::thread> builders;
+    for (uint32_t i = 0; i < numBuilds; i++) {
+        programs.emplace_back(new Program(pContext));
+    }
+    for (uint32_t i = 0; i < numBuilds; i++) {
+        builders.emplace_back([&, i]() {
+            buildResults[i] = pCompilerInterface->build(*programs[i], inputArgs, true);
+        });
+    }
+    for (auto &builder : builders) {
+        builder.join();
+    }
+
+    gEnvironment->igcPopDebugVars();
+
+    EXPECT_EQ(1u, listenerData.numTranslations);
+    EXPECT_EQ(0u, pCompilerInterface->getNumInFlightBuildWaiters());
+
+    size_t expectedBinarySize = 0;
+    auto expectedBinary = programs[0]->getGenBinary(expectedBinarySize);
+    EXPECT_NE(0u, expectedBinarySize);
+    for (uint32_t i = 0; i < numBuilds; i++) {
+        EXPECT_EQ(CL_SUCCESS, buildResults[i]);
+        size_t binarySize = 0;
+        auto binary = programs[i]->getGenBinary(binarySize);
+        ASSERT_EQ(expectedBinarySize, binarySize);
+        EXPECT_EQ(0, memcmp(expectedBinary, binary, binarySize));
+    }
+}
+
+struct DistinctBuildsTranslateListener {
+    static void listener(void *data) {
+        auto listenerData = static_cast<DistinctBuildsTranslateListener *>(data);
+
+        // both compilations have to be in flight at once
+        std::unique_lock<std::mutex> lock(listenerData->mtx);
+        listenerData->numTranslations++;
+        listenerData->translationStarted.notify_all();
+        auto overlapped = listenerData->translationStarted.wait_for(lock, std::chrono::seconds(10), [listenerData] {
+            return listenerData->numTranslations >= listenerData->expectedTranslations;
+        });
+        listenerData->allOverlapped &= overlapped;
+    }
+
+    std::mutex mtx;
+    std::condition_variable translationStarted;
+    uint32_t expectedTranslations = 0;
+    uint32_t numTranslations = 0;
+    bool allOverlapped = true;
+};
+
+TEST_F(CompilerInterfaceTest, GivenConcurrentDistinctBuildsWhenCachingIsEnabledThenEachBuildIsTranslatedInParallel) {
+    constexpr uint32_t numBuilds = 2;
+    delete pCompilerInterface->replaceBinaryCache(new MissingBinaryCacheBarrier(numBuilds));
+
+    DistinctBuildsTranslateListener listenerData;
+    listenerData.expectedTranslations = numBuilds;
+
+    auto igcDebugVars = getIgcDebugVars();
+    igcDebugVars.translateListener = DistinctBuildsTranslateListener::listener;
+    igcDebugVars.translateListenerData = &listenerData;
+    gEnvironment->igcPushDebugVars(igcDebugVars);
+
+    std::string internalOptions[numBuilds] = {"-first", "-second"};
+    std::vector<std::unique_ptr<Program>> programs;
+    cl_int buildResults[numBuilds] = {};
+    std::vector<std::thread> builders;
+    for (uint32_t i = 0; i < numBuilds; i++) {
+        programs.emplace_back(new Program(pContext));
+    }
+    for (uint32_t i = 0; i < numBuilds; i++) {
+        builders.emplace_back([&, i]() {
+            auto buildArgs = inputArgs;
+            buildArgs.pInternalOptions = internalOptions[i].c_str();
+            buildArgs.InternalOptionsSize = static_cast<uint32_t>(internalOptions[i].length());
+            buildResults[i] = pCompilerInterface->build(*programs[i], buildArgs, true);
+        });
+    }
+    for (auto &builder : builders) {
+        builder.join();
+    }
+
+    gEnvironment->igcPopDebugVars();
+
+    EXPECT_EQ(numBuilds, listenerData.numTranslations);
+    EXPECT_TRUE(listenerData.allOverlapped);
+    for (uint32_t i = 0; i < numBuilds; i++) {
+        EXPECT_EQ(CL_SUCCESS, buildResults[i]);
+    }
+}
@@ -34,6 +34,7 @@
 #include "runtime/command_queue/dispatch_walker_helper.h"
 #include "runtime/helpers/kernel_commands.h"
 
+#include <algorithm>
 #include <memory>
 
 using namespace OCLRT;
@@ -302,6 +303,61 @@ HWTEST_F(DeviceQueueSlb, slbEndOffset) {
     free(slbCopy);
 }
 
+HWTEST_F(DeviceQueueSlb, givenSimulatedSchedulerRunWhenResetThenBuffersMatchFullResetAndFewerBytesAreTouched) {
+    std::unique_ptr<MockDeviceQueueHw<FamilyType>> mockDeviceQueueHw(new MockDeviceQueueHw<FamilyType>(pContext, device, deviceQueueProperties::minimumProperties[0]));
+
+    auto slb = mockDeviceQueueHw->getSlbBuffer();
+    auto eventPool = mockDeviceQueueHw->getEventPoolBuffer();
+    auto commandsSize = mockDeviceQueueHw->getMinimumSlbSize() + mockDeviceQueueHw->getWaCommandsSize();
+    auto slbCommandsSize = commandsSize * 128 + sizeof(typename FamilyType::MI_BATCH_BUFFER_START);
+
+    mockDeviceQueueHw->resetDeviceQueue();
+    auto fullResetBytes = mockDeviceQueueHw->lastResetBytesTouched;
+    EXPECT_EQ(sizeof(IGIL_EventPool) + commandsSize * 128, fullResetBytes);
+
+    std::unique_ptr<uint8_t[]> expectedSlb(new uint8_t[slbCommandsSize]);
+    std::unique_ptr<uint8_t[]> expectedEventPool(new uint8_t[eventPool->getUnderlyingBufferSize()]);
+    memcpy(expectedSlb.get(), slb->getUnderlyingBuffer(), slbCommandsSize);
+    memcpy(expectedEventPool.get(), eventPool->getUnderlyingBuffer(), eventPool->getUnderlyingBufferSize());
+
+    // scheduler used 5 events and ended SLB after 10 enqueues
+    const uint32_t usedEvents = 5;
+    auto igilEventPool = reinterpret_cast<IGIL_EventPool *>(eventPool->getUnderlyingBuffer());
+    memset(ptrOffset(eventPool->getUnderlyingBuffer(), sizeof(IGIL_EventPool)), 0xCD, usedEvents * sizeof(IGIL_DeviceEvent));
+    igilEventPool->m_head = usedEvents;
+    auto slbEndOffset = static_cast<int>(commandsSize) * 10;
+    memset(ptrOffset(slb->getUnderlyingBuffer(), slbEndOffset), 0xCD, commandsSize);
+    mockDeviceQueueHw->getIgilQueue()->m_controls.m_SLBENDoffsetInBytes = slbEndOffset;
+    mockDeviceQueueHw->slbDummyCommandsValid = false;
+
+    mockDeviceQueueHw->resetDeviceQueue();
+    EXPECT_EQ(0, memcmp(expectedSlb.get(), slb->getUnderlyingBuffer(), slbCommandsSize));
+    EXPECT_EQ(0, memcmp(expectedEventPool.get(), eventPool->getUnderlyingBuffer(), eventPool->getUnderlyingBufferSize()));
+    EXPECT_EQ(sizeof(IGIL_EventPool) + usedEvents * sizeof(IGIL_DeviceEvent) + commandsSize, mockDeviceQueueHw->lastResetBytesTouched);
+    EXPECT_LT(mockDeviceQueueHw->lastResetBytesTouched, fullResetBytes);
+
+    // nothing dispatched since the last reset
+    mockDeviceQueueHw->resetDeviceQueue();
+    EXPECT_EQ(0, memcmp(expectedSlb.get(), slb->getUnderlyingBuffer(), slbCommandsSize));
+    EXPECT_EQ(sizeof(IGIL_EventPool), mockDeviceQueueHw->lastResetBytesTouched);
+}
+
+HWTEST_F(DeviceQueueSlb, givenExhaustedEventPoolWhenResetThenWholePoolIsCleared) {
+    std::unique_ptr<MockDeviceQueueHw<FamilyType>> mockDeviceQueueHw(new MockDeviceQueueHw<FamilyType>(pContext, device, deviceQueueProperties::minimumProperties[0]));
+    auto eventPool = mockDeviceQueueHw->getEventPoolBuffer();
+    mockDeviceQueueHw->resetDeviceQueue();
+
+    memset(eventPool->getUnderlyingBuffer(), 0xCD, eventPool->getUnderlyingBufferSize());
+    auto igilEventPool = reinterpret_cast<IGIL_EventPool *>(eventPool->getUnderlyingBuffer());
+    igilEventPool->m_head = device->getDeviceInfo().maxOnDeviceEvents;
+
+    mockDeviceQueueHw->resetDeviceQueue();
+    EXPECT_EQ(eventPool->getUnderlyingBufferSize(), mockDeviceQueueHw->lastResetBytesTouched);
+    auto events = reinterpret_cast<uint8_t *>(ptrOffset(eventPool->getUnderlyingBuffer(), sizeof(IGIL_EventPool)));
+    auto eventsSize = eventPool->getUnderlyingBufferSize() - sizeof(IGIL_EventPool);
+    EXPECT_EQ(eventsSize, static_cast<size_t>(std::count(events, events + eventsSize, 0)));
+}
+
 HWTEST_F(DeviceQueueSlb, cleanupSection) {
     using MI_BATCH_BUFFER_START = typename FamilyType::MI_BATCH_BUFFER_START;
     using MI_BATCH_BUFFER_END = typename FamilyType::MI_BATCH_BUFFER_END;
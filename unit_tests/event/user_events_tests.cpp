@@ -24,7 +24,9 @@
 #include "unit_tests/command_queue/enqueue_fixture.h"
 #include "unit_tests/fixtures/hello_world_fixture.h"
 #include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/helpers/memory_management.h"
 #include "unit_tests/mocks/mock_event.h"
+#include "unit_tests/mocks/mock_slab_allocator.h"
 #include "runtime/memory_manager/memory_manager.h"
 
 TEST(UserEvent, testInitialStatusOfUserEventCmdQueue) {
@@ -1083,4 +1085,35 @@ TEST_F(EventTests, givenUserEventWhenSetStatusIsDoneThenDeviceMutextisAcquired)
     mockedEvent mockEvent(this->context);
     clSetUserEventStatus(&mockEvent, CL_COMPLETE);
     EXPECT_TRUE(mockEvent.mutexProperlyAcquired);
-}
\ No newline at end of file
+}
+TEST(UserEvent, givenEventsFromSlabAllocatorWhenCreatedAndReleasedRepeatedlyThenBlocksAreReusedWithoutNewSlabs) {
+    using EventAllocator = MockSizeClassSlabAllocator<BaseObject<_cl_event>>;
+    const size_t numEventsInFlight = 64;
+
+    // slabs stay with the shared allocators until process exit
+    MemoryManagement::fastLeaksDetectionMode = MemoryManagement::LeakDetectionMode::TURN_OFF_LEAK_DETECTION;
+    baseObjectsFromSlabAllocator = true;
+
+    MockContext context;
+    UserEvent *events[numEventsInFlight];
+    for (auto &event : events) {
+        event = new UserEvent(&context);
+    }
+    auto sizeClass = EventAllocator::getBlockSizeClass(events[0]);
+    EXPECT_LT(sizeClass, EventAllocator::heapSizeClass);
+    for (auto event : events) {
+        event->release();
+    }
+    auto slabCount = EventAllocator::getSharedAllocator(sizeClass).getSlabCount();
+
+    for (int iteration = 0; iteration < 100; iteration++) {
+        for (auto &event : events) {
+            event = new UserEvent(&context);
+        }
+        for (auto event : events) {
+            event->release();
+        }
+    }
+    EXPECT_EQ(slabCount, EventAllocator::getSharedAllocator(sizeClass).getSlabCount());
+    baseObjectsFromSlabAllocator = false;
+}
@@ -24,8 +24,13 @@
 #include "unit_tests/fixtures/buffer_fixture.h"
 #include "unit_tests/fixtures/hello_world_fixture.h"
 #include "runtime/memory_manager/memory_manager.h"
+#include "unit_tests/helpers/memory_management.h"
+#include "unit_tests/mocks/mock_slab_allocator.h"
 
+#include <atomic>
 #include <memory>
+#include <thread>
+#include <vector>
 
 typedef HelloWorldTest<HelloWorldFixtureFactory> EventTests;
 
@@ -123,3 +128,53 @@ TEST_F(EventTests, givenUserEventBlockingEnqueueWithBlockingFlagWhenUserEventIsC
     EXPECT_EQ(CL_SUCCESS, retVal);
     t.join();
 }
+
+TEST_F(EventTests, givenManyThreadsWhenUserEventsAreCreatedAndReleasedConcurrentlyThenAllCallsSucceed) {
+    const int numThreads = 8;
+    const int numIterations = 200;
+    const int eventsPerIteration = 16;
+
+    // events come from the runtime's slab allocator, whose slabs stay until process exit
+    MemoryManagement::fastLeaksDetectionMode = MemoryManagement::LeakDetectionMode::TURN_OFF_LEAK_DETECTION;
+    baseObjectsFromSlabAllocator = true;
+
+    std::atomic<int> failures(0);
+    std::atomic<bool> start(false);
+    std::vector<std::thread> threads;
+
+    for (int threadId = 0; threadId < numThreads; threadId++) {
+        threads.push_back(std::thread([&]() {
+            while (!start)
+                ;
+            cl_event events[eventsPerIteration];
+            for (int iteration = 0; iteration < numIterations; iteration++) {
+                for (auto &event : events) {
+                    cl_int retVal = CL_INVALID_VALUE;
+                    event = clCreateUserEvent(BufferDefaults::context, &retVal);
+                    if (retVal != CL_SUCCESS || event == nullptr) {
+                        failures++;
+                    }
+                }
+                for (auto &event : events) {
+                    if (event == nullptr) {
+                        continue;
+                    }
+                    if (clSetUserEventStatus(event, CL_COMPLETE) != CL_SUCCESS) {
+                        failures++;
+                    }
+                    if (clReleaseEvent(event) != CL_SUCCESS) {
+                        failures++;
+                    }
+                }
+            }
+        }));
+    }
+
+    start = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    baseObjectsFromSlabAllocator = false;
+
+    EXPECT_EQ(0, failures.load());
+}
@@ -27,6 +27,8 @@
 #include "runtime/helpers/ptr_math.h"
 #include "runtime/memory_manager/os_agnostic_memory_manager.h"
 #include "runtime/gmm_helper/gmm_helper.h"
+#include "runtime/gmm_helper/image_layout_cache.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/mocks/mock_device.h"
 #include "unit_tests/mocks/mock_gmm.h"
 
@@ -617,4 +619,116 @@ TEST(GmmSimplifiedCacheSelectionPolicy, givenGmmInSimplifiedCacheSelectionPolicy
     Gmm::useSimplifiedMocsTable = false;
 }
 
+TEST_F(GmmTests, givenSameImageParamsWhenQueriedTwiceThenSecondQueryIsServedFromLayoutCacheWithIdenticalResults) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableImageLayoutCache.set(true);
+    auto &layoutCache = ImageLayoutCache::getInstance();
+    layoutCache.clear();
+
+    cl_image_desc imgDesc{};
+    imgDesc.image_type = CL_MEM_OBJECT_IMAGE3D;
+    imgDesc.image_width = 33;
+    imgDesc.image_height = 17;
+    imgDesc.image_depth = 9;
+
+    auto firstImgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    auto firstGmm = MockGmm::queryImgParams(firstImgInfo);
+    EXPECT_EQ(0u, layoutCache.getHits());
+    EXPECT_EQ(1u, layoutCache.getMisses());
+    EXPECT_EQ(1u, layoutCache.size());
+
+    auto secondImgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    auto secondGmm = MockGmm::queryImgParams(secondImgInfo);
+    EXPECT_EQ(1u, layoutCache.getHits());
+    EXPECT_EQ(1u, layoutCache.getMisses());
+
+    ASSERT_NE(nullptr, secondGmm->gmmResourceInfo.get());
+    EXPECT_NE(firstGmm->gmmResourceInfo.get(), secondGmm->gmmResourceInfo.get());
+    EXPECT_EQ(firstImgInfo.size, secondImgInfo.size);
+    EXPECT_EQ(firstImgInfo.rowPitch, secondImgInfo.rowPitch);
+    EXPECT_EQ(firstImgInfo.slicePitch, secondImgInfo.slicePitch);
+    EXPECT_EQ(firstImgInfo.qPitch, secondImgInfo.qPitch);
+    EXPECT_EQ(firstImgInfo.offset, secondImgInfo.offset);
+    EXPECT_EQ(firstImgInfo.xOffset, secondImgInfo.xOffset);
+    EXPECT_EQ(firstImgInfo.yOffset, secondImgInfo.yOffset);
+    EXPECT_EQ(firstImgInfo.yOffsetForUVPlane, secondImgInfo.yOffsetForUVPlane);
+    layoutCache.clear();
+}
+
+TEST_F(GmmTests, givenCachedLayoutWhenImageIsQueriedThenGmmResourceIsNotQueriedForLayout) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableImageLayoutCache.set(true);
+    auto &layoutCache = ImageLayoutCache::getInstance();
+    layoutCache.clear();
+
+    cl_image_desc imgDesc{};
+    imgDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    imgDesc.image_width = 64;
+    imgDesc.image_height = 64;
+
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    auto gmm = MockGmm::queryImgParams(imgInfo);
+
+    // replace cached layout with values the mock GmmLib never reports
+    auto cachedImgInfo = imgInfo;
+    cachedImgInfo.size = 0x12345;
+    cachedImgInfo.rowPitch = 0x321;
+    cachedImgInfo.qPitch = 7;
+    layoutCache.insert(ImageLayoutCache::createKey(gmm->resourceParams, imgInfo.plane, (*platformDevices)->pPlatform->eRenderCoreFamily), cachedImgInfo);
+
+    auto cachedQueryImgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    auto cachedGmm = MockGmm::queryImgParams(cachedQueryImgInfo);
+    EXPECT_NE(nullptr, cachedGmm->gmmResourceInfo.get());
+    EXPECT_EQ(0x12345u, cachedQueryImgInfo.size);
+    EXPECT_EQ(0x321u, cachedQueryImgInfo.rowPitch);
+    EXPECT_EQ(7u, cachedQueryImgInfo.qPitch);
+    layoutCache.clear();
+}
+
+TEST_F(GmmTests, givenDifferentImageParamsWhenQueriedThenLayoutCacheMisses) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableImageLayoutCache.set(true);
+    auto &layoutCache = ImageLayoutCache::getInstance();
+    layoutCache.clear();
+
+    cl_image_desc imgDesc{};
+    imgDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    imgDesc.image_width = 64;
+    imgDesc.image_height = 64;
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    MockGmm::queryImgParams(imgInfo);
+
+    imgDesc.image_height = 65;
+    imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    MockGmm::queryImgParams(imgInfo);
+
+    DebugManager.flags.ForceLinearImages.set(!DebugManager.flags.ForceLinearImages.get());
+    imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    MockGmm::queryImgParams(imgInfo);
+
+    EXPECT_EQ(0u, layoutCache.getHits());
+    EXPECT_EQ(3u, layoutCache.getMisses());
+    EXPECT_EQ(3u, layoutCache.size());
+    layoutCache.clear();
+}
+
+TEST_F(GmmTests, givenLayoutCacheDisabledWhenImageIsQueriedThenCacheIsNotUsed) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.EnableImageLayoutCache.set(false);
+    auto &layoutCache = ImageLayoutCache::getInstance();
+    layoutCache.clear();
+
+    cl_image_desc imgDesc{};
+    imgDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    imgDesc.image_width = 64;
+    imgDesc.image_height = 64;
+    auto imgInfo = MockGmm::initImgInfo(imgDesc, 0, nullptr);
+    MockGmm::queryImgParams(imgInfo);
+    MockGmm::queryImgParams(imgInfo);
+
+    EXPECT_EQ(0u, layoutCache.getHits());
+    EXPECT_EQ(0u, layoutCache.getMisses());
+    EXPECT_EQ(0u, layoutCache.size());
+}
+
 } // namespace OCLRT
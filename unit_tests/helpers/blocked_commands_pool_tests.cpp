@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/command_queue/enqueue_common.h"
+#include "runtime/event/user_event.h"
+#include "runtime/helpers/array_count.h"
+#include "runtime/helpers/blocked_commands_pool.h"
+#include "runtime/helpers/task_information.h"
+#include "unit_tests/fixtures/hello_world_fixture.h"
+#include "unit_tests/helpers/memory_management.h"
+#include "unit_tests/mocks/mock_buffer.h"
+#include "unit_tests/mocks/mock_graphics_allocation.h"
+#include "unit_tests/mocks/mock_mdi.h"
+#include "test.h"
+
+#include <typeinfo>
+
+using namespace OCLRT;
+
+TEST(BlockedCommandsPoolTest, whenKernelOperationIsObtainedFromEmptyPoolThenStreamsWithRequestedSizesAreCreated) {
+    BlockedCommandsPool pool;
+    auto kernelOperation = pool.obtainKernelOperation(4096, 100, 200, 300, 400);
+
+    ASSERT_NE(nullptr, kernelOperation);
+    EXPECT_EQ(&pool, kernelOperation->pool);
+    EXPECT_EQ(4096u, kernelOperation->commandStream->getMaxAvailableSpace());
+    EXPECT_EQ(100u, kernelOperation->dsh->getMaxAvailableSpace());
+    EXPECT_EQ(200u, kernelOperation->ish->getMaxAvailableSpace());
+    EXPECT_EQ(300u, kernelOperation->ioh->getMaxAvailableSpace());
+    EXPECT_EQ(400u, kernelOperation->ssh->getMaxAvailableSpace());
+
+    pool.returnKernelOperation(kernelOperation);
+    EXPECT_EQ(1u, pool.peekFreeKernelOperationsCount());
+}
+
+TEST(BlockedCommandsPoolTest, givenReturnedKernelOperationWhenObtainingAgainThenStorageIsReusedAndStreamsAreReset) {
+    BlockedCommandsPool pool;
+    auto kernelOperation = pool.obtainKernelOperation(4096, 128, 128, 128, 128);
+    auto dshBase = kernelOperation->dsh->getBase();
+    kernelOperation->commandStream->getSpace(64);
+    kernelOperation->dsh->getSpace(64);
+    kernelOperation->instructionHeapSizeEM = 16;
+    pool.returnKernelOperation(kernelOperation);
+
+    auto reusedKernelOperation = pool.obtainKernelOperation(4096, 64, 64, 64, 64);
+    EXPECT_EQ(kernelOperation, reusedKernelOperation);
+    EXPECT_EQ(dshBase, reusedKernelOperation->dsh->getBase());
+    EXPECT_EQ(0u, reusedKernelOperation->commandStream->getUsed());
+    EXPECT_EQ(0u, reusedKernelOperation->dsh->getUsed());
+    EXPECT_EQ(0u, reusedKernelOperation->instructionHeapSizeEM);
+    EXPECT_EQ(0u, pool.peekFreeKernelOperationsCount());
+
+    pool.returnKernelOperation(reusedKernelOperation);
+}
+
+TEST(BlockedCommandsPoolTest, givenReturnedKernelOperationWhenBiggerHeapIsRequestedThenHeapIsGrown) {
+    BlockedCommandsPool pool;
+    auto kernelOperation = pool.obtainKernelOperation(4096, 64, 64, 64, 64);
+    pool.returnKernelOperation(kernelOperation);
+
+    kernelOperation = pool.obtainKernelOperation(4096, 64, 64, 64, 8192);
+    EXPECT_EQ(64u, kernelOperation->dsh->getMaxAvailableSpace());
+    EXPECT_EQ(8192u, kernelOperation->ssh->getMaxAvailableSpace());
+    EXPECT_NE(nullptr, kernelOperation->ssh->getSpace(8192));
+
+    pool.returnKernelOperation(kernelOperation);
+}
+
+TEST(BlockedCommandsPoolTest, givenPooledSurfacesWhenKernelOperationIsReturnedThenSurfacesAreDestroyedAndStorageIsRecycled) {
+    MockGraphicsAllocation allocation(nullptr, 0);
+    MockBuffer buffer;
+    auto initialRefCount = buffer.getRefInternalCount();
+
+    BlockedCommandsPool pool;
+    auto kernelOperation = pool.obtainKernelOperation(4096, 64, 64, 64, 64);
+    kernelOperation->pooledSurfaces.push_back(pool.createSurface<GeneralSurface>(&allocation));
+    kernelOperation->pooledSurfaces.push_back(pool.createSurface<MemObjSurface>(&buffer));
+    EXPECT_LT(initialRefCount, buffer.getRefInternalCount());
+
+    pool.returnKernelOperation(kernelOperation);
+    EXPECT_EQ(initialRefCount, buffer.getRefInternalCount());
+    EXPECT_TRUE(kernelOperation->pooledSurfaces.empty());
+    EXPECT_EQ(2u, pool.peekFreeSurfaceStorageCount());
+}
+
+TEST(BlockedCommandsPoolTest, givenSurfacesWhenDuplicatedThroughPoolThenCopiesLiveInRecycledStorage) {
+    MockGraphicsAllocation allocation(nullptr, 0);
+    MockBuffer buffer;
+    char hostMemory[16];
+    NullSurface nullSurface;
+    HostPtrSurface hostPtrSurface(hostMemory, sizeof(hostMemory), &allocation);
+    MemObjSurface memObjSurface(&buffer);
+    GeneralSurface generalSurface(&allocation);
+    auto initialRefCount = buffer.getRefInternalCount();
+
+    BlockedCommandsPool pool;
+    auto kernelOperation = pool.obtainKernelOperation(4096, 64, 64, 64, 64);
+    for (Surface *surface : {static_cast<Surface *>(&nullSurface), static_cast<Surface *>(&hostPtrSurface),
+                             static_cast<Surface *>(&memObjSurface), static_cast<Surface *>(&generalSurface)}) {
+        auto surfaceCopy = pool.duplicateSurface(*surface);
+        ASSERT_NE(nullptr, surfaceCopy);
+        EXPECT_NE(surface, surfaceCopy);
+        EXPECT_TRUE(typeid(*surface) == typeid(*surfaceCopy));
+        kernelOperation->pooledSurfaces.push_back(surfaceCopy);
+    }
+    EXPECT_EQ(initialRefCount + 1, buffer.getRefInternalCount());
+    EXPECT_EQ(static_cast<void *>(hostMemory), static_cast<HostPtrSurface *>(kernelOperation->pooledSurfaces[1])->getMemoryPointer());
+    EXPECT_EQ(&allocation, static_cast<HostPtrSurface *>(kernelOperation->pooledSurfaces[1])->getAllocation());
+
+    pool.returnKernelOperation(kernelOperation);
+    EXPECT_EQ(initialRefCount, buffer.getRefInternalCount());
+    EXPECT_EQ(4u, pool.peekFreeSurfaceStorageCount());
+}
+
+TEST(BlockedCommandsPoolTest, givenSurfaceWithoutInPlaceCopyWhenDuplicatedThroughPoolThenNullptrIsReturnedAndStorageIsKept) {
+    struct SurfaceWithoutInPlaceCopy : public NullSurface {
+        Surface *duplicateInto(void *storage) override { return nullptr; }
+    } surface;
+
+    BlockedCommandsPool pool;
+    EXPECT_EQ(nullptr, pool.duplicateSurface(surface));
+    EXPECT_EQ(1u, pool.peekFreeSurfaceStorageCount());
+}
+
+TEST(BlockedCommandsPoolTest, givenReleasedCommandStorageWhenStorageOfSameSizeIsObtainedThenItIsReused) {
+    BlockedCommandsPool pool;
+    auto storage = BlockedCommandsPool::obtainCommandStorage(&pool, 256);
+    ASSERT_NE(nullptr, storage);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(storage) % alignof(std::max_align_t));
+
+    BlockedCommandsPool::releaseCommandStorage(storage);
+    EXPECT_EQ(1u, pool.peekFreeCommandStorageCount());
+
+    auto allocationsBefore = MemoryManagement::indexAllocation.load();
+    EXPECT_EQ(storage, BlockedCommandsPool::obtainCommandStorage(&pool, 256));
+    EXPECT_EQ(allocationsBefore, MemoryManagement::indexAllocation.load());
+    EXPECT_EQ(0u, pool.peekFreeCommandStorageCount());
+
+    // other sizes are not recycled by this pool
+    auto otherStorage = BlockedCommandsPool::obtainCommandStorage(&pool, 512);
+    BlockedCommandsPool::releaseCommandStorage(otherStorage);
+    EXPECT_EQ(0u, pool.peekFreeCommandStorageCount());
+
+    BlockedCommandsPool::releaseCommandStorage(storage);
+    EXPECT_EQ(1u, pool.peekFreeCommandStorageCount());
+}
+
+TEST(BlockedCommandsPoolTest, givenCommandStorageWithoutPoolWhenReleasedThenItIsFreed) {
+    auto deallocationsBefore = MemoryManagement::indexDeallocation.load();
+    auto storage = BlockedCommandsPool::obtainCommandStorage(nullptr, 256);
+    ASSERT_NE(nullptr, storage);
+    BlockedCommandsPool::releaseCommandStorage(storage);
+    EXPECT_EQ(deallocationsBefore + 1, MemoryManagement::indexDeallocation.load());
+}
+
+TEST(BlockedCommandsPoolTest, givenWarmedUpPoolWhenBlockedCommandStorageIsObtainedAndReturnedThenNoAllocationsAreMade) {
+    MockGraphicsAllocation allocation(nullptr, 0);
+    MockBuffer buffer;
+    BlockedCommandsPool pool;
+
+    auto blockedCommandCycle = [&]() {
+        auto kernelOperation = pool.obtainKernelOperation(4096, 256, 256, 256, 256);
+        kernelOperation->pooledSurfaces.push_back(pool.createSurface<GeneralSurface>(&allocation));
+        kernelOperation->pooledSurfaces.push_back(pool.createSurface<GeneralSurface>(&allocation));
+        kernelOperation->pooledSurfaces.push_back(pool.createSurface<MemObjSurface>(&buffer));
+        pool.returnKernelOperation(kernelOperation);
+    };
+
+    blockedCommandCycle();
+
+    auto allocationsBefore = MemoryManagement::indexAllocation.load();
+    auto deallocationsBefore = MemoryManagement::indexDeallocation.load();
+    for (int i = 0; i < 100; i++) {
+        blockedCommandCycle();
+    }
+    EXPECT_EQ(allocationsBefore, MemoryManagement::indexAllocation.load());
+    EXPECT_EQ(deallocationsBefore, MemoryManagement::indexDeallocation.load());
+}
+
+typedef HelloWorldTest<HelloWorldFixtureFactory> BlockedCommandsPoolEnqueueTest;
+
+TEST_F(BlockedCommandsPoolEnqueueTest, givenBlockedEnqueueWhenUserEventIsSignaledThenKernelOperationReturnsToQueuePool) {
+    auto &pool = pCmdQ->getBlockedCommandsPool();
+
+    for (int i = 0; i < 10; i++) {
+        UserEvent uEvent(context);
+        cl_event eventWaitList[] = {&uEvent};
+
+        retVal = callOneWorkItemNDRKernel(eventWaitList, 1);
+        ASSERT_EQ(CL_SUCCESS, retVal);
+        EXPECT_EQ(0u, pool.peekFreeKernelOperationsCount());
+        ASSERT_NE(nullptr, pCmdQ->virtualEvent);
+        EXPECT_NE(nullptr, pCmdQ->virtualEvent->peekCommand());
+
+        uEvent.setStatus(CL_COMPLETE);
+        EXPECT_EQ(1u, pool.peekFreeKernelOperationsCount());
+    }
+}
+
+TEST_F(BlockedCommandsPoolEnqueueTest, givenWarmedUpQueueWhenBlockedEnqueuesAreRepeatedThenPooledStorageIsNotReallocated) {
+    auto &pool = pCmdQ->getBlockedCommandsPool();
+
+    auto blockedEnqueueCycle = [&]() {
+        UserEvent uEvent(context);
+        cl_event eventWaitList[] = {&uEvent};
+        EXPECT_EQ(CL_SUCCESS, callOneWorkItemNDRKernel(eventWaitList, 1));
+        auto cmdStream = pCmdQ->virtualEvent->peekCommand()->getCommandStream();
+        uEvent.setStatus(CL_COMPLETE);
+        return cmdStream;
+    };
+
+    auto warmUpCommandStream = blockedEnqueueCycle();
+    auto surfaceStorageCount = pool.peekFreeSurfaceStorageCount();
+
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(warmUpCommandStream, blockedEnqueueCycle());
+        EXPECT_EQ(1u, pool.peekFreeKernelOperationsCount());
+        EXPECT_EQ(surfaceStorageCount, pool.peekFreeSurfaceStorageCount());
+    }
+}
+
+HWTEST_F(BlockedCommandsPoolEnqueueTest, givenWarmedUpQueueWhenUserEventBlockedEnqueueWithSurfacesIsUnblockedThenSurfaceCopiesMakeNoAllocations) {
+    auto &cmdQ = static_cast<CommandQueueHw<FamilyType> &>(*pCmdQ);
+    auto &pool = cmdQ.getBlockedCommandsPool();
+    MockMultiDispatchInfo multiDispatchInfo(pKernel);
+    MockBuffer buffer;
+    NullSurface nullSurfaces[3];
+    MemObjSurface memObjSurface(&buffer);
+    Surface *surfaces[] = {&nullSurfaces[0], &nullSurfaces[1], &nullSurfaces[2], &memObjSurface};
+
+    auto blockedEnqueueCycle = [&](Surface **surfacesForResidency, size_t surfaceCount) {
+        UserEvent uEvent(context);
+        cl_event eventWaitList[] = {&uEvent};
+        cmdQ.template enqueueHandler<CL_COMMAND_NDRANGE_KERNEL>(surfacesForResidency, surfaceCount, false, multiDispatchInfo,
+                                                                1, eventWaitList, nullptr);
+        EXPECT_NE(nullptr, cmdQ.virtualEvent->peekCommand());
+        uEvent.setStatus(CL_COMPLETE);
+    };
+    auto countAllocations = [&](Surface **surfacesForResidency, size_t surfaceCount) {
+        auto allocationsBefore = MemoryManagement::indexAllocation.load();
+        blockedEnqueueCycle(surfacesForResidency, surfaceCount);
+        return MemoryManagement::indexAllocation.load() - allocationsBefore;
+    };
+
+    for (int i = 0; i < 2; i++) {
+        blockedEnqueueCycle(nullptr, 0);
+        blockedEnqueueCycle(surfaces, arrayCount(surfaces));
+    }
+    auto surfaceStorageCount = pool.peekFreeSurfaceStorageCount();
+    EXPECT_LE(arrayCount(surfaces), surfaceStorageCount);
+
+    for (int i = 0; i < 5; i++) {
+        auto allocationsWithoutSurfaces = countAllocations(nullptr, 0);
+        auto allocationsWithSurfaces = countAllocations(surfaces, arrayCount(surfaces));
+        EXPECT_EQ(allocationsWithoutSurfaces, allocationsWithSurfaces);
+        EXPECT_EQ(surfaceStorageCount, pool.peekFreeSurfaceStorageCount());
+    }
+}
+
+TEST_F(BlockedCommandsPoolEnqueueTest, givenWarmedUpQueueWhenBlockedEnqueuesAreRepeatedThenCommandStorageIsReusedAndAllocationCountIsSteady) {
+    auto &pool = pCmdQ->getBlockedCommandsPool();
+
+    auto blockedEnqueueCycle = [&]() {
+        UserEvent uEvent(context);
+        cl_event eventWaitList[] = {&uEvent};
+        EXPECT_EQ(CL_SUCCESS, callOneWorkItemNDRKernel(eventWaitList, 1));
+        auto command = pCmdQ->virtualEvent->peekCommand();
+        uEvent.setStatus(CL_COMPLETE);
+        return command;
+    };
+    auto countAllocations = [&]() {
+        auto allocationsBefore = MemoryManagement::indexAllocation.load();
+        blockedEnqueueCycle();
+        return MemoryManagement::indexAllocation.load() - allocationsBefore;
+    };
+
+    auto warmUpCommand = blockedEnqueueCycle();
+    EXPECT_EQ(1u, pool.peekFreeCommandStorageCount());
+    auto steadyStateAllocations = countAllocations();
+
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(warmUpCommand, blockedEnqueueCycle());
+        EXPECT_EQ(1u, pool.peekFreeCommandStorageCount());
+        // what remains are the events of the cycle, the command and its storage are recycled
+        EXPECT_EQ(steadyStateAllocations, countAllocations());
+    }
+}
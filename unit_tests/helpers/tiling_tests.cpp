@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/tiling.h"
+#include "runtime/utilities/cpu_info.h"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <tuple>
+#include <vector>
+
+using namespace OCLRT;
+
+namespace {
+// Byte-at-a-time reference, written against the tile definitions rather
+// than TilingHelper::getTiledOffset
+size_t referenceOffset(TileMode tileMode, size_t pitch, size_t x, size_t y) {
+    switch (tileMode) {
+    case TileMode::TileX: {
+        size_t tile = (y / 8) * (pitch / 512) + x / 512;
+        return tile * 4096 + (y % 8) * 512 + x % 512;
+    }
+    case TileMode::TileY: {
+        size_t tile = (y / 32) * (pitch / 128) + x / 128;
+        return tile * 4096 + ((x % 128) / 16) * 512 + (y % 32) * 16 + x % 16;
+    }
+    default:
+        return y * pitch + x;
+    }
+}
+
+void referenceSwizzle(TileMode tileMode, size_t pitch, uint8_t *tiled, size_t x, size_t y,
+                      const uint8_t *linear, size_t linearPitch, size_t widthInBytes, size_t height) {
+    for (size_t row = 0; row < height; row++) {
+        for (size_t col = 0; col < widthInBytes; col++) {
+            tiled[referenceOffset(tileMode, pitch, x + col, y + row)] = linear[row * linearPitch + col];
+        }
+    }
+}
+
+struct SpanFunctions {
+    decltype(TilingHelper::swizzleTileYSpan) swizzle;
+    decltype(TilingHelper::unswizzleTileYSpan) unswizzle;
+};
+} // namespace
+
+typedef ::testing::TestWithParam<std::tuple<TileMode, size_t>> TilingRoundTripTest;
+
+TEST_P(TilingRoundTripTest, givenRandomRegionWhenSwizzledAndUnswizzledThenMatchesReference) {
+    TileMode tileMode;
+    size_t bytesPerPixel;
+    std::tie(tileMode, bytesPerPixel) = GetParam();
+
+    std::vector<SpanFunctions> spanFunctions;
+    spanFunctions.push_back({swizzleTileYSpan<OWordCopySse4>, unswizzleTileYSpan<OWordCopySse4>});
+    if (CpuInfo::getInstance().isFeatureSupported(CpuInfo::featureAvX2)) {
+        spanFunctions.push_back({swizzleTileYSpan<OWordCopyAvx2>, unswizzleTileYSpan<OWordCopyAvx2>});
+    }
+    auto savedSwizzle = TilingHelper::swizzleTileYSpan;
+    auto savedUnswizzle = TilingHelper::unswizzleTileYSpan;
+
+    const size_t widthInPixels = 300;
+    const size_t height = 70;
+    auto tileWidth = TilingHelper::getTileWidth(tileMode);
+    auto tileHeight = TilingHelper::getTileHeight(tileMode);
+    auto pitch = alignUp(widthInPixels * bytesPerPixel, tileWidth);
+    auto surfaceSize = pitch * alignUp(height, tileHeight);
+
+    std::mt19937 generator(static_cast<uint32_t>(bytesPerPixel * 3 + static_cast<uint32_t>(tileMode)));
+    std::uniform_int_distribution<int> byteDistribution(0, 255);
+
+    for (auto &functions : spanFunctions) {
+        TilingHelper::swizzleTileYSpan = functions.swizzle;
+        TilingHelper::unswizzleTileYSpan = functions.unswizzle;
+
+        for (int iteration = 0; iteration < 8; iteration++) {
+            std::uniform_int_distribution<size_t> xDistribution(0, widthInPixels - 1);
+            std::uniform_int_distribution<size_t> yDistribution(0, height - 1);
+            auto x = xDistribution(generator);
+            auto y = yDistribution(generator);
+            auto regionWidth = std::uniform_int_distribution<size_t>(1, widthInPixels - x)(generator);
+            auto regionHeight = std::uniform_int_distribution<size_t>(1, height - y)(generator);
+            if (iteration == 0) {
+                x = y = 0;
+                regionWidth = widthInPixels;
+                regionHeight = height;
+            }
+
+            auto widthInBytes = regionWidth * bytesPerPixel;
+            auto linearPitch = widthInBytes + bytesPerPixel * iteration;
+            std::vector<uint8_t> linear(linearPitch * regionHeight);
+            for (auto &byte : linear) {
+                byte = static_cast<uint8_t>(byteDistribution(generator));
+            }
+
+            std::vector<uint8_t> tiled(surfaceSize, 0xcd);
+            std::vector<uint8_t> expected(surfaceSize, 0xcd);
+            TiledSurface surface = {tiled.data(), pitch, tileMode};
+
+            TilingHelper::swizzle(surface, x * bytesPerPixel, y, linear.data(), linearPitch, widthInBytes, regionHeight);
+            referenceSwizzle(tileMode, pitch, expected.data(), x * bytesPerPixel, y, linear.data(), linearPitch, widthInBytes, regionHeight);
+            EXPECT_EQ(expected, tiled);
+
+            std::vector<uint8_t> readBack(linearPitch * regionHeight, 0);
+            TilingHelper::unswizzle(surface, x * bytesPerPixel, y, readBack.data(), linearPitch, widthInBytes, regionHeight);
+            for (size_t row = 0; row < regionHeight; row++) {
+                EXPECT_EQ(0, memcmp(&linear[row * linearPitch], &readBack[row * linearPitch], widthInBytes));
+            }
+        }
+    }
+
+    TilingHelper::swizzleTileYSpan = savedSwizzle;
+    TilingHelper::unswizzleTileYSpan = savedUnswizzle;
+}
+
+INSTANTIATE_TEST_CASE_P(TilingHelper,
+                        TilingRoundTripTest,
+                        ::testing::Combine(
+                            ::testing::Values(TileMode::Linear, TileMode::TileX, TileMode::TileY),
+                            ::testing::Values(1, 2, 4, 8, 16)));
+
+TEST(TilingHelper, givenTileYSurfaceWhenComputingOffsetThenOWordColumnsAreContiguousVertically) {
+    TiledSurface surface = {nullptr, 256, TileMode::TileY};
+    EXPECT_EQ(0u, TilingHelper::getTiledOffset(surface, 0, 0));
+    EXPECT_EQ(16u, TilingHelper::getTiledOffset(surface, 0, 1));
+    EXPECT_EQ(512u, TilingHelper::getTiledOffset(surface, 16, 0));
+    EXPECT_EQ(4096u, TilingHelper::getTiledOffset(surface, 128, 0));
+    EXPECT_EQ(8192u, TilingHelper::getTiledOffset(surface, 0, 32));
+}
+
+TEST(TilingHelper, givenTileXSurfaceWhenComputingOffsetThenRowsAreContiguousWithinTile) {
+    TiledSurface surface = {nullptr, 1024, TileMode::TileX};
+    EXPECT_EQ(1u, TilingHelper::getTiledOffset(surface, 1, 0));
+    EXPECT_EQ(512u, TilingHelper::getTiledOffset(surface, 0, 1));
+    EXPECT_EQ(4096u, TilingHelper::getTiledOffset(surface, 512, 0));
+    EXPECT_EQ(8192u, TilingHelper::getTiledOffset(surface, 0, 8));
+}
@@ -102,3 +102,100 @@ TEST_F(IndirectHeapTest, getBase) {
     auto base = indirectHeap.getBase();
     EXPECT_EQ(base, buffer);
 }
+
+TEST_F(IndirectHeapTest, givenHeapWithoutUsageTrackingWhenMarkedUsedByTaskThenNoRangeIsRecorded) {
+    indirectHeap.getSpace(64);
+    indirectHeap.markUsedByTask(1);
+
+    EXPECT_FALSE(indirectHeap.isUsageTracked());
+    EXPECT_EQ(0u, indirectHeap.peekInFlightRangesCount());
+}
+
+TEST_F(IndirectHeapTest, givenTrackedHeapWhenMarkedUsedByTaskThenOnlyNewlyConsumedSpaceIsRecorded) {
+    indirectHeap.enableUsageTracking();
+
+    indirectHeap.markUsedByTask(1);
+    EXPECT_EQ(0u, indirectHeap.peekInFlightRangesCount());
+
+    indirectHeap.getSpace(64);
+    indirectHeap.markUsedByTask(1);
+    indirectHeap.markUsedByTask(2);
+    EXPECT_EQ(1u, indirectHeap.peekInFlightRangesCount());
+
+    indirectHeap.getSpace(64);
+    indirectHeap.markUsedByTask(2);
+    EXPECT_EQ(2u, indirectHeap.peekInFlightRangesCount());
+}
+
+TEST_F(IndirectHeapTest, givenTrackedHeapWhenTasksCompleteThenTheirRangesAreReclaimed) {
+    indirectHeap.enableUsageTracking();
+    for (uint32_t taskCount = 1; taskCount <= 3; taskCount++) {
+        indirectHeap.getSpace(64);
+        indirectHeap.markUsedByTask(taskCount);
+    }
+
+    indirectHeap.reclaimCompletedUsage(2);
+    EXPECT_EQ(1u, indirectHeap.peekInFlightRangesCount());
+
+    indirectHeap.reclaimCompletedUsage(3);
+    EXPECT_EQ(0u, indirectHeap.peekInFlightRangesCount());
+}
+
+TEST_F(IndirectHeapTest, givenRewoundHeapWhenAskedForTaskCountToReuseThenOnlyOverlappingRangesOfPreviousLapAreConsidered) {
+    indirectHeap.enableUsageTracking();
+    for (uint32_t taskCount = 1; taskCount <= 4; taskCount++) {
+        indirectHeap.getSpace(64);
+        indirectHeap.markUsedByTask(taskCount);
+    }
+    EXPECT_EQ(0u, indirectHeap.getTaskCountToReuse(0));
+    EXPECT_EQ(0u, indirectHeap.getTaskCountToReuse(indirectHeap.getAvailableSpace()));
+
+    auto base = indirectHeap.getBase();
+    indirectHeap.rewind(5, 0);
+    EXPECT_EQ(base, indirectHeap.getBase());
+    EXPECT_EQ(sizeof(buffer), indirectHeap.getMaxAvailableSpace());
+    EXPECT_EQ(0u, indirectHeap.getUsed());
+
+    EXPECT_EQ(0u, indirectHeap.getTaskCountToReuse(0));
+    EXPECT_EQ(1u, indirectHeap.getTaskCountToReuse(64));
+    EXPECT_EQ(2u, indirectHeap.getTaskCountToReuse(65));
+    EXPECT_EQ(4u, indirectHeap.getTaskCountToReuse(sizeof(buffer)));
+
+    indirectHeap.getSpace(128);
+    EXPECT_EQ(3u, indirectHeap.getTaskCountToReuse(1));
+}
+
+TEST_F(IndirectHeapTest, givenSpaceConsumedSinceLastFlushWhenHeapIsRewoundThenItIsAssignedToPendingTask) {
+    indirectHeap.enableUsageTracking();
+    indirectHeap.getSpace(64);
+    indirectHeap.markUsedByTask(1);
+    indirectHeap.getSpace(sizeof(buffer) - 64);
+
+    indirectHeap.rewind(2, 0);
+    EXPECT_EQ(2u, indirectHeap.peekInFlightRangesCount());
+    EXPECT_EQ(2u, indirectHeap.getTaskCountToReuse(sizeof(buffer)));
+}
+
+TEST_F(IndirectHeapTest, givenReservedBlockWhenHeapIsRewoundThenUsageRestartsAfterIt) {
+    indirectHeap.enableUsageTracking();
+    indirectHeap.getSpace(sizeof(buffer));
+    indirectHeap.markUsedByTask(1);
+
+    indirectHeap.rewind(2, 64);
+    EXPECT_EQ(64u, indirectHeap.getUsed());
+    EXPECT_EQ(sizeof(buffer) - 64, indirectHeap.getAvailableSpace());
+
+    indirectHeap.getSpace(64);
+    indirectHeap.markUsedByTask(2);
+    EXPECT_EQ(2u, indirectHeap.peekInFlightRangesCount());
+}
+
+TEST_F(IndirectHeapTest, givenTrackedHeapWhenUsageTrackingIsResetThenAllRangesAreDropped) {
+    indirectHeap.enableUsageTracking();
+    indirectHeap.getSpace(64);
+    indirectHeap.markUsedByTask(1);
+
+    indirectHeap.resetUsageTracking();
+    EXPECT_EQ(0u, indirectHeap.peekInFlightRangesCount());
+    EXPECT_TRUE(indirectHeap.isUsageTracked());
+}
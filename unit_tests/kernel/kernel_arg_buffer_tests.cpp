@@ -22,8 +22,10 @@
 
 #include "config.h"
 #include "CL/cl.h"
+#include "runtime/command_stream/command_stream_receiver.h"
 #include "runtime/kernel/kernel.h"
 #include "runtime/mem_obj/buffer.h"
+#include "runtime/memory_manager/surface.h"
 #include "unit_tests/fixtures/context_fixture.h"
 #include "unit_tests/fixtures/device_fixture.h"
 #include "unit_tests/fixtures/memory_management_fixture.h"
@@ -31,6 +33,7 @@
 #include "test.h"
 #include "unit_tests/mocks/mock_buffer.h"
 #include "unit_tests/mocks/mock_context.h"
+#include "unit_tests/mocks/mock_graphics_allocation.h"
 #include "unit_tests/mocks/mock_kernel.h"
 #include "unit_tests/mocks/mock_program.h"
 #include "gtest/gtest.h"
@@ -184,3 +187,84 @@ TEST_F(KernelArgBufferTest, given32BitDeviceWhenArgPassedIsNullThenOnly4BytesAre
     EXPECT_EQ(0u, *pKernelArg32bit);
     EXPECT_NE(expValue, *pKernelArg64bit);
 }
+
+TEST_F(KernelArgBufferTest, givenResolvedResidencyWhenAnyArgumentOrExecInfoIsSetThenResolvedResidencyIsInvalidated) {
+    MockBuffer buffer;
+    auto val = (cl_mem)&buffer;
+    char svmData[64];
+    MockGraphicsAllocation svmAlloc(svmData, sizeof(svmData));
+    std::vector<Surface *> surfaces;
+
+    auto resolveResidency = [&] {
+        pKernel->getResidency(surfaces);
+        for (auto surface : surfaces) {
+            delete surface;
+        }
+        surfaces.clear();
+        EXPECT_TRUE(pKernel->resolvedResidencyValid);
+    };
+
+    resolveResidency();
+    pKernel->setArg(0, sizeof(cl_mem *), &val);
+    EXPECT_FALSE(pKernel->resolvedResidencyValid);
+
+    resolveResidency();
+    pKernel->setArgSvmAlloc(0, svmData, &svmAlloc);
+    EXPECT_FALSE(pKernel->resolvedResidencyValid);
+
+    resolveResidency();
+    pKernel->setArgSvm(0, sizeof(svmData), svmData, &svmAlloc, 0u);
+    EXPECT_FALSE(pKernel->resolvedResidencyValid);
+
+    resolveResidency();
+    pKernel->setKernelExecInfo(&svmAlloc);
+    EXPECT_FALSE(pKernel->resolvedResidencyValid);
+
+    resolveResidency();
+    pKernel->clearKernelExecInfo();
+    EXPECT_FALSE(pKernel->resolvedResidencyValid);
+
+    resolveResidency();
+    pKernel->setArg(0, sizeof(cl_mem *), nullptr);
+    EXPECT_FALSE(pKernel->resolvedResidencyValid);
+}
+
+TEST_F(KernelArgBufferTest, givenResolvedResidencyWhenKernelIsMadeResidentThenAllocationsMatchArgumentsAndExecInfo) {
+    MockBuffer buffer;
+    MockBuffer otherBuffer;
+    char svmData[64];
+    MockGraphicsAllocation svmAlloc(svmData, sizeof(svmData));
+    auto &csr = pDevice->getCommandStreamReceiver();
+    auto &residencyAllocations = pDevice->getMemoryManager()->getResidencyAllocations();
+
+    auto val = (cl_mem)&buffer;
+    pKernel->setArg(0, sizeof(cl_mem *), &val);
+    pKernel->setKernelExecInfo(&svmAlloc);
+
+    for (int enqueue = 0; enqueue < 2; enqueue++) {
+        pKernel->makeResident(csr);
+        ASSERT_EQ(2u, residencyAllocations.size());
+        EXPECT_EQ(&svmAlloc, residencyAllocations[0]);
+        EXPECT_EQ(buffer.getGraphicsAllocation(), residencyAllocations[1]);
+        csr.makeSurfacePackNonResident(nullptr);
+    }
+
+    std::vector<Surface *> surfaces;
+    pKernel->getResidency(surfaces);
+    ASSERT_EQ(2u, surfaces.size());
+    for (auto surface : surfaces) {
+        surface->makeResident(csr);
+        delete surface;
+    }
+    ASSERT_EQ(2u, residencyAllocations.size());
+    EXPECT_EQ(&svmAlloc, residencyAllocations[0]);
+    EXPECT_EQ(buffer.getGraphicsAllocation(), residencyAllocations[1]);
+    csr.makeSurfacePackNonResident(nullptr);
+
+    val = (cl_mem)&otherBuffer;
+    pKernel->setArg(0, sizeof(cl_mem *), &val);
+    pKernel->makeResident(csr);
+    ASSERT_EQ(2u, residencyAllocations.size());
+    EXPECT_EQ(otherBuffer.getGraphicsAllocation(), residencyAllocations[1]);
+    csr.makeSurfacePackNonResident(nullptr);
+}
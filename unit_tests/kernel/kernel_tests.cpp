@@ -24,6 +24,7 @@
 #include "runtime/helpers/options.h"
 #include "runtime/helpers/surface_formats.h"
 #include "runtime/kernel/kernel.h"
+#include "runtime/kernel/kernel_template.h"
 #include "runtime/mem_obj/image.h"
 #include "runtime/memory_manager/os_agnostic_memory_manager.h"
 #include "runtime/os_interface/debug_settings_manager.h"
@@ -378,6 +379,85 @@ TEST_F(KernelFromBinaryTests, BuiltInIsSetToFalseForRegularKernels) {
     delete pKernel;
 }
 
+TEST_F(KernelFromBinaryTests, givenBuiltProgramWhenKernelIsCreatedThenArgHandlersComeFromKernelTemplate) {
+    cl_device_id device = pDevice;
+
+    CreateProgramFromBinary<Program>(pContext, &device, "simple_kernels");
+
+    ASSERT_NE(nullptr, pProgram);
+    retVal = pProgram->build(
+        1,
+        &device,
+        nullptr,
+        nullptr,
+        nullptr,
+        false);
+
+    ASSERT_EQ(CL_SUCCESS, retVal);
+
+    auto pKernelInfo = pProgram->getKernelInfo("simple_kernel_0");
+    ASSERT_NE(nullptr, pKernelInfo);
+    ASSERT_NE(nullptr, pKernelInfo->kernelTemplate);
+    EXPECT_EQ(pKernelInfo->kernelArgInfo.size(), pKernelInfo->kernelTemplate->argHandlers.size());
+
+    std::unique_ptr<MockKernel> pKernel(new MockKernel(pProgram, *pKernelInfo, *pDevice));
+    ASSERT_EQ(CL_SUCCESS, pKernel->initialize());
+
+    EXPECT_EQ(pKernelInfo->kernelTemplate->argHandlers, pKernel->kernelArgHandlers);
+    EXPECT_EQ(&Kernel::setArgImmediate, pKernel->kernelArgHandlers[0]);
+    EXPECT_EQ(&Kernel::setArgImmediate, pKernel->kernelArgHandlers[1]);
+    EXPECT_EQ(&Kernel::setArgBuffer, pKernel->kernelArgHandlers[2]);
+    EXPECT_EQ(Kernel::BUFFER_OBJ, pKernel->getKernelArgInfo(2).type);
+}
+
+TEST_F(KernelFromBinaryTests, givenSiblingKernelsFromSameKernelInfoWhenArgsAreSetOnOneKernelThenOtherKernelIsNotAffected) {
+    cl_device_id device = pDevice;
+
+    CreateProgramFromBinary<Program>(pContext, &device, "simple_kernels");
+
+    ASSERT_NE(nullptr, pProgram);
+    retVal = pProgram->build(
+        1,
+        &device,
+        nullptr,
+        nullptr,
+        nullptr,
+        false);
+
+    ASSERT_EQ(CL_SUCCESS, retVal);
+
+    auto pKernelInfo = pProgram->getKernelInfo("simple_kernel_0");
+    ASSERT_NE(nullptr, pKernelInfo);
+
+    std::unique_ptr<MockKernel> pKernel1(new MockKernel(pProgram, *pKernelInfo, *pDevice));
+    std::unique_ptr<MockKernel> pKernel2(new MockKernel(pProgram, *pKernelInfo, *pDevice));
+    ASSERT_EQ(CL_SUCCESS, pKernel1->initialize());
+    ASSERT_EQ(CL_SUCCESS, pKernel2->initialize());
+
+    ASSERT_EQ(pKernel1->getCrossThreadDataSize(), pKernel2->getCrossThreadDataSize());
+    EXPECT_NE(pKernel1->getCrossThreadData(), pKernel2->getCrossThreadData());
+    std::vector<char> initialCrossThreadData(pKernel2->getCrossThreadData(), pKernel2->getCrossThreadData() + pKernel2->getCrossThreadDataSize());
+
+    uint32_t arg0 = 0xdeadbeef;
+    retVal = pKernel1->setArg(0, sizeof(arg0), &arg0);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+
+    auto arg0Offset = pKernelInfo->kernelArgInfo[0].kernelArgPatchInfoVector[0].crossthreadOffset;
+    EXPECT_EQ(arg0, *reinterpret_cast<uint32_t *>(ptrOffset(pKernel1->getCrossThreadData(), arg0Offset)));
+    EXPECT_EQ(0, memcmp(initialCrossThreadData.data(), pKernel2->getCrossThreadData(), initialCrossThreadData.size()));
+    EXPECT_TRUE(pKernel1->getKernelArgInfo(0).isPatched);
+    EXPECT_FALSE(pKernel2->getKernelArgInfo(0).isPatched);
+
+    pKernel1->setKernelArgHandler(1, &Kernel::setArgBuffer);
+    EXPECT_EQ(&Kernel::setArgImmediate, pKernel2->kernelArgHandlers[1]);
+    EXPECT_EQ(&Kernel::setArgImmediate, pKernelInfo->kernelTemplate->argHandlers[1]);
+
+    std::unique_ptr<MockKernel> pKernel3(new MockKernel(pProgram, *pKernelInfo, *pDevice));
+    ASSERT_EQ(CL_SUCCESS, pKernel3->initialize());
+    EXPECT_EQ(0, memcmp(initialCrossThreadData.data(), pKernel3->getCrossThreadData(), initialCrossThreadData.size()));
+    EXPECT_EQ(&Kernel::setArgImmediate, pKernel3->kernelArgHandlers[1]);
+}
+
 TEST(PatchInfo, Constructor) {
     PatchInfo patchInfo;
     EXPECT_EQ(nullptr, patchInfo.interfaceDescriptorDataLoad);
@@ -513,7 +593,7 @@ TEST_F(KernelPrivateSurfaceTest, testPrivateSurface) {
     delete pKernelInfo;
 }
 
-TEST_F(KernelPrivateSurfaceTest, givenKernelWithPrivateSurfaceThatIsInUseByGpuWhenKernelIsBeingDestroyedThenAllocationIsAddedToDefferedFreeList) {
+TEST_F(KernelPrivateSurfaceTest, givenKernelWithPrivateSurfaceWhenKernelIsBeingDestroyedThenPooledAllocationStaysInCommandStreamReceiver) {
     std::unique_ptr<KernelInfo> pKernelInfo(KernelInfo::create());
     SPatchAllocateStatelessPrivateSurface tokenSPS;
     tokenSPS.SurfaceStateHeapOffset = 64;
@@ -538,15 +618,92 @@ TEST_F(KernelPrivateSurfaceTest, givenKernelWithPrivateSurfaceThatIsInUseByGpuWh
     auto memoryManager = pDevice->getMemoryManager();
 
     auto privateSurface = pKernel->getPrivateSurface();
-    auto tagAddress = context.getDevice(0)->getTagAddress();
+    EXPECT_EQ(pDevice->getCommandStreamReceiver().getPrivateSurface(), privateSurface);
 
-    privateSurface->taskCount = *tagAddress + 1;
+    pKernel.reset(nullptr);
 
     EXPECT_TRUE(memoryManager->graphicsAllocations.peekIsEmpty());
-    pKernel.reset(nullptr);
+    EXPECT_EQ(privateSurface, pDevice->getCommandStreamReceiver().getPrivateSurface());
+}
+
+TEST_F(KernelPrivateSurfaceTest, givenMultipleKernelsWithPrivateSurfaceWhenKernelsAreCreatedThenTheySharePooledAllocation) {
+    std::unique_ptr<KernelInfo> pKernelInfo(KernelInfo::create());
+    SPatchAllocateStatelessPrivateSurface tokenSPS;
+    tokenSPS.SurfaceStateHeapOffset = 64;
+    tokenSPS.DataParamOffset = 40;
+    tokenSPS.DataParamSize = 8;
+    tokenSPS.PerThreadPrivateMemorySize = 112;
+    pKernelInfo->patchInfo.pAllocateStatelessPrivateSurface = &tokenSPS;
+
+    SPatchDataParameterStream tokenDPS;
+    tokenDPS.DataParameterStreamSize = 64;
+    pKernelInfo->patchInfo.dataParameterStream = &tokenDPS;
+
+    SPatchExecutionEnvironment tokenEE;
+    tokenEE.CompiledSIMD32 = true;
+    pKernelInfo->patchInfo.executionEnvironment = &tokenEE;
+
+    MockContext context;
+    MockProgram program(&context);
+    std::unique_ptr<MockKernel> pKernel1(new MockKernel(&program, *pKernelInfo, *pDevice));
+    std::unique_ptr<MockKernel> pKernel2(new MockKernel(&program, *pKernelInfo, *pDevice));
+    ASSERT_EQ(CL_SUCCESS, pKernel1->initialize());
+    ASSERT_EQ(CL_SUCCESS, pKernel2->initialize());
+
+    EXPECT_NE(nullptr, pKernel1->getPrivateSurface());
+    EXPECT_EQ(pKernel1->getPrivateSurface(), pKernel2->getPrivateSurface());
+    EXPECT_EQ(pDevice->getCommandStreamReceiver().getPrivateSurface(), pKernel1->getPrivateSurface());
+}
+
+HWTEST_F(KernelPrivateSurfaceTest, givenKernelRequiringBiggerPrivateSurfaceWhenKernelIsCreatedThenPoolGrowsAndOldSurfaceIsDeferred) {
+    std::unique_ptr<KernelInfo> pSmallKernelInfo(KernelInfo::create());
+    std::unique_ptr<KernelInfo> pBigKernelInfo(KernelInfo::create());
+    SPatchAllocateStatelessPrivateSurface smallTokenSPS;
+    smallTokenSPS.SurfaceStateHeapOffset = 64;
+    smallTokenSPS.DataParamOffset = 40;
+    smallTokenSPS.DataParamSize = 8;
+    smallTokenSPS.PerThreadPrivateMemorySize = 112;
+    pSmallKernelInfo->patchInfo.pAllocateStatelessPrivateSurface = &smallTokenSPS;
+
+    SPatchAllocateStatelessPrivateSurface bigTokenSPS = smallTokenSPS;
+    bigTokenSPS.PerThreadPrivateMemorySize = 4 * 112;
+    pBigKernelInfo->patchInfo.pAllocateStatelessPrivateSurface = &bigTokenSPS;
+
+    SPatchDataParameterStream tokenDPS;
+    tokenDPS.DataParameterStreamSize = 64;
+    pSmallKernelInfo->patchInfo.dataParameterStream = &tokenDPS;
+    pBigKernelInfo->patchInfo.dataParameterStream = &tokenDPS;
+
+    SPatchExecutionEnvironment tokenEE;
+    tokenEE.CompiledSIMD32 = true;
+    pSmallKernelInfo->patchInfo.executionEnvironment = &tokenEE;
+    pBigKernelInfo->patchInfo.executionEnvironment = &tokenEE;
+
+    MockContext context;
+    MockProgram program(&context);
+    std::unique_ptr<MockKernel> pSmallKernel(new MockKernel(&program, *pSmallKernelInfo, *pDevice));
+    ASSERT_EQ(CL_SUCCESS, pSmallKernel->initialize());
+    auto smallSurface = pSmallKernel->getPrivateSurface();
+
+    auto &csr = pDevice->getUltCommandStreamReceiver<FamilyType>();
+    auto memoryManager = pDevice->getMemoryManager();
+    csr.taskCount = *pDevice->getTagAddress() + 1;
+
+    std::unique_ptr<MockKernel> pBigKernel(new MockKernel(&program, *pBigKernelInfo, *pDevice));
+    ASSERT_EQ(CL_SUCCESS, pBigKernel->initialize());
+    auto bigSurface = pBigKernel->getPrivateSurface();
+
+    EXPECT_NE(smallSurface, bigSurface);
+    EXPECT_GT(bigSurface->getUnderlyingBufferSize(), smallSurface->getUnderlyingBufferSize());
+    EXPECT_EQ(bigSurface, csr.getPrivateSurface());
 
-    EXPECT_FALSE(memoryManager->graphicsAllocations.peekIsEmpty());
-    EXPECT_EQ(memoryManager->graphicsAllocations.peekHead(), privateSurface);
+    EXPECT_EQ(smallSurface, memoryManager->graphicsAllocations.peekHead());
+    EXPECT_EQ(csr.peekTaskCount(), smallSurface->taskCount);
+
+    pSmallKernel->patchPrivateSurface(*csr.getPrivateSurface());
+    EXPECT_EQ(bigSurface, pSmallKernel->getPrivateSurface());
+    auto patchedAddress = *reinterpret_cast<uint64_t *>(ptrOffset(pSmallKernel->getCrossThreadData(), smallTokenSPS.DataParamOffset));
+    EXPECT_EQ(static_cast<uint64_t>(bigSurface->getGpuAddressToPatch()), patchedAddress);
 }
 
 TEST_F(KernelPrivateSurfaceTest, testPrivateSurfaceAllocationFailure) {
@@ -577,6 +734,8 @@ TEST_F(KernelPrivateSurfaceTest, testPrivateSurfaceAllocationFailure) {
     MockContext context;
     MockProgram program(&context);
     MemoryManagementFixture::InjectedFunction method = [&](size_t failureIndex) {
+        // start each iteration with an empty private surface pool
+        pDevice->resetCommandStreamReceiver(new CommandStreamReceiverMock());
         MockKernel *pKernel = new MockKernel(&program, *pKernelInfo, *pDevice);
 
         if (MemoryManagementFixture::nonfailingAllocation == failureIndex) {
@@ -2123,3 +2282,51 @@ TEST(KernelTest, givenKernelWhenDebugFlagToUseMaxSimdForCalculationsIsUsedThenMa
     kernel.mockKernel->getWorkGroupInfo(device.get(), CL_KERNEL_WORK_GROUP_SIZE, sizeof(size_t), &maxKernelWkgSize, nullptr);
     EXPECT_EQ(256u, maxKernelWkgSize);
 }
+
+struct RecordingArgHandlerKernel : public MockKernel {
+    using MockKernel::MockKernel;
+
+    cl_int recordSetArg(uint32_t argIndex, size_t argSize, const void *argVal) {
+        recordedArgIndices.push_back(argIndex);
+        return CL_SUCCESS;
+    }
+
+    std::vector<uint32_t> recordedArgIndices;
+};
+
+typedef Test<DeviceFixture> KernelTemplateTest;
+
+TEST_F(KernelTemplateTest, givenKernelInfoWithKernelTemplateWhenArgIsSetThenHandlerCachedOnTemplateIsCalled) {
+    MockKernelWithInternals kernelInternals(*pDevice);
+    auto &kernelInfo = kernelInternals.kernelInfo;
+    kernelInfo.kernelArgInfo.resize(2);
+    for (auto &argInfo : kernelInfo.kernelArgInfo) {
+        KernelArgPatchInfo patchInfo;
+        patchInfo.crossthreadOffset = 0;
+        patchInfo.size = sizeof(uint32_t);
+        patchInfo.sourceOffset = 0;
+        argInfo.kernelArgPatchInfoVector.push_back(patchInfo);
+    }
+
+    auto kernelTemplate = KernelTemplate::create(kernelInfo);
+    EXPECT_EQ(&Kernel::setArgImmediate, kernelTemplate->argHandlers[1]);
+    kernelTemplate->argHandlers[1] = static_cast<Kernel::KernelArgHandler>(&RecordingArgHandlerKernel::recordSetArg);
+    kernelInfo.kernelTemplate = kernelTemplate;
+
+    RecordingArgHandlerKernel kernel(kernelInternals.mockProgram, kernelInfo, *pDevice);
+    ASSERT_EQ(CL_SUCCESS, kernel.initialize());
+    kernel.setCrossThreadData(kernelInternals.crossThreadData, sizeof(kernelInternals.crossThreadData));
+
+    uint32_t argValue = 5;
+    EXPECT_EQ(CL_SUCCESS, kernel.setArg(1, sizeof(argValue), &argValue));
+    ASSERT_EQ(1u, kernel.recordedArgIndices.size());
+    EXPECT_EQ(1u, kernel.recordedArgIndices[0]);
+
+    // handlers the template keeps unchanged are the resolved ones
+    EXPECT_EQ(CL_SUCCESS, kernel.setArg(0, sizeof(argValue), &argValue));
+    EXPECT_EQ(1u, kernel.recordedArgIndices.size());
+    EXPECT_EQ(argValue, *reinterpret_cast<uint32_t *>(kernel.getCrossThreadData()));
+
+    EXPECT_EQ(CL_SUCCESS, kernel.setArg(1, sizeof(argValue), &argValue));
+    EXPECT_EQ(2u, kernel.recordedArgIndices.size());
+}
@@ -34,6 +34,8 @@
 #include "runtime/helpers/options.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+#include <atomic>
+#include <thread>
 #include "test.h"
 
 using namespace OCLRT;
@@ -807,6 +809,168 @@ HWTEST_F(BufferSetSurfaceTests, givenBufferWithOffsetWhenSetArgStatefulIsCalledT
     DebugManager.flags.Force32bitAddressing.set(false);
 }
 
+HWTEST_F(BufferSetSurfaceTests, givenBuffersWhenSetArgStatefulIsCalledRepeatedlyOnDifferentHeapContentsThenSurfaceStateMatchesFreshlyEncodedOne) {
+    using RENDER_SURFACE_STATE = typename FamilyType::RENDER_SURFACE_STATE;
+    MockContext context;
+    auto size = MemoryConstants::pageSize;
+    auto ptr = alignedMalloc(size * 2, MemoryConstants::pageSize);
+    auto retVal = CL_SUCCESS;
+
+    auto buffer = Buffer::create(&context, CL_MEM_USE_HOST_PTR, size, ptr, retVal);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    auto readOnlyBuffer = Buffer::create(&context, CL_MEM_READ_ONLY, size + 3, nullptr, retVal);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    cl_buffer_region region = {4, 8};
+    auto subBuffer = buffer->createSubBuffer(CL_MEM_READ_WRITE, &region, retVal);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+
+    struct {
+        Buffer *buffer;
+        size_t offset;
+        size_t size;
+    } testedBuffers[] = {{buffer, 0, size},
+                         {readOnlyBuffer, 0, size + 3},
+                         {subBuffer, region.origin, region.size}};
+
+    RENDER_SURFACE_STATE heapContents[4];
+    memset(&heapContents[0], 0, sizeof(RENDER_SURFACE_STATE));
+    memset(&heapContents[1], 0xff, sizeof(RENDER_SURFACE_STATE));
+    memset(&heapContents[2], 0x5a, sizeof(RENDER_SURFACE_STATE));
+    heapContents[3] = RENDER_SURFACE_STATE::sInit();
+
+    for (int iteration = 0; iteration < 3; iteration++) {
+        for (auto &tested : testedBuffers) {
+            auto allocation = tested.buffer->getGraphicsAllocation();
+            for (auto &contents : heapContents) {
+                RENDER_SURFACE_STATE surfaceState = contents;
+                RENDER_SURFACE_STATE expectedSurfaceState = contents;
+
+                tested.buffer->setArgStateful(&surfaceState);
+                BufferHw<FamilyType>::encodeSurfaceState(&expectedSurfaceState, allocation->getGpuAddress() + tested.offset,
+                                                         allocation->getUnderlyingBufferSize(), tested.size, tested.buffer->getFlags());
+                EXPECT_EQ(0, memcmp(&expectedSurfaceState, &surfaceState, sizeof(RENDER_SURFACE_STATE)));
+            }
+        }
+    }
+
+    subBuffer->release();
+    delete readOnlyBuffer;
+    delete buffer;
+    alignedFree(ptr);
+}
+
+HWTEST_F(BufferSetSurfaceTests, givenCachedSurfaceStateWhenBufferGpuAddressChangesThenNewAddressIsProgrammed) {
+    using RENDER_SURFACE_STATE = typename FamilyType::RENDER_SURFACE_STATE;
+    MockContext context;
+    auto retVal = CL_SUCCESS;
+    auto buffer = Buffer::create(&context, CL_MEM_READ_WRITE, MemoryConstants::pageSize, nullptr, retVal);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+
+    RENDER_SURFACE_STATE surfaceState = RENDER_SURFACE_STATE::sInit();
+    buffer->setArgStateful(&surfaceState);
+    buffer->setArgStateful(&surfaceState);
+
+    auto allocation = buffer->getGraphicsAllocation();
+    auto originalGpuAddress = allocation->getGpuAddress();
+    allocation->setGpuAddress(originalGpuAddress + MemoryConstants::pageSize);
+
+    buffer->setArgStateful(&surfaceState);
+    EXPECT_EQ(originalGpuAddress + MemoryConstants::pageSize, surfaceState.getSurfaceBaseAddress());
+
+    RENDER_SURFACE_STATE expectedSurfaceState = RENDER_SURFACE_STATE::sInit();
+    BufferHw<FamilyType>::encodeSurfaceState(&expectedSurfaceState, allocation->getGpuAddress(), allocation->getUnderlyingBufferSize(),
+                                             MemoryConstants::pageSize, CL_MEM_READ_WRITE);
+    EXPECT_EQ(0, memcmp(&expectedSurfaceState, &surfaceState, sizeof(RENDER_SURFACE_STATE)));
+
+    allocation->setGpuAddress(originalGpuAddress);
+    delete buffer;
+}
+
+HWTEST_F(BufferSetSurfaceTests, givenPublishedSurfaceStateCacheWhenSetArgStatefulIsCalledAgainThenSameEntryIsUsed) {
+    using RENDER_SURFACE_STATE = typename FamilyType::RENDER_SURFACE_STATE;
+    MockContext context;
+    auto retVal = CL_SUCCESS;
+    std::unique_ptr<Buffer> buffer(Buffer::create(&context, CL_MEM_READ_WRITE, MemoryConstants::pageSize, nullptr, retVal));
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    auto bufferHw = static_cast<BufferHw<FamilyType> *>(buffer.get());
+    auto allocation = buffer->getGraphicsAllocation();
+
+    RENDER_SURFACE_STATE surfaceState = RENDER_SURFACE_STATE::sInit();
+    buffer->setArgStateful(&surfaceState);
+    EXPECT_EQ(nullptr, bufferHw->peekSurfaceStateCache());
+
+    buffer->setArgStateful(&surfaceState);
+    auto cache = bufferHw->peekSurfaceStateCache();
+    ASSERT_NE(nullptr, cache);
+    EXPECT_EQ(allocation, cache->graphicsAllocation);
+    EXPECT_EQ(allocation->getGpuAddress(), cache->bufferAddress);
+
+    RENDER_SURFACE_STATE expectedSurfaceState = RENDER_SURFACE_STATE::sInit();
+    BufferHw<FamilyType>::encodeSurfaceState(&expectedSurfaceState, allocation->getGpuAddress(), allocation->getUnderlyingBufferSize(),
+                                             buffer->getSize(), buffer->getFlags());
+    for (int i = 0; i < 100; i++) {
+        surfaceState = RENDER_SURFACE_STATE::sInit();
+        buffer->setArgStateful(&surfaceState);
+        EXPECT_EQ(cache, bufferHw->peekSurfaceStateCache());
+        EXPECT_EQ(0, memcmp(&expectedSurfaceState, &surfaceState, sizeof(RENDER_SURFACE_STATE)));
+    }
+
+    auto originalGpuAddress = allocation->getGpuAddress();
+    allocation->setGpuAddress(originalGpuAddress + MemoryConstants::pageSize);
+    buffer->setArgStateful(&surfaceState);
+    buffer->setArgStateful(&surfaceState);
+    auto newCache = bufferHw->peekSurfaceStateCache();
+    ASSERT_NE(nullptr, newCache);
+    EXPECT_NE(cache, newCache);
+    EXPECT_EQ(originalGpuAddress + MemoryConstants::pageSize, newCache->bufferAddress);
+    // replaced entry is kept for readers that loaded it before the switch
+    EXPECT_EQ(originalGpuAddress, cache->bufferAddress);
+
+    allocation->setGpuAddress(originalGpuAddress);
+}
+
+HWTEST_F(BufferSetSurfaceTests, givenBufferSharedByConcurrentlySetKernelArgsWhenSetArgStatefulIsCalledFromManyThreadsThenEverySurfaceStateIsFullyProgrammed) {
+    using RENDER_SURFACE_STATE = typename FamilyType::RENDER_SURFACE_STATE;
+    MockContext context;
+    auto retVal = CL_SUCCESS;
+    const int numThreads = 4;
+    const int numIterations = 200;
+
+    for (int round = 0; round < 8; round++) {
+        // fresh buffer each round, so threads race on building the cache
+        std::unique_ptr<Buffer> buffer(Buffer::create(&context, CL_MEM_READ_WRITE, MemoryConstants::pageSize + round, nullptr, retVal));
+        ASSERT_EQ(CL_SUCCESS, retVal);
+        auto allocation = buffer->getGraphicsAllocation();
+
+        RENDER_SURFACE_STATE expectedSurfaceState = RENDER_SURFACE_STATE::sInit();
+        BufferHw<FamilyType>::encodeSurfaceState(&expectedSurfaceState, allocation->getGpuAddress(), allocation->getUnderlyingBufferSize(),
+                                                 buffer->getSize(), buffer->getFlags());
+
+        std::atomic<bool> start(false);
+        std::atomic<int> mismatches(0);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < numThreads; i++) {
+            threads.push_back(std::thread([&]() {
+                while (!start) {
+                    std::this_thread::yield();
+                }
+                for (int iteration = 0; iteration < numIterations; iteration++) {
+                    RENDER_SURFACE_STATE surfaceState = RENDER_SURFACE_STATE::sInit();
+                    buffer->setArgStateful(&surfaceState);
+                    if (memcmp(&expectedSurfaceState, &surfaceState, sizeof(RENDER_SURFACE_STATE)) != 0) {
+                        mismatches++;
+                    }
+                }
+            }));
+        }
+        start = true;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        EXPECT_EQ(0, mismatches.load());
+    }
+}
+
 struct BufferUnmapTest : public DeviceFixture, public ::testing::Test {
     void SetUp() override {
         DeviceFixture::SetUp();
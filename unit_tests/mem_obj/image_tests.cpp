@@ -26,6 +26,7 @@
 #include "runtime/compiler_interface/compiler_interface.h"
 #include "runtime/mem_obj/image.h"
 #include "runtime/helpers/aligned_memory.h"
+#include "runtime/helpers/tiling.h"
 #include "runtime/built_ins/built_ins.h"
 #include "unit_tests/fixtures/memory_management_fixture.h"
 #include "unit_tests/helpers/debug_manager_state_restore.h"
@@ -991,3 +992,102 @@ TEST_F(ImageCompressionTests, givenNonTiledImageWhenCreatingAllocationThenDontPr
     EXPECT_TRUE(myMemoryManager->mockMethodCalled);
     EXPECT_FALSE(myMemoryManager->capturedImgInfo.preferRenderCompression);
 }
+
+class ImageCpuTilingTests : public ::testing::Test {
+  public:
+    class LockableMemoryManager : public MockMemoryManager {
+      public:
+        void *lockResource(GraphicsAllocation *graphicsAllocation) override {
+            lockCount++;
+            return graphicsAllocation->getUnderlyingBuffer();
+        }
+        void unlockResource(GraphicsAllocation *graphicsAllocation) override {
+            unlockCount++;
+        }
+        bool isResourceLockable() const override { return true; }
+        uint32_t lockCount = 0;
+        uint32_t unlockCount = 0;
+    };
+
+    void SetUp() override {
+        memoryManager = new LockableMemoryManager();
+        mockDevice.reset(Device::create<MockDevice>(*platformDevices));
+        mockDevice->injectMemoryManager(memoryManager);
+        mockContext.reset(new MockContext(mockDevice.get()));
+
+        imageDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+        imageDesc.image_width = 64;
+        imageDesc.image_height = 32;
+        for (size_t i = 0; i < hostData.size(); i++) {
+            hostData[i] = static_cast<uint8_t>(i * 7 + 3);
+        }
+    }
+
+    Image *createImage(cl_mem_flags flags, const void *hostPtr) {
+        auto surfaceFormat = Image::getSurfaceFormatFromTable(flags, &imageFormat);
+        return Image::create(mockContext.get(), flags, surfaceFormat, &imageDesc, hostPtr, retVal);
+    }
+
+    DebugManagerStateRestore restorer;
+    std::unique_ptr<MockDevice> mockDevice;
+    std::unique_ptr<MockContext> mockContext;
+    LockableMemoryManager *memoryManager = nullptr;
+
+    cl_image_desc imageDesc = {};
+    cl_image_format imageFormat{CL_RGBA, CL_UNORM_INT8};
+    cl_int retVal = CL_SUCCESS;
+    std::array<uint8_t, 64 * 32 * 4> hostData;
+};
+
+TEST_F(ImageCpuTilingTests, givenLockableTiledImageWhenCreatingWithHostPtrThenDataIsSwizzledOnCpu) {
+    std::unique_ptr<Image> image(createImage(CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, hostData.data()));
+    ASSERT_NE(nullptr, image);
+    EXPECT_EQ(CL_SUCCESS, retVal);
+    ASSERT_TRUE(image->isTiledImage);
+    EXPECT_TRUE(image->isTiledCopyOnCpuAllowed());
+    EXPECT_EQ(1u, memoryManager->lockCount);
+    EXPECT_EQ(1u, memoryManager->unlockCount);
+
+    TiledSurface surface = {image->getGraphicsAllocation()->getUnderlyingBuffer(), image->getImageDesc().image_row_pitch, TileMode::TileY};
+    std::array<uint8_t, 64 * 32 * 4> readBack = {};
+    TilingHelper::unswizzle(surface, 0, 0, readBack.data(), 64 * 4, 64 * 4, 32);
+    EXPECT_EQ(hostData, readBack);
+}
+
+TEST_F(ImageCpuTilingTests, givenCpuTilingDisabledWhenCreatingWithHostPtrThenResourceIsNotLocked) {
+    DebugManager.flags.EnableCpuImageTiling.set(0);
+    std::unique_ptr<Image> image(createImage(CL_MEM_READ_WRITE, nullptr));
+    ASSERT_NE(nullptr, image);
+    EXPECT_FALSE(image->isTiledCopyOnCpuAllowed());
+    EXPECT_EQ(0u, memoryManager->lockCount);
+}
+
+TEST_F(ImageCpuTilingTests, givenTiledImageWhenRegionIsWrittenAndReadOnCpuThenDataRoundTrips) {
+    std::unique_ptr<Image> image(createImage(CL_MEM_READ_WRITE, nullptr));
+    ASSERT_NE(nullptr, image);
+
+    size_t origin[3] = {5, 3, 0};
+    size_t region[3] = {17, 9, 1};
+    size_t rowPitch = region[0] * 4;
+    EXPECT_TRUE(image->isReadWriteOnCpuAllowed(CL_TRUE, 0, region));
+    EXPECT_FALSE(image->isReadWriteOnCpuAllowed(CL_FALSE, 0, region));
+    EXPECT_FALSE(image->isReadWriteOnCpuAllowed(CL_TRUE, 1, region));
+
+    EXPECT_TRUE(image->writeTiledOnCpu(hostData.data(), rowPitch, 0, origin, region));
+    std::array<uint8_t, 64 * 32 * 4> readBack = {};
+    EXPECT_TRUE(image->readTiledOnCpu(readBack.data(), rowPitch, 0, origin, region));
+    EXPECT_EQ(0, memcmp(hostData.data(), readBack.data(), rowPitch * region[1]));
+    EXPECT_EQ(2u, memoryManager->lockCount);
+    EXPECT_EQ(2u, memoryManager->unlockCount);
+}
+
+TEST_F(ImageCpuTilingTests, givenRegionAboveThresholdWhenCheckingReadWriteOnCpuThenNotAllowed) {
+    imageDesc.image_width = 512;
+    imageDesc.image_height = 512;
+    std::unique_ptr<Image> image(createImage(CL_MEM_READ_WRITE, nullptr));
+    ASSERT_NE(nullptr, image);
+
+    size_t region[3] = {512, 512, 1};
+    EXPECT_TRUE(image->isTiledCopyOnCpuAllowed());
+    EXPECT_FALSE(image->isReadWriteOnCpuAllowed(CL_TRUE, 0, region));
+}
@@ -162,6 +162,45 @@ TEST(ImageDepthFormatTest, returnSurfaceFormatForDepthStencilFormats) {
     EXPECT_TRUE(surfaceFormatInfo->GMMSurfaceFormat == GMM_FORMAT_R32G32_FLOAT_TYPE);
 }
 
+TEST(ImageFormatLookupTest, givenEveryFormatFromSurfaceFormatTablesWhenLookedUpThenFirstMatchingTableEntryIsReturned) {
+    struct {
+        cl_mem_flags flags;
+        const SurfaceFormatInfo *table;
+        size_t numFormats;
+    } tables[] = {
+        {CL_MEM_READ_ONLY, readOnlySurfaceFormats, numReadOnlySurfaceFormats},
+        {CL_MEM_WRITE_ONLY, writeOnlySurfaceFormats, numWriteOnlySurfaceFormats},
+        {CL_MEM_READ_WRITE, readWriteSurfaceFormats, numReadWriteSurfaceFormats},
+        {CL_MEM_READ_ONLY, readOnlyDepthSurfaceFormats, numReadOnlyDepthSurfaceFormats},
+        {CL_MEM_READ_WRITE, readWriteDepthSurfaceFormats, numReadWriteDepthSurfaceFormats}};
+
+    for (const auto &table : tables) {
+        for (size_t i = 0; i < table.numFormats; i++) {
+            const auto &imgFormat = table.table[i].OCLImageFormat;
+            const SurfaceFormatInfo *expected = &table.table[i];
+            for (size_t j = 0; j < i; j++) {
+                if (table.table[j].OCLImageFormat.image_channel_order == imgFormat.image_channel_order &&
+                    table.table[j].OCLImageFormat.image_channel_data_type == imgFormat.image_channel_data_type) {
+                    expected = &table.table[j];
+                    break;
+                }
+            }
+            EXPECT_EQ(expected, Image::getSurfaceFormatFromTable(table.flags, &imgFormat));
+        }
+    }
+}
+
+TEST(ImageFormatLookupTest, givenUnsupportedFormatWhenLookedUpThenNullptrIsReturned) {
+    cl_image_format imgFormat = {};
+    imgFormat.image_channel_order = CL_RGB;
+    imgFormat.image_channel_data_type = CL_FLOAT;
+    EXPECT_EQ(nullptr, Image::getSurfaceFormatFromTable(CL_MEM_READ_WRITE, &imgFormat));
+
+    imgFormat.image_channel_order = 0;
+    imgFormat.image_channel_data_type = 0;
+    EXPECT_EQ(nullptr, Image::getSurfaceFormatFromTable(CL_MEM_READ_WRITE, &imgFormat));
+}
+
 static cl_image_desc validImageDesc[] = {
     {CL_MEM_OBJECT_IMAGE1D, /*image_type*/
      16384,                 /*image_width*/
@@ -29,6 +29,9 @@
 
 class MockBuiltins : public OCLRT::BuiltIns {
   public:
+    using BuiltIns::getSipKernelCacheName;
+    using BuiltIns::instanceId;
+
     MockBuiltins() {
         originalGlobalBuiltins = this;
     }
@@ -60,6 +63,10 @@ class MockBuiltins : public OCLRT::BuiltIns {
         return BuiltIns::getSipKernel(type, device);
     }
 
+    std::string getCompilerFileStamp() const override {
+        return compilerFileStampOverride.empty() ? BuiltIns::getCompilerFileStamp() : compilerFileStampOverride;
+    }
+
     void overrideSipKernel(std::unique_ptr<OCLRT::SipKernel> kernel) {
         sipKernelsOverride[kernel->getType()] = std::move(kernel);
     }
@@ -67,4 +74,5 @@ class MockBuiltins : public OCLRT::BuiltIns {
     OCLRT::BuiltIns *originalGlobalBuiltins = nullptr;
     std::map<OCLRT::SipKernelType, std::unique_ptr<OCLRT::SipKernel>> sipKernelsOverride;
     bool getSipKernelCalled = false;
+    std::string compilerFileStampOverride;
 };
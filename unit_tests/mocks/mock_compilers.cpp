@@ -339,6 +339,10 @@ std::unique_ptr<unsigned char[]> loadBinaryFile(StrT &&fileName, size_t &fileSiz
 void translate(bool usingIgc, CIF::Builtins::BufferSimple *src, CIF::Builtins::BufferSimple *options,
                CIF::Builtins::BufferSimple *internalOptions, MockOclTranslationOutput *out) {
     MockCompilerDebugVars &debugVars = (usingIgc) ? *OCLRT::igcDebugVars : *fclDebugVars;
+    if (debugVars.translateListener != nullptr) {
+        debugVars.translateListener(debugVars.translateListenerData);
+    }
+
     if (debugVars.receivedInput != nullptr) {
         if (src != nullptr) {
             debugVars.receivedInput->assign(src->GetMemory<char>(),
@@ -47,6 +47,8 @@ struct MockCompilerDebugVars {
     bool failCreateIgcFeWaInterface = false;
     std::string *receivedInternalOptionsOutput = nullptr;
     std::string *receivedInput = nullptr;
+    void (*translateListener)(void *data) = nullptr;
+    void *translateListenerData = nullptr;
 
     std::string fileName;
 };
@@ -287,6 +289,7 @@ class MockCompilerInterface : public CompilerInterface {
     }
 
     cl_int getSipKernelBinary(SipKernelType type, const Device &device, std::vector<char> &retBinary) override {
+        this->sipKernelBinaryRequests++;
         if (this->sipKernelBinaryOverride.size() > 0) {
             retBinary = this->sipKernelBinaryOverride;
             this->requestedSipKernel = type;
@@ -296,6 +299,20 @@ class MockCompilerInterface : public CompilerInterface {
         }
     }
 
+    size_t getNumIdleIgcTranslationCtxs(const Device &device, IGC::CodeType::CodeType_t inType, IGC::CodeType::CodeType_t outType) {
+        return this->igcTranslationCtxPool.getNumIdle(std::make_tuple(&device, inType, outType));
+    }
+
+    uint32_t getNumInFlightBuildWaiters() {
+        std::lock_guard<std::mutex> lock(this->inFlightBuildsMtx);
+        uint32_t numWaiters = 0;
+        for (auto &inFlightBuild : this->inFlightBuilds) {
+            std::lock_guard<std::mutex> buildLock(inFlightBuild.second->mtx);
+            numWaiters += inFlightBuild.second->numWaiters;
+        }
+        return numWaiters;
+    }
+
     static std::vector<char> getDummyGenBinary();
 
     CompilerInterface *originalGlobalCompilerInterface = nullptr;
@@ -307,6 +324,7 @@ class MockCompilerInterface : public CompilerInterface {
 
     std::vector<char> sipKernelBinaryOverride;
     SipKernelType requestedSipKernel = SipKernelType::COUNT;
+    uint32_t sipKernelBinaryRequests = 0;
 };
 
 template <>
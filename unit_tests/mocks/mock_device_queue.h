@@ -55,6 +55,8 @@ class MockDeviceQueueHw : public DeviceQueueHw<GfxFamily> {
     using BaseClass::getMediaStateClearCmdsSize;
     using BaseClass::getProfilingEndCmdsSize;
     using BaseClass::getExecutionModelCleanupSectionSize;
+    using BaseClass::lastResetBytesTouched;
+    using BaseClass::slbDummyCommandsValid;
 
     bool arbCheckWa;
     bool miAtomicWa;
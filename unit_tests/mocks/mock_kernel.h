@@ -164,6 +164,7 @@ class MockKernel : public Kernel {
 
     void setKernelArguments(std::vector<SimpleKernelArgInfo> kernelArguments) {
         this->kernelArguments = kernelArguments;
+        invalidateResolvedResidency();
     }
 
     template <typename PatchTokenT>
@@ -180,6 +181,7 @@ class MockKernel : public Kernel {
 
     // Make protected members from base class publicly accessible in mock class
     using Kernel::kernelArgHandlers;
+    using Kernel::resolvedResidencyValid;
 
     void setUsingSharedArgs(bool usingSharedArgValue) { this->usingSharedObjArgs = usingSharedArgValue; }
 };
@@ -73,6 +73,7 @@ class MockProgram : public Program {
     }
     void addKernelInfo(KernelInfo *inInfo) {
         kernelInfoArray.push_back(inInfo);
+        indexKernelInfosByName();
     }
     std::vector<KernelInfo *> &getParentKernelInfoArray() {
         return parentKernelInfoArray;
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/slab_allocator.h"
+#include "unit_tests/helpers/memory_management.h"
+#include "unit_tests/mocks/mock_slab_allocator.h"
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace OCLRT {
+
+TEST(SlabAllocatorMtTest, givenThreadCachesOnManyThreadsWhenBlocksAreAllocatedAndReleasedThenBlocksAreNeverShared) {
+    const int numThreads = 8;
+    const int numIterations = 1000;
+    const int blocksPerIteration = 48;
+
+    SlabAllocator allocator(64, 64);
+    std::atomic<int> failures(0);
+    std::atomic<bool> start(false);
+    std::vector<std::thread> threads;
+
+    for (int threadId = 0; threadId < numThreads; threadId++) {
+        threads.push_back(std::thread([&, threadId]() {
+            SlabCache cache;
+            void *blocks[blocksPerIteration];
+            while (!start)
+                ;
+            for (int iteration = 0; iteration < numIterations; iteration++) {
+                for (auto &block : blocks) {
+                    block = cache.allocate(allocator);
+                    memset(block, threadId, allocator.getBlockSize());
+                }
+                for (auto block : blocks) {
+                    auto bytes = static_cast<unsigned char *>(block);
+                    for (size_t i = 0; i < allocator.getBlockSize(); i++) {
+                        if (bytes[i] != static_cast<unsigned char>(threadId)) {
+                            failures++;
+                            break;
+                        }
+                    }
+                    cache.release(allocator, block);
+                }
+            }
+            cache.flush(allocator);
+        }));
+    }
+
+    start = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(0, failures.load());
+    EXPECT_EQ(allocator.getSlabCount() * allocator.getBlocksPerSlab(), allocator.getFreeBlockCount());
+}
+
+struct SizeClassSlabAllocatorMtTest : public ::testing::Test {
+    void SetUp() override {
+        // slabs stay with the shared allocators until process exit
+        MemoryManagement::fastLeaksDetectionMode = MemoryManagement::LeakDetectionMode::TURN_OFF_LEAK_DETECTION;
+    }
+};
+
+struct ThreadExitFlushTestTag {};
+struct CrossThreadReleaseTestTag {};
+struct ManyThreadsTestTag {};
+
+TEST_F(SizeClassSlabAllocatorMtTest, givenBlocksCachedOnThreadWhenThreadExitsThenThreadCacheIsFlushedToSharedAllocator) {
+    using Allocator = MockSizeClassSlabAllocator<ThreadExitFlushTestTag>;
+    const size_t size = 100;
+    const uint32_t sizeClass = Allocator::getSizeClass(size);
+    size_t blocksCachedBeforeExit = 0;
+
+    std::thread thread([&]() {
+        void *ptrs[10];
+        for (auto &ptr : ptrs) {
+            ptr = Allocator::allocate(size);
+        }
+        for (auto ptr : ptrs) {
+            Allocator::release(ptr);
+        }
+        blocksCachedBeforeExit = Allocator::getThreadCaches().caches[sizeClass].count;
+    });
+    thread.join();
+
+    EXPECT_NE(0u, blocksCachedBeforeExit);
+    EXPECT_NE(0u, Allocator::getTotalBlockCount(sizeClass));
+    EXPECT_EQ(Allocator::getTotalBlockCount(sizeClass), Allocator::getSharedAllocator(sizeClass).getFreeBlockCount());
+}
+
+TEST_F(SizeClassSlabAllocatorMtTest, givenBlocksAllocatedOnOneThreadWhenReleasedOnAnotherThenAllBlocksReturnToSharedAllocator) {
+    using Allocator = MockSizeClassSlabAllocator<CrossThreadReleaseTestTag>;
+    const size_t size = 500;
+    const uint32_t sizeClass = Allocator::getSizeClass(size);
+    std::vector<void *> ptrs(3 * SlabCache::capacity);
+
+    std::thread allocatingThread([&]() {
+        for (auto &ptr : ptrs) {
+            ptr = Allocator::allocate(size);
+            memset(ptr, 0xcd, size);
+        }
+    });
+    allocatingThread.join();
+
+    std::thread releasingThread([&]() {
+        for (auto ptr : ptrs) {
+            EXPECT_EQ(sizeClass, Allocator::getBlockSizeClass(ptr));
+            Allocator::release(ptr);
+        }
+    });
+    releasingThread.join();
+
+    EXPECT_EQ(Allocator::getTotalBlockCount(sizeClass), Allocator::getSharedAllocator(sizeClass).getFreeBlockCount());
+}
+
+TEST_F(SizeClassSlabAllocatorMtTest, givenManyThreadsAllocatingDifferentSizesWhenBlocksAreReleasedThenBlocksAreNeverSharedAndAllReturnOnThreadExit) {
+    using Allocator = MockSizeClassSlabAllocator<ManyThreadsTestTag>;
+    const int numThreads = 8;
+    const int numIterations = 500;
+    const size_t sizes[] = {16, 100, 300, 1000};
+    const int blocksPerIteration = 48;
+
+    std::atomic<int> failures(0);
+    std::atomic<bool> start(false);
+    std::vector<std::thread> threads;
+
+    for (int threadId = 0; threadId < numThreads; threadId++) {
+        threads.push_back(std::thread([&, threadId]() {
+            void *ptrs[blocksPerIteration];
+            while (!start)
+                ;
+            for (int iteration = 0; iteration < numIterations; iteration++) {
+                for (int i = 0; i < blocksPerIteration; i++) {
+                    ptrs[i] = Allocator::allocate(sizes[i % 4]);
+                    memset(ptrs[i], threadId, sizes[i % 4]);
+                }
+                for (int i = 0; i < blocksPerIteration; i++) {
+                    auto bytes = static_cast<unsigned char *>(ptrs[i]);
+                    for (size_t j = 0; j < sizes[i % 4]; j++) {
+                        if (bytes[j] != static_cast<unsigned char>(threadId)) {
+                            failures++;
+                            break;
+                        }
+                    }
+                    Allocator::release(ptrs[i]);
+                }
+            }
+        }));
+    }
+
+    start = true;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(0, failures.load());
+    for (auto size : sizes) {
+        auto sizeClass = Allocator::getSizeClass(size);
+        EXPECT_EQ(Allocator::getTotalBlockCount(sizeClass), Allocator::getSharedAllocator(sizeClass).getFreeBlockCount());
+    }
+}
+} // namespace OCLRT
@@ -44,6 +44,7 @@
 #include "drm/i915_drm.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
@@ -766,6 +767,9 @@ class DrmCommandStreamEnhancedFixture : public MemoryManagementFixture
         std::vector<drm_i915_gem_exec_object2> &getExecStorage() {
             return this->execObjectsStorage;
         }
+        std::vector<uint64_t> &getExecObjectsGenerations() {
+            return this->execObjectsGenerations;
+        }
     };
     TestedDrmCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME> *tCsr = nullptr;
 
@@ -899,6 +903,280 @@ TEST_F(DrmCommandStreamGemWorkerTests, givenCommandStreamWithDuplicatesWhenItIsF
     mm->freeGraphicsMemory(commandBuffer);
 }
 
+std::vector<drm_i915_gem_exec_object2> captureExecObjects(const drm_i915_gem_execbuffer2 &execBuffer) {
+    auto execObjects = reinterpret_cast<drm_i915_gem_exec_object2 *>(execBuffer.buffers_ptr);
+    return std::vector<drm_i915_gem_exec_object2>(execObjects, execObjects + execBuffer.buffer_count);
+}
+
+void markExecObjects(const drm_i915_gem_execbuffer2 &execBuffer, uint64_t marker) {
+    auto execObjects = reinterpret_cast<drm_i915_gem_exec_object2 *>(execBuffer.buffers_ptr);
+    for (auto i = 0u; i < execBuffer.buffer_count; i++) {
+        execObjects[i].rsvd2 = marker;
+    }
+}
+
+TEST_F(DrmCommandStreamGemWorkerTests, givenUnchangedResidencyWhenFlushedAgainThenPreviousExecObjectsAreReused) {
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+    const uint64_t marker = 0xABCD;
+
+    std::vector<DrmAllocation *> allocations;
+    for (auto i = 0; i < 4; i++) {
+        allocations.push_back(mm->allocateGraphicsMemory(1024, 4096));
+    }
+    auto commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    LinearStream cs(commandBuffer);
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, false, false, QueueThrottle::MEDIUM, cs.getUsed(), &cs};
+
+    for (auto allocation : allocations) {
+        csr->makeResident(*allocation);
+    }
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    auto firstExecObjects = captureExecObjects(mock->execBuffer);
+    ASSERT_EQ(5u, firstExecObjects.size());
+    markExecObjects(mock->execBuffer, marker);
+
+    csr->makeSurfacePackNonResident(nullptr);
+    for (auto allocation : allocations) {
+        csr->makeResident(*allocation);
+    }
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    auto secondExecObjects = captureExecObjects(mock->execBuffer);
+    ASSERT_EQ(firstExecObjects.size(), secondExecObjects.size());
+
+    for (auto i = 0u; i < secondExecObjects.size(); i++) {
+        EXPECT_EQ(marker, secondExecObjects[i].rsvd2);
+        EXPECT_EQ(firstExecObjects[i].handle, secondExecObjects[i].handle);
+        EXPECT_EQ(firstExecObjects[i].offset, secondExecObjects[i].offset);
+        EXPECT_EQ(firstExecObjects[i].flags, secondExecObjects[i].flags);
+    }
+
+    for (auto allocation : allocations) {
+        mm->freeGraphicsMemory(allocation);
+    }
+    mm->freeGraphicsMemory(commandBuffer);
+}
+
+TEST_F(DrmCommandStreamGemWorkerTests, givenUnchangedResidencyAndNoBoChangesWhenFlushedAgainThenResidencyExecObjectsAreNotVisited) {
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+    const uint64_t marker = 0xABCD;
+
+    std::vector<DrmAllocation *> allocations;
+    for (auto i = 0; i < 4; i++) {
+        allocations.push_back(mm->allocateGraphicsMemory(1024, 4096));
+    }
+    auto commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    LinearStream cs(commandBuffer);
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, false, false, QueueThrottle::MEDIUM, cs.getUsed(), &cs};
+
+    auto flushAllocations = [&]() {
+        for (auto allocation : allocations) {
+            csr->makeResident(*allocation);
+        }
+        csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+        csr->makeSurfacePackNonResident(nullptr);
+    };
+
+    flushAllocations();
+    markExecObjects(mock->execBuffer, marker);
+    // a per-BO comparison would refill every slot with a cleared generation
+    auto &generations = tCsr->getExecObjectsGenerations();
+    std::fill(generations.begin(), generations.begin() + allocations.size(), 0u);
+
+    flushAllocations();
+    auto execObjects = captureExecObjects(mock->execBuffer);
+    ASSERT_EQ(5u, execObjects.size());
+    for (auto i = 0u; i < allocations.size(); i++) {
+        EXPECT_EQ(marker, execObjects[i].rsvd2);
+    }
+
+    // any BO state change falls back to the per-BO comparison
+    auto newAllocation = mm->allocateGraphicsMemory(1024, 4096);
+    flushAllocations();
+    execObjects = captureExecObjects(mock->execBuffer);
+    ASSERT_EQ(5u, execObjects.size());
+    for (auto i = 0u; i < allocations.size(); i++) {
+        EXPECT_EQ(0u, execObjects[i].rsvd2);
+        EXPECT_EQ(static_cast<uint32_t>(allocations[i]->getBO()->peekHandle()), execObjects[i].handle);
+    }
+
+    for (auto allocation : allocations) {
+        mm->freeGraphicsMemory(allocation);
+    }
+    mm->freeGraphicsMemory(newAllocation);
+    mm->freeGraphicsMemory(commandBuffer);
+}
+
+TEST_F(DrmCommandStreamGemWorkerTests, givenResidencyInDifferentOrderWhenFlushedAgainThenExecObjectsFollowNewOrder) {
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+
+    auto first = mm->allocateGraphicsMemory(1024, 4096);
+    auto second = mm->allocateGraphicsMemory(1024, 4096);
+    auto commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    LinearStream cs(commandBuffer);
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, false, false, QueueThrottle::MEDIUM, cs.getUsed(), &cs};
+
+    csr->makeResident(*first);
+    csr->makeResident(*second);
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    csr->makeSurfacePackNonResident(nullptr);
+
+    csr->makeResident(*second);
+    csr->makeResident(*first);
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    csr->makeSurfacePackNonResident(nullptr);
+
+    auto execObjects = captureExecObjects(mock->execBuffer);
+    ASSERT_EQ(3u, execObjects.size());
+    EXPECT_EQ(static_cast<uint32_t>(second->getBO()->peekHandle()), execObjects[0].handle);
+    EXPECT_EQ(static_cast<uint32_t>(first->getBO()->peekHandle()), execObjects[1].handle);
+
+    mm->freeGraphicsMemory(first);
+    mm->freeGraphicsMemory(second);
+    mm->freeGraphicsMemory(commandBuffer);
+}
+
+TEST_F(DrmCommandStreamGemWorkerTests, givenChangedResidencyWhenFlushedAgainThenOnlyChangedExecObjectsArePatched) {
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+    const uint64_t marker = 0xABCD;
+
+    std::vector<DrmAllocation *> allocations;
+    for (auto i = 0; i < 3; i++) {
+        allocations.push_back(mm->allocateGraphicsMemory(1024, 4096));
+    }
+    auto replacement = mm->allocateGraphicsMemory(1024, 4096);
+    auto commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    LinearStream cs(commandBuffer);
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, false, false, QueueThrottle::MEDIUM, cs.getUsed(), &cs};
+
+    for (auto allocation : allocations) {
+        csr->makeResident(*allocation);
+    }
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    markExecObjects(mock->execBuffer, marker);
+    csr->makeSurfacePackNonResident(nullptr);
+
+    csr->makeResident(*allocations[0]);
+    csr->makeResident(*replacement);
+    csr->makeResident(*allocations[2]);
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    auto execObjects = captureExecObjects(mock->execBuffer);
+    ASSERT_EQ(4u, execObjects.size());
+
+    EXPECT_EQ(marker, execObjects[0].rsvd2);
+    EXPECT_EQ(0u, execObjects[1].rsvd2);
+    EXPECT_EQ(static_cast<uint32_t>(replacement->getBO()->peekHandle()), execObjects[1].handle);
+    EXPECT_EQ(marker, execObjects[2].rsvd2);
+    EXPECT_EQ(marker, execObjects[3].rsvd2);
+    EXPECT_EQ(static_cast<uint32_t>(commandBuffer->getBO()->peekHandle()), execObjects[3].handle);
+
+    for (auto allocation : allocations) {
+        mm->freeGraphicsMemory(allocation);
+    }
+    mm->freeGraphicsMemory(replacement);
+    mm->freeGraphicsMemory(commandBuffer);
+}
+
+TEST_F(DrmCommandStreamGemWorkerTests, givenResidentBoWhenItIsSoftPinnedBetweenFlushesThenItsExecObjectIsRefilled) {
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+
+    auto allocation = mm->allocateGraphicsMemory(1024, 4096);
+    auto commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    LinearStream cs(commandBuffer);
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, false, false, QueueThrottle::MEDIUM, cs.getUsed(), &cs};
+
+    csr->makeResident(*allocation);
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    csr->makeSurfacePackNonResident(nullptr);
+
+    auto generation = allocation->getBO()->peekGeneration();
+    allocation->getBO()->softPin(0x10000);
+    EXPECT_NE(generation, allocation->getBO()->peekGeneration());
+
+    csr->makeResident(*allocation);
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    auto execObjects = captureExecObjects(mock->execBuffer);
+    ASSERT_EQ(2u, execObjects.size());
+    EXPECT_EQ(0x10000u, execObjects[0].offset);
+    EXPECT_NE(0u, execObjects[0].flags & EXEC_OBJECT_PINNED);
+
+    mm->freeGraphicsMemory(allocation);
+    mm->freeGraphicsMemory(commandBuffer);
+}
+
+TEST_F(DrmCommandStreamGemWorkerTests, givenExecStorageResizedWhenFlushedThenAllExecObjectsAreRefilled) {
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+    const uint64_t marker = 0xABCD;
+
+    auto allocation = mm->allocateGraphicsMemory(1024, 4096);
+    auto commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    LinearStream cs(commandBuffer);
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, false, false, QueueThrottle::MEDIUM, cs.getUsed(), &cs};
+
+    csr->makeResident(*allocation);
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    markExecObjects(mock->execBuffer, marker);
+    csr->makeSurfacePackNonResident(nullptr);
+
+    tCsr->getExecStorage().resize(0);
+    csr->makeResident(*allocation);
+    csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+    auto execObjects = captureExecObjects(mock->execBuffer);
+    ASSERT_EQ(2u, execObjects.size());
+    EXPECT_EQ(0u, execObjects[0].rsvd2);
+    EXPECT_EQ(static_cast<uint32_t>(allocation->getBO()->peekHandle()), execObjects[0].handle);
+    EXPECT_EQ(0u, execObjects[1].rsvd2);
+
+    mm->freeGraphicsMemory(allocation);
+    mm->freeGraphicsMemory(commandBuffer);
+}
+
+TEST_F(DrmCommandStreamGemWorkerTests, givenThousandResidentBosWhenFlushedRepeatedlyThenExecObjectsMatchFirstFlush) {
+    tCsr->overrideGemCloseWorkerOperationMode(gemCloseWorkerMode::gemCloseWorkerInactive);
+
+    std::vector<DrmAllocation *> allocations;
+    for (auto i = 0; i < 1000; i++) {
+        allocations.push_back(mm->allocateGraphicsMemory(1, 4096));
+    }
+    auto commandBuffer = mm->allocateGraphicsMemory(1024, 4096);
+    LinearStream cs(commandBuffer);
+    csr->addBatchBufferEnd(cs, nullptr);
+    csr->alignToCacheLine(cs);
+    BatchBuffer batchBuffer{cs.getGraphicsAllocation(), 0, false, false, QueueThrottle::MEDIUM, cs.getUsed(), &cs};
+
+    std::vector<drm_i915_gem_exec_object2> firstExecObjects;
+    for (auto flushId = 0; flushId < 10; flushId++) {
+        for (auto allocation : allocations) {
+            csr->makeResident(*allocation);
+        }
+        csr->flush(batchBuffer, EngineType::ENGINE_RCS, nullptr);
+        csr->makeSurfacePackNonResident(nullptr);
+
+        auto execObjects = captureExecObjects(mock->execBuffer);
+        ASSERT_EQ(1001u, execObjects.size());
+        if (flushId == 0) {
+            firstExecObjects = execObjects;
+        }
+        EXPECT_EQ(0, memcmp(firstExecObjects.data(), execObjects.data(), execObjects.size() * sizeof(drm_i915_gem_exec_object2)));
+    }
+
+    for (auto allocation : allocations) {
+        mm->freeGraphicsMemory(allocation);
+    }
+    mm->freeGraphicsMemory(commandBuffer);
+}
+
 TEST_F(DrmCommandStreamGemWorkerTests, givenDrmCsrCreatedWithInactiveGemCloseWorkerPolicyThenThreadIsNotCreated) {
     TestedDrmCommandStreamReceiver<DEFAULT_TEST_FAMILY_NAME> testedCsr(mock, gemCloseWorkerMode::gemCloseWorkerInactive);
     EXPECT_EQ(gemCloseWorkerMode::gemCloseWorkerInactive, testedCsr.peekGemCloseWorkerOperationMode());
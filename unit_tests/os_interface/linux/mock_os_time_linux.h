@@ -27,6 +27,9 @@
 namespace OCLRT {
 class MockOSTimeLinux : public OSTimeLinux {
   public:
+    using OSTimeLinux::calibration;
+    using OSTimeLinux::calibrationIntervalNs;
+
     MockOSTimeLinux(OSInterface *osInterface) : OSTimeLinux(osInterface){};
     void setResolutionFunc(resolutionFunc_t func) {
         this->resolutionFunc = func;
@@ -22,6 +22,7 @@
 
 #include "unit_tests/os_interface/linux/device_command_stream_fixture.h"
 #include "unit_tests/os_interface/linux/mock_os_time_linux.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "runtime/os_interface/linux/drm_neo.h"
 #include "test.h"
 #include "gtest/gtest.h"
@@ -229,3 +230,177 @@ TEST_F(DrmTimeTest, givenAlwaysPassingResolutionFuncWhenGetCpuRawTimestampIsCall
     auto retVal = osTime->getCpuRawTimestamp();
     EXPECT_EQ(1ull, retVal);
 }
+
+static uint64_t calibrationCpuTimeNs = 0;
+
+int getTimeFuncCalibration(clockid_t clkId, struct timespec *tp) throw() {
+    tp->tv_sec = calibrationCpuTimeNs / NSEC_PER_SEC;
+    tp->tv_nsec = calibrationCpuTimeNs % NSEC_PER_SEC;
+    return 0;
+}
+
+class DrmMockTimeCalibration : public DrmMockSuccess {
+  public:
+    int ioctl(unsigned long request, void *arg) override {
+        if (request == DRM_IOCTL_I915_REG_READ) {
+            regReadCount++;
+            auto reg = reinterpret_cast<drm_i915_reg_read *>(arg);
+            reg->val = getGpuTicks(calibrationCpuTimeNs);
+            calibrationCpuTimeNs += readLatencyNs;
+        }
+        return 0;
+    }
+
+    uint64_t getGpuTicks(uint64_t cpuTimeNs) const {
+        return gpuTicksOffset + static_cast<uint64_t>(cpuTimeNs / nsPerTick);
+    }
+
+    double nsPerTick = 80.0;
+    uint64_t gpuTicksOffset = 1000;
+    uint64_t readLatencyNs = 0;
+    int regReadCount = 0;
+};
+
+struct DrmTimeCalibrationTest : public DrmTimeTest {
+    void SetUp() override {
+        DrmTimeTest::SetUp();
+        calibrationCpuTimeNs = 0;
+        osTime->setGetTimeFunc(getTimeFuncCalibration);
+        drm.reset(new DrmMockTimeCalibration());
+        osTime->updateDrm(drm.get());
+        drm->regReadCount = 0;
+    }
+
+    uint64_t query() {
+        TimeStampData cpuGpuTime = {0, 0};
+        EXPECT_TRUE(osTime->getCpuGpuTime(&cpuGpuTime));
+        EXPECT_EQ(calibrationCpuTimeNs, cpuGpuTime.CPUTimeinNS);
+        return cpuGpuTime.GPUTimeStamp;
+    }
+
+    void calibrate() {
+        query();
+        calibrationCpuTimeNs += OSTimeLinux::minCalibrationWindowNs;
+        query();
+        ASSERT_TRUE(osTime->calibration.valid);
+    }
+
+    std::unique_ptr<DrmMockTimeCalibration> drm;
+};
+
+TEST_F(DrmTimeCalibrationTest, givenCalibrationWindowNotReachedWhenCpuGpuTimeIsQueriedThenTimestampRegisterIsReadEveryTime) {
+    for (int i = 0; i < 10; i++) {
+        calibrationCpuTimeNs += OSTimeLinux::minCalibrationWindowNs / 20;
+        EXPECT_EQ(drm->getGpuTicks(calibrationCpuTimeNs), query());
+    }
+    EXPECT_EQ(10, drm->regReadCount);
+    EXPECT_FALSE(osTime->calibration.valid);
+}
+
+TEST_F(DrmTimeCalibrationTest, givenCalibratedModelWhenCpuGpuTimeIsQueriedWithinIntervalThenGpuTimeIsExtrapolatedWithoutRegisterReads) {
+    calibrate();
+    EXPECT_EQ(2, drm->regReadCount);
+
+    const int numQueries = 1000;
+    const uint64_t step = osTime->calibrationIntervalNs / (numQueries + 1);
+    for (int i = 0; i < numQueries; i++) {
+        calibrationCpuTimeNs += step;
+        auto expected = drm->getGpuTicks(calibrationCpuTimeNs);
+        auto gpuTime = query();
+        EXPECT_LE(gpuTime, expected + 1);
+        EXPECT_GE(gpuTime + 1, expected);
+    }
+    EXPECT_EQ(2, drm->regReadCount);
+}
+
+TEST_F(DrmTimeCalibrationTest, givenCalibrationIntervalElapsedWhenCpuGpuTimeIsQueriedThenSingleRegisterReadRefreshesModel) {
+    calibrate();
+    calibrationCpuTimeNs += osTime->calibrationIntervalNs;
+    EXPECT_EQ(drm->getGpuTicks(calibrationCpuTimeNs), query());
+    EXPECT_EQ(3, drm->regReadCount);
+    EXPECT_TRUE(osTime->calibration.valid);
+    EXPECT_EQ(calibrationCpuTimeNs, osTime->calibration.lastSample.CPUTimeinNS);
+
+    calibrationCpuTimeNs += osTime->calibrationIntervalNs / 2;
+    query();
+    EXPECT_EQ(3, drm->regReadCount);
+}
+
+TEST_F(DrmTimeCalibrationTest, givenGpuClockDriftBeyondErrorBoundWhenModelIsRecalibratedThenFitIsRestarted) {
+    calibrate();
+    drm->gpuTicksOffset += 1000;
+    calibrationCpuTimeNs += osTime->calibrationIntervalNs;
+    EXPECT_EQ(drm->getGpuTicks(calibrationCpuTimeNs), query());
+    EXPECT_FALSE(osTime->calibration.valid);
+    EXPECT_EQ(calibrationCpuTimeNs, osTime->calibration.anchor.CPUTimeinNS);
+
+    calibrationCpuTimeNs += OSTimeLinux::minCalibrationWindowNs / 2;
+    EXPECT_EQ(drm->getGpuTicks(calibrationCpuTimeNs), query());
+    EXPECT_EQ(4, drm->regReadCount);
+
+    calibrationCpuTimeNs += OSTimeLinux::minCalibrationWindowNs;
+    query();
+    EXPECT_TRUE(osTime->calibration.valid);
+    EXPECT_EQ(5, drm->regReadCount);
+}
+
+TEST_F(DrmTimeCalibrationTest, givenGpuClockDriftWithinErrorBoundWhenModelIsRecalibratedThenFitIsKept) {
+    calibrate();
+    auto anchor = osTime->calibration.anchor;
+    drm->nsPerTick = 80.001;
+    calibrationCpuTimeNs += osTime->calibrationIntervalNs;
+    query();
+    EXPECT_TRUE(osTime->calibration.valid);
+    EXPECT_EQ(anchor.CPUTimeinNS, osTime->calibration.anchor.CPUTimeinNS);
+}
+
+TEST_F(DrmTimeCalibrationTest, givenSlowRegisterReadWhenDriftIsWithinLatencyDerivedBoundThenFitIsKept) {
+    calibrate();
+    auto anchor = osTime->calibration.anchor;
+    drm->readLatencyNs = 10000;
+    drm->gpuTicksOffset += 500;
+    calibrationCpuTimeNs += osTime->calibrationIntervalNs;
+    query();
+    EXPECT_TRUE(osTime->calibration.valid);
+    EXPECT_EQ(anchor.CPUTimeinNS, osTime->calibration.anchor.CPUTimeinNS);
+    EXPECT_EQ(drm->readLatencyNs, osTime->calibration.lastSampleReadLatencyNs);
+}
+
+TEST_F(DrmTimeCalibrationTest, givenModelAheadOfGpuClockWhenModelIsRefreshedThenReturnedGpuTimeNeverDecreases) {
+    calibrate();
+    auto lastGpuTime = query();
+    auto regReadsBefore = drm->regReadCount;
+
+    // GPU clock turns out slower than the fitted model
+    drm->nsPerTick = 80.1;
+    const uint64_t step = osTime->calibrationIntervalNs / 4;
+    for (int i = 0; i < 12; i++) {
+        calibrationCpuTimeNs += step;
+        auto gpuTime = query();
+        EXPECT_GE(gpuTime, lastGpuTime);
+        lastGpuTime = gpuTime;
+    }
+    EXPECT_LT(regReadsBefore, drm->regReadCount);
+
+    // once the real clock passes the last returned value, it is reported as is
+    calibrationCpuTimeNs += 100 * osTime->calibrationIntervalNs;
+    EXPECT_EQ(drm->getGpuTicks(calibrationCpuTimeNs), query());
+}
+
+TEST_F(DrmTimeCalibrationTest, givenZeroCalibrationIntervalWhenCpuGpuTimeIsQueriedThenTimestampRegisterIsReadEveryTime) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.GpuTimeCalibrationIntervalUs.set(0);
+    auto osTimeNoCalibration = MockOSTimeLinux::create(osInterface.get());
+    EXPECT_EQ(0u, osTimeNoCalibration->calibrationIntervalNs);
+    osTimeNoCalibration->setGetTimeFunc(getTimeFuncCalibration);
+    osTimeNoCalibration->updateDrm(drm.get());
+    drm->regReadCount = 0;
+
+    for (int i = 0; i < 10; i++) {
+        calibrationCpuTimeNs += OSTimeLinux::minCalibrationWindowNs;
+        TimeStampData cpuGpuTime = {0, 0};
+        EXPECT_TRUE(osTimeNoCalibration->getCpuGpuTime(&cpuGpuTime));
+        EXPECT_EQ(drm->getGpuTicks(calibrationCpuTimeNs), cpuGpuTime.GPUTimeStamp);
+    }
+    EXPECT_EQ(10, drm->regReadCount);
+}
@@ -26,10 +26,12 @@
 #include "runtime/os_interface/linux/os_library.h"
 #endif
 #include "runtime/os_interface/os_library.h"
+#include "runtime/helpers/file_io.h"
 #include "test.h"
 #include "unit_tests/helpers/memory_management.h"
 #include "unit_tests/fixtures/memory_management_fixture.h"
 #include "gtest/gtest.h"
+#include <cstdio>
 #include <memory>
 
 namespace Os {
@@ -88,6 +90,23 @@ TEST_F(OSLibraryTest, whenSymbolNameIsInvalidThenGetProcAddressReturnsNullPointe
     EXPECT_EQ(nullptr, ptr);
 }
 
+TEST_F(OSLibraryTest, whenLibraryFileIsNotFoundThenFileStampIsEmpty) {
+    EXPECT_TRUE(OsLibrary::getFileStamp(fakeLibName).empty());
+}
+
+TEST_F(OSLibraryTest, whenLibraryFileIsRewrittenWithDifferentSizeThenFileStampChanges) {
+    const char *fileName = "./file_stamp_test.bin";
+    char data[64] = {};
+    writeDataToFile(fileName, data, 32);
+    auto firstStamp = OsLibrary::getFileStamp(fileName);
+    EXPECT_FALSE(firstStamp.empty());
+    EXPECT_EQ(firstStamp, OsLibrary::getFileStamp(fileName));
+
+    writeDataToFile(fileName, data, sizeof(data));
+    EXPECT_NE(firstStamp, OsLibrary::getFileStamp(fileName));
+    std::remove(fileName);
+}
+
 TEST_F(OSLibraryTest, testFailNew) {
     InjectedFunction method = [](size_t failureIndex) {
         std::string libName(Os::testDllName);
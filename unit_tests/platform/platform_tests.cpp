@@ -22,10 +22,12 @@
 
 #include "runtime/helpers/options.h"
 #include "runtime/device/device.h"
+#include "runtime/os_interface/debug_settings_manager.h"
 #include "runtime/platform/extensions.h"
 #include "runtime/sharings/sharing_factory.h"
 #include "unit_tests/fixtures/memory_management_fixture.h"
 #include "unit_tests/fixtures/platform_fixture.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
 #include "unit_tests/mocks/mock_async_event_handler.h"
 #include "unit_tests/mocks/mock_csr.h"
 #include "gtest/gtest.h"
@@ -153,6 +155,53 @@ TEST_F(PlatformFailingTest, givenPlatformInitializationWhenIncorrectHwInfoThenIn
     delete platform;
 }
 
+TEST_F(PlatformTest, givenMultipleDevicesWhenPlatformIsInitializedConcurrentlyThenDevicesAreOrderedByOrdinal) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.DeviceInitThreads.set(3);
+
+    HardwareInfo hwInfos[] = {*platformDevices[0], *platformDevices[0], *platformDevices[0]};
+    const HardwareInfo *hwInfoPtrs[] = {&hwInfos[0], &hwInfos[1], &hwInfos[2]};
+    const size_t numDevices = sizeof(hwInfoPtrs) / sizeof(hwInfoPtrs[0]);
+
+    Platform *platform = new Platform;
+    EXPECT_TRUE(platform->initialize(numDevices, hwInfoPtrs));
+    ASSERT_EQ(numDevices, platform->getNumDevices());
+
+    auto &caps = platform->getDevice(0)->getDeviceInfo();
+    for (size_t i = 0; i < numDevices; i++) {
+        auto device = platform->getDevice(i);
+        ASSERT_NE(nullptr, device);
+        EXPECT_EQ(&hwInfos[i], &device->getHardwareInfo());
+        EXPECT_STREQ(platform->getPlatformInfo().extensions.c_str(), device->getDeviceInfo().deviceExtensions);
+        EXPECT_EQ(caps.maxComputUnits, device->getDeviceInfo().maxComputUnits);
+        EXPECT_EQ(caps.globalMemSize, device->getDeviceInfo().globalMemSize);
+    }
+    delete platform;
+}
+
+TEST_F(PlatformTest, givenFailingDeviceWhenPlatformIsInitializedConcurrentlyThenCreatedDevicesAreReleasedAndInitializationCanBeRetried) {
+    DebugManagerStateRestore dbgRestore;
+    DebugManager.flags.DeviceInitThreads.set(3);
+
+    PLATFORM unknownPlatform = *platformDevices[0]->pPlatform;
+    unknownPlatform.eRenderCoreFamily = IGFX_UNKNOWN_CORE;
+
+    HardwareInfo hwInfos[] = {*platformDevices[0], *platformDevices[0], *platformDevices[0]};
+    hwInfos[1].pPlatform = &unknownPlatform;
+    const HardwareInfo *hwInfoPtrs[] = {&hwInfos[0], &hwInfos[1], &hwInfos[2]};
+    const size_t numDevices = sizeof(hwInfoPtrs) / sizeof(hwInfoPtrs[0]);
+
+    Platform *platform = new Platform;
+    EXPECT_FALSE(platform->initialize(numDevices, hwInfoPtrs));
+    EXPECT_FALSE(platform->isInitialized());
+    EXPECT_EQ(0u, platform->getNumDevices());
+    EXPECT_EQ(nullptr, platform->getDevice(0));
+
+    EXPECT_TRUE(platform->initialize(numPlatformDevices, platformDevices));
+    EXPECT_EQ(numPlatformDevices, platform->getNumDevices());
+    delete platform;
+}
+
 TEST_F(PlatformTest, getAsCompilerEnabledExtensionsString) {
     const HardwareInfo *hwInfo;
     hwInfo = platformDevices[0];
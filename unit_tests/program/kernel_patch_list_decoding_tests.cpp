@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/kernel/kernel_template.h"
+#include "unit_tests/helpers/debug_manager_state_restore.h"
+#include "unit_tests/mocks/mock_program.h"
+#include "unit_tests/program/program_from_binary.h"
+#include "test.h"
+
+#include <sstream>
+#include <thread>
+
+using namespace OCLRT;
+
+class KernelPatchListDecodingTest : public ProgramFromBinarySimpleTest,
+                                    public ::testing::Test {
+  public:
+    void SetUp() override {
+        ProgramFromBinarySimpleTest::SetUp();
+    }
+    void TearDown() override {
+        ProgramFromBinarySimpleTest::TearDown();
+    }
+
+    MockProgram *buildProgram(PatchListDecoding decodingMode) {
+        DebugManager.flags.KernelPatchListDecoding.set(static_cast<int32_t>(decodingMode));
+        cl_device_id device = pDevice;
+        CreateProgramFromBinary<MockProgram>(pContext, &device, "simple_kernels");
+        EXPECT_NE(nullptr, pProgram);
+        retVal = pProgram->build(1, &device, nullptr, nullptr, nullptr, false);
+        EXPECT_EQ(CL_SUCCESS, retVal);
+        return static_cast<MockProgram *>(pProgram);
+    }
+
+    static std::string describe(const KernelInfo &kernelInfo) {
+        std::stringstream description;
+        description << kernelInfo.name << " valid:" << kernelInfo.isValid
+                    << " simd:" << kernelInfo.getMaxSimdSize()
+                    << " ssh:" << kernelInfo.usesSsh
+                    << " blobSize:" << kernelInfo.heapInfo.blobSize
+                    << " patchesToArgs:" << kernelInfo.argumentsToPatchNum;
+        for (auto &argInfo : kernelInfo.kernelArgInfo) {
+            description << " arg:" << argInfo.name << "," << argInfo.typeStr << "," << argInfo.accessQualifier << ","
+                        << argInfo.addressQualifier << "," << argInfo.offsetHeap << "," << argInfo.isBuffer;
+            for (auto &patchInfo : argInfo.kernelArgPatchInfoVector) {
+                description << "," << patchInfo.crossthreadOffset << ":" << patchInfo.size << ":" << patchInfo.sourceOffset;
+            }
+        }
+        for (auto offset : kernelInfo.workloadInfo.globalWorkSizeOffsets) {
+            description << " gws:" << offset;
+        }
+        for (auto offset : kernelInfo.workloadInfo.localWorkSizeOffsets) {
+            description << " lws:" << offset;
+        }
+        if (kernelInfo.patchInfo.dataParameterStream) {
+            auto crossThreadDataSize = kernelInfo.patchInfo.dataParameterStream->DataParameterStreamSize;
+            description << " crossThreadData:" << crossThreadDataSize;
+            for (uint32_t i = 0; i < crossThreadDataSize; i++) {
+                description << "," << static_cast<uint32_t>(static_cast<uint8_t>(kernelInfo.crossThreadData[i]));
+            }
+        }
+        description << " template:" << (kernelInfo.kernelTemplate ? kernelInfo.kernelTemplate->argTypes.size() : 0u);
+        return description.str();
+    }
+
+    std::vector<std::string> describeKernels() {
+        std::vector<std::string> descriptions;
+        for (size_t ordinal = 0; ordinal < pProgram->getNumKernels(); ordinal++) {
+            auto kernelInfo = pProgram->getKernelInfo(ordinal);
+            EXPECT_NE(nullptr, kernelInfo);
+            descriptions.push_back(kernelInfo ? describe(*kernelInfo) : std::string());
+        }
+        return descriptions;
+    }
+
+    DebugManagerStateRestore dbgRestore;
+};
+
+TEST_F(KernelPatchListDecodingTest, givenLazyDecodingWhenProgramIsBuiltThenPatchListsAreDecodedOnFirstLookup) {
+    auto program = buildProgram(PatchListDecoding::Lazy);
+    auto &kernelInfos = program->getKernelInfoArray();
+    ASSERT_EQ(3u, kernelInfos.size());
+    for (auto kernelInfo : kernelInfos) {
+        EXPECT_FALSE(kernelInfo->patchListDecoded);
+        EXPECT_EQ(nullptr, kernelInfo->kernelTemplate);
+        EXPECT_FALSE(kernelInfo->name.empty());
+    }
+
+    auto kernelInfo = program->getKernelInfo("simple_kernel_1");
+    ASSERT_NE(nullptr, kernelInfo);
+    EXPECT_TRUE(kernelInfo->patchListDecoded);
+    EXPECT_NE(nullptr, kernelInfo->kernelTemplate);
+    EXPECT_TRUE(kernelInfo->isValid);
+
+    EXPECT_FALSE(kernelInfos[0]->patchListDecoded);
+    EXPECT_FALSE(kernelInfos[2]->patchListDecoded);
+}
+
+TEST_F(KernelPatchListDecodingTest, givenEagerDecodingModesWhenProgramIsBuiltThenAllPatchListsAreDecoded) {
+    for (auto decodingMode : {PatchListDecoding::Eager, PatchListDecoding::EagerParallel}) {
+        auto program = buildProgram(decodingMode);
+        for (auto kernelInfo : program->getKernelInfoArray()) {
+            EXPECT_TRUE(kernelInfo->patchListDecoded);
+            EXPECT_NE(nullptr, kernelInfo->kernelTemplate);
+        }
+    }
+}
+
+TEST_F(KernelPatchListDecodingTest, givenDifferentDecodingModesWhenKernelInfosAreLookedUpThenContentsAreIdentical) {
+    buildProgram(PatchListDecoding::Eager);
+    auto eagerDescriptions = describeKernels();
+    ASSERT_EQ(3u, eagerDescriptions.size());
+
+    buildProgram(PatchListDecoding::EagerParallel);
+    EXPECT_EQ(eagerDescriptions, describeKernels());
+
+    buildProgram(PatchListDecoding::Lazy);
+    EXPECT_EQ(eagerDescriptions, describeKernels());
+}
+
+TEST_F(KernelPatchListDecodingTest, givenLazyDecodingWhenKernelIsLookedUpConcurrentlyThenItIsDecodedOnce) {
+    auto program = buildProgram(PatchListDecoding::Lazy);
+
+    const size_t numThreads = 8;
+    std::vector<const KernelInfo *> lookedUpInfos(numThreads, nullptr);
+    std::vector<const KernelTemplate *> templates(numThreads, nullptr);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numThreads; i++) {
+        threads.emplace_back([&, i]() {
+            lookedUpInfos[i] = program->getKernelInfo(i % 2 ? "simple_kernel_0" : "simple_kernel_2");
+            templates[i] = lookedUpInfos[i] ? lookedUpInfos[i]->kernelTemplate : nullptr;
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < numThreads; i++) {
+        ASSERT_NE(nullptr, lookedUpInfos[i]);
+        EXPECT_EQ(lookedUpInfos[i % 2], lookedUpInfos[i]);
+        EXPECT_EQ(templates[i % 2], templates[i]);
+        EXPECT_NE(nullptr, templates[i]);
+    }
+    EXPECT_NE(lookedUpInfos[0], lookedUpInfos[1]);
+}
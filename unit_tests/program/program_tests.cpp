@@ -93,6 +93,28 @@ TEST_P(ProgramFromBinaryTest, BuildProgram) {
     EXPECT_EQ(CL_SUCCESS, retVal);
 }
 
+TEST_P(ProgramFromBinaryTest, givenBuiltProgramWhenKernelInfoIsQueriedByNameThenMatchingKernelInfoIsReturned) {
+    cl_device_id device = pDevice;
+    ASSERT_NE(nullptr, pProgram);
+    retVal = pProgram->build(
+        1,
+        &device,
+        nullptr,
+        nullptr,
+        nullptr,
+        false);
+    ASSERT_EQ(CL_SUCCESS, retVal);
+    ASSERT_NE(0u, pProgram->getNumKernels());
+
+    for (size_t ordinal = 0; ordinal < pProgram->getNumKernels(); ++ordinal) {
+        auto pKernelInfo = pProgram->getKernelInfo(ordinal);
+        EXPECT_EQ(pKernelInfo, pProgram->getKernelInfo(pKernelInfo->name.c_str()));
+    }
+    EXPECT_EQ(nullptr, pProgram->getKernelInfo("kernel_not_existing"));
+    EXPECT_EQ(nullptr, pProgram->getKernelInfo(""));
+    EXPECT_EQ(nullptr, pProgram->getKernelInfo(nullptr));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Program::getInfo( context )
 ////////////////////////////////////////////////////////////////////////////////
@@ -2877,6 +2899,40 @@ TEST_F(ProgramTests, givenSeparateBlockKernelsWhenParentKernelWithChildKernelThe
     EXPECT_EQ(0, strcmp("parent_kernel_dispatch_0", program.getBlockKernelManager()->getBlockKernelInfo(0)->name.c_str()));
 }
 
+TEST_F(ProgramTests, givenSeparatedChildKernelWhenKernelInfoIsQueriedByNameThenOnlyParentKernelIsFound) {
+    MockProgram program(pContext);
+
+    auto pParentKernelInfo = KernelInfo::create();
+    pParentKernelInfo->name = "parent_kernel";
+    program.getKernelInfoArray().push_back(pParentKernelInfo);
+    program.getParentKernelInfoArray().push_back(pParentKernelInfo);
+
+    auto pChildKernelInfo = KernelInfo::create();
+    pChildKernelInfo->name = "parent_kernel_dispatch_0";
+    program.getKernelInfoArray().push_back(pChildKernelInfo);
+
+    program.separateBlockKernels();
+
+    EXPECT_EQ(pParentKernelInfo, program.getKernelInfo("parent_kernel"));
+    EXPECT_EQ(nullptr, program.getKernelInfo("parent_kernel_dispatch_0"));
+    EXPECT_EQ(nullptr, program.getKernelInfo("parent_kernel_dispatch"));
+}
+
+TEST_F(ProgramTests, givenKernelInfosWithSameNameWhenKernelInfoIsQueriedByNameThenFirstOneIsReturned) {
+    MockProgram program(pContext);
+
+    auto pFirstKernelInfo = KernelInfo::create();
+    pFirstKernelInfo->name = "kernel";
+    program.addKernelInfo(pFirstKernelInfo);
+
+    auto pSecondKernelInfo = KernelInfo::create();
+    pSecondKernelInfo->name = "kernel";
+    program.addKernelInfo(pSecondKernelInfo);
+
+    EXPECT_EQ(pFirstKernelInfo, program.getKernelInfo("kernel"));
+    EXPECT_EQ(nullptr, program.getKernelInfo("kernel2"));
+}
+
 TEST_F(ProgramTests, givenSeparateBlockKernelsWhenSubgroupKernelWithChildKernelThenSeparateChildKernel) {
     MockProgram program(pContext);
 
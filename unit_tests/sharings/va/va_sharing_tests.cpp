@@ -28,6 +28,7 @@
 #include "unit_tests/sharings/va/mock_va_sharing.h"
 #include "unit_tests/fixtures/platform_fixture.h"
 #include "runtime/sharings/va/va_surface.h"
+#include "runtime/sharings/va/va_surface_cache.h"
 #include "runtime/api/api.h"
 #include "gtest/gtest.h"
 
@@ -425,3 +426,135 @@ TEST_F(VaSharingTests, givenInValidPlatformWhenGetDeviceIdsFromVaApiMediaAdapter
     EXPECT_EQ(0u, numDevices);
     EXPECT_EQ(0u, devices);
 }
+
+TEST_F(VaSharingTests, givenVaSurfaceWhenImagesAreCreatedAndReleasedInTurnThenSurfaceIsImportedOnce) {
+    const int numCycles = 16;
+    GraphicsAllocation *firstAllocation = nullptr;
+
+    for (int i = 0; i < numCycles; i++) {
+        createMediaSurface();
+        if (i == 0) {
+            firstAllocation = sharedImg->getGraphicsAllocation();
+        }
+        EXPECT_EQ(firstAllocation, sharedImg->getGraphicsAllocation());
+        EXPECT_NE(nullptr, sharedImg->getGraphicsAllocation()->gmm);
+
+        // no image of the surface is alive between iterations
+        errCode = clReleaseMemObject(sharedClMem);
+        EXPECT_EQ(CL_SUCCESS, errCode);
+        sharedImg = nullptr;
+        EXPECT_EQ(1u, vaSharing->m_sharingFunctions.getSurfaceCache().size());
+    }
+
+    EXPECT_EQ(1, vaDeriveImageCalled);
+    EXPECT_EQ(1, vaDestroyImageCalled);
+    EXPECT_EQ(numCycles, vaExtGetSurfaceHandleCalled);
+}
+
+TEST_F(VaSharingTests, givenImagesOfVaSurfaceCreatedWhileOneIsAliveWhenSharedHandleIsUnchangedThenSurfaceIsImportedOnce) {
+    createMediaSurface();
+    auto firstImage = sharedImg;
+    createMediaSurface();
+
+    EXPECT_EQ(firstImage->getGraphicsAllocation(), sharedImg->getGraphicsAllocation());
+    EXPECT_EQ(1, vaDeriveImageCalled);
+    EXPECT_EQ(1u, vaSharing->m_sharingFunctions.getSurfaceCache().size());
+
+    delete firstImage;
+}
+
+TEST_F(VaSharingTests, givenCachedVaSurfaceWhenSecondImageIsCreatedThenImageParamsMatchFirstImport) {
+    createMediaSurface(1u);
+    auto firstImage = sharedImg;
+    auto imgDesc = firstImage->getImageDesc();
+    auto rowPitch = firstImage->getHostPtrRowPitch();
+
+    createMediaSurface(1u);
+    EXPECT_EQ(1, vaDeriveImageCalled);
+    EXPECT_EQ(imgDesc.image_width, sharedImg->getImageDesc().image_width);
+    EXPECT_EQ(imgDesc.image_height, sharedImg->getImageDesc().image_height);
+    EXPECT_EQ(imgDesc.image_row_pitch, sharedImg->getImageDesc().image_row_pitch);
+    EXPECT_EQ(rowPitch, sharedImg->getHostPtrRowPitch());
+    EXPECT_EQ(1u, sharedImg->getMediaPlaneType());
+
+    delete firstImage;
+}
+
+TEST_F(VaSharingTests, givenDifferentPlanesOfVaSurfaceWhenCreatedThenEachPlaneIsImportedSeparately) {
+    createMediaSurface(0u);
+    auto yPlane = sharedImg;
+    createMediaSurface(1u);
+    auto uvPlane = sharedImg;
+
+    EXPECT_NE(yPlane->getGraphicsAllocation(), uvPlane->getGraphicsAllocation());
+    EXPECT_EQ(2, vaDeriveImageCalled);
+    EXPECT_EQ(2u, vaSharing->m_sharingFunctions.getSurfaceCache().size());
+
+    delete yPlane;
+}
+
+TEST_F(VaSharingTests, givenVaSurfaceWithChangedSharedHandleWhenRecreatedThenSurfaceIsImportedAgain) {
+    createMediaSurface();
+    auto firstImage = sharedImg;
+    auto firstAllocation = firstImage->getGraphicsAllocation();
+
+    updateAcquiredHandle(sharingHandle + 1);
+    createMediaSurface();
+
+    EXPECT_EQ(2, vaDeriveImageCalled);
+    EXPECT_NE(firstAllocation, sharedImg->getGraphicsAllocation());
+    EXPECT_EQ(sharingHandle, sharedImg->getGraphicsAllocation()->peekSharedHandle());
+    EXPECT_EQ(1u, vaSharing->m_sharingFunctions.getSurfaceCache().size());
+
+    // stale import stays alive for the image still using it
+    EXPECT_EQ(firstAllocation, firstImage->getGraphicsAllocation());
+    delete firstImage;
+
+    EXPECT_EQ(1u, vaSharing->m_sharingFunctions.getSurfaceCache().size());
+}
+
+namespace {
+std::shared_ptr<VASurfaceImport> createCachedImport(VASurfaceID surfaceId, unsigned int sharedHandle) {
+    std::shared_ptr<VASurfaceImport> surfaceImport(new VASurfaceImport);
+    surfaceImport->surfaceId = surfaceId;
+    surfaceImport->sharedHandle = sharedHandle;
+    return surfaceImport;
+}
+} // namespace
+
+TEST(VaSurfaceCacheTest, givenFullCacheWhenImportIsInsertedThenLeastRecentlyUsedEntryIsEvicted) {
+    VASurfaceCache surfaceCache(2);
+    surfaceCache.insert(createCachedImport(1, 1));
+    surfaceCache.insert(createCachedImport(2, 2));
+    EXPECT_NE(nullptr, surfaceCache.find(1, 0, 1, nullptr));
+
+    surfaceCache.insert(createCachedImport(3, 3));
+    EXPECT_EQ(2u, surfaceCache.size());
+    EXPECT_NE(nullptr, surfaceCache.find(1, 0, 1, nullptr));
+    EXPECT_EQ(nullptr, surfaceCache.find(2, 0, 2, nullptr));
+    EXPECT_NE(nullptr, surfaceCache.find(3, 0, 3, nullptr));
+}
+
+TEST(VaSurfaceCacheTest, givenCachedImportWhenSharedHandleChangesThenEntryIsDropped) {
+    VASurfaceCache surfaceCache;
+    auto surfaceImport = createCachedImport(1, 1);
+    surfaceCache.insert(surfaceImport);
+    EXPECT_EQ(2, surfaceImport.use_count());
+
+    EXPECT_EQ(nullptr, surfaceCache.find(1, 0, 2, nullptr));
+    EXPECT_EQ(0u, surfaceCache.size());
+    EXPECT_EQ(1, surfaceImport.use_count());
+}
+
+TEST_F(VaSharingTests, givenTwoImagesOfSameVaSurfaceWhenOneIsReleasedThenSharedAllocationStaysValid) {
+    createMediaSurface();
+    auto firstImage = sharedImg;
+    createMediaSurface();
+
+    EXPECT_EQ(firstImage->getGraphicsAllocation(), sharedImg->getGraphicsAllocation());
+    EXPECT_TRUE(firstImage->peekSharingHandler()->retainsGraphicsAllocation());
+    delete firstImage;
+
+    EXPECT_NE(nullptr, sharedImg->getGraphicsAllocation()->gmm);
+    EXPECT_EQ(1, vaDeriveImageCalled);
+}
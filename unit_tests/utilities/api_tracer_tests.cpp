@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/api_trace_decoder.h"
+#include "runtime/utilities/api_tracer.h"
+#include "gtest/gtest.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+using namespace OCLRT;
+
+namespace {
+ApiTrace::Record createRecord(uint64_t startNs, uint32_t apiId = 0) {
+    ApiTrace::Record record = {};
+    record.startNs = startNs;
+    record.apiId = apiId;
+    return record;
+}
+
+struct ApiTracerTest : public ::testing::Test {
+    void SetUp() override {
+        traceStream = new std::stringstream;
+        tracer.reset(new ApiTracer(std::unique_ptr<std::ostream>(traceStream), 64));
+    }
+
+    bool decode() {
+        std::stringstream input(traceStream->str());
+        return decoder.load(input);
+    }
+
+    std::stringstream *traceStream = nullptr;
+    std::unique_ptr<ApiTracer> tracer;
+    ApiTraceDecoder decoder;
+};
+} // namespace
+
+TEST(ApiTraceRing, givenCapacityWhichIsNotPowerOfTwoWhenRingIsCreatedThenItIsRoundedUp) {
+    ApiTraceRing ring(0, 5);
+    EXPECT_EQ(8u, ring.getCapacity());
+}
+
+TEST(ApiTraceRing, givenRingDrainedRepeatedlyWhenIndicesWrapAroundThenRecordsKeepTheirOrder) {
+    ApiTraceRing ring(0, 4);
+    std::vector<ApiTrace::Record> drained;
+    uint64_t nextExpected = 0;
+    uint64_t nextPushed = 0;
+
+    for (int cycle = 0; cycle < 100; cycle++) {
+        // push a number of records that is not aligned to the capacity to move the wrap point
+        for (int i = 0; i < 3; i++) {
+            EXPECT_TRUE(ring.push(createRecord(nextPushed++)));
+        }
+        drained.clear();
+        EXPECT_EQ(3u, ring.drain(drained));
+        for (auto &record : drained) {
+            EXPECT_EQ(nextExpected++, record.startNs);
+        }
+    }
+    EXPECT_EQ(0u, ring.peekDroppedCount());
+}
+
+TEST(ApiTraceRing, givenFullRingWhenRecordIsPushedThenItIsDroppedAndCounted) {
+    ApiTraceRing ring(0, 4);
+    for (uint64_t i = 0; i < 4; i++) {
+        EXPECT_TRUE(ring.push(createRecord(i)));
+    }
+    EXPECT_FALSE(ring.push(createRecord(4)));
+    EXPECT_EQ(1u, ring.peekDroppedCount());
+
+    std::vector<ApiTrace::Record> drained;
+    EXPECT_EQ(4u, ring.drain(drained));
+    EXPECT_EQ(3u, drained.back().startNs);
+
+    EXPECT_TRUE(ring.push(createRecord(5)));
+    drained.clear();
+    EXPECT_EQ(1u, ring.drain(drained));
+    EXPECT_EQ(5u, drained[0].startNs);
+}
+
+TEST(ApiTraceNames, givenSameNameRegisteredTwiceThenTheSameIdIsReturned) {
+    auto firstId = ApiTraceNames::registerName("apiTraceNamesTestFunction");
+    std::string copy = "apiTraceNamesTestFunction";
+    EXPECT_EQ(firstId, ApiTraceNames::registerName(copy.c_str()));
+    EXPECT_NE(firstId, ApiTraceNames::registerName("apiTraceNamesOtherTestFunction"));
+}
+
+TEST_F(ApiTracerTest, givenRecordedCallsWhenTraceIsDecodedThenAllFieldsRoundTrip) {
+    auto readId = ApiTraceNames::registerName("clEnqueueReadBuffer");
+    auto finishId = ApiTraceNames::registerName("clFinish");
+    int queue = 0;
+    int buffer = 0;
+
+    tracer->record(readId, 1000, 250, &queue, &buffer, 0);
+    tracer->flush();
+    tracer->record(finishId, 2000, 5000, &queue, nullptr, -5);
+    tracer->flush();
+
+    ASSERT_TRUE(decode());
+    auto &records = decoder.getRecords();
+    ASSERT_EQ(2u, records.size());
+
+    EXPECT_EQ(readId, records[0].apiId);
+    EXPECT_EQ(1000u, records[0].startNs);
+    EXPECT_EQ(250u, records[0].durationNs);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&queue), records[0].queue);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&buffer), records[0].object);
+    EXPECT_EQ(0, records[0].retVal);
+
+    EXPECT_EQ(finishId, records[1].apiId);
+    EXPECT_EQ(5000u, records[1].durationNs);
+    EXPECT_EQ(0u, records[1].object);
+    EXPECT_EQ(-5, records[1].retVal);
+
+    EXPECT_STREQ("clEnqueueReadBuffer", decoder.getApiName(readId).c_str());
+    EXPECT_STREQ("clFinish", decoder.getApiName(finishId).c_str());
+    EXPECT_STREQ("unknown", decoder.getApiName(0xffffffff).c_str());
+
+    std::stringstream json;
+    decoder.writeChromeTrace(json);
+    auto jsonString = json.str();
+    EXPECT_EQ(0u, jsonString.find("{\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, jsonString.find("\"name\":\"clEnqueueReadBuffer\",\"cat\":\"api\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":0.000,\"dur\":0.250"));
+    EXPECT_NE(std::string::npos, jsonString.find("\"name\":\"clFinish\",\"cat\":\"api\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":1.000,\"dur\":5.000"));
+    EXPECT_NE(std::string::npos, jsonString.find("\"retVal\":-5"));
+}
+
+TEST_F(ApiTracerTest, givenRecordsFromManyThreadsWhenTraceIsDecodedThenTheyAreOrderedByTimestamp) {
+    const uint32_t threadsCount = 4;
+    const uint32_t recordsPerThread = 200;
+    std::vector<std::thread> threads;
+    for (uint32_t thread = 0; thread < threadsCount; thread++) {
+        threads.push_back(std::thread([this, thread] {
+            for (uint32_t i = 0; i < recordsPerThread; i++) {
+                tracer->record(thread, ApiTracer::getTimestampNs(), 0, nullptr, nullptr, static_cast<int32_t>(i));
+                if (i % 32 == 31) {
+                    tracer->flush();
+                }
+            }
+        }));
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    tracer->flush();
+
+    EXPECT_EQ(0u, tracer->peekDroppedCount());
+    ASSERT_TRUE(decode());
+    auto &records = decoder.getRecords();
+    ASSERT_EQ(threadsCount * recordsPerThread, records.size());
+
+    std::vector<int32_t> lastRetValPerThread(threadsCount, -1);
+    for (size_t i = 0; i < records.size(); i++) {
+        if (i > 0) {
+            EXPECT_LE(records[i - 1].startNs, records[i].startNs);
+        }
+        ASSERT_LT(records[i].threadId, threadsCount);
+        // records of one thread keep their program order
+        EXPECT_LT(lastRetValPerThread[records[i].threadId], records[i].retVal);
+        lastRetValPerThread[records[i].threadId] = records[i].retVal;
+    }
+}
+
+TEST_F(ApiTracerTest, givenThreadsExitingOneAfterAnotherWhenTheyRecordThenRingIsReusedAndRecordsAreKept) {
+    const uint32_t threadsCount = 8;
+    for (uint32_t thread = 0; thread < threadsCount; thread++) {
+        std::thread([this, thread] {
+            tracer->record(0, thread, 0, nullptr, nullptr, static_cast<int32_t>(thread));
+        }).join();
+    }
+    EXPECT_EQ(1u, tracer->peekRingsCount());
+
+    tracer->flush();
+    ASSERT_TRUE(decode());
+    auto &records = decoder.getRecords();
+    ASSERT_EQ(threadsCount, records.size());
+    for (uint32_t i = 0; i < threadsCount; i++) {
+        EXPECT_EQ(static_cast<int32_t>(i), records[i].retVal);
+        // every thread still gets its own id in the trace
+        EXPECT_EQ(i, records[i].threadId);
+    }
+}
+
+TEST_F(ApiTracerTest, givenTracerDestroyedBeforeThreadExitWhenThreadExitsThenRingIsNotReleased) {
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool recorded = false;
+    bool tracerDestroyed = false;
+    std::thread thread([&] {
+        tracer->record(0, 1, 0, nullptr, nullptr, 0);
+        std::unique_lock<std::mutex> lock(mutex);
+        recorded = true;
+        condition.notify_one();
+        condition.wait(lock, [&] { return tracerDestroyed; });
+    });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return recorded; });
+        tracer.reset();
+        tracerDestroyed = true;
+    }
+    condition.notify_one();
+    thread.join();
+
+    ASSERT_TRUE(decode());
+    EXPECT_EQ(1u, decoder.getRecords().size());
+}
+
+TEST_F(ApiTracerTest, givenBackgroundFlusherWhenItIsStoppedThenRecordedCallsAreWritten) {
+    tracer->startFlusher(std::chrono::milliseconds(1));
+    tracer->record(0, 1, 1, nullptr, nullptr, 0);
+    tracer->stopFlusher();
+
+    ASSERT_TRUE(decode());
+    EXPECT_EQ(1u, decoder.getRecords().size());
+}
+
+TEST_F(ApiTracerTest, givenTraceScopeWithoutGlobalTracerWhenDestroyedThenNothingIsRecorded) {
+    int retVal = 0;
+    {
+        ApiTraceScope scope(0, &retVal);
+        scope.setHandles(nullptr, nullptr);
+    }
+    tracer->flush();
+    ASSERT_TRUE(decode());
+    EXPECT_EQ(0u, decoder.getRecords().size());
+}
+
+TEST_F(ApiTracerTest, givenGlobalTracerShutDownWhenItIsRequestedThenNullptrIsReturnedAndRecordsAreFlushed) {
+    auto originalTracer = ApiTracer::replaceGlobal(tracer.get());
+    EXPECT_EQ(tracer.get(), ApiTracer::getGlobal());
+
+    int retVal = 0;
+    {
+        ApiTraceScope scope(0, &retVal);
+    }
+    ApiTracer::shutdownGlobal();
+    EXPECT_EQ(nullptr, ApiTracer::getGlobal());
+    {
+        ApiTraceScope scope(0, &retVal);
+    }
+    ApiTracer::shutdownGlobal();
+
+    ASSERT_TRUE(decode());
+    EXPECT_EQ(1u, decoder.getRecords().size());
+    ApiTracer::replaceGlobal(originalTracer);
+}
+
+TEST(ApiTraceDecoder, givenStreamWithInvalidHeaderWhenLoadedThenFalseIsReturned) {
+    ApiTrace::FileHeader header = {ApiTrace::fileMagic + 1, ApiTrace::fileVersion, sizeof(ApiTrace::Record), 0};
+    std::stringstream input(std::string(reinterpret_cast<const char *>(&header), sizeof(header)));
+    ApiTraceDecoder decoder;
+    EXPECT_FALSE(decoder.load(input));
+}
+
+TEST(ApiTraceDecoder, givenTruncatedRecordsChunkWhenLoadedThenFalseIsReturned) {
+    ApiTrace::FileHeader header = {ApiTrace::fileMagic, ApiTrace::fileVersion, sizeof(ApiTrace::Record), 0};
+    ApiTrace::ChunkHeader chunk = {ApiTrace::ChunkType::Records, 2 * sizeof(ApiTrace::Record)};
+    auto record = createRecord(0);
+    std::string data(reinterpret_cast<const char *>(&header), sizeof(header));
+    data.append(reinterpret_cast<const char *>(&chunk), sizeof(chunk));
+    data.append(reinterpret_cast<const char *>(&record), sizeof(record));
+
+    std::stringstream input(data);
+    ApiTraceDecoder decoder;
+    EXPECT_FALSE(decoder.load(input));
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2018, Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "runtime/utilities/slab_allocator.h"
+#include "unit_tests/helpers/memory_management.h"
+#include "unit_tests/mocks/mock_slab_allocator.h"
+#include "gtest/gtest.h"
+
+#include <set>
+
+using namespace OCLRT;
+
+TEST(SlabAllocatorTest, givenSmallBlockSizeWhenAllocatorIsCreatedThenBlockSizeIsAlignedAndNoSlabIsAllocated) {
+    SlabAllocator allocator(20, 8);
+    EXPECT_EQ(32u, allocator.getBlockSize());
+    EXPECT_EQ(8u, allocator.getBlocksPerSlab());
+    EXPECT_EQ(0u, allocator.getSlabCount());
+    EXPECT_EQ(0u, allocator.getFreeBlockCount());
+}
+
+TEST(SlabAllocatorTest, givenEmptyAllocatorWhenBlockIsAllocatedThenSlabIsAddedAndBlockIsAligned) {
+    SlabAllocator allocator(64, 8);
+    auto block = allocator.allocate();
+    ASSERT_NE(nullptr, block);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(block) % SlabAllocator::blockAlignment);
+    EXPECT_EQ(1u, allocator.getSlabCount());
+    EXPECT_EQ(7u, allocator.getFreeBlockCount());
+
+    allocator.release(block);
+    EXPECT_EQ(8u, allocator.getFreeBlockCount());
+}
+
+TEST(SlabAllocatorTest, givenReleasedBlockWhenNextBlockIsAllocatedThenSameBlockIsReused) {
+    SlabAllocator allocator(64, 8);
+    auto block = allocator.allocate();
+    allocator.release(block);
+    EXPECT_EQ(block, allocator.allocate());
+    allocator.release(block);
+}
+
+TEST(SlabAllocatorTest, givenExhaustedSlabWhenBlocksAreAllocatedThenNewSlabIsAddedAndAllBlocksAreDistinct) {
+    SlabAllocator allocator(64, 4);
+    void *blocks[10];
+    std::set<void *> uniqueBlocks;
+    for (auto &block : blocks) {
+        block = allocator.allocate();
+        ASSERT_NE(nullptr, block);
+        memset(block, 0xcd, allocator.getBlockSize());
+        uniqueBlocks.insert(block);
+    }
+    EXPECT_EQ(10u, uniqueBlocks.size());
+    EXPECT_EQ(3u, allocator.getSlabCount());
+
+    allocator.releaseBatch(blocks, 10);
+    EXPECT_EQ(12u, allocator.getFreeBlockCount());
+}
+
+TEST(SlabAllocatorTest, whenBatchIsAllocatedThenRequestedNumberOfBlocksIsReturned) {
+    SlabAllocator allocator(128, 4);
+    void *blocks[6] = {};
+    EXPECT_EQ(6u, allocator.allocateBatch(blocks, 6));
+    EXPECT_EQ(2u, allocator.getSlabCount());
+    EXPECT_EQ(2u, allocator.getFreeBlockCount());
+    allocator.releaseBatch(blocks, 6);
+    EXPECT_EQ(8u, allocator.getFreeBlockCount());
+}
+
+TEST(SlabCacheTest, givenEmptyCacheWhenBlockIsAllocatedThenHalfCapacityIsMovedFromAllocator) {
+    SlabAllocator allocator(64, 64);
+    SlabCache cache;
+    auto block = cache.allocate(allocator);
+    ASSERT_NE(nullptr, block);
+    EXPECT_EQ(SlabCache::capacity / 2 - 1, cache.count);
+    EXPECT_EQ(64u - SlabCache::capacity / 2, allocator.getFreeBlockCount());
+
+    cache.release(allocator, block);
+    cache.flush(allocator);
+    EXPECT_EQ(0u, cache.count);
+    EXPECT_EQ(64u, allocator.getFreeBlockCount());
+}
+
+TEST(SlabCacheTest, givenFullCacheWhenBlockIsReleasedThenHalfCapacityIsReturnedToAllocator) {
+    SlabAllocator allocator(64, 64);
+    SlabCache cache;
+    void *blocks[SlabCache::capacity + 1];
+    for (auto &block : blocks) {
+        block = allocator.allocate();
+    }
+    for (size_t i = 0; i < SlabCache::capacity; i++) {
+        cache.release(allocator, blocks[i]);
+    }
+    EXPECT_EQ(SlabCache::capacity, cache.count);
+    auto freeBlocksBefore = allocator.getFreeBlockCount();
+
+    cache.release(allocator, blocks[SlabCache::capacity]);
+    EXPECT_EQ(SlabCache::capacity / 2 + 1, cache.count);
+    EXPECT_EQ(freeBlocksBefore + SlabCache::capacity / 2, allocator.getFreeBlockCount());
+
+    cache.flush(allocator);
+    EXPECT_EQ(64u, allocator.getFreeBlockCount());
+}
+
+struct SlabAllocatorTestTag {};
+using TestSizeClassSlabAllocator = SizeClassSlabAllocator<SlabAllocatorTestTag>;
+
+TEST(SizeClassSlabAllocatorTest, whenSizeClassIsQueriedThenSmallestBlockFittingSizeAndHeaderIsSelected) {
+    EXPECT_EQ(0u, TestSizeClassSlabAllocator::getSizeClass(1));
+    EXPECT_EQ(0u, TestSizeClassSlabAllocator::getSizeClass(64 - TestSizeClassSlabAllocator::headerSize));
+    EXPECT_EQ(1u, TestSizeClassSlabAllocator::getSizeClass(64 - TestSizeClassSlabAllocator::headerSize + 1));
+    EXPECT_EQ(4u, TestSizeClassSlabAllocator::getSizeClass(1000));
+    EXPECT_EQ(TestSizeClassSlabAllocator::numSizeClasses - 1, TestSizeClassSlabAllocator::getSizeClass(8192 - TestSizeClassSlabAllocator::headerSize));
+    EXPECT_EQ(TestSizeClassSlabAllocator::heapSizeClass, TestSizeClassSlabAllocator::getSizeClass(8192));
+}
+
+TEST(SizeClassSlabAllocatorTest, givenSizeAboveLargestClassWhenAllocatedThenHeapMemoryIsUsedAndReleased) {
+    const size_t size = 16 * 1024;
+    auto ptr = TestSizeClassSlabAllocator::allocate(size);
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % SlabAllocator::blockAlignment);
+    memset(ptr, 0xcd, size);
+    TestSizeClassSlabAllocator::release(ptr);
+}
+
+struct SizeClassSlabAllocatorSlabTest : public ::testing::Test {
+    void SetUp() override {
+        // slabs stay with the shared allocators until process exit
+        MemoryManagement::fastLeaksDetectionMode = MemoryManagement::LeakDetectionMode::TURN_OFF_LEAK_DETECTION;
+    }
+};
+
+struct ThreadCacheTestTag {};
+struct SizeClassRoundTripTestTag {};
+
+TEST_F(SizeClassSlabAllocatorSlabTest, givenSmallSizeWhenAllocatedAndReleasedThenBlockGoesThroughThreadCache) {
+    using Allocator = MockSizeClassSlabAllocator<ThreadCacheTestTag>;
+    const size_t size = 100;
+    const uint32_t sizeClass = 1;
+    ASSERT_EQ(sizeClass, Allocator::getSizeClass(size));
+
+    auto ptr = Allocator::allocate(size);
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % SlabAllocator::blockAlignment);
+    EXPECT_EQ(sizeClass, Allocator::getBlockSizeClass(ptr));
+    memset(ptr, 0xcd, size);
+
+    auto &cache = Allocator::getThreadCaches().caches[sizeClass];
+    auto &sharedAllocator = Allocator::getSharedAllocator(sizeClass);
+    EXPECT_EQ(1u, sharedAllocator.getSlabCount());
+    EXPECT_EQ(SlabCache::capacity / 2 - 1, cache.count);
+    EXPECT_EQ(Allocator::getTotalBlockCount(sizeClass) - SlabCache::capacity / 2, sharedAllocator.getFreeBlockCount());
+
+    Allocator::release(ptr);
+    EXPECT_EQ(SlabCache::capacity / 2, cache.count);
+    EXPECT_EQ(Allocator::getTotalBlockCount(sizeClass) - SlabCache::capacity / 2, sharedAllocator.getFreeBlockCount());
+
+    auto reusedPtr = Allocator::allocate(size);
+    EXPECT_EQ(ptr, reusedPtr);
+    Allocator::release(reusedPtr);
+
+    cache.flush(sharedAllocator);
+    EXPECT_EQ(Allocator::getTotalBlockCount(sizeClass), sharedAllocator.getFreeBlockCount());
+}
+
+TEST_F(SizeClassSlabAllocatorSlabTest, givenAllocationsOfDifferentSizesWhenReleasedThenEachBlockReturnsToSizeClassRecordedInItsHeader) {
+    using Allocator = MockSizeClassSlabAllocator<SizeClassRoundTripTestTag>;
+    const size_t headerSize = Allocator::headerSize;
+    const size_t sizes[] = {1, 64 - headerSize, 64 - headerSize + 1, 200, 1000, 4000, 8192 - headerSize, 8192};
+    const uint32_t expectedSizeClasses[] = {0, 0, 1, 2, 4, 6, 7, Allocator::heapSizeClass};
+
+    void *ptrs[sizeof(sizes) / sizeof(sizes[0])];
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        ptrs[i] = Allocator::allocate(sizes[i]);
+        ASSERT_NE(nullptr, ptrs[i]);
+        EXPECT_EQ(expectedSizeClasses[i], Allocator::getBlockSizeClass(ptrs[i]));
+        memset(ptrs[i], 0xcd, sizes[i]);
+    }
+    for (auto ptr : ptrs) {
+        Allocator::release(ptr);
+    }
+
+    for (uint32_t sizeClass = 0; sizeClass < Allocator::numSizeClasses; sizeClass++) {
+        auto &sharedAllocator = Allocator::getSharedAllocator(sizeClass);
+        Allocator::getThreadCaches().caches[sizeClass].flush(sharedAllocator);
+        EXPECT_EQ(Allocator::getTotalBlockCount(sizeClass), sharedAllocator.getFreeBlockCount());
+    }
+    EXPECT_EQ(1u, Allocator::getSharedAllocator(0).getSlabCount());
+    EXPECT_EQ(0u, Allocator::getSharedAllocator(3).getSlabCount());
+}